@@ -7,6 +7,7 @@
 
 #include <rhydb/common/data_version.h>
 #include <rhydb/database.h>
+#include <rhydb/query_engine/scalar_expressions/filter_bitmap_cache.h>
 
 namespace {
 void monitorReferenceCountThenTrimAllocations(
@@ -49,6 +50,9 @@ void rhydb_app::ActiveDatabase::setActiveDatabase(rhydb::Database&& new_database
    auto new_database_pointer = std::make_shared<rhydb::Database>(std::move(new_database));
 
    std::atomic_store(&database, new_database_pointer);
+   query_result_cache.invalidate();
+   // The bitmaps of the old tables are never hit again
+   rhydb::query_engine::scalar_expressions::getFilterBitmapCache().clear();
 
    SPDLOG_INFO(
       "Swapped Database that is serving new incoming requests to new database with data version "
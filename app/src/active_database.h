@@ -4,6 +4,8 @@
 
 #include <rhydb/database.h>
 
+#include "query_result_cache.h"
+
 namespace rhydb_app {
 
 class UninitializedDatabaseException : public std::runtime_error {
@@ -14,9 +16,11 @@ class UninitializedDatabaseException : public std::runtime_error {
 
 class ActiveDatabase {
    std::shared_ptr<rhydb::Database> database;
+   QueryResultCache query_result_cache;
 
   public:
-   ActiveDatabase() = default;
+   explicit ActiveDatabase(size_t query_result_cache_size_in_bytes = 0)
+       : query_result_cache(query_result_cache_size_in_bytes) {}
    ActiveDatabase(const ActiveDatabase& other) = delete;
    ActiveDatabase(ActiveDatabase&& other) = delete;
    ActiveDatabase& operator=(const ActiveDatabase& other) = delete;
@@ -25,6 +29,9 @@ class ActiveDatabase {
    void setActiveDatabase(rhydb::Database&& new_database);
 
    std::shared_ptr<rhydb::Database> getActiveDatabase();
+
+   /// Invalidated whenever a new database is activated
+   QueryResultCache& getQueryResultCache() { return query_result_cache; }
 };
 
 }  // namespace rhydb_app
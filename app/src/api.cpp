@@ -7,10 +7,14 @@
 #include <spdlog/spdlog.h>
 
 #include <rhydb/common/silo_directory.h>
+#include <rhydb/persistence/load_mode.h>
+#include <rhydb/query_engine/exec_node/scan_thread_pool.h>
+#include <rhydb/query_engine/scalar_expressions/filter_bitmap_cache.h>
 
 #include "active_database.h"
 #include "memory_monitor.h"
 #include "request_handler_factory.h"
+#include "response_writer.h"
 #include "silo_directory_watcher.h"
 
 namespace rhydb_app {
@@ -50,13 +54,53 @@ int Api::runApi(const rhydb::config::RuntimeConfig& runtime_config) {
       /* maxCapacity = */ worker_threads_to_use
    );
 
-   auto database = std::make_shared<ActiveDatabase>();
+   const auto scan_thread_status = rhydb::query_engine::exec_node::setScanThreadPoolCapacity(
+      runtime_config.api_options.table_scan_threads
+   );
+   if (!scan_thread_status.ok()) {
+      SPDLOG_ERROR("Failed to set up the table scan threads: {}", scan_thread_status.ToString());
+      return EXIT_FAILURE;
+   }
+   SPDLOG_INFO(
+      "Using {} threads for table scans",
+      rhydb::query_engine::exec_node::getScanThreadPool()->GetCapacity()
+   );
+
+   const size_t query_result_cache_size =
+      size_t{runtime_config.api_options.query_result_cache_size_in_megabytes} * 1024 * 1024;
+   SPDLOG_INFO("Using {} bytes for the query result cache", query_result_cache_size);
+   auto database = std::make_shared<ActiveDatabase>(query_result_cache_size);
+
+   const size_t filter_bitmap_cache_size =
+      size_t{runtime_config.api_options.filter_bitmap_cache_size_in_megabytes} * 1024 * 1024;
+   SPDLOG_INFO("Using {} bytes for the filter bitmap cache", filter_bitmap_cache_size);
+   rhydb::query_engine::scalar_expressions::getFilterBitmapCache().setCapacity(
+      filter_bitmap_cache_size
+   );
+
+   std::shared_ptr<ResponseWriter> response_writer;
+   if (runtime_config.api_options.response_buffer_size_in_megabytes > 0) {
+      const size_t response_buffer_size =
+         size_t{runtime_config.api_options.response_buffer_size_in_megabytes} * 1024 * 1024;
+      SPDLOG_INFO(
+         "Sending results on a separate thread with a buffer of {} bytes per response",
+         response_buffer_size
+      );
+      response_writer = std::make_shared<ResponseWriter>(
+         response_buffer_size,
+         std::chrono::seconds{runtime_config.api_options.response_send_timeout_in_seconds}
+      );
+   }
 
-   auto silo_request_handler_factory =
-      std::make_unique<rhydb_app::RhyDBRequestHandlerFactory>(runtime_config, database);
+   auto silo_request_handler_factory = std::make_unique<rhydb_app::RhyDBRequestHandlerFactory>(
+      runtime_config, database, response_writer
+   );
 
+   const auto load_mode = runtime_config.api_options.memory_mapped_load
+                             ? rhydb::persistence::LoadMode::MEMORY_MAPPED
+                             : rhydb::persistence::LoadMode::COPY;
    const rhydb_app::RhyDBDirectoryWatcher directory_watcher(
-      rhydb::RhyDBDirectory{runtime_config.data_directory}, database
+      rhydb::RhyDBDirectory{runtime_config.data_directory}, database, load_mode
    );
 
    const rhydb_app::MemoryMonitor memory_monitor{runtime_config.api_options.soft_memory_limit};
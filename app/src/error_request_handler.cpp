@@ -10,8 +10,11 @@
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
 
+#include <rhydb/query_engine/cancellation_token.h>
+
 #include "active_database.h"
 #include "bad_request.h"
+#include "query_scheduler.h"
 
 namespace rhydb_app {
 ErrorRequestHandler::ErrorRequestHandler(
@@ -42,6 +45,24 @@ void ErrorRequestHandler::handleRequest(
       out_stream << nlohmann::json(
          ErrorResponse{.error = "Service Temporarily Unavailable", .message = message}
       );
+   } catch (const rhydb_app::QueryRejected& exception) {
+      SPDLOG_INFO("Rejected query: {}", exception.what());
+
+      response.setContentType("application/json");
+      response.setStatusAndReason(Poco::Net::HTTPResponse::HTTP_SERVICE_UNAVAILABLE);
+      std::ostream& out_stream = response.send();
+      out_stream << nlohmann::json(
+         ErrorResponse{.error = "Service Temporarily Unavailable", .message = exception.what()}
+      );
+   } catch (const rhydb::query_engine::QueryCancelledException& exception) {
+      SPDLOG_INFO("Cancelled query: {}", exception.what());
+
+      response.setContentType("application/json");
+      response.setStatusAndReason(Poco::Net::HTTPResponse::HTTP_SERVICE_UNAVAILABLE);
+      std::ostream& out_stream = response.send();
+      out_stream << nlohmann::json(
+         ErrorResponse{.error = "Service Temporarily Unavailable", .message = exception.what()}
+      );
    } catch (const rhydb_app::BadRequest& exception) {
       response.setContentType("application/json");
       response.setStatusAndReason(Poco::Net::HTTPResponse::HTTP_BAD_REQUEST);
@@ -6,15 +6,23 @@
 #include <Poco/Net/HTTPServerRequest.h>
 #include <Poco/Net/HTTPServerResponse.h>
 #include <Poco/URI.h>
+#include <nlohmann/json.hpp>
+#include <utility>
 
 namespace rhydb_app {
 
+HealthHandler::HealthHandler(std::shared_ptr<QueryScheduler> query_scheduler)
+    : query_scheduler(std::move(query_scheduler)) {}
+
 void HealthHandler::get(
    Poco::Net::HTTPServerRequest& /*request*/,
    Poco::Net::HTTPServerResponse& response
 ) {
    response.setContentType("application/json");
    response.setStatus(Poco::Net::HTTPResponse::HTTP_OK);
-   response.send() << R"({"status":"UP"})";
+   const nlohmann::json health{
+      {"status", "UP"}, {"queryScheduler", query_scheduler->getStatistics()}
+   };
+   response.send() << health;
 }
 }  // namespace rhydb_app
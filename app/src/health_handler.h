@@ -1,15 +1,21 @@
 #pragma once
 
+#include <memory>
+
 #include <Poco/Net/HTTPServerRequest.h>
 #include <Poco/Net/HTTPServerResponse.h>
 
+#include "query_scheduler.h"
 #include "rest_resource.h"
 
 namespace rhydb_app {
 
 class HealthHandler : public RestResource {
+  private:
+   std::shared_ptr<QueryScheduler> query_scheduler;
+
   public:
-   explicit HealthHandler() = default;
+   explicit HealthHandler(std::shared_ptr<QueryScheduler> query_scheduler);
 
    void get(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response)
       override;
@@ -1,5 +1,6 @@
 #include "info_handler.h"
 
+#include <algorithm>
 #include <string>
 
 #include <Poco/Net/HTTPServerRequest.h>
@@ -8,22 +9,80 @@
 #include <nlohmann/json.hpp>
 #include <utility>
 
+#include <rhydb/query_engine/scalar_expressions/filter_bitmap_cache.h>
+
 #include "active_database.h"
 
 namespace rhydb_app {
 
-InfoHandler::InfoHandler(std::shared_ptr<ActiveDatabase> database_handle)
-    : database_handle(std::move(database_handle)) {}
+InfoHandler::InfoHandler(
+   std::shared_ptr<ActiveDatabase> database_handle,
+   std::shared_ptr<QueryScheduler> query_scheduler
+)
+    : database_handle(std::move(database_handle)),
+      query_scheduler(std::move(query_scheduler)) {}
+
+namespace {
+
+/// Whether the request asks for the per-chunk statistics with `?chunkStatistics=true`
+bool requestsChunkStatistics(const Poco::Net::HTTPServerRequest& request) {
+   const Poco::URI uri(request.getURI());
+   return std::ranges::any_of(uri.getQueryParameters(), [](const auto& parameter) {
+      return parameter.first == "chunkStatistics" && parameter.second == "true";
+   });
+}
+
+/// Whether the request asks for the statistics of the query result cache with
+/// `?queryResultCache=true`
+bool requestsQueryResultCacheStatistics(const Poco::Net::HTTPServerRequest& request) {
+   const Poco::URI uri(request.getURI());
+   return std::ranges::any_of(uri.getQueryParameters(), [](const auto& parameter) {
+      return parameter.first == "queryResultCache" && parameter.second == "true";
+   });
+}
+
+/// Whether the request asks for the statistics of the filter bitmap cache with
+/// `?filterBitmapCache=true`
+bool requestsFilterBitmapCacheStatistics(const Poco::Net::HTTPServerRequest& request) {
+   const Poco::URI uri(request.getURI());
+   return std::ranges::any_of(uri.getQueryParameters(), [](const auto& parameter) {
+      return parameter.first == "filterBitmapCache" && parameter.second == "true";
+   });
+}
+
+/// Whether the request asks for the lane occupancy of the query scheduler with
+/// `?queryScheduler=true`
+bool requestsQuerySchedulerStatistics(const Poco::Net::HTTPServerRequest& request) {
+   const Poco::URI uri(request.getURI());
+   return std::ranges::any_of(uri.getQueryParameters(), [](const auto& parameter) {
+      return parameter.first == "queryScheduler" && parameter.second == "true";
+   });
+}
+
+}  // namespace
 
 void InfoHandler::get(
-   Poco::Net::HTTPServerRequest& /*request*/,
+   Poco::Net::HTTPServerRequest& request,
    Poco::Net::HTTPServerResponse& response
 ) {
    const auto database = database_handle->getActiveDatabase();
 
    response.set("data-version", database->getDataVersionTimestamp().value);
 
-   const nlohmann::json database_info = nlohmann::json(database->getDatabaseInfo());
+   nlohmann::json database_info = nlohmann::json(database->getDatabaseInfo());
+   if (requestsChunkStatistics(request)) {
+      database_info["chunkStatistics"] = database->getChunkStatistics();
+   }
+   if (requestsQueryResultCacheStatistics(request)) {
+      database_info["queryResultCache"] = database_handle->getQueryResultCache().getStatistics();
+   }
+   if (requestsFilterBitmapCacheStatistics(request)) {
+      database_info["filterBitmapCache"] =
+         rhydb::query_engine::scalar_expressions::getFilterBitmapCache().getStatistics();
+   }
+   if (requestsQuerySchedulerStatistics(request)) {
+      database_info["queryScheduler"] = query_scheduler->getStatistics();
+   }
    response.setContentType("application/json");
    std::ostream& out_stream = response.send();
    out_stream << database_info;
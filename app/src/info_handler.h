@@ -4,6 +4,7 @@
 #include <Poco/Net/HTTPServerResponse.h>
 
 #include "active_database.h"
+#include "query_scheduler.h"
 #include "rest_resource.h"
 
 namespace rhydb_app {
@@ -11,9 +12,13 @@ namespace rhydb_app {
 class InfoHandler : public RestResource {
   private:
    std::shared_ptr<ActiveDatabase> database_handle;
+   std::shared_ptr<QueryScheduler> query_scheduler;
 
   public:
-   explicit InfoHandler(std::shared_ptr<ActiveDatabase> database_handle);
+   InfoHandler(
+      std::shared_ptr<ActiveDatabase> database_handle,
+      std::shared_ptr<QueryScheduler> query_scheduler
+   );
 
    void get(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response)
       override;
@@ -1,5 +1,9 @@
 #include "query_handler.h"
 
+#include <chrono>
+#include <ios>
+#include <optional>
+#include <streambuf>
 #include <string>
 #include <utility>
 
@@ -7,40 +11,156 @@
 #include <Poco/Net/HTTPServerRequest.h>
 #include <Poco/Net/HTTPServerResponse.h>
 #include <Poco/StreamCopier.h>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 
+#include <rhydb/query_engine/cancellation_token.h>
 #include <rhydb/query_engine/exec_node/arrow_ipc_sink.h>
 #include <rhydb/query_engine/exec_node/ndjson_sink.h>
 #include <rhydb/query_engine/illegal_query_exception.h>
 #include <rhydb/query_engine/planner.h>
+#include <rhydb/query_engine/query_cost.h>
+#include <rhydb/query_engine/saneql/ast_to_query.h>
 #include <rhydb/query_engine/saneql/parse_exception.h>
 #include <evobench/evobench.hpp>
 
 #include "active_database.h"
 #include "bad_request.h"
 #include "error_request_handler.h"
+#include "query_result_cache.h"
+#include "query_scheduler.h"
+#include "response_buffer.h"
+#include "response_writer.h"
 
 namespace rhydb_app {
 
 QueryHandler::QueryHandler(
    std::shared_ptr<ActiveDatabase> database_handle,
+   std::shared_ptr<QueryScheduler> query_scheduler,
+   std::shared_ptr<ResponseWriter> response_writer,
    rhydb::config::QueryOptions query_options
 )
     : query_options(query_options),
-      database_handle(std::move(database_handle)) {}
+      database_handle(std::move(database_handle)),
+      query_scheduler(std::move(query_scheduler)),
+      response_writer(std::move(response_writer)) {}
 
 namespace {
 
 const uint64_t DEFAULT_TIMEOUT_TWO_MINUTES = 120;
 
+const std::string ARROW_IPC_CONTENT_TYPE = "application/vnd.apache.arrow.stream";
+const std::string NDJSON_CONTENT_TYPE = "application/x-ndjson";
+
+/// Passes everything on to `output` and keeps a copy of it, as long as the copy stays within
+/// `max_copy_size`
+class CopyingStreamBuffer : public std::streambuf {
+   std::streambuf* output;
+   size_t max_copy_size;
+   std::string copy;
+   bool copy_is_complete = true;
+
+   void keep(const char* data, size_t size) {
+      if (!copy_is_complete) {
+         return;
+      }
+      if (copy.size() + size > max_copy_size) {
+         copy_is_complete = false;
+         std::string{}.swap(copy);
+         return;
+      }
+      copy.append(data, size);
+   }
+
+  protected:
+   std::streamsize xsputn(const char* data, std::streamsize count) override {
+      keep(data, static_cast<size_t>(count));
+      return output->sputn(data, count);
+   }
+
+   int_type overflow(int_type character) override {
+      if (traits_type::eq_int_type(character, traits_type::eof())) {
+         return traits_type::not_eof(character);
+      }
+      const char byte = traits_type::to_char_type(character);
+      keep(&byte, 1);
+      return output->sputc(byte);
+   }
+
+   int sync() override { return output->pubsync(); }
+
+  public:
+   CopyingStreamBuffer(std::streambuf* output, size_t max_copy_size)
+       : output(output),
+         max_copy_size(max_copy_size) {}
+
+   /// The copy of everything, if it did not exceed `max_copy_size`
+   std::optional<std::string> takeCopy() && {
+      if (!copy_is_complete) {
+         return std::nullopt;
+      }
+      return std::move(copy);
+   }
+};
+
+/// A response is identified by the data version, the format, the query and its optimized plan. The
+/// plan holds what the query text leaves open, e.g. the seed that an unseeded `randomize` draws,
+/// while the query text holds the details that the descriptions of the plan nodes leave out.
+std::string queryResultCacheKey(
+   const rhydb::Database& database,
+   const std::string& content_type,
+   const std::string& query_string,
+   const rhydb::query_engine::operators::QueryNode& optimized_query
+) {
+   return fmt::format(
+      "{}\n{}\n{}\n{}",
+      database.getDataVersionTimestamp().value,
+      content_type,
+      query_string,
+      optimized_query.toJson().dump()
+   );
 }
 
+void writeResults(
+   rhydb::query_engine::QueryPlan& query_plan,
+   bool use_arrow_ipc,
+   std::ostream& output_stream
+) {
+   if (use_arrow_ipc) {
+      auto result = rhydb::query_engine::exec_node::ArrowIpcSink::make(
+         &output_stream, query_plan.results_schema
+      );
+      if (!result.ok()) {
+         throw std::runtime_error(result.status().ToString());
+      }
+      auto output_sink = std::move(result).ValueUnsafe();
+
+      EVOBENCH_SCOPE("QueryPlan", "executeAndWrite");
+      query_plan.executeAndWrite(output_sink, DEFAULT_TIMEOUT_TWO_MINUTES);
+   } else {
+      rhydb::query_engine::exec_node::NdjsonSink output_sink{
+         &output_stream, query_plan.results_schema
+      };
+
+      EVOBENCH_SCOPE("QueryPlan", "executeAndWrite");
+      query_plan.executeAndWrite(output_sink, DEFAULT_TIMEOUT_TWO_MINUTES);
+   }
+}
+
+}  // namespace
+
 void QueryHandler::post(
    Poco::Net::HTTPServerRequest& request,
    Poco::Net::HTTPServerResponse& response
 ) {
    EVOBENCH_SCOPE("QueryHandler", "post");
 
+   QueryResultCache& result_cache = database_handle->getQueryResultCache();
+   // Taken before the database, so that the result of a database that is replaced in the meantime
+   // is not cached
+   const uint64_t cache_generation = result_cache.currentGeneration();
+
    // This fixes the database to outlive the execution of the query
    const auto database = database_handle->getActiveDatabase();
 
@@ -55,41 +175,105 @@ void QueryHandler::post(
    SPDLOG_INFO("Request Id [{}] - received query: {}", request_id, query_string);
 
    try {
-      auto query_plan = rhydb::query_engine::Planner::planSaneqlQuery(
-         query_string, database->tables, query_options, request_id
+      auto optimized_query = rhydb::query_engine::Planner::optimize(
+         rhydb::query_engine::saneql::parseAndConvertToQueryTree(query_string, database->tables),
+         request_id
       );
 
       response.set("data-version", database->getDataVersionTimestamp().value);
-      response.set(
-         "result-ordering", rhydb::query_engine::serializeResultOrdering(query_plan.result_ordering)
-      );
 
       const std::string accept_header = request.has("Accept") ? request.get("Accept") : "";
-      const bool use_arrow_ipc =
-         accept_header.find("application/vnd.apache.arrow.stream") != std::string::npos;
-
-      if (use_arrow_ipc) {
-         response.setContentType("application/vnd.apache.arrow.stream");
-         std::ostream& output_stream = response.send();
-         auto result = rhydb::query_engine::exec_node::ArrowIpcSink::make(
-            &output_stream, query_plan.results_schema
-         );
-         if (!result.ok()) {
-            throw std::runtime_error(result.status().ToString());
+      const bool use_arrow_ipc = accept_header.find(ARROW_IPC_CONTENT_TYPE) != std::string::npos;
+      const std::string& content_type =
+         use_arrow_ipc ? ARROW_IPC_CONTENT_TYPE : NDJSON_CONTENT_TYPE;
+
+      std::string cache_key;
+      if (result_cache.enabled()) {
+         cache_key = queryResultCacheKey(*database, content_type, query_string, *optimized_query);
+         if (const auto cached_result = result_cache.lookup(cache_key)) {
+            SPDLOG_INFO("Request Id [{}] - sending the cached result", request_id);
+            response.set("result-ordering", cached_result->result_ordering);
+            response.setContentType(cached_result->content_type);
+            std::ostream& output_stream = response.send();
+            output_stream.write(
+               cached_result->body.data(),
+               static_cast<std::streamsize>(cached_result->body.size())
+            );
+            return;
+         }
+      }
+
+      const auto cost_estimate = rhydb::query_engine::estimateQueryCost(*optimized_query);
+      // Declared before the plan, so that the plan frees its memory before the slot is released
+      const auto admission = query_scheduler->admit(cost_estimate);
+      SPDLOG_INFO(
+         "Request Id [{}] - admitted as {} query with estimated cost {}",
+         request_id,
+         queryLaneToString(admission->getLane()),
+         nlohmann::json(cost_estimate).dump()
+      );
+
+      // Planning evaluates the filters, which must finish within the same timeout as every batch
+      auto cancellation_token =
+         std::make_shared<rhydb::query_engine::CancellationToken>(request_id);
+      cancellation_token->setTimeout(std::chrono::seconds{DEFAULT_TIMEOUT_TWO_MINUTES});
+      auto query_plan = rhydb::query_engine::Planner::planOptimizedQuery(
+         *optimized_query,
+         database->tables,
+         query_options,
+         request_id,
+         &admission->memoryPool(),
+         std::move(cancellation_token)
+      );
+
+      const std::string result_ordering =
+         rhydb::query_engine::serializeResultOrdering(query_plan.result_ordering);
+      response.set("result-ordering", result_ordering);
+      response.setContentType(content_type);
+
+      // Without a response writer, or if it cannot take the connection, the worker thread sends
+      // the result itself
+      const auto response_buffer =
+         response_writer != nullptr ? response_writer->takeOver(request, response) : nullptr;
+      std::optional<ResponseBufferStreamBuffer> buffered_output;
+      if (response_buffer != nullptr) {
+         buffered_output.emplace(*response_buffer);
+      }
+      CopyingStreamBuffer copying_buffer{
+         buffered_output.has_value() ? &buffered_output.value() : response.send().rdbuf(),
+         result_cache.enabled() ? result_cache.maxEntrySizeInBytes() : 0
+      };
+      std::ostream output_stream{&copying_buffer};
+
+      try {
+         writeResults(query_plan, use_arrow_ipc, output_stream);
+      } catch (const std::exception& exception) {
+         if (response_buffer == nullptr) {
+            throw;
          }
-         auto output_sink = std::move(result).ValueUnsafe();
-
-         EVOBENCH_SCOPE("QueryPlan", "executeAndWrite");
-         query_plan.executeAndWrite(output_sink, DEFAULT_TIMEOUT_TWO_MINUTES);
-      } else {
-         response.setContentType("application/x-ndjson");
-         std::ostream& output_stream = response.send();
-         rhydb::query_engine::exec_node::NdjsonSink output_sink{
-            &output_stream, query_plan.results_schema
-         };
-
-         EVOBENCH_SCOPE("QueryPlan", "executeAndWrite");
-         query_plan.executeAndWrite(output_sink, DEFAULT_TIMEOUT_TWO_MINUTES);
+         // The head was already sent, the client sees the response end without its last chunk
+         SPDLOG_ERROR(
+            "Request Id [{}] - error while executing the query: {}", request_id, exception.what()
+         );
+         response_buffer->cancel();
+         return;
+      }
+      if (buffered_output.has_value() && !buffered_output->close()) {
+         output_stream.setstate(std::ios::badbit);
+      }
+
+      // A failed write means that the client did not receive the whole result
+      auto body = std::move(copying_buffer).takeCopy();
+      if (result_cache.enabled() && output_stream.good() && body.has_value()) {
+         result_cache.insert(
+            std::move(cache_key),
+            CachedQueryResult{
+               .content_type = content_type,
+               .result_ordering = result_ordering,
+               .body = std::move(body.value())
+            },
+            cache_generation
+         );
       }
    } catch (const rhydb::query_engine::saneql::ParseException& ex) {
       throw BadRequest(ex.what());
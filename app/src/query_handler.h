@@ -6,6 +6,8 @@
 #include <rhydb/config/runtime_config.h>
 
 #include "active_database.h"
+#include "query_scheduler.h"
+#include "response_writer.h"
 #include "rest_resource.h"
 
 namespace rhydb_app {
@@ -13,10 +15,15 @@ class QueryHandler : public RestResource {
   private:
    rhydb::config::QueryOptions query_options;
    std::shared_ptr<ActiveDatabase> database_handle;
+   std::shared_ptr<QueryScheduler> query_scheduler;
+   /// nullptr to send results on the http worker thread
+   std::shared_ptr<ResponseWriter> response_writer;
 
   public:
-   explicit QueryHandler(
+   QueryHandler(
       std::shared_ptr<ActiveDatabase> database_handle,
+      std::shared_ptr<QueryScheduler> query_scheduler,
+      std::shared_ptr<ResponseWriter> response_writer,
       rhydb::config::QueryOptions query_options
    );
 
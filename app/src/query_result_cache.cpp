@@ -0,0 +1,89 @@
+#include "query_result_cache.h"
+
+#include <utility>
+
+namespace rhydb_app {
+
+void to_json(nlohmann::json& json, const QueryResultCacheStatistics& statistics) {
+   json = nlohmann::json{
+      {"hits", statistics.hits},
+      {"misses", statistics.misses},
+      {"bytesSaved", statistics.bytes_saved},
+      {"entries", statistics.entries},
+      {"sizeInBytes", statistics.size_in_bytes},
+      {"capacityInBytes", statistics.capacity_in_bytes},
+   };
+}
+
+QueryResultCache::QueryResultCache(size_t capacity_in_bytes)
+    : capacity_in_bytes(capacity_in_bytes),
+      max_entry_size_in_bytes(capacity_in_bytes / MAX_ENTRY_SHARE) {}
+
+uint64_t QueryResultCache::currentGeneration() const {
+   const std::lock_guard lock{mutex};
+   return generation;
+}
+
+std::shared_ptr<const CachedQueryResult> QueryResultCache::lookup(const std::string& key) {
+   const std::lock_guard lock{mutex};
+   const auto entry = index.find(key);
+   if (entry == index.end()) {
+      ++misses;
+      return nullptr;
+   }
+   entries.splice(entries.begin(), entries, entry->second);
+   ++hits;
+   bytes_saved += entry->second->result->body.size();
+   return entry->second->result;
+}
+
+void QueryResultCache::insert(std::string key, CachedQueryResult result, uint64_t generation) {
+   const size_t entry_size = key.size() + result.body.size() + result.result_ordering.size() +
+                             result.content_type.size() + sizeof(Entry);
+   if (entry_size > max_entry_size_in_bytes) {
+      return;
+   }
+   const std::lock_guard lock{mutex};
+   if (generation != this->generation || index.contains(key)) {
+      return;
+   }
+   evictUntilBelow(capacity_in_bytes - entry_size);
+   entries.push_front(Entry{
+      .key = std::move(key),
+      .result = std::make_shared<const CachedQueryResult>(std::move(result)),
+      .size_in_bytes = entry_size
+   });
+   index.emplace(entries.front().key, entries.begin());
+   size_in_bytes += entry_size;
+}
+
+void QueryResultCache::evictUntilBelow(size_t target_size_in_bytes) {
+   while (size_in_bytes > target_size_in_bytes) {
+      const Entry& least_recently_used = entries.back();
+      size_in_bytes -= least_recently_used.size_in_bytes;
+      index.erase(least_recently_used.key);
+      entries.pop_back();
+   }
+}
+
+void QueryResultCache::invalidate() {
+   const std::lock_guard lock{mutex};
+   ++generation;
+   index.clear();
+   entries.clear();
+   size_in_bytes = 0;
+}
+
+QueryResultCacheStatistics QueryResultCache::getStatistics() const {
+   const std::lock_guard lock{mutex};
+   return {
+      .hits = hits,
+      .misses = misses,
+      .bytes_saved = bytes_saved,
+      .entries = entries.size(),
+      .size_in_bytes = size_in_bytes,
+      .capacity_in_bytes = capacity_in_bytes,
+   };
+}
+
+}  // namespace rhydb_app
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <nlohmann/json.hpp>
+
+namespace rhydb_app {
+
+/// The response to a query, as it was sent
+struct CachedQueryResult {
+   std::string content_type;
+   std::string result_ordering;
+   std::string body;
+};
+
+struct QueryResultCacheStatistics {
+   uint64_t hits;
+   uint64_t misses;
+   /// The bytes of the bodies that were sent from the cache
+   uint64_t bytes_saved;
+   size_t entries;
+   size_t size_in_bytes;
+   size_t capacity_in_bytes;
+};
+
+void to_json(nlohmann::json& json, const QueryResultCacheStatistics& statistics);
+
+/// The responses to recent queries, evicted least recently used first when they exceed
+/// `capacity_in_bytes`. The key of a response must identify the data version of the database that
+/// computed it, so that stale entries are never hit. `invalidate` drops all entries when a new data
+/// version is activated, and makes `insert` reject the responses of queries that started before.
+/// Thread-safe.
+class QueryResultCache {
+   struct Entry {
+      std::string key;
+      std::shared_ptr<const CachedQueryResult> result;
+      size_t size_in_bytes;
+   };
+
+   size_t capacity_in_bytes;
+   size_t max_entry_size_in_bytes;
+
+   mutable std::mutex mutex;
+   /// Most recently used first
+   std::list<Entry> entries;
+   std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+   size_t size_in_bytes = 0;
+   uint64_t generation = 0;
+   uint64_t hits = 0;
+   uint64_t misses = 0;
+   uint64_t bytes_saved = 0;
+
+   void evictUntilBelow(size_t target_size_in_bytes);
+
+  public:
+   /// A share of the capacity, so that a single response cannot evict most others
+   static constexpr size_t MAX_ENTRY_SHARE = 8;
+
+   /// A capacity of 0 disables the cache
+   explicit QueryResultCache(size_t capacity_in_bytes);
+
+   QueryResultCache(const QueryResultCache& other) = delete;
+   QueryResultCache& operator=(const QueryResultCache& other) = delete;
+
+   [[nodiscard]] bool enabled() const { return capacity_in_bytes > 0; }
+
+   /// Larger responses are streamed without being admitted
+   [[nodiscard]] size_t maxEntrySizeInBytes() const { return max_entry_size_in_bytes; }
+
+   /// Has to be taken before the database is, and passed to `insert`
+   [[nodiscard]] uint64_t currentGeneration() const;
+
+   /// Counts a hit or a miss
+   [[nodiscard]] std::shared_ptr<const CachedQueryResult> lookup(const std::string& key);
+
+   /// Does nothing if the cache was invalidated since `generation` or the result is too large
+   void insert(std::string key, CachedQueryResult result, uint64_t generation);
+
+   void invalidate();
+
+   [[nodiscard]] QueryResultCacheStatistics getStatistics() const;
+};
+
+}  // namespace rhydb_app
@@ -0,0 +1,85 @@
+#include "query_result_cache.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+using rhydb_app::CachedQueryResult;
+using rhydb_app::QueryResultCache;
+
+namespace {
+
+CachedQueryResult resultWithBody(std::string body) {
+   return {
+      .content_type = "application/x-ndjson", .result_ordering = "[]", .body = std::move(body)
+   };
+}
+
+}  // namespace
+
+TEST(QueryResultCache, returnsInsertedResultsAndCountsHitsAndMisses) {
+   QueryResultCache under_test{1024 * 1024};
+   EXPECT_EQ(under_test.lookup("query"), nullptr);
+
+   under_test.insert("query", resultWithBody("{\"count\":3}\n"), under_test.currentGeneration());
+   const auto result = under_test.lookup("query");
+   ASSERT_NE(result, nullptr);
+   EXPECT_EQ(result->body, "{\"count\":3}\n");
+   EXPECT_EQ(result->result_ordering, "[]");
+
+   const auto statistics = under_test.getStatistics();
+   EXPECT_EQ(statistics.hits, 1);
+   EXPECT_EQ(statistics.misses, 1);
+   EXPECT_EQ(statistics.bytes_saved, result->body.size());
+   EXPECT_EQ(statistics.entries, 1);
+}
+
+TEST(QueryResultCache, evictsTheLeastRecentlyUsedResults) {
+   const size_t body_size = 1000;
+   QueryResultCache under_test{QueryResultCache::MAX_ENTRY_SHARE * 2 * body_size};
+   const auto generation = under_test.currentGeneration();
+   under_test.insert("first", resultWithBody(std::string(body_size, 'a')), generation);
+   under_test.insert("second", resultWithBody(std::string(body_size, 'b')), generation);
+   for (size_t i = 0; i < QueryResultCache::MAX_ENTRY_SHARE * 2; ++i) {
+      // Keeps "first" the most recently used
+      ASSERT_NE(under_test.lookup("first"), nullptr);
+      under_test.insert(
+         "other " + std::to_string(i), resultWithBody(std::string(body_size, 'c')), generation
+      );
+   }
+
+   EXPECT_NE(under_test.lookup("first"), nullptr);
+   EXPECT_EQ(under_test.lookup("second"), nullptr);
+   const auto statistics = under_test.getStatistics();
+   EXPECT_LE(statistics.size_in_bytes, statistics.capacity_in_bytes);
+}
+
+TEST(QueryResultCache, doesNotAdmitResultsLargerThanTheMaximumEntrySize) {
+   QueryResultCache under_test{QueryResultCache::MAX_ENTRY_SHARE * 1000};
+   under_test.insert("large", resultWithBody(std::string(1000, 'a')), 0);
+   EXPECT_EQ(under_test.lookup("large"), nullptr);
+}
+
+TEST(QueryResultCache, rejectsResultsOfQueriesThatStartedBeforeAnInvalidation) {
+   QueryResultCache under_test{1024 * 1024};
+   const auto generation_before = under_test.currentGeneration();
+   under_test.insert("query", resultWithBody("old"), generation_before);
+
+   under_test.invalidate();
+   EXPECT_EQ(under_test.lookup("query"), nullptr);
+   EXPECT_EQ(under_test.getStatistics().entries, 0);
+
+   under_test.insert("query", resultWithBody("computed on the old data"), generation_before);
+   EXPECT_EQ(under_test.lookup("query"), nullptr);
+
+   under_test.insert("query", resultWithBody("new"), under_test.currentGeneration());
+   ASSERT_NE(under_test.lookup("query"), nullptr);
+   EXPECT_EQ(under_test.lookup("query")->body, "new");
+}
+
+TEST(QueryResultCache, isDisabledWithoutCapacity) {
+   QueryResultCache under_test{0};
+   EXPECT_FALSE(under_test.enabled());
+   under_test.insert("query", resultWithBody(""), under_test.currentGeneration());
+   EXPECT_EQ(under_test.lookup("query"), nullptr);
+}
@@ -0,0 +1,178 @@
+#include "query_scheduler.h"
+
+#include <utility>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <rhydb/common/panic.h>
+
+namespace rhydb_app {
+
+namespace {
+
+nlohmann::json laneToJson(const QueryLaneStatistics& lane) {
+   return nlohmann::json{
+      {"running", lane.running},
+      {"queued", lane.queued},
+      {"maxRunning", lane.max_running},
+      {"admitted", lane.admitted},
+      {"rejected", lane.rejected},
+   };
+}
+
+constexpr uint64_t BYTES_PER_MEGABYTE = uint64_t{1024} * 1024;
+
+}  // namespace
+
+std::string_view queryLaneToString(QueryLane lane) {
+   switch (lane) {
+      case QueryLane::CHEAP:
+         return "cheap";
+      case QueryLane::HEAVY:
+         return "heavy";
+   }
+   SILO_UNREACHABLE();
+}
+
+void to_json(nlohmann::json& json, const QuerySchedulerStatistics& statistics) {
+   json = nlohmann::json{
+      {"cheap", laneToJson(statistics.cheap)},
+      {"heavy", laneToJson(statistics.heavy)},
+      {"memoryInBytes", statistics.memory_in_bytes},
+      {"peakMemoryInBytes", statistics.peak_memory_in_bytes},
+      {"memoryBudgetInBytes", statistics.memory_budget_in_bytes},
+   };
+}
+
+QuerySchedulerOptions QuerySchedulerOptions::fromApiOptions(
+   const rhydb::config::ApiOptions& api_options
+) {
+   return {
+      .max_running_cheap_queries = api_options.max_running_cheap_queries,
+      .max_running_heavy_queries = api_options.max_running_heavy_queries,
+      .max_queued_queries = api_options.max_queued_queries_per_lane,
+      .heavy_query_threshold_in_bytes =
+         uint64_t{api_options.heavy_query_threshold_in_megabytes} * BYTES_PER_MEGABYTE,
+      .memory_budget_in_bytes =
+         uint64_t{api_options.query_memory_budget_in_megabytes} * BYTES_PER_MEGABYTE,
+      .max_queue_time = std::chrono::seconds{api_options.max_query_queue_time_in_seconds},
+   };
+}
+
+QueryScheduler::Admission::Admission(QueryScheduler& scheduler, QueryLane lane)
+    : scheduler(scheduler),
+      lane(lane),
+      memory_pool(&scheduler.memory_pool) {}
+
+QueryScheduler::Admission::~Admission() {
+   scheduler.release(lane);
+}
+
+QueryScheduler::QueryScheduler(QuerySchedulerOptions options)
+    : options(options),
+      memory_pool(
+         arrow::default_memory_pool(),
+         options.memory_budget_in_bytes == 0
+            ? std::nullopt
+            : std::optional<int64_t>{static_cast<int64_t>(options.memory_budget_in_bytes)}
+      ),
+      cheap{.max_running = options.max_running_cheap_queries},
+      heavy{.max_running = options.max_running_heavy_queries} {
+   SPDLOG_INFO(
+      "Admitting at most {} cheap and {} heavy queries at the same time (0 for no limit), "
+      "queries from {} bytes on are heavy, memory budget for queries: {} bytes (0 for no budget)",
+      options.max_running_cheap_queries,
+      options.max_running_heavy_queries,
+      options.heavy_query_threshold_in_bytes,
+      options.memory_budget_in_bytes
+   );
+}
+
+QueryScheduler::Lane& QueryScheduler::laneOf(QueryLane lane) {
+   return lane == QueryLane::CHEAP ? cheap : heavy;
+}
+
+bool QueryScheduler::hasRoomFor(QueryLane lane, uint64_t estimated_bytes) {
+   const Lane& state = laneOf(lane);
+   if (state.max_running != 0 && state.running >= state.max_running) {
+      return false;
+   }
+   if (lane == QueryLane::CHEAP || options.memory_budget_in_bytes == 0 || heavy.running == 0) {
+      return true;
+   }
+   const auto bytes_in_use = static_cast<uint64_t>(memory_pool.bytes_allocated());
+   return bytes_in_use + estimated_bytes <= options.memory_budget_in_bytes;
+}
+
+void QueryScheduler::release(QueryLane lane) {
+   {
+      const std::lock_guard lock{mutex};
+      --laneOf(lane).running;
+   }
+   slot_released.notify_all();
+}
+
+QueryLane QueryScheduler::classify(const rhydb::query_engine::QueryCostEstimate& estimate) const {
+   if (estimate.reconstructs_sequences ||
+       estimate.materialized_bytes >= options.heavy_query_threshold_in_bytes) {
+      return QueryLane::HEAVY;
+   }
+   return QueryLane::CHEAP;
+}
+
+std::unique_ptr<QueryScheduler::Admission> QueryScheduler::admit(
+   const rhydb::query_engine::QueryCostEstimate& estimate
+) {
+   const QueryLane lane = classify(estimate);
+   std::unique_lock lock{mutex};
+   Lane& state = laneOf(lane);
+   if (!hasRoomFor(lane, estimate.materialized_bytes)) {
+      if (state.queued >= options.max_queued_queries) {
+         ++state.rejected;
+         throw QueryRejected(fmt::format(
+            "Too many {} queries are waiting to be executed, please try again later",
+            queryLaneToString(lane)
+         ));
+      }
+      ++state.queued;
+      const bool admitted = slot_released.wait_for(lock, options.max_queue_time, [&] {
+         return hasRoomFor(lane, estimate.materialized_bytes);
+      });
+      --state.queued;
+      if (!admitted) {
+         ++state.rejected;
+         throw QueryRejected(fmt::format(
+            "The {} query waited longer than {} ms to be executed, please try again later",
+            queryLaneToString(lane),
+            options.max_queue_time.count()
+         ));
+      }
+   }
+   ++state.running;
+   ++state.admitted;
+   // Admission's constructor is private, so it cannot be created with std::make_unique
+   return std::unique_ptr<Admission>(new Admission(*this, lane));
+}
+
+QuerySchedulerStatistics QueryScheduler::getStatistics() const {
+   const std::lock_guard lock{mutex};
+   const auto lane_statistics = [](const Lane& lane) {
+      return QueryLaneStatistics{
+         .running = lane.running,
+         .queued = lane.queued,
+         .max_running = lane.max_running,
+         .admitted = lane.admitted,
+         .rejected = lane.rejected,
+      };
+   };
+   return {
+      .cheap = lane_statistics(cheap),
+      .heavy = lane_statistics(heavy),
+      .memory_in_bytes = memory_pool.bytes_allocated(),
+      .peak_memory_in_bytes = memory_pool.max_memory(),
+      .memory_budget_in_bytes = options.memory_budget_in_bytes,
+   };
+}
+
+}  // namespace rhydb_app
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <nlohmann/json.hpp>
+
+#include <rhydb/config/runtime_config.h>
+#include <rhydb/query_engine/counting_memory_pool.h>
+#include <rhydb/query_engine/query_cost.h>
+
+namespace rhydb_app {
+
+/// Queries are admitted to one of two lanes by their estimated cost, so that cheap queries, e.g.
+/// counts, do not wait behind queries that reconstruct many sequences
+enum class QueryLane : uint8_t {
+   CHEAP,
+   HEAVY,
+};
+
+[[nodiscard]] std::string_view queryLaneToString(QueryLane lane);
+
+struct QueryLaneStatistics {
+   size_t running;
+   size_t queued;
+   /// 0 for no limit
+   size_t max_running;
+   uint64_t admitted;
+   uint64_t rejected;
+};
+
+struct QuerySchedulerStatistics {
+   QueryLaneStatistics cheap;
+   QueryLaneStatistics heavy;
+   /// The arrow memory of all running queries
+   int64_t memory_in_bytes;
+   int64_t peak_memory_in_bytes;
+   /// 0 for no budget
+   uint64_t memory_budget_in_bytes;
+};
+
+void to_json(nlohmann::json& json, const QuerySchedulerStatistics& statistics);
+
+struct QuerySchedulerOptions {
+   /// 0 for no limit besides the http worker threads
+   size_t max_running_cheap_queries = 0;
+   size_t max_running_heavy_queries = 2;
+   /// Per lane
+   size_t max_queued_queries = 16;
+   uint64_t heavy_query_threshold_in_bytes = uint64_t{256} * 1024 * 1024;
+   /// 0 for no budget
+   uint64_t memory_budget_in_bytes = 0;
+   std::chrono::milliseconds max_queue_time = std::chrono::seconds{60};
+
+   [[nodiscard]] static QuerySchedulerOptions fromApiOptions(
+      const rhydb::config::ApiOptions& api_options
+   );
+};
+
+/// The query could not be admitted in time, the client should try again later
+class QueryRejected : public std::runtime_error {
+  public:
+   explicit QueryRejected(const std::string& error_message)
+       : std::runtime_error(error_message) {}
+};
+
+/// Admits queries to their lane when it has a free slot, and queues them otherwise. A query is
+/// rejected when its lane already queues `max_queued_queries` or it waited for `max_queue_time`.
+///
+/// The arrow memory of all queries is allocated from a `CountingMemoryPool` that is limited to
+/// the memory budget. A heavy query is only admitted while its estimated memory fits into what is
+/// left of the budget, unless it is the only heavy query, so that queries whose upper bound exceeds
+/// the budget still run one at a time. Thread-safe.
+class QueryScheduler {
+   struct Lane {
+      size_t max_running;
+      size_t running = 0;
+      size_t queued = 0;
+      uint64_t admitted = 0;
+      uint64_t rejected = 0;
+   };
+
+   QuerySchedulerOptions options;
+   rhydb::query_engine::CountingMemoryPool memory_pool;
+
+   mutable std::mutex mutex;
+   std::condition_variable slot_released;
+   Lane cheap;
+   Lane heavy;
+
+   Lane& laneOf(QueryLane lane);
+
+   // Requires `mutex` to be held
+   [[nodiscard]] bool hasRoomFor(QueryLane lane, uint64_t estimated_bytes);
+
+   void release(QueryLane lane);
+
+  public:
+   /// A slot of a lane, released when it is destroyed, and the memory pool of the query. Has to
+   /// outlive the execution of the query.
+   class Admission {
+      friend class QueryScheduler;
+
+      QueryScheduler& scheduler;
+      QueryLane lane;
+      rhydb::query_engine::CountingMemoryPool memory_pool;
+
+      Admission(QueryScheduler& scheduler, QueryLane lane);
+
+     public:
+      Admission(const Admission& other) = delete;
+      Admission& operator=(const Admission& other) = delete;
+      ~Admission();
+
+      [[nodiscard]] QueryLane getLane() const { return lane; }
+
+      /// Accounts for the memory of this query, and of all queries in the scheduler's pool
+      [[nodiscard]] rhydb::query_engine::CountingMemoryPool& memoryPool() { return memory_pool; }
+   };
+
+   explicit QueryScheduler(QuerySchedulerOptions options);
+
+   QueryScheduler(const QueryScheduler& other) = delete;
+   QueryScheduler& operator=(const QueryScheduler& other) = delete;
+
+   [[nodiscard]] QueryLane classify(const rhydb::query_engine::QueryCostEstimate& estimate) const;
+
+   /// Blocks until the query can run in the lane that `classify` assigns it to. Throws
+   /// `QueryRejected` if it cannot be admitted.
+   [[nodiscard]] std::unique_ptr<Admission> admit(
+      const rhydb::query_engine::QueryCostEstimate& estimate
+   );
+
+   [[nodiscard]] QuerySchedulerStatistics getStatistics() const;
+};
+
+}  // namespace rhydb_app
@@ -0,0 +1,117 @@
+#include "query_scheduler.h"
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <thread>
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+using rhydb::query_engine::QueryCostEstimate;
+using rhydb_app::QueryLane;
+using rhydb_app::QueryRejected;
+using rhydb_app::QueryScheduler;
+using rhydb_app::QuerySchedulerOptions;
+
+namespace {
+
+const QueryCostEstimate COUNT_QUERY{.rows = 1000, .materialized_bytes = 0};
+const QueryCostEstimate SEQUENCE_QUERY{
+   .rows = 1000, .materialized_bytes = 30'000'000, .reconstructs_sequences = true
+};
+
+QuerySchedulerOptions oneHeavyQueryAtATime() {
+   return {
+      .max_running_cheap_queries = 0,
+      .max_running_heavy_queries = 1,
+      .max_queued_queries = 1,
+      .heavy_query_threshold_in_bytes = 1024,
+      .memory_budget_in_bytes = 0,
+      .max_queue_time = std::chrono::seconds{10},
+   };
+}
+
+}  // namespace
+
+TEST(QueryScheduler, classifiesQueriesThatReconstructSequencesOrMaterializeMuchAsHeavy) {
+   const QueryScheduler under_test{oneHeavyQueryAtATime()};
+   EXPECT_EQ(under_test.classify(COUNT_QUERY), QueryLane::CHEAP);
+   EXPECT_EQ(under_test.classify(SEQUENCE_QUERY), QueryLane::HEAVY);
+   EXPECT_EQ(under_test.classify({.rows = 100, .materialized_bytes = 2048}), QueryLane::HEAVY);
+   EXPECT_EQ(under_test.classify({.rows = 100, .materialized_bytes = 512}), QueryLane::CHEAP);
+}
+
+TEST(QueryScheduler, cheapQueriesDoNotWaitBehindHeavyQueries) {
+   QueryScheduler under_test{oneHeavyQueryAtATime()};
+   const auto heavy = under_test.admit(SEQUENCE_QUERY);
+   const auto cheap = under_test.admit(COUNT_QUERY);
+   EXPECT_EQ(cheap->getLane(), QueryLane::CHEAP);
+
+   const auto statistics = under_test.getStatistics();
+   EXPECT_EQ(statistics.heavy.running, 1);
+   EXPECT_EQ(statistics.cheap.running, 1);
+}
+
+TEST(QueryScheduler, queuesHeavyQueriesUntilASlotIsReleased) {
+   QueryScheduler under_test{oneHeavyQueryAtATime()};
+   auto running = under_test.admit(SEQUENCE_QUERY);
+
+   auto queued = std::async(std::launch::async, [&] { return under_test.admit(SEQUENCE_QUERY); });
+   while (under_test.getStatistics().heavy.queued == 0) {
+      std::this_thread::yield();
+   }
+   EXPECT_EQ(queued.wait_for(std::chrono::milliseconds{10}), std::future_status::timeout);
+
+   running.reset();
+   const auto admitted = queued.get();
+   const auto statistics = under_test.getStatistics();
+   EXPECT_EQ(statistics.heavy.running, 1);
+   EXPECT_EQ(statistics.heavy.queued, 0);
+   EXPECT_EQ(statistics.heavy.admitted, 2);
+}
+
+TEST(QueryScheduler, rejectsQueriesWhenTheQueueOfTheirLaneIsFull) {
+   auto options = oneHeavyQueryAtATime();
+   options.max_queued_queries = 0;
+   QueryScheduler under_test{options};
+   const auto running = under_test.admit(SEQUENCE_QUERY);
+
+   EXPECT_THROW(std::ignore = under_test.admit(SEQUENCE_QUERY), QueryRejected);
+   EXPECT_EQ(under_test.getStatistics().heavy.rejected, 1);
+}
+
+TEST(QueryScheduler, rejectsQueriesThatWaitedTooLong) {
+   auto options = oneHeavyQueryAtATime();
+   options.max_queue_time = std::chrono::milliseconds{10};
+   QueryScheduler under_test{options};
+   const auto running = under_test.admit(SEQUENCE_QUERY);
+
+   EXPECT_THROW(std::ignore = under_test.admit(SEQUENCE_QUERY), QueryRejected);
+   const auto statistics = under_test.getStatistics();
+   EXPECT_EQ(statistics.heavy.queued, 0);
+   EXPECT_EQ(statistics.heavy.rejected, 1);
+}
+
+TEST(QueryScheduler, admitsHeavyQueriesOnlyWhileTheirEstimateFitsIntoTheMemoryBudget) {
+   auto options = oneHeavyQueryAtATime();
+   options.max_running_heavy_queries = 0;
+   options.memory_budget_in_bytes = 10'000;
+   options.max_queue_time = std::chrono::milliseconds{10};
+   QueryScheduler under_test{options};
+
+   // The only heavy query runs even though its estimate exceeds the budget
+   auto first = under_test.admit(SEQUENCE_QUERY);
+   uint8_t* buffer = nullptr;
+   ASSERT_TRUE(first->memoryPool().Allocate(8'000, &buffer).ok());
+   EXPECT_EQ(under_test.getStatistics().memory_in_bytes, 8'000);
+
+   const QueryCostEstimate small_heavy_query{
+      .rows = 1, .materialized_bytes = 4'000, .reconstructs_sequences = true
+   };
+   EXPECT_THROW(std::ignore = under_test.admit(small_heavy_query), QueryRejected);
+
+   first->memoryPool().Free(buffer, 8'000);
+   const auto second = under_test.admit(small_heavy_query);
+   EXPECT_EQ(under_test.getStatistics().heavy.running, 2);
+}
@@ -20,10 +20,15 @@ namespace rhydb_app {
 
 RhyDBRequestHandlerFactory::RhyDBRequestHandlerFactory(
    rhydb::config::RuntimeConfig runtime_config,
-   std::shared_ptr<ActiveDatabase> database_handle
+   std::shared_ptr<ActiveDatabase> database_handle,
+   std::shared_ptr<ResponseWriter> response_writer
 )
     : runtime_config(std::move(runtime_config)),
-      database_handle(std::move(database_handle)) {}
+      database_handle(std::move(database_handle)),
+      query_scheduler(std::make_shared<QueryScheduler>(
+         QuerySchedulerOptions::fromApiOptions(this->runtime_config.api_options)
+      )),
+      response_writer(std::move(response_writer)) {}
 
 Poco::Net::HTTPRequestHandler* RhyDBRequestHandlerFactory::createRequestHandler(
    const Poco::Net::HTTPServerRequest& request
@@ -43,17 +48,17 @@ std::unique_ptr<Poco::Net::HTTPRequestHandler> RhyDBRequestHandlerFactory::route
    uri.getPathSegments(segments);
 
    if (path == "/health") {
-      return std::make_unique<rhydb_app::HealthHandler>();
+      return std::make_unique<rhydb_app::HealthHandler>(query_scheduler);
    }
    if (path == "/info") {
-      return std::make_unique<rhydb_app::InfoHandler>(database_handle);
+      return std::make_unique<rhydb_app::InfoHandler>(database_handle, query_scheduler);
    }
    if (segments.size() == 2 && segments.at(0) == "lineageDefinition") {
       return std::make_unique<rhydb_app::LineageDefinitionHandler>(database_handle, segments.at(1));
    }
    if (path == "/query") {
       return std::make_unique<rhydb_app::QueryHandler>(
-         database_handle, runtime_config.query_options
+         database_handle, query_scheduler, response_writer, runtime_config.query_options
       );
    }
    return std::make_unique<rhydb_app::NotFoundHandler>();
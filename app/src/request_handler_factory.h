@@ -9,6 +9,8 @@
 
 #include "active_database.h"
 #include "error_request_handler.h"
+#include "query_scheduler.h"
+#include "response_writer.h"
 
 namespace rhydb_app {
 
@@ -16,11 +18,15 @@ class RhyDBRequestHandlerFactory : public Poco::Net::HTTPRequestHandlerFactory {
   private:
    const rhydb::config::RuntimeConfig runtime_config;
    std::shared_ptr<ActiveDatabase> database_handle;
+   std::shared_ptr<QueryScheduler> query_scheduler;
+   std::shared_ptr<ResponseWriter> response_writer;
 
   public:
+   /// Without a `response_writer`, results are sent on the http worker threads
    RhyDBRequestHandlerFactory(
       rhydb::config::RuntimeConfig runtime_config,
-      std::shared_ptr<ActiveDatabase> database_handle
+      std::shared_ptr<ActiveDatabase> database_handle,
+      std::shared_ptr<ResponseWriter> response_writer = nullptr
    );
 
    Poco::Net::HTTPRequestHandler* createRequestHandler(const Poco::Net::HTTPServerRequest& request
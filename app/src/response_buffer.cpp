@@ -0,0 +1,136 @@
+#include "response_buffer.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace rhydb_app {
+
+ResponseBuffer::ResponseBuffer(size_t capacity_in_bytes)
+    : capacity_in_bytes(capacity_in_bytes) {}
+
+void ResponseBuffer::notifyReadable() {
+   std::function<void()> callback;
+   {
+      const std::lock_guard lock{mutex};
+      callback = on_readable;
+   }
+   if (callback) {
+      callback();
+   }
+}
+
+bool ResponseBuffer::write(std::string chunk) {
+   if (chunk.empty()) {
+      return !isCancelled();
+   }
+   {
+      std::unique_lock lock{mutex};
+      space_available.wait(lock, [&] {
+         return cancelled || size_in_bytes == 0 ||
+                size_in_bytes + chunk.size() <= capacity_in_bytes;
+      });
+      if (cancelled) {
+         return false;
+      }
+      size_in_bytes += chunk.size();
+      peak_size_in_bytes = std::max(peak_size_in_bytes, size_in_bytes);
+      chunks.push_back(std::move(chunk));
+   }
+   notifyReadable();
+   return true;
+}
+
+void ResponseBuffer::close() {
+   {
+      const std::lock_guard lock{mutex};
+      closed = true;
+   }
+   notifyReadable();
+}
+
+void ResponseBuffer::cancel() {
+   {
+      const std::lock_guard lock{mutex};
+      cancelled = true;
+      chunks.clear();
+      size_in_bytes = 0;
+   }
+   space_available.notify_all();
+   notifyReadable();
+}
+
+bool ResponseBuffer::isCancelled() const {
+   const std::lock_guard lock{mutex};
+   return cancelled;
+}
+
+ResponseBuffer::Drained ResponseBuffer::drain() {
+   Drained drained;
+   {
+      const std::lock_guard lock{mutex};
+      drained.chunks.swap(chunks);
+      drained.finished = closed;
+      size_in_bytes = 0;
+   }
+   space_available.notify_all();
+   return drained;
+}
+
+void ResponseBuffer::setReadableCallback(std::function<void()> callback) {
+   {
+      const std::lock_guard lock{mutex};
+      on_readable = std::move(callback);
+   }
+   notifyReadable();
+}
+
+size_t ResponseBuffer::peakSizeInBytes() const {
+   const std::lock_guard lock{mutex};
+   return peak_size_in_bytes;
+}
+
+ResponseBufferStreamBuffer::ResponseBufferStreamBuffer(ResponseBuffer& buffer)
+    : buffer(buffer) {
+   pending.reserve(CHUNK_SIZE);
+}
+
+bool ResponseBufferStreamBuffer::flushPending() {
+   if (pending.empty()) {
+      return true;
+   }
+   std::string chunk;
+   chunk.reserve(CHUNK_SIZE);
+   chunk.swap(pending);
+   return buffer.write(std::move(chunk));
+}
+
+std::streamsize ResponseBufferStreamBuffer::xsputn(const char* data, std::streamsize count) {
+   pending.append(data, static_cast<size_t>(count));
+   if (pending.size() >= CHUNK_SIZE && !flushPending()) {
+      return 0;
+   }
+   return count;
+}
+
+ResponseBufferStreamBuffer::int_type ResponseBufferStreamBuffer::overflow(int_type character) {
+   if (traits_type::eq_int_type(character, traits_type::eof())) {
+      return traits_type::not_eof(character);
+   }
+   pending.push_back(traits_type::to_char_type(character));
+   if (pending.size() >= CHUNK_SIZE && !flushPending()) {
+      return traits_type::eof();
+   }
+   return character;
+}
+
+int ResponseBufferStreamBuffer::sync() {
+   return flushPending() ? 0 : -1;
+}
+
+bool ResponseBufferStreamBuffer::close() {
+   const bool flushed = flushPending();
+   buffer.close();
+   return flushed;
+}
+
+}  // namespace rhydb_app
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+namespace rhydb_app {
+
+/// The bytes of a response on their way from the thread that executes the query to the thread that
+/// sends them to the client. `write` blocks while `capacity_in_bytes` are buffered, which stops the
+/// query from pulling further batches out of its plan, so that the plan's backpressure pauses it
+/// while the client reads slowly. Thread-safe, for one writing and one reading thread.
+class ResponseBuffer {
+   size_t capacity_in_bytes;
+
+   mutable std::mutex mutex;
+   std::condition_variable space_available;
+   std::deque<std::string> chunks;
+   size_t size_in_bytes = 0;
+   size_t peak_size_in_bytes = 0;
+   bool closed = false;
+   bool cancelled = false;
+   /// Called without holding `mutex` whenever there is something new to read
+   std::function<void()> on_readable;
+
+   void notifyReadable();
+
+  public:
+   /// What `drain` took out of the buffer
+   struct Drained {
+      std::deque<std::string> chunks;
+      /// Whether these are the last chunks of the response
+      bool finished;
+   };
+
+   explicit ResponseBuffer(size_t capacity_in_bytes);
+
+   ResponseBuffer(const ResponseBuffer& other) = delete;
+   ResponseBuffer& operator=(const ResponseBuffer& other) = delete;
+
+   /// Blocks until the chunk fits, a single chunk larger than the capacity is accepted into an
+   /// empty buffer. Returns false if the reader cancelled the response.
+   bool write(std::string chunk);
+
+   /// There is nothing more to write
+   void close();
+
+   /// Either side gives up on the response, e.g. the reader because the client went away or the
+   /// writer because the query failed. Pending and future writes fail, buffered chunks are dropped.
+   void cancel();
+
+   [[nodiscard]] bool isCancelled() const;
+
+   /// Takes everything that is buffered without waiting
+   [[nodiscard]] Drained drain();
+
+   /// Replaces the callback that is run whenever there are chunks to drain or the response was
+   /// closed. It may be run on any thread and must not block.
+   void setReadableCallback(std::function<void()> callback);
+
+   [[nodiscard]] size_t capacityInBytes() const { return capacity_in_bytes; }
+
+   [[nodiscard]] size_t peakSizeInBytes() const;
+};
+
+/// Lets a `std::ostream` write into a `ResponseBuffer`. Small writes are collected into chunks of
+/// `CHUNK_SIZE` bytes. A write fails and sets the `badbit` of the stream if the response was
+/// cancelled.
+class ResponseBufferStreamBuffer : public std::streambuf {
+   ResponseBuffer& buffer;
+   std::string pending;
+
+   bool flushPending();
+
+  protected:
+   std::streamsize xsputn(const char* data, std::streamsize count) override;
+
+   int_type overflow(int_type character) override;
+
+   int sync() override;
+
+  public:
+   static constexpr size_t CHUNK_SIZE = size_t{64} * 1024;
+
+   explicit ResponseBufferStreamBuffer(ResponseBuffer& buffer);
+
+   /// Flushes what is pending and closes the buffer. Returns false if the response was cancelled.
+   bool close();
+};
+
+}  // namespace rhydb_app
@@ -0,0 +1,270 @@
+#include "response_writer.h"
+
+#include <array>
+#include <cerrno>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <Poco/Exception.h>
+#include <Poco/Net/HTTPMessage.h>
+#include <Poco/Net/HTTPServerRequestImpl.h>
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+namespace rhydb_app {
+
+namespace {
+
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+// Poco sets SO_NOSIGPIPE on the sockets of platforms without MSG_NOSIGNAL
+constexpr int SEND_FLAGS = 0;
+#endif
+
+/// Also bounds how late a stalled client is noticed
+constexpr int POLL_TIMEOUT_IN_MILLISECONDS = 1000;
+
+void appendChunk(std::string& pending, const std::string& chunk) {
+   pending += fmt::format("{:x}\r\n", chunk.size());
+   pending += chunk;
+   pending += "\r\n";
+}
+
+void closeConnection(Poco::Net::StreamSocket& socket) {
+   try {
+      socket.shutdownSend();
+   } catch (const Poco::Exception&) {  // NOLINT(bugprone-empty-catch)
+      // The client may have closed the connection already
+   }
+   try {
+      socket.close();
+   } catch (const Poco::Exception& exception) {
+      SPDLOG_DEBUG("Failed to close a response connection: {}", exception.displayText());
+   }
+}
+
+}  // namespace
+
+/// Interrupts the `poll` of the writer thread when there is something new to send. Shared with the
+/// callbacks of the response buffers, which may outlive the writer.
+struct ResponseWriter::Wakeup {
+   int read_fd = -1;
+   int write_fd = -1;
+
+   Wakeup() {
+      std::array<int, 2> fds{};
+      if (::pipe(fds.data()) != 0) {
+         throw std::runtime_error(fmt::format("Could not create a pipe: errno {}", errno));
+      }
+      read_fd = fds[0];
+      write_fd = fds[1];
+      for (const int file_descriptor : fds) {
+         ::fcntl(file_descriptor, F_SETFL, ::fcntl(file_descriptor, F_GETFL) | O_NONBLOCK);
+      }
+   }
+
+   Wakeup(const Wakeup& other) = delete;
+   Wakeup& operator=(const Wakeup& other) = delete;
+
+   ~Wakeup() {
+      ::close(read_fd);
+      ::close(write_fd);
+   }
+
+   void signal() const {
+      const char byte = 0;
+      // A full pipe already wakes the writer up
+      [[maybe_unused]] const auto written = ::write(write_fd, &byte, 1);
+   }
+
+   void clear() const {
+      std::array<char, 256> bytes{};
+      while (::read(read_fd, bytes.data(), bytes.size()) > 0) {
+      }
+   }
+};
+
+ResponseWriter::ResponseWriter(size_t buffer_size_in_bytes, std::chrono::milliseconds stall_timeout)
+    : buffer_size_in_bytes(buffer_size_in_bytes),
+      stall_timeout(stall_timeout),
+      wakeup(std::make_shared<Wakeup>()),
+      thread([this] { run(); }) {}
+
+ResponseWriter::~ResponseWriter() {
+   {
+      const std::lock_guard lock{mutex};
+      stopping = true;
+   }
+   wakeup->signal();
+   thread.join();
+}
+
+std::shared_ptr<ResponseBuffer> ResponseWriter::send(
+   Poco::Net::StreamSocket socket,
+   std::string head
+) {
+   auto buffer = std::make_shared<ResponseBuffer>(buffer_size_in_bytes);
+   socket.setBlocking(false);
+   {
+      const std::lock_guard lock{mutex};
+      if (stopping) {
+         closeConnection(socket);
+         buffer->cancel();
+         return buffer;
+      }
+      incoming.push_back(Response{
+         .socket = std::move(socket),
+         .buffer = buffer,
+         .pending = std::move(head),
+         .last_progress = std::chrono::steady_clock::now()
+      });
+      ++open_responses;
+   }
+   buffer->setReadableCallback([wakeup = wakeup] { wakeup->signal(); });
+   return buffer;
+}
+
+std::shared_ptr<ResponseBuffer> ResponseWriter::takeOver(
+   Poco::Net::HTTPServerRequest& request,
+   Poco::Net::HTTPServerResponse& response
+) {
+   auto* request_impl = dynamic_cast<Poco::Net::HTTPServerRequestImpl*>(&request);
+   if (request_impl == nullptr || request.getVersion() == Poco::Net::HTTPMessage::HTTP_1_0) {
+      return nullptr;
+   }
+   response.setChunkedTransferEncoding(true);
+   // The connection is closed after the response, the http server does not get it back
+   response.setKeepAlive(false);
+   std::ostringstream head;
+   response.write(head);
+   return send(request_impl->detachSocket(), std::move(head).str());
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+void ResponseWriter::run() {
+   std::vector<Response> responses;
+   std::vector<pollfd> poll_fds;
+   /// The index in `responses` of every polled socket after the wakeup pipe
+   std::vector<size_t> polled_responses;
+   while (true) {
+      {
+         const std::lock_guard lock{mutex};
+         if (stopping) {
+            break;
+         }
+         for (auto& response : incoming) {
+            responses.push_back(std::move(response));
+         }
+         incoming.clear();
+      }
+      wakeup->clear();
+
+      const auto now = std::chrono::steady_clock::now();
+      std::erase_if(responses, [&](Response& response) {
+         if (response.offset == response.pending.size() && !response.finished) {
+            auto drained = response.buffer->drain();
+            if (response.buffer->isCancelled()) {
+               closeConnection(response.socket);
+               --open_responses;
+               return true;
+            }
+            response.pending.clear();
+            response.offset = 0;
+            for (const auto& chunk : drained.chunks) {
+               appendChunk(response.pending, chunk);
+            }
+            if (drained.finished) {
+               response.pending += "0\r\n\r\n";
+               response.finished = true;
+            }
+            // The client is only waited for while there is something to send
+            response.last_progress = now;
+         }
+         if (response.offset == response.pending.size()) {
+            if (!response.finished) {
+               return false;
+            }
+            closeConnection(response.socket);
+            --open_responses;
+            return true;
+         }
+         if (now - response.last_progress > stall_timeout) {
+            SPDLOG_WARN(
+               "A client did not accept any bytes of its response for {} ms, closing the socket",
+               stall_timeout.count()
+            );
+            response.buffer->cancel();
+            closeConnection(response.socket);
+            --open_responses;
+            return true;
+         }
+         return false;
+      });
+
+      // Responses that wait for their query are woken up through the pipe
+      poll_fds.clear();
+      polled_responses.clear();
+      poll_fds.push_back({.fd = wakeup->read_fd, .events = POLLIN, .revents = 0});
+      for (size_t index = 0; index < responses.size(); ++index) {
+         if (responses[index].offset < responses[index].pending.size()) {
+            poll_fds.push_back(
+               {.fd = responses[index].socket.impl()->sockfd(), .events = POLLOUT, .revents = 0}
+            );
+            polled_responses.push_back(index);
+         }
+      }
+      const int ready = ::poll(poll_fds.data(), poll_fds.size(), POLL_TIMEOUT_IN_MILLISECONDS);
+      if (ready <= 0) {
+         continue;
+      }
+
+      for (size_t polled = 0; polled < polled_responses.size(); ++polled) {
+         Response& response = responses[polled_responses[polled]];
+         const short revents = poll_fds[polled + 1].revents;
+         if ((revents & (POLLOUT | POLLERR | POLLHUP)) == 0) {
+            continue;
+         }
+         const auto sent = ::send(
+            response.socket.impl()->sockfd(),
+            response.pending.data() + response.offset,
+            response.pending.size() - response.offset,
+            SEND_FLAGS
+         );
+         if (sent > 0) {
+            response.offset += static_cast<size_t>(sent);
+            response.last_progress = std::chrono::steady_clock::now();
+         } else if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            SPDLOG_WARN(
+               "Failed to send a response, the client likely went away: errno {}", errno
+            );
+            response.buffer->cancel();
+            // Closed in the next round
+            response.pending.clear();
+            response.offset = 0;
+            response.finished = true;
+         }
+      }
+   }
+
+   for (auto& response : responses) {
+      response.buffer->cancel();
+      closeConnection(response.socket);
+      --open_responses;
+   }
+   const std::lock_guard lock{mutex};
+   for (auto& response : incoming) {
+      response.buffer->cancel();
+      closeConnection(response.socket);
+      --open_responses;
+   }
+   incoming.clear();
+}
+
+}  // namespace rhydb_app
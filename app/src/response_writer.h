@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+#include <Poco/Net/StreamSocket.h>
+
+#include "response_buffer.h"
+
+namespace rhydb_app {
+
+/// Sends query results to the clients on a single thread, so that slow clients do not pin the http
+/// worker threads. A worker hands over the connection after the head of the response, then only
+/// executes the query into the response's `ResponseBuffer` and is released as soon as the query
+/// produced its last bytes. This thread polls the non-blocking sockets and sends the buffered
+/// chunks with chunked transfer encoding, then closes the connection.
+///
+/// A response is cancelled, and its connection closed, if the client does not accept any bytes for
+/// `stall_timeout`, if sending fails, or if the query cancels it.
+class ResponseWriter {
+   struct Wakeup;
+
+   struct Response {
+      Poco::Net::StreamSocket socket;
+      std::shared_ptr<ResponseBuffer> buffer;
+      /// Framed bytes that are not sent yet, starting at `offset`
+      std::string pending;
+      size_t offset = 0;
+      /// Whether `pending` ends with the last chunk of the response
+      bool finished = false;
+      std::chrono::steady_clock::time_point last_progress;
+   };
+
+   size_t buffer_size_in_bytes;
+   std::chrono::milliseconds stall_timeout;
+   std::shared_ptr<Wakeup> wakeup;
+
+   std::mutex mutex;
+   std::vector<Response> incoming;
+   bool stopping = false;
+   std::atomic<size_t> open_responses = 0;
+
+   std::thread thread;
+
+   void run();
+
+  public:
+   ResponseWriter(size_t buffer_size_in_bytes, std::chrono::milliseconds stall_timeout);
+
+   ResponseWriter(const ResponseWriter& other) = delete;
+   ResponseWriter& operator=(const ResponseWriter& other) = delete;
+
+   /// Cancels the responses that are still being sent
+   ~ResponseWriter();
+
+   /// Sends `head`, then the chunks written to the returned buffer, on `socket`
+   [[nodiscard]] std::shared_ptr<ResponseBuffer> send(
+      Poco::Net::StreamSocket socket,
+      std::string head
+   );
+
+   /// Takes the connection of `request` from the http server and sends the head of `response` on
+   /// it. Returns nullptr if the connection cannot be taken, e.g. for HTTP/1.0 clients, which do
+   /// not accept chunked responses. Then the response has to be sent as usual.
+   [[nodiscard]] std::shared_ptr<ResponseBuffer> takeOver(
+      Poco::Net::HTTPServerRequest& request,
+      Poco::Net::HTTPServerResponse& response
+   );
+
+   /// The responses that were handed over and are not completely sent yet
+   [[nodiscard]] size_t openResponses() const { return open_responses.load(); }
+};
+
+}  // namespace rhydb_app
@@ -0,0 +1,197 @@
+#include "response_writer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <ostream>
+#include <string>
+#include <thread>
+
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/Net/SocketAddress.h>
+#include <Poco/Net/StreamSocket.h>
+#include <gtest/gtest.h>
+
+#include "response_buffer.h"
+
+using rhydb_app::ResponseBuffer;
+using rhydb_app::ResponseBufferStreamBuffer;
+using rhydb_app::ResponseWriter;
+
+namespace {
+
+const std::string HEAD = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n";
+constexpr size_t SMALL_SOCKET_BUFFER = 4096;
+
+/// Both ends of a connection on the loopback interface, with small socket buffers so that a slow
+/// reader backs up into the response buffer quickly
+struct Connection {
+   Poco::Net::StreamSocket server_side;
+   Poco::Net::StreamSocket client;
+};
+
+Connection connect() {
+   Poco::Net::ServerSocket listener{Poco::Net::SocketAddress{"127.0.0.1", 0}};
+   Poco::Net::StreamSocket client;
+   client.setReceiveBufferSize(SMALL_SOCKET_BUFFER);
+   client.connect(Poco::Net::SocketAddress{"127.0.0.1", listener.address().port()});
+   auto server_side = listener.acceptConnection();
+   server_side.setSendBufferSize(SMALL_SOCKET_BUFFER);
+   return {.server_side = std::move(server_side), .client = std::move(client)};
+}
+
+/// A client that reads `bytes_per_read` and then waits for `delay`, until the server closes the
+/// connection
+std::string readSlowly(
+   Poco::Net::StreamSocket& client,
+   size_t bytes_per_read,
+   std::chrono::milliseconds delay
+) {
+   std::string received;
+   std::string buffer(bytes_per_read, '\0');
+   while (true) {
+      const int count = client.receiveBytes(buffer.data(), static_cast<int>(buffer.size()));
+      if (count <= 0) {
+         return received;
+      }
+      received.append(buffer.data(), static_cast<size_t>(count));
+      std::this_thread::sleep_for(delay);
+   }
+}
+
+/// The body of a chunked response, or an error message if it is malformed or incomplete
+std::string decodeChunkedBody(const std::string& response) {
+   const size_t head_end = response.find("\r\n\r\n");
+   if (head_end == std::string::npos || response.substr(0, head_end + 4) != HEAD) {
+      return "<malformed head>";
+   }
+   std::string body;
+   size_t position = head_end + 4;
+   while (true) {
+      const size_t line_end = response.find("\r\n", position);
+      if (line_end == std::string::npos) {
+         return "<incomplete>";
+      }
+      const size_t size = std::stoul(response.substr(position, line_end - position), nullptr, 16);
+      if (size == 0) {
+         return response.substr(line_end + 2) == "\r\n" ? body : "<trailing bytes>";
+      }
+      body += response.substr(line_end + 2, size);
+      position = line_end + 2 + size + 2;
+   }
+}
+
+/// `size` bytes of numbered lines
+std::string resultOfSize(size_t size) {
+   std::string result;
+   for (size_t index = 0; result.size() < size; ++index) {
+      result += std::to_string(index) + '\n';
+   }
+   result.resize(size);
+   return result;
+}
+
+/// Writes `result` into `buffer` the way a query does, returns whether it was accepted completely
+bool produce(ResponseBuffer& buffer, const std::string& result, size_t piece_size) {
+   ResponseBufferStreamBuffer stream_buffer{buffer};
+   std::ostream output{&stream_buffer};
+   for (size_t offset = 0; offset < result.size() && output.good(); offset += piece_size) {
+      output.write(
+         result.data() + offset,
+         static_cast<std::streamsize>(std::min(piece_size, result.size() - offset))
+      );
+   }
+   output.flush();
+   return stream_buffer.close() && output.good();
+}
+
+}  // namespace
+
+TEST(ResponseBuffer, blocksTheWriterWhileItIsFullUntilItIsDrained) {
+   ResponseBuffer under_test{10};
+   ASSERT_TRUE(under_test.write("0123456789"));
+
+   auto blocked_write = std::async(std::launch::async, [&] { return under_test.write("abc"); });
+   EXPECT_EQ(blocked_write.wait_for(std::chrono::milliseconds{20}), std::future_status::timeout);
+
+   auto drained = under_test.drain();
+   EXPECT_TRUE(blocked_write.get());
+   EXPECT_EQ(drained.chunks.size(), 1);
+   EXPECT_FALSE(drained.finished);
+
+   under_test.close();
+   drained = under_test.drain();
+   EXPECT_EQ(drained.chunks.front(), "abc");
+   EXPECT_TRUE(drained.finished);
+}
+
+TEST(ResponseBuffer, failsBlockedWritesWhenItIsCancelled) {
+   ResponseBuffer under_test{10};
+   ASSERT_TRUE(under_test.write("0123456789"));
+
+   auto blocked_write = std::async(std::launch::async, [&] { return under_test.write("abc"); });
+   under_test.cancel();
+   EXPECT_FALSE(blocked_write.get());
+   EXPECT_FALSE(under_test.write("abc"));
+}
+
+TEST(ResponseWriter, sendsTheCompleteResultToASlowReaderWithinTheBufferSize) {
+   constexpr size_t BUFFER_SIZE = 2 * ResponseBufferStreamBuffer::CHUNK_SIZE;
+   ResponseWriter under_test{BUFFER_SIZE, std::chrono::seconds{10}};
+   auto connection = connect();
+   const auto result = resultOfSize(2 * 1024 * 1024);
+
+   const auto buffer = under_test.send(connection.server_side, HEAD);
+   auto producer = std::async(std::launch::async, [&] { return produce(*buffer, result, 1000); });
+   const auto received = readSlowly(connection.client, 16 * 1024, std::chrono::milliseconds{1});
+
+   EXPECT_TRUE(producer.get());
+   EXPECT_EQ(decodeChunkedBody(received), result);
+   EXPECT_LE(buffer->peakSizeInBytes(), BUFFER_SIZE);
+}
+
+TEST(ResponseWriter, releasesTheQueryAsSoonAsItsResultIsBuffered) {
+   ResponseWriter under_test{1024 * 1024, std::chrono::seconds{10}};
+   auto connection = connect();
+   const auto result = resultOfSize(256 * 1024);
+
+   const auto buffer = under_test.send(connection.server_side, HEAD);
+   // The client has not read anything yet
+   EXPECT_TRUE(produce(*buffer, result, 1000));
+   EXPECT_EQ(under_test.openResponses(), 1);
+
+   const auto received = readSlowly(connection.client, 16 * 1024, std::chrono::milliseconds{1});
+   EXPECT_EQ(decodeChunkedBody(received), result);
+}
+
+TEST(ResponseWriter, cancelsTheQueryWhenTheClientGoesAway) {
+   ResponseWriter under_test{ResponseBufferStreamBuffer::CHUNK_SIZE, std::chrono::seconds{10}};
+   auto connection = connect();
+   const auto result = resultOfSize(16 * 1024 * 1024);
+
+   const auto buffer = under_test.send(connection.server_side, HEAD);
+   auto producer = std::async(std::launch::async, [&] { return produce(*buffer, result, 1000); });
+   std::string first_bytes(1024, '\0');
+   connection.client.receiveBytes(first_bytes.data(), static_cast<int>(first_bytes.size()));
+   connection.client.close();
+
+   ASSERT_EQ(producer.wait_for(std::chrono::seconds{10}), std::future_status::ready);
+   EXPECT_FALSE(producer.get());
+   EXPECT_TRUE(buffer->isCancelled());
+}
+
+TEST(ResponseWriter, cancelsTheQueryWhenTheClientStopsReading) {
+   const std::chrono::milliseconds stall_timeout{100};
+   ResponseWriter under_test{ResponseBufferStreamBuffer::CHUNK_SIZE, stall_timeout};
+   auto connection = connect();
+   const auto result = resultOfSize(16 * 1024 * 1024);
+
+   const auto buffer = under_test.send(connection.server_side, HEAD);
+   auto producer = std::async(std::launch::async, [&] { return produce(*buffer, result, 1000); });
+
+   ASSERT_EQ(producer.wait_for(std::chrono::seconds{10}), std::future_status::ready);
+   EXPECT_FALSE(producer.get());
+   while (under_test.openResponses() > 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+   }
+}
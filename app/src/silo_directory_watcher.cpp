@@ -14,10 +14,12 @@
 
 rhydb_app::RhyDBDirectoryWatcher::RhyDBDirectoryWatcher(
    rhydb::RhyDBDirectory silo_directory,
-   std::shared_ptr<ActiveDatabase> database_handle
+   std::shared_ptr<ActiveDatabase> database_handle,
+   rhydb::persistence::LoadMode load_mode
 )
     : silo_directory(std::move(silo_directory)),
       database_handle(std::move(database_handle)),
+      load_mode(load_mode),
       timer(0, 2000) {
    timer.start(Poco::TimerCallback<RhyDBDirectoryWatcher>(
       *this, &RhyDBDirectoryWatcher::checkDirectoryForData
@@ -56,7 +58,7 @@ void rhydb_app::RhyDBDirectoryWatcher::checkDirectoryForData(Poco::Timer& /*time
    SPDLOG_INFO("New data version detected: {}", most_recent_database_state.path.string());
    try {
       database_handle->setActiveDatabase(
-         rhydb::Database::loadDatabaseState(most_recent_database_state)
+         rhydb::Database::loadDatabaseState(most_recent_database_state, load_mode)
       );
       SPDLOG_INFO(
          "New database with version {} successfully loaded.",
@@ -3,6 +3,7 @@
 #include <Poco/Timer.h>
 
 #include <rhydb/common/silo_directory.h>
+#include <rhydb/persistence/load_mode.h>
 
 #include "active_database.h"
 
@@ -11,12 +12,14 @@ namespace rhydb_app {
 class RhyDBDirectoryWatcher {
    rhydb::RhyDBDirectory silo_directory;
    std::shared_ptr<ActiveDatabase> database_handle;
+   rhydb::persistence::LoadMode load_mode;
    Poco::Timer timer;
 
   public:
    RhyDBDirectoryWatcher(
       rhydb::RhyDBDirectory silo_directory,
-      std::shared_ptr<ActiveDatabase> database_handle
+      std::shared_ptr<ActiveDatabase> database_handle,
+      rhydb::persistence::LoadMode load_mode
    );
 
    void checkDirectoryForData(Poco::Timer& timer);
@@ -0,0 +1,317 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <arrow/compute/initialize.h>
+#include <spdlog/spdlog.h>
+#include <fmt/format.h>
+
+#include "rhydb/common/panic.h"
+#include "rhydb/query_engine/filter/operators/compare_kernels.h"
+#include "rhydb/query_engine/filter/operators/selection.h"
+#include "rhydb/storage/column/column_metadata.h"
+#include "rhydb/storage/column/date32_column.h"
+#include "rhydb/storage/column/float_column.h"
+#include "rhydb/storage/column/int_column.h"
+#include "rhydb/storage/column/row_layout.h"
+
+// Measures the comparison of an Int32, Float and Date32 column to a constant with every comparator.
+//
+// CompareToValueSelection compares columns of fixed-width values a whole chunk at a time, with
+// kernels that write the result straight into the words of a roaring bitset container (see
+// compare_kernels.h). The kernel is chosen at runtime from the instruction sets the CPU supports.
+//
+// For every column type and comparator the benchmark reports the time per row of
+//  - the raw kernel of every instruction set the CPU supports, over all chunks,
+//  - CompareToValueSelection::makeBitmap, i.e. the kernel plus building the bitmap and removing
+//    the null rows,
+//  - the row-by-row evaluation that was used before, for comparison.
+// The columns hold uniformly distributed values, a percent of the rows are null, and the compared
+// value is the median, so that about half of the rows match.
+//
+// Finally it measures a between on a Date32 column whose values ascend from chunk to chunk, like
+// the sampling dates of data that is ingested roughly in date order. There the zone maps of the
+// chunks let CompareToRangeSelection skip the chunks outside of the range and take the chunks
+// inside of it as a whole, so that only the chunks at its borders are compared.
+//
+// Last it measures a between on a Date32 column that is appended in batches, each of which is
+// sorted by date but spans all dates, so that neither the column is sorted nor the zone maps can
+// skip a chunk. The chunks are binary searched there, which is compared to the chunks holding the
+// same values in random order, where every value is compared.
+
+using rhydb::query_engine::filter::operators::CHUNK_BITSET_WORDS;
+using rhydb::query_engine::filter::operators::Comparator;
+using rhydb::query_engine::filter::operators::CompareKernelIsa;
+using rhydb::query_engine::filter::operators::compareKernelIsaName;
+using rhydb::query_engine::filter::operators::CompareToRangeSelection;
+using rhydb::query_engine::filter::operators::compareToBitset;
+using rhydb::query_engine::filter::operators::CompareToValueSelection;
+using rhydb::query_engine::filter::operators::detectCompareKernelIsa;
+using rhydb::query_engine::filter::operators::displayComparator;
+using rhydb::query_engine::filter::operators::Predicate;
+using rhydb::query_engine::filter::operators::ValueRange;
+using rhydb::storage::column::COLUMN_CHUNK_SIZE;
+using rhydb::storage::column::ColumnMetadata;
+using rhydb::storage::column::RowLayout;
+
+namespace {
+
+constexpr size_t NUM_CHUNKS = 256;
+constexpr size_t REPETITIONS = 5;
+constexpr std::array<Comparator, 6> COMPARATORS = {
+   Comparator::EQUALS,
+   Comparator::NOT_EQUALS,
+   Comparator::LESS,
+   Comparator::HIGHER,
+   Comparator::LESS_OR_EQUALS,
+   Comparator::HIGHER_OR_EQUALS
+};
+
+/// The best of `REPETITIONS` runs, in nanoseconds per row
+template <typename Function>
+double nanosecondsPerRow(size_t row_count, const Function& function) {
+   double best = 0;
+   for (size_t repetition = 0; repetition < REPETITIONS; ++repetition) {
+      const auto start = std::chrono::high_resolution_clock::now();
+      function();
+      const auto end = std::chrono::high_resolution_clock::now();
+      const std::chrono::duration<double, std::nano> elapsed = end - start;
+      if (repetition == 0 || elapsed.count() < best) {
+         best = elapsed.count();
+      }
+   }
+   return best / static_cast<double>(row_count);
+}
+
+std::vector<CompareKernelIsa> supportedInstructionSets() {
+   std::vector<CompareKernelIsa> result{CompareKernelIsa::SCALAR};
+   if (detectCompareKernelIsa() >= CompareKernelIsa::AVX2) {
+      result.push_back(CompareKernelIsa::AVX2);
+   }
+   if (detectCompareKernelIsa() >= CompareKernelIsa::AVX512) {
+      result.push_back(CompareKernelIsa::AVX512);
+   }
+   return result;
+}
+
+template <typename ColumnType>
+void benchmarkColumn(const std::string& column_type, std::vector<std::string>& summary) {
+   using ValueType = ColumnType::value_type;
+
+   auto metadata = std::make_shared<ColumnMetadata>("benchmark");
+   ColumnType column{metadata.get()};
+   std::mt19937 rng(42);
+   std::uniform_int_distribution<int32_t> value_distribution(0, 20'000);
+   std::uniform_int_distribution<int32_t> null_distribution(0, 99);
+   for (size_t chunk = 0; chunk < NUM_CHUNKS; ++chunk) {
+      typename ColumnType::Builder builder;
+      for (size_t row = 0; row < COLUMN_CHUNK_SIZE; ++row) {
+         if (null_distribution(rng) == 0) {
+            builder.insertNull();
+         } else {
+            builder.insert(static_cast<ValueType>(value_distribution(rng)));
+         }
+      }
+      SILO_ASSERT(column.appendChunk(builder.finalize()).has_value());
+   }
+   RowLayout row_layout;
+   for (size_t chunk = 0; chunk < NUM_CHUNKS; ++chunk) {
+      row_layout.appendChunk(COLUMN_CHUNK_SIZE);
+   }
+   const size_t row_count = row_layout.numRows();
+   const auto compared_value = static_cast<ValueType>(10'000);
+
+   for (const Comparator comparator : COMPARATORS) {
+      const CompareToValueSelection<ColumnType> selection{column, comparator, compared_value};
+
+      std::string kernel_timings;
+      for (const CompareKernelIsa isa : supportedInstructionSets()) {
+         std::array<uint64_t, CHUNK_BITSET_WORDS> words{};
+         uint64_t checksum = 0;
+         const double kernel = nanosecondsPerRow(row_count, [&]() {
+            for (size_t chunk = 0; chunk < NUM_CHUNKS; ++chunk) {
+               compareToBitset(
+                  column.getValueBuffer().chunk(chunk), comparator, compared_value, words, isa
+               );
+               checksum += words.front();
+            }
+         });
+         SPDLOG_DEBUG("checksum {}", checksum);
+         kernel_timings += fmt::format("{} {:>6.3f}, ", compareKernelIsaName(isa), kernel);
+      }
+
+      uint64_t cardinality = 0;
+      const double make_bitmap = nanosecondsPerRow(row_count, [&]() {
+         cardinality = selection.makeBitmap(row_layout).cardinality();
+      });
+      // The default implementation of Predicate, which calls match for every row
+      const Predicate& predicate = selection;
+      const double row_by_row = nanosecondsPerRow(row_count, [&]() {
+         cardinality =
+            predicate.Predicate::makeBitmapForChunks(row_layout, 0, row_layout.numChunks())
+               .cardinality();
+      });
+
+      summary.push_back(fmt::format(
+         "{:<7} {:<2} kernels [ns/row]: {}makeBitmap {:>6.3f} ns/row, row by row {:>6.3f} ns/row "
+         "({:.1f}x), {} matches",
+         column_type,
+         displayComparator(comparator),
+         kernel_timings,
+         make_bitmap,
+         row_by_row,
+         row_by_row / make_bitmap,
+         cardinality
+      ));
+   }
+}
+
+void benchmarkOrderedDateColumn(std::vector<std::string>& summary) {
+   using rhydb::common::Date32;
+   using rhydb::storage::column::Date32Column;
+
+   auto metadata = std::make_shared<ColumnMetadata>("benchmark");
+   Date32Column column{metadata.get()};
+   std::mt19937 rng(42);
+   // Every chunk covers about ten days, neighbouring chunks overlap by a day
+   constexpr int32_t DAYS_PER_CHUNK = 10;
+   for (size_t chunk = 0; chunk < NUM_CHUNKS; ++chunk) {
+      const auto first_day = static_cast<int32_t>(chunk) * DAYS_PER_CHUNK;
+      std::uniform_int_distribution<int32_t> day_distribution(
+         first_day, first_day + DAYS_PER_CHUNK
+      );
+      Date32Column::Builder builder;
+      for (size_t row = 0; row < COLUMN_CHUNK_SIZE; ++row) {
+         builder.insert(day_distribution(rng));
+      }
+      SILO_ASSERT(column.appendChunk(builder.finalize()).has_value());
+   }
+   RowLayout row_layout;
+   for (size_t chunk = 0; chunk < NUM_CHUNKS; ++chunk) {
+      row_layout.appendChunk(COLUMN_CHUNK_SIZE);
+   }
+   const size_t row_count = row_layout.numRows();
+
+   // A tenth of the days
+   const Date32 lower = (NUM_CHUNKS * DAYS_PER_CHUNK) / 2;
+   const Date32 upper = lower + ((NUM_CHUNKS * DAYS_PER_CHUNK) / 10);
+   const CompareToRangeSelection<Date32Column> selection{
+      column, ValueRange<Date32>{.lower = lower, .upper = upper}
+   };
+   uint64_t cardinality = 0;
+   const double make_bitmap = nanosecondsPerRow(row_count, [&]() {
+      cardinality = selection.makeBitmap(row_layout).cardinality();
+   });
+   const Predicate& predicate = selection;
+   const double row_by_row = nanosecondsPerRow(row_count, [&]() {
+      cardinality = predicate.Predicate::makeBitmapForChunks(row_layout, 0, row_layout.numChunks())
+                       .cardinality();
+   });
+   summary.push_back(fmt::format(
+      "ordered date32 between: makeBitmap {:>6.3f} ns/row, row by row {:>6.3f} ns/row ({:.1f}x), "
+      "{} matches",
+      make_bitmap,
+      row_by_row,
+      row_by_row / make_bitmap,
+      cardinality
+   ));
+}
+
+/// The time per row of a between that matches a tenth of the dates on chunks that each hold
+/// random dates of all days, sorted within the chunk if `sorted_chunks`
+double dateBetweenOnAppendedBatches(bool sorted_chunks, uint64_t& cardinality) {
+   using rhydb::common::Date32;
+   using rhydb::storage::column::Date32Column;
+
+   auto metadata = std::make_shared<ColumnMetadata>("benchmark");
+   Date32Column column{metadata.get()};
+   std::mt19937 rng(42);
+   constexpr int32_t NUM_DAYS = 3650;
+   std::uniform_int_distribution<int32_t> day_distribution(0, NUM_DAYS - 1);
+   std::uniform_int_distribution<int32_t> null_distribution(0, 99);
+   for (size_t chunk = 0; chunk < NUM_CHUNKS; ++chunk) {
+      std::vector<Date32> days(COLUMN_CHUNK_SIZE);
+      for (auto& day : days) {
+         day = day_distribution(rng);
+      }
+      if (sorted_chunks) {
+         std::ranges::sort(days);
+      }
+      Date32Column::Builder builder;
+      for (const Date32 day : days) {
+         if (null_distribution(rng) == 0) {
+            builder.insertNull();
+         } else {
+            builder.insert(day);
+         }
+      }
+      SILO_ASSERT(column.appendChunk(builder.finalize()).has_value());
+   }
+   SILO_ASSERT(!column.isSorted());
+   RowLayout row_layout;
+   for (size_t chunk = 0; chunk < NUM_CHUNKS; ++chunk) {
+      row_layout.appendChunk(COLUMN_CHUNK_SIZE);
+   }
+
+   const Date32 lower = NUM_DAYS / 2;
+   const CompareToRangeSelection<Date32Column> selection{
+      column, ValueRange<Date32>{.lower = lower, .upper = lower + (NUM_DAYS / 10)}
+   };
+   return nanosecondsPerRow(row_layout.numRows(), [&]() {
+      cardinality = selection.makeBitmap(row_layout).cardinality();
+   });
+}
+
+void benchmarkAppendedDateColumn(std::vector<std::string>& summary) {
+   uint64_t cardinality = 0;
+   const double sorted_chunks = dateBetweenOnAppendedBatches(true, cardinality);
+   const double unsorted_chunks = dateBetweenOnAppendedBatches(false, cardinality);
+   summary.push_back(fmt::format(
+      "appended date32 between: sorted chunks {:>6.3f} ns/row, unsorted chunks {:>6.3f} ns/row "
+      "({:.1f}x), {} matches",
+      sorted_chunks,
+      unsorted_chunks,
+      unsorted_chunks / sorted_chunks,
+      cardinality
+   ));
+}
+
+void run() {
+   SILO_ASSERT(arrow::compute::Initialize().ok());
+
+   SPDLOG_INFO(
+      "Comparing {} rows, kernels chosen at runtime: {}",
+      NUM_CHUNKS * COLUMN_CHUNK_SIZE,
+      compareKernelIsaName(detectCompareKernelIsa())
+   );
+   std::vector<std::string> summary;
+   benchmarkColumn<rhydb::storage::column::Int32Column>("int32", summary);
+   benchmarkColumn<rhydb::storage::column::FloatColumn>("float", summary);
+   benchmarkColumn<rhydb::storage::column::Date32Column>("date32", summary);
+   benchmarkOrderedDateColumn(summary);
+   benchmarkAppendedDateColumn(summary);
+
+   SPDLOG_INFO("=== Summary ===");
+   for (const auto& line : summary) {
+      SPDLOG_INFO("{}", line);
+   }
+}
+
+}  // namespace
+
+int main() {
+   try {
+      run();
+   } catch (const std::exception& e) {
+      SPDLOG_ERROR(e.what());
+      return EXIT_FAILURE;
+   }
+}
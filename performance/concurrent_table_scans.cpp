@@ -0,0 +1,174 @@
+// Benchmark for many table scans running at the same time, as they do under concurrent HTTP load.
+//
+// A number of client threads each run full-table scans of the full-sequence dataset back to back
+// through the regular Planner. For every configuration the benchmark reports the scan throughput
+// and the thread churn of the process: how many distinct threads showed up while the scans ran
+// (sampled from /proc/self/task) and how many existed at the same time at most. Before table scans
+// got a fixed scan thread pool, every produced batch spawned a new thread, which shows up here as
+// thousands of distinct threads. Run this benchmark on a commit before that change to get the
+// baseline numbers; the queries are unchanged, so the two runs are directly comparable.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arrow/compute/initialize.h>
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "sequence_generator.h"
+#include "rhydb/config/runtime_config.h"
+#include "rhydb/query_engine/exec_node/ndjson_sink.h"
+#include "rhydb/query_engine/planner.h"
+
+using rhydb::Database;
+using rhydb::config::QueryOptions;
+using rhydb::query_engine::Planner;
+
+namespace {
+
+constexpr int SCANS_PER_CLIENT = 4;
+// Small batches, so that every scan produces many of them
+constexpr size_t MATERIALIZATION_CUTOFF = 1023;
+
+// Samples the thread ids of this process in the background. Linux hands out thread ids
+// increasingly, so the number of distinct ids seen approximates the number of threads created.
+class ThreadChurnSampler {
+   std::atomic<bool> stopped = false;
+   std::set<std::string> seen_thread_ids;
+   size_t peak_thread_count = 0;
+   std::thread sampler;
+
+  public:
+   ThreadChurnSampler()
+       : sampler([this]() {
+            while (!stopped) {
+               size_t thread_count = 0;
+               for (const auto& entry : std::filesystem::directory_iterator("/proc/self/task")) {
+                  seen_thread_ids.insert(entry.path().filename().string());
+                  ++thread_count;
+               }
+               peak_thread_count = std::max(peak_thread_count, thread_count);
+               std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+         }) {}
+
+   ThreadChurnSampler(const ThreadChurnSampler&) = delete;
+   ThreadChurnSampler& operator=(const ThreadChurnSampler&) = delete;
+   ThreadChurnSampler(ThreadChurnSampler&&) = delete;
+   ThreadChurnSampler& operator=(ThreadChurnSampler&&) = delete;
+
+   ~ThreadChurnSampler() { stop(); }
+
+   void stop() {
+      stopped = true;
+      if (sampler.joinable()) {
+         sampler.join();
+      }
+   }
+
+   // Only valid after `stop()`
+   [[nodiscard]] size_t distinctThreads() const { return seen_thread_ids.size(); }
+   [[nodiscard]] size_t peakThreads() const { return peak_thread_count; }
+};
+
+void runScan(
+   const std::shared_ptr<Database>& database,
+   const std::string& query,
+   const QueryOptions& query_options
+) {
+   auto query_plan = Planner::planSaneqlQuery(query, database->tables, query_options, "bench");
+   std::ofstream null_output("/dev/null");
+   rhydb::query_engine::exec_node::NdjsonSink sink{&null_output, query_plan.results_schema};
+   query_plan.executeAndWrite(sink, /*timeout_in_seconds=*/600);
+}
+
+void runConcurrentScans(
+   const std::shared_ptr<Database>& database,
+   const std::string& label,
+   const std::string& query,
+   size_t num_clients,
+   const QueryOptions& query_options
+) {
+   const size_t rows_per_scan = database->tables.at(rhydb::schema::TableName::getDefault())
+                                   ->sequence_count;
+
+   ThreadChurnSampler sampler;
+   const auto start = std::chrono::high_resolution_clock::now();
+   std::vector<std::thread> clients;
+   for (size_t client = 0; client < num_clients; ++client) {
+      clients.emplace_back([&]() {
+         for (int scan = 0; scan < SCANS_PER_CLIENT; ++scan) {
+            runScan(database, query, query_options);
+         }
+      });
+   }
+   for (auto& client : clients) {
+      client.join();
+   }
+   const auto end = std::chrono::high_resolution_clock::now();
+   sampler.stop();
+
+   const double seconds = std::chrono::duration<double>(end - start).count();
+   const double total_rows =
+      static_cast<double>(rows_per_scan) * static_cast<double>(num_clients * SCANS_PER_CLIENT);
+   SPDLOG_INFO(
+      "  {:<28} clients={:>3}  time={:>8.2f}s  rows/s={:>12.0f}  distinct threads={:>6}  peak "
+      "threads={:>4}",
+      label,
+      num_clients,
+      seconds,
+      total_rows / seconds,
+      sampler.distinctThreads(),
+      sampler.peakThreads()
+   );
+}
+
+void run() {
+   changeCwdToTestFolder();
+   SILO_ASSERT(arrow::compute::Initialize().ok());
+
+   const std::string reference = readReferenceFromFile();
+   SPDLOG_INFO("Loading full-length sequences from {}...", FULL_SEQUENCE_NDJSON_PATH);
+   auto ndjson = openTestDataInput(FULL_SEQUENCE_NDJSON_PATH);
+   auto database = initializeDatabaseWithFullSequenceSchema(reference);
+   database->appendData(rhydb::schema::TableName::getDefault(), ndjson);
+
+   auto default_options = rhydb::config::RuntimeConfig::withDefaults().query_options;
+   default_options.materialization_cutoff = MATERIALIZATION_CUTOFF;
+   auto no_prefetch_options = default_options;
+   no_prefetch_options.table_scan_prefetch_batches = 0;
+   no_prefetch_options.table_scan_parallelism = 1;
+
+   const std::vector<std::pair<std::string, std::string>> queries{
+      {"metadata", "default.project({key})"},
+      {"sequences", "default.project({key, main})"},
+   };
+   for (const auto& [query_label, query] : queries) {
+      SPDLOG_INFO("=== Full-table scans of {}: {} ===", query_label, query);
+      for (const size_t num_clients : {1, 8, 32}) {
+         runConcurrentScans(database, "no prefetch", query, num_clients, no_prefetch_options);
+         runConcurrentScans(database, "default prefetch", query, num_clients, default_options);
+      }
+   }
+   SPDLOG_INFO("=== Benchmark complete ===");
+}
+
+}  // namespace
+
+int main() {
+   try {
+      run();
+   } catch (const std::exception& e) {
+      SPDLOG_ERROR(e.what());
+      return EXIT_FAILURE;
+   }
+}
@@ -0,0 +1,256 @@
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <arrow/compute/initialize.h>
+#include <spdlog/spdlog.h>
+#include <fmt/format.h>
+
+#include "rhydb/common/panic.h"
+#include "rhydb/common/phylo_tree.h"
+#include "rhydb/config/database_config.h"
+#include "rhydb/database.h"
+#include "rhydb/initialize/initializer.h"
+#include "rhydb/storage/reference_genomes.h"
+
+// Measures how long saving a database takes after appending a small delta to a loaded database.
+//
+// Chunks of loaded columns remember the segment file they came from, so saving them into the next
+// data version hard-links the existing segments and only writes segments for the appended chunks
+// (see persistence::SegmentStore). The save after an append should therefore scale with the size
+// of the delta and not with the size of the base. Global structures of a column, like bitmaps and
+// dictionaries, are still written in full, so some cost per base row remains.
+//
+// The benchmark runs once with a metadata-only table and once with a table that additionally has a
+// nucleotide sequence, whose mutation and coverage indexes are segmented per chunk as well. For
+// every base size it builds and saves a base database once (a full save), then for every delta size
+// loads the base, appends the delta and saves again. It reports the append and save times and how
+// many bytes were newly written versus hard-linked.
+
+using rhydb::Database;
+
+namespace {
+
+constexpr std::array<size_t, 2> BASE_ROW_COUNTS = {1'000'000, 4'000'000};
+// Every row of the sequence table carries a whole sequence, so its bases are smaller
+constexpr std::array<size_t, 2> SEQUENCE_BASE_ROW_COUNTS = {250'000, 1'000'000};
+constexpr size_t REFERENCE_LENGTH = 300;
+constexpr size_t MUTATIONS_PER_SEQUENCE = 3;
+constexpr std::array<size_t, 3> DELTA_ROW_COUNTS = {1'000, 10'000, 100'000};
+constexpr std::array<std::string_view, 8> COUNTRIES = {
+   "Switzerland", "Germany", "France", "Italy", "Austria", "Spain", "Portugal", "Denmark"
+};
+
+std::string makeReference() {
+   std::mt19937 rng(REFERENCE_LENGTH);
+   std::uniform_int_distribution<size_t> symbol_dist(0, 3);
+   std::string reference(REFERENCE_LENGTH, 'A');
+   for (auto& symbol : reference) {
+      symbol = "ACGT"[symbol_dist(rng)];
+   }
+   return reference;
+}
+
+/// With a `reference`, the table has a nucleotide sequence `main` aligned against it
+std::shared_ptr<Database> initializeDatabase(const std::optional<std::string>& reference) {
+   auto database_config = rhydb::config::DatabaseConfig::getValidatedConfig(R"(
+schema:
+  instanceName: test
+  metadata:
+    - name: key
+      type: string
+    - name: age
+      type: int
+    - name: qc
+      type: float
+    - name: samplingDate
+      type: date
+    - name: country
+      type: string
+      generateIndex: true
+  primaryKey: key
+)");
+   rhydb::ReferenceGenomes reference_genomes;
+   if (reference.has_value()) {
+      reference_genomes = rhydb::ReferenceGenomes{{{"main", reference.value()}}, {}};
+   }
+   auto database = std::make_shared<Database>();
+   database->createTable(
+      rhydb::schema::TableName::getDefault(),
+      rhydb::initialize::Initializer::createSchemaFromConfigFiles(
+         std::move(database_config),
+         std::move(reference_genomes),
+         {},
+         rhydb::common::PhyloTree{},
+         /*without_unaligned_sequences=*/true
+      )
+   );
+   return database;
+}
+
+/// Returns the seconds the append took, excluding the generation of the rows. With a `reference`,
+/// every row gets a sequence that differs from it at a few random positions.
+double appendRows(
+   Database& database,
+   size_t first_key,
+   size_t row_count,
+   const std::optional<std::string>& reference
+) {
+   std::mt19937 rng(first_key);
+   std::uniform_int_distribution<int32_t> age_dist(0, 100);
+   std::uniform_real_distribution<double> qc_dist(0.0, 1.0);
+   std::uniform_int_distribution<int32_t> day_dist(1, 28);
+   std::uniform_int_distribution<size_t> country_dist(0, COUNTRIES.size() - 1);
+   std::uniform_int_distribution<size_t> position_dist(0, REFERENCE_LENGTH - 1);
+   std::uniform_int_distribution<size_t> symbol_dist(0, 3);
+
+   std::stringstream ndjson;
+   for (size_t key = first_key; key < first_key + row_count; ++key) {
+      std::string sequence_field;
+      if (reference.has_value()) {
+         std::string sequence = reference.value();
+         for (size_t mutation = 0; mutation < MUTATIONS_PER_SEQUENCE; ++mutation) {
+            sequence.at(position_dist(rng)) = "ACGT"[symbol_dist(rng)];
+         }
+         sequence_field =
+            fmt::format(R"(, "main": {{"sequence": "{}", "insertions": []}})", sequence);
+      }
+      ndjson << fmt::format(
+         R"({{"key": "key_{}", "age": {}, "qc": {}, "samplingDate": "2024-03-{:02}", )"
+         R"("country": "{}"{}}})"
+         "\n",
+         key,
+         age_dist(rng),
+         qc_dist(rng),
+         day_dist(rng),
+         COUNTRIES.at(country_dist(rng)),
+         sequence_field
+      );
+   }
+   const auto start = std::chrono::high_resolution_clock::now();
+   database.appendData(rhydb::schema::TableName::getDefault(), ndjson);
+   const auto end = std::chrono::high_resolution_clock::now();
+   return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() / 1000.0;
+}
+
+struct SaveResult {
+   double seconds;
+   std::filesystem::path versioned_directory;
+   uintmax_t new_bytes = 0;
+   uintmax_t linked_bytes = 0;
+};
+
+SaveResult timedSave(Database& database, const std::filesystem::path& save_directory) {
+   const auto start = std::chrono::high_resolution_clock::now();
+   database.saveDatabaseState(save_directory);
+   const auto end = std::chrono::high_resolution_clock::now();
+
+   SaveResult result{
+      .seconds =
+         std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() / 1000.0,
+      .versioned_directory = save_directory / database.getDataVersionTimestamp().value
+   };
+   for (const auto& file :
+        std::filesystem::recursive_directory_iterator(result.versioned_directory)) {
+      if (!file.is_regular_file()) {
+         continue;
+      }
+      if (file.hard_link_count() > 1) {
+         result.linked_bytes += file.file_size();
+      } else {
+         result.new_bytes += file.file_size();
+      }
+   }
+   return result;
+}
+
+double toMegabytes(uintmax_t bytes) {
+   return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+void runTable(
+   const std::string& table_name,
+   std::span<const size_t> base_row_counts,
+   const std::optional<std::string>& reference,
+   std::vector<std::string>& summary
+) {
+   const auto benchmark_directory =
+      std::filesystem::temp_directory_path() / "silo_incremental_append_benchmark";
+
+   for (const size_t base_rows : base_row_counts) {
+      std::filesystem::remove_all(benchmark_directory);
+      std::filesystem::create_directories(benchmark_directory);
+
+      SPDLOG_INFO("=== {} base database with {} rows ===", table_name, base_rows);
+      auto base_database = initializeDatabase(reference);
+      appendRows(*base_database, 0, base_rows, reference);
+      const auto base = timedSave(*base_database, benchmark_directory / "base");
+      base_database.reset();
+      summary.push_back(fmt::format(
+         "{:<9} base {:>9} rows, full save:                             save {:>7.3f}s, {:>8.1f} "
+         "MB written",
+         table_name,
+         base_rows,
+         base.seconds,
+         toMegabytes(base.new_bytes)
+      ));
+
+      for (const size_t delta_rows : DELTA_ROW_COUNTS) {
+         auto database = Database::loadDatabaseState(
+            rhydb::RhyDBDataSource::checkValidDataSource(base.versioned_directory)
+         );
+         const double append_seconds = appendRows(database, base_rows, delta_rows, reference);
+         const auto appended =
+            timedSave(database, benchmark_directory / fmt::format("delta_{}", delta_rows));
+         summary.push_back(fmt::format(
+            "{:<9} base {:>9} rows, append {:>7} rows: append {:>7.3f}s, save {:>7.3f}s, {:>8.1f} "
+            "MB written, {:>8.1f} MB linked",
+            table_name,
+            base_rows,
+            delta_rows,
+            append_seconds,
+            appended.seconds,
+            toMegabytes(appended.new_bytes),
+            toMegabytes(appended.linked_bytes)
+         ));
+      }
+   }
+   std::filesystem::remove_all(benchmark_directory);
+}
+
+void run() {
+   SILO_ASSERT(arrow::compute::Initialize().ok());
+
+   std::vector<std::string> summary;
+   runTable("metadata", BASE_ROW_COUNTS, std::nullopt, summary);
+   runTable("sequences", SEQUENCE_BASE_ROW_COUNTS, makeReference(), summary);
+
+   SPDLOG_INFO("=== Summary (append and save time / bytes written) ===");
+   for (const auto& line : summary) {
+      SPDLOG_INFO("{}", line);
+   }
+}
+
+}  // namespace
+
+int main() {
+   try {
+      run();
+   } catch (const std::exception& e) {
+      SPDLOG_ERROR(e.what());
+      return EXIT_FAILURE;
+   }
+}
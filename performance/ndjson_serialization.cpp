@@ -0,0 +1,260 @@
+// Benchmark for writing query results as NDJSON.
+//
+// NdjsonSink renders the rows of every batch with an NdjsonSerializer: the escaped keys of the
+// schema are rendered once, the values are formatted straight into one reused buffer, and the
+// buffer is written to the output stream in blocks of 256 KiB without flushing.
+//
+// The benchmark generates wide metadata rows in memory, i.e. it needs no test data: strings of
+// different lengths, integers, floats, dates and booleans, a tenth of the values null. It reports
+// rows/s and MB/s of
+//  - NdjsonSerializer::appendRows alone,
+//  - NdjsonSink, i.e. the serializer plus the writes to a stream that discards its input,
+//  - the rendering that NdjsonSink used before for comparison: a stringstream per row, values
+//    formatted with nlohmann::json, and a flush of the stream every 8 KiB.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
+#include <arrow/compute/exec.h>
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
+
+#include "rhydb/common/date32.h"
+#include "rhydb/common/panic.h"
+#include "rhydb/query_engine/exec_node/ndjson_serializer.h"
+#include "rhydb/query_engine/exec_node/ndjson_sink.h"
+
+using rhydb::query_engine::exec_node::NdjsonSerializer;
+using rhydb::query_engine::exec_node::NdjsonSink;
+
+namespace {
+
+constexpr size_t ROWS_PER_BATCH = 16'384;
+constexpr size_t NUM_BATCHES = 16;
+constexpr size_t COLUMNS_PER_TYPE = 6;
+constexpr size_t REPETITIONS = 3;
+
+/// Discards everything written to it, but counts the bytes
+class CountingBuffer : public std::streambuf {
+  public:
+   size_t bytes = 0;
+
+  protected:
+   std::streamsize xsputn(const char* /*data*/, std::streamsize count) override {
+      bytes += static_cast<size_t>(count);
+      return count;
+   }
+
+   int_type overflow(int_type character) override {
+      ++bytes;
+      return character;
+   }
+};
+
+struct Data {
+   std::shared_ptr<arrow::Schema> schema;
+   std::vector<std::vector<std::shared_ptr<arrow::Array>>> batches;
+};
+
+template <typename Builder, typename Generate>
+std::shared_ptr<arrow::Array> generateColumn(std::mt19937& rng, const Generate& generate) {
+   std::uniform_int_distribution<int32_t> null_distribution(0, 9);
+   Builder builder;
+   for (size_t row = 0; row < ROWS_PER_BATCH; ++row) {
+      if (null_distribution(rng) == 0) {
+         SILO_ASSERT(builder.AppendNull().ok());
+      } else {
+         SILO_ASSERT(builder.Append(generate()).ok());
+      }
+   }
+   std::shared_ptr<arrow::Array> array;
+   SILO_ASSERT(builder.Finish(&array).ok());
+   return array;
+}
+
+Data generateData() {
+   std::mt19937 rng(42);
+   std::uniform_int_distribution<int32_t> int_distribution(0, 1'000'000);
+   std::uniform_real_distribution<double> float_distribution(0, 1000);
+   std::uniform_int_distribution<int32_t> date_distribution(18'000, 20'000);
+   std::uniform_int_distribution<size_t> length_distribution(4, 40);
+   std::uniform_int_distribution<int32_t> char_distribution('A', 'z');
+   const auto generate_string = [&]() {
+      std::string value(length_distribution(rng), ' ');
+      std::ranges::generate(value, [&]() { return static_cast<char>(char_distribution(rng)); });
+      return value;
+   };
+
+   arrow::FieldVector fields;
+   for (size_t column = 0; column < COLUMNS_PER_TYPE; ++column) {
+      fields.push_back(arrow::field(fmt::format("string_{}", column), arrow::utf8()));
+      fields.push_back(arrow::field(fmt::format("int_{}", column), arrow::int32()));
+      fields.push_back(arrow::field(fmt::format("float_{}", column), arrow::float64()));
+      fields.push_back(arrow::field(fmt::format("date_{}", column), arrow::date32()));
+      fields.push_back(arrow::field(fmt::format("bool_{}", column), arrow::boolean()));
+   }
+   Data data{.schema = arrow::schema(fields), .batches = {}};
+   for (size_t batch = 0; batch < NUM_BATCHES; ++batch) {
+      std::vector<std::shared_ptr<arrow::Array>> columns;
+      for (size_t column = 0; column < COLUMNS_PER_TYPE; ++column) {
+         columns.push_back(generateColumn<arrow::StringBuilder>(rng, generate_string));
+         columns.push_back(generateColumn<arrow::Int32Builder>(rng, [&]() {
+            return int_distribution(rng);
+         }));
+         columns.push_back(generateColumn<arrow::DoubleBuilder>(rng, [&]() {
+            return float_distribution(rng);
+         }));
+         columns.push_back(generateColumn<arrow::Date32Builder>(rng, [&]() {
+            return date_distribution(rng);
+         }));
+         columns.push_back(generateColumn<arrow::BooleanBuilder>(rng, [&]() {
+            return int_distribution(rng) % 2 == 0;
+         }));
+      }
+      data.batches.push_back(std::move(columns));
+   }
+   return data;
+}
+
+/// The value at `row` like nlohmann::json renders it
+nlohmann::json toJson(const arrow::Array& array, int64_t row) {
+   if (array.IsNull(row)) {
+      return nullptr;
+   }
+   switch (array.type_id()) {
+      case arrow::Type::STRING:
+         return static_cast<const arrow::StringArray&>(array).GetView(row);
+      case arrow::Type::INT32:
+         return static_cast<const arrow::Int32Array&>(array).Value(row);
+      case arrow::Type::DOUBLE:
+         return static_cast<const arrow::DoubleArray&>(array).Value(row);
+      case arrow::Type::DATE32:
+         return rhydb::common::date32ToString(
+            static_cast<const arrow::Date32Array&>(array).Value(row)
+         );
+      case arrow::Type::BOOL:
+         return static_cast<const arrow::BooleanArray&>(array).Value(row);
+      default:
+         SILO_UNREACHABLE();
+   }
+}
+
+/// The rendering NdjsonSink used before
+void writeWithStringStreams(const Data& data, std::ostream& output) {
+   constexpr size_t FLUSH_SIZE = 8192;
+   std::vector<std::string> key_prefixes;
+   for (const auto& field : data.schema->fields()) {
+      key_prefixes.push_back(
+         (key_prefixes.empty() ? "" : ",") + nlohmann::json(field->name()).dump() + ":"
+      );
+   }
+   for (const auto& columns : data.batches) {
+      for (size_t row = 0; row < ROWS_PER_BATCH; ++row) {
+         std::stringstream line;
+         line << "{";
+         for (size_t column = 0; column < columns.size(); ++column) {
+            line << key_prefixes[column] << toJson(*columns[column], static_cast<int64_t>(row));
+         }
+         line << "}\n";
+         const std::string content = std::move(line).str();
+         for (size_t pos = 0; pos < content.size(); pos += FLUSH_SIZE) {
+            const size_t size = std::min(FLUSH_SIZE, content.size() - pos);
+            output.write(content.data() + pos, static_cast<std::streamsize>(size));
+            output.flush();
+         }
+      }
+   }
+}
+
+/// The best of `REPETITIONS` runs, in seconds, and the bytes written
+template <typename Function>
+std::pair<double, size_t> bestRun(const Function& function) {
+   double best = 0;
+   size_t bytes = 0;
+   for (size_t repetition = 0; repetition < REPETITIONS; ++repetition) {
+      const auto start = std::chrono::high_resolution_clock::now();
+      bytes = function();
+      const auto end = std::chrono::high_resolution_clock::now();
+      const std::chrono::duration<double> elapsed = end - start;
+      if (repetition == 0 || elapsed.count() < best) {
+         best = elapsed.count();
+      }
+   }
+   return {best, bytes};
+}
+
+void report(const std::string& name, std::pair<double, size_t> run) {
+   const auto [seconds, bytes] = run;
+   const auto rows = static_cast<double>(ROWS_PER_BATCH * NUM_BATCHES);
+   SPDLOG_INFO(
+      "{:<20} {:>12.0f} rows/s {:>10.1f} MB/s ({} bytes)",
+      name,
+      rows / seconds,
+      static_cast<double>(bytes) / seconds / 1e6,
+      bytes
+   );
+}
+
+void run() {
+   SPDLOG_INFO(
+      "Generating {} rows with {} columns...",
+      ROWS_PER_BATCH * NUM_BATCHES,
+      COLUMNS_PER_TYPE * 5
+   );
+   const Data data = generateData();
+
+   report("serializer", bestRun([&]() {
+             NdjsonSerializer serializer{*data.schema};
+             size_t bytes = 0;
+             for (const auto& columns : data.batches) {
+                SILO_ASSERT(serializer.appendRows(columns, 0, ROWS_PER_BATCH).ok());
+                bytes += serializer.size();
+                serializer.clear();
+             }
+             return bytes;
+          }));
+
+   report("sink", bestRun([&]() {
+             CountingBuffer buffer;
+             std::ostream output{&buffer};
+             NdjsonSink sink{&output, data.schema};
+             for (const auto& columns : data.batches) {
+                const std::vector<arrow::Datum> values(columns.begin(), columns.end());
+                const arrow::compute::ExecBatch batch{values, ROWS_PER_BATCH};
+                SILO_ASSERT(sink.writeBatch(batch).ok());
+             }
+             SILO_ASSERT(sink.finish().ok());
+             return buffer.bytes;
+          }));
+
+   report("stringstream before", bestRun([&]() {
+             CountingBuffer buffer;
+             std::ostream output{&buffer};
+             writeWithStringStreams(data, output);
+             return buffer.bytes;
+          }));
+}
+
+}  // namespace
+
+int main() {
+   try {
+      run();
+   } catch (const std::exception& e) {
+      SPDLOG_ERROR(e.what());
+      return EXIT_FAILURE;
+   }
+}
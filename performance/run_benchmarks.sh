@@ -25,6 +25,12 @@ benchmarks=(
   nof_sequence_filter
   sequence_column_insert
   co_occurrence_benchmark
+  concurrent_table_scans
+  sequence_download
+  incremental_append
+  compare_predicate_kernels
+  sequence_point_lookup
+  ndjson_serialization
 )
 
 failed=()
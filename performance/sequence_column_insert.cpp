@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <exception>
 #include <string>
+#include <thread>
 
 #include <spdlog/spdlog.h>
 
@@ -19,7 +21,8 @@ double toMs(std::chrono::steady_clock::time_point start, std::chrono::steady_clo
 
 // Ingest full-length sequences with realistic N runs through the regular appendData path (NDJSON ->
 // column-group builder -> sequence column), measuring the end-to-end append time. The dataset is
-// generated once by `make generateTestData` (writeNRunSequenceNdjson).
+// generated once by `make generateTestData` (writeNRunSequenceNdjson). The append uses one parse
+// worker per core, so rows/s should grow with the core count.
 void run() {
    changeCwdToTestFolder();
    const std::string reference = readReferenceFromFile();
@@ -34,6 +37,11 @@ void run() {
 
    SPDLOG_INFO("sequences appended: {}", SEQUENCE_COLUMN_SEQUENCE_COUNT);
    SPDLOG_INFO("appendData:         {:.1f} ms", toMs(start, end));
+   SPDLOG_INFO(
+      "rows/s:             {:.0f} with {} parse workers",
+      static_cast<double>(SEQUENCE_COLUMN_SEQUENCE_COUNT) / (toMs(start, end) / 1000.0),
+      std::max(std::thread::hardware_concurrency(), 1U)
+   );
 }
 
 }  // namespace
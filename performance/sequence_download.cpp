@@ -0,0 +1,144 @@
+// Benchmark for downloading aligned sequences.
+//
+// Streams all aligned sequences of the full-sequence dataset through the regular Planner and the
+// NDJSON sink and reports the output rate in MB/s. Every produced batch reconstructs its sequences
+// and zstd-compresses them against the reference, so small batches make the per-batch setup
+// visible while large batches are dominated by reconstruction and compression. Each batch size is
+// also run from several concurrent clients, which share the per-column compression dictionary.
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <arrow/compute/initialize.h>
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "sequence_generator.h"
+#include "rhydb/config/runtime_config.h"
+#include "rhydb/query_engine/exec_node/ndjson_sink.h"
+#include "rhydb/query_engine/planner.h"
+
+using rhydb::Database;
+using rhydb::config::QueryOptions;
+using rhydb::query_engine::Planner;
+
+namespace {
+
+constexpr int ITERATIONS = 3;
+constexpr std::string_view QUERY = "default.project({key, main})";
+
+// Discards everything written to it and only counts the bytes.
+class CountingBuffer : public std::streambuf {
+   std::array<char, 1 << 16> buffer{};
+   uint64_t bytes_written = 0;
+
+  public:
+   CountingBuffer() { setp(buffer.data(), buffer.data() + buffer.size()); }
+
+   [[nodiscard]] uint64_t bytesWritten() const { return bytes_written + (pptr() - pbase()); }
+
+  protected:
+   int_type overflow(int_type character) override {
+      bytes_written += pptr() - pbase();
+      setp(buffer.data(), buffer.data() + buffer.size());
+      if (!traits_type::eq_int_type(character, traits_type::eof())) {
+         sputc(traits_type::to_char_type(character));
+      }
+      return traits_type::not_eof(character);
+   }
+
+   std::streamsize xsputn(const char* /*data*/, std::streamsize count) override {
+      bytes_written += count;
+      return count;
+   }
+};
+
+uint64_t downloadSequences(
+   const std::shared_ptr<Database>& database,
+   const QueryOptions& query_options
+) {
+   auto query_plan =
+      Planner::planSaneqlQuery(std::string{QUERY}, database->tables, query_options, "bench");
+   CountingBuffer counting_buffer;
+   std::ostream output{&counting_buffer};
+   rhydb::query_engine::exec_node::NdjsonSink sink{&output, query_plan.results_schema};
+   query_plan.executeAndWrite(sink, /*timeout_in_seconds=*/600);
+   output.flush();
+   return counting_buffer.bytesWritten();
+}
+
+void runDownloads(
+   const std::shared_ptr<Database>& database,
+   size_t materialization_cutoff,
+   size_t num_clients
+) {
+   auto query_options = rhydb::config::RuntimeConfig::withDefaults().query_options;
+   query_options.materialization_cutoff = materialization_cutoff;
+
+   std::vector<uint64_t> bytes_per_client(num_clients, 0);
+   const auto start = std::chrono::high_resolution_clock::now();
+   std::vector<std::thread> clients;
+   for (size_t client = 0; client < num_clients; ++client) {
+      clients.emplace_back([&, client]() {
+         for (int iteration = 0; iteration < ITERATIONS; ++iteration) {
+            bytes_per_client[client] += downloadSequences(database, query_options);
+         }
+      });
+   }
+   for (auto& client : clients) {
+      client.join();
+   }
+   const auto end = std::chrono::high_resolution_clock::now();
+
+   uint64_t total_bytes = 0;
+   for (const uint64_t bytes : bytes_per_client) {
+      total_bytes += bytes;
+   }
+   const double seconds = std::chrono::duration<double>(end - start).count();
+   SPDLOG_INFO(
+      "  batch size={:>6}  clients={:>2}  output={:>9.1f} MB  time={:>7.2f}s  {:>8.1f} MB/s",
+      materialization_cutoff + 1,
+      num_clients,
+      static_cast<double>(total_bytes) / 1e6,
+      seconds,
+      static_cast<double>(total_bytes) / 1e6 / seconds
+   );
+}
+
+void run() {
+   changeCwdToTestFolder();
+   SILO_ASSERT(arrow::compute::Initialize().ok());
+
+   const std::string reference = readReferenceFromFile();
+   SPDLOG_INFO("Loading full-length sequences from {}...", FULL_SEQUENCE_NDJSON_PATH);
+   auto ndjson = openTestDataInput(FULL_SEQUENCE_NDJSON_PATH);
+   auto database = initializeDatabaseWithFullSequenceSchema(reference);
+   database->appendData(rhydb::schema::TableName::getDefault(), ndjson);
+
+   SPDLOG_INFO("=== Aligned sequence download: {} ===", QUERY);
+   for (const size_t materialization_cutoff : {15, 255, 4095, 32767}) {
+      for (const size_t num_clients : {1, 8}) {
+         runDownloads(database, materialization_cutoff, num_clients);
+      }
+   }
+   SPDLOG_INFO("=== Benchmark complete ===");
+}
+
+}  // namespace
+
+int main() {
+   try {
+      run();
+   } catch (const std::exception& e) {
+      SPDLOG_ERROR(e.what());
+      return EXIT_FAILURE;
+   }
+}
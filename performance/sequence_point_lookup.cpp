@@ -0,0 +1,154 @@
+// Benchmark for fetching a few aligned sequences by primary key.
+//
+// Reconstructing aligned sequences overwrites the local reference with the stored symbol
+// containers of the requested rows. The frozen vertical sequence index keeps its containers in
+// position order and additionally in chunk (v_index) order, so that a batch of rows from a few
+// chunks only visits the containers of those chunks instead of all of them.
+//
+// The benchmark ingests sequences of a shortened reference into eight full chunks and
+//  - runs `filter(key.in(...)).project({key, main})` for 1, 100 and 10k random keys through the
+//    Planner and the NDJSON sink,
+//  - reconstructs the same numbers of random rows directly with either strategy of
+//    `VerticalSequenceIndex::overwriteSymbolsInSequences`, the full sweep over all containers and
+//    the chunk-major lookup.
+// A single key only touches one chunk, while 10k random keys touch all of them, where the automatic
+// choice falls back to the full sweep.
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <arrow/compute/initialize.h>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <spdlog/spdlog.h>
+#include <roaring/roaring.hh>
+
+#include "sequence_generator.h"
+#include "rhydb/config/runtime_config.h"
+#include "rhydb/query_engine/exec_node/ndjson_sink.h"
+#include "rhydb/query_engine/planner.h"
+#include "rhydb/storage/column/vertical_sequence_index.h"
+
+using rhydb::Database;
+using rhydb::Nucleotide;
+using rhydb::query_engine::Planner;
+using rhydb::storage::column::COLUMN_CHUNK_SIZE;
+using ReconstructionStrategy =
+   rhydb::storage::column::VerticalSequenceIndex<Nucleotide>::ReconstructionStrategy;
+
+namespace {
+
+constexpr size_t REFERENCE_LENGTH = 1000;
+constexpr size_t NUM_CHUNKS = 8;
+constexpr size_t NUM_ROWS = NUM_CHUNKS * COLUMN_CHUNK_SIZE;
+constexpr size_t REPETITIONS = 20;
+
+/// `count` distinct random rows, ascending
+std::vector<uint32_t> randomRows(size_t count, std::mt19937& rng) {
+   std::uniform_int_distribution<uint32_t> row_distribution(0, NUM_ROWS - 1);
+   std::set<uint32_t> rows;
+   while (rows.size() < count) {
+      rows.insert(row_distribution(rng));
+   }
+   return {rows.begin(), rows.end()};
+}
+
+/// The mean of `REPETITIONS` runs, in microseconds
+template <typename Function>
+double microsecondsPerRun(const Function& function) {
+   const auto start = std::chrono::high_resolution_clock::now();
+   for (size_t repetition = 0; repetition < REPETITIONS; ++repetition) {
+      function();
+   }
+   const auto end = std::chrono::high_resolution_clock::now();
+   return std::chrono::duration<double, std::micro>(end - start).count() /
+          static_cast<double>(REPETITIONS);
+}
+
+double fetchByPrimaryKey(
+   const std::shared_ptr<Database>& database,
+   const std::vector<uint32_t>& rows
+) {
+   std::vector<std::string> keys;
+   keys.reserve(rows.size());
+   for (const uint32_t row : rows) {
+      keys.push_back(fmt::format("'{}'", row));
+   }
+   const std::string query =
+      fmt::format("default.filter(key.in({{{}}})).project({{key, main}})", fmt::join(keys, ", "));
+   const auto query_options = rhydb::config::RuntimeConfig::withDefaults().query_options;
+   return microsecondsPerRun([&]() {
+      auto query_plan = Planner::planSaneqlQuery(query, database->tables, query_options, "bench");
+      std::ostringstream output;
+      rhydb::query_engine::exec_node::NdjsonSink sink{&output, query_plan.results_schema};
+      query_plan.executeAndWrite(sink, /*timeout_in_seconds=*/600);
+   });
+}
+
+double reconstruct(
+   const rhydb::storage::column::SequenceColumn<Nucleotide>& sequence_column,
+   const std::vector<uint32_t>& rows,
+   ReconstructionStrategy strategy
+) {
+   roaring::Roaring row_ids;
+   row_ids.addMany(rows.size(), rows.data());
+   return microsecondsPerRun([&]() {
+      std::vector<std::string> sequences(
+         rows.size(), sequence_column.local_reference_sequence_string
+      );
+      sequence_column.vertical_sequence_index.overwriteSymbolsInSequences(
+         sequences, row_ids, strategy
+      );
+   });
+}
+
+void run() {
+   changeCwdToTestFolder();
+   SILO_ASSERT(arrow::compute::Initialize().ok());
+
+   const std::string reference = readReferenceFromFile().substr(0, REFERENCE_LENGTH);
+   SPDLOG_INFO("Generating {} sequences of length {}...", NUM_ROWS, REFERENCE_LENGTH);
+   std::stringstream ndjson;
+   writeFullSequenceNdjson(ndjson, reference, NUM_ROWS);
+   auto database = initializeDatabaseWithFullSequenceSchema(reference);
+   database->appendData(rhydb::schema::TableName::getDefault(), ndjson);
+   const auto& sequence_column =
+      database->tables.at(rhydb::schema::TableName::getDefault())->columns.nuc_columns.at("main");
+   SPDLOG_INFO(
+      "{} stored symbol containers",
+      sequence_column.vertical_sequence_index.numSequenceDiffs()
+   );
+
+   std::mt19937 rng(42);
+   SPDLOG_INFO("=== Fetch aligned sequences by primary key ===");
+   for (const size_t count : {1, 100, 10'000}) {
+      const auto rows = randomRows(count, rng);
+      SPDLOG_INFO(
+         "  {:>6} keys: query {:>10.1f} us, reconstruction: full sweep {:>10.1f} us, chunk-major "
+         "{:>10.1f} us, automatic {:>10.1f} us",
+         count,
+         fetchByPrimaryKey(database, rows),
+         reconstruct(sequence_column, rows, ReconstructionStrategy::FULL_SWEEP),
+         reconstruct(sequence_column, rows, ReconstructionStrategy::CHUNK_MAJOR),
+         reconstruct(sequence_column, rows, ReconstructionStrategy::AUTOMATIC)
+      );
+   }
+   SPDLOG_INFO("=== Benchmark complete ===");
+}
+
+}  // namespace
+
+int main() {
+   try {
+      run();
+   } catch (const std::exception& e) {
+      SPDLOG_ERROR(e.what());
+      return EXIT_FAILURE;
+   }
+}
@@ -0,0 +1,267 @@
+#include "rhydb/append/ingestion_pipeline.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "evobench/evobench.hpp"
+#include "rhydb/append/append_exception.h"
+
+namespace rhydb::append {
+
+namespace {
+
+constexpr size_t LOG_EVERY_N_LINES = 10000;
+
+/// Lets the workers run ahead of a batch that takes longer to parse than the others
+constexpr size_t ROW_BUFFERS_PER_WORKER = 2;
+
+}  // namespace
+
+IngestionPipeline::IngestionPipeline(
+   TableInserter& table_inserter,
+   NdjsonLineReader& input_data,
+   size_t num_parse_workers,
+   size_t lines_per_batch
+)
+    : table_inserter(table_inserter),
+      input_data(input_data),
+      num_parse_workers(std::max<size_t>(num_parse_workers, 1)),
+      lines_per_batch(std::max<size_t>(lines_per_batch, 1)) {}
+
+IngestionPipeline::~IngestionPipeline() {
+   stop();
+}
+
+void IngestionPipeline::stop() {
+   {
+      const std::lock_guard lock{mutex};
+      stopping = true;
+   }
+   changed.notify_all();
+   for (auto& thread : threads) {
+      if (thread.joinable()) {
+         thread.join();
+      }
+   }
+   threads.clear();
+}
+
+void IngestionPipeline::run() {
+   EVOBENCH_SCOPE("IngestionPipeline", "run");
+   std::string first_line;
+   if (!input_data.readRawLine(first_line)) {
+      if (input_data.readError()) {
+         throw AppendException(
+            "get error '{}' when parsing the current line: {}",
+            simdjson::error_message(input_data.readError()),
+            first_line
+         );
+      }
+      return;
+   }
+
+   // Inserting is faster if we parse the fields in the correct order.
+   // Sniff the order from the first json in the ndjson stream
+   {
+      simdjson::ondemand::parser parser;
+      simdjson::ondemand::document document;
+      if (auto error = parser.iterate(first_line).get(document)) {
+         throw AppendException(
+            "get error '{}' when parsing the current line: {}",
+            simdjson::error_message(error),
+            first_line
+         );
+      }
+      auto sniffed_field_order_or_error = table_inserter.sniffFieldOrder(document);
+      if (!sniffed_field_order_or_error.has_value()) {
+         throw AppendException{
+            "{} - current line: {}", sniffed_field_order_or_error.error(), first_line
+         };
+      }
+      field_order = std::move(sniffed_field_order_or_error.value());
+   }
+
+   // The row buffers read the local references of the table, which is only safe before the
+   // inserter starts to change the table
+   const size_t num_row_buffers = num_parse_workers * ROW_BUFFERS_PER_WORKER;
+   free_row_buffers.reserve(num_row_buffers);
+   for (size_t i = 0; i < num_row_buffers; ++i) {
+      free_row_buffers.push_back(
+         std::make_unique<storage::ColumnGroupBuilder>(table_inserter.makeRowBuffer())
+      );
+   }
+
+   threads.emplace_back([this, first_line = std::move(first_line)]() mutable {
+      read(std::move(first_line));
+   });
+   for (size_t i = 0; i < num_parse_workers; ++i) {
+      threads.emplace_back([this] { parse(); });
+   }
+   insertInOrder();
+   stop();
+}
+
+void IngestionPipeline::read(std::string first_line) {
+   size_t sequence_number = 0;
+   LineBatch batch{.sequence_number = sequence_number, .lines = {}};
+   batch.lines.reserve(lines_per_batch);
+   batch.lines.push_back(std::move(first_line));
+
+   // Returns false if the pipeline stopped
+   const auto enqueue = [&]() {
+      {
+         std::unique_lock lock{mutex};
+         changed.wait(lock, [&] {
+            return stopping || line_batches.size() < num_parse_workers;
+         });
+         if (stopping) {
+            return false;
+         }
+         line_batches.push_back(std::move(batch));
+      }
+      changed.notify_all();
+      ++sequence_number;
+      batch = LineBatch{.sequence_number = sequence_number, .lines = {}};
+      batch.lines.reserve(lines_per_batch);
+      return true;
+   };
+
+   std::exception_ptr error;
+   try {
+      std::string line;
+      while (input_data.readRawLine(line)) {
+         batch.lines.push_back(std::move(line));
+         if (batch.lines.size() == lines_per_batch && !enqueue()) {
+            return;
+         }
+      }
+      if (!batch.lines.empty() && !enqueue()) {
+         return;
+      }
+      if (input_data.readError()) {
+         throw AppendException(
+            "get error '{}' when parsing the current line: {}",
+            simdjson::error_message(input_data.readError()),
+            line
+         );
+      }
+   } catch (...) {
+      error = std::current_exception();
+   }
+
+   {
+      const std::lock_guard lock{mutex};
+      // Reported after all batches that were read before it
+      if (error != nullptr) {
+         parsed_batches.emplace(sequence_number, ParsedBatch{.error = error});
+         ++sequence_number;
+      }
+      num_batches = sequence_number;
+      input_exhausted = true;
+   }
+   changed.notify_all();
+}
+
+void IngestionPipeline::parse() {
+   simdjson::ondemand::parser parser;
+   while (true) {
+      LineBatch batch;
+      ParsedBatch parsed;
+      {
+         std::unique_lock lock{mutex};
+         // A batch is only taken together with a row buffer, so that the batch that is inserted
+         // next never waits for one
+         changed.wait(lock, [&] {
+            return stopping || (line_batches.empty() ? input_exhausted : !free_row_buffers.empty());
+         });
+         if (stopping || line_batches.empty()) {
+            return;
+         }
+         batch = std::move(line_batches.front());
+         line_batches.pop_front();
+         parsed.rows = std::move(free_row_buffers.back());
+         free_row_buffers.pop_back();
+      }
+      changed.notify_all();
+
+      parsed.num_lines = batch.lines.size();
+      try {
+         parseBatch(parser, batch, *parsed.rows);
+      } catch (...) {
+         parsed.error = std::current_exception();
+      }
+
+      {
+         const std::lock_guard lock{mutex};
+         parsed_batches.emplace(batch.sequence_number, std::move(parsed));
+      }
+      changed.notify_all();
+   }
+}
+
+void IngestionPipeline::parseBatch(
+   simdjson::ondemand::parser& parser,
+   LineBatch& batch,
+   storage::ColumnGroupBuilder& rows
+) const {
+   EVOBENCH_SCOPE_EVERY(20, "IngestionPipeline", "parseBatch");
+   for (auto& line : batch.lines) {
+      simdjson::ondemand::document document;
+      if (auto error = parser.iterate(line).get(document)) {
+         throw AppendException(
+            "get error '{}' when parsing the current line: {}", simdjson::error_message(error), line
+         );
+      }
+      auto maybe_error = TableInserter::parseInto(rows, document, field_order);
+      if (!maybe_error.has_value()) {
+         throw AppendException{"{} - current line: {}", maybe_error.error(), line};
+      }
+   }
+}
+
+void IngestionPipeline::insertInOrder() {
+   size_t next_sequence_number = 0;
+   size_t line_count = 0;
+   while (true) {
+      ParsedBatch parsed;
+      {
+         std::unique_lock lock{mutex};
+         changed.wait(lock, [&] {
+            return parsed_batches.contains(next_sequence_number) ||
+                   (input_exhausted && next_sequence_number == num_batches);
+         });
+         auto node = parsed_batches.extract(next_sequence_number);
+         if (node.empty()) {
+            return;
+         }
+         parsed = std::move(node.mapped());
+      }
+      if (parsed.error != nullptr) {
+         std::rethrow_exception(parsed.error);
+      }
+
+      auto maybe_error = table_inserter.insertRows(*parsed.rows);
+      if (!maybe_error.has_value()) {
+         throw AppendException{
+            "{} - current line number: {}", maybe_error.error(), line_count + parsed.num_lines
+         };
+      }
+      const size_t previous_line_count = line_count;
+      line_count += parsed.num_lines;
+      if (line_count / LOG_EVERY_N_LINES > previous_line_count / LOG_EVERY_N_LINES) {
+         SPDLOG_INFO("Processed {} json objects from the input file", line_count);
+      }
+
+      {
+         const std::lock_guard lock{mutex};
+         free_row_buffers.push_back(std::move(parsed.rows));
+         ++next_sequence_number;
+      }
+      changed.notify_all();
+   }
+}
+
+}  // namespace rhydb::append
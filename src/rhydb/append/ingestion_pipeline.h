@@ -0,0 +1,94 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rhydb/append/ndjson_line_reader.h"
+#include "rhydb/append/table_inserter.h"
+#include "rhydb/storage/column_group_builder.h"
+
+namespace rhydb::append {
+
+/// Ingests the input with several threads in three stages:
+///  - a reader thread splits the input into batches of raw lines,
+///  - parse workers parse the lines of a batch and diff their sequences into a row buffer,
+///  - the calling thread inserts the parsed batches in input order, which keeps the rows (and the
+///    chunks they are flushed into) in the same order as ingesting the lines one by one.
+/// The table applies each chunk to its columns in parallel (see `Table::bulkInsert`).
+///
+/// The number of row buffers bounds the batches in flight: a worker only takes a batch together
+/// with a free row buffer, and the buffers return once their batch was inserted. An error is
+/// reported for the first failing line in input order, after all lines before it were inserted.
+class IngestionPipeline {
+   struct LineBatch {
+      size_t sequence_number;
+      std::vector<std::string> lines;
+   };
+
+   /// Holds either the parsed rows of a batch or the error that stopped it
+   struct ParsedBatch {
+      std::unique_ptr<storage::ColumnGroupBuilder> rows;
+      size_t num_lines = 0;
+      std::exception_ptr error;
+   };
+
+   TableInserter& table_inserter;
+   NdjsonLineReader& input_data;
+   size_t num_parse_workers;
+   size_t lines_per_batch;
+   std::vector<TableInserter::SniffedField> field_order;
+
+   std::mutex mutex;
+   std::condition_variable changed;
+   std::deque<LineBatch> line_batches;
+   /// Ordered by sequence number, the inserter takes them out in order
+   std::map<size_t, ParsedBatch> parsed_batches;
+   std::vector<std::unique_ptr<storage::ColumnGroupBuilder>> free_row_buffers;
+   bool input_exhausted = false;
+   size_t num_batches = 0;
+   bool stopping = false;
+
+   std::vector<std::thread> threads;
+
+   void read(std::string first_line);
+
+   void parse();
+
+   void parseBatch(
+      simdjson::ondemand::parser& parser,
+      LineBatch& batch,
+      storage::ColumnGroupBuilder& rows
+   ) const;
+
+   void insertInOrder();
+
+   void stop();
+
+  public:
+   IngestionPipeline(
+      TableInserter& table_inserter,
+      NdjsonLineReader& input_data,
+      size_t num_parse_workers,
+      size_t lines_per_batch
+   );
+
+   IngestionPipeline(const IngestionPipeline& other) = delete;
+   IngestionPipeline& operator=(const IngestionPipeline& other) = delete;
+
+   /// Stops and joins the threads if `run` ended early. A reader that waits for input finishes
+   /// that read first.
+   ~IngestionPipeline();
+
+   /// Inserts every line of the input, does not commit. Throws `AppendException` for invalid input.
+   void run();
+};
+
+}  // namespace rhydb::append
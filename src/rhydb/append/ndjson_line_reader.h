@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iterator>
+#include <string>
 
 #include <simdjson.h>
 
@@ -78,33 +79,44 @@ class NdjsonLineReader {
    [[nodiscard]] Iterator begin() { return Iterator(this); }
    [[nodiscard]] static Iterator end() { return {}; }
 
-  private:
-   bool next() {
+   /// Reads the next line that is not blank into `line` without parsing it, so that it can be
+   /// parsed on another thread. Returns false at the end of the input or if it could not be read,
+   /// `readError` tells the two apart. Do not mix with iterating over the reader.
+   bool readRawLine(std::string& line) {
       if (error) {
-         return true;
+         return false;
       }
       while (true) {
          // We need this check here, because we only check for 'eof && empty'
          // after we read to also allow files that do not end with a line-break
          if (input_stream->eof()) {
-            return true;
+            return false;
          }
-         std::getline(*input_stream, line_buffer);
+         std::getline(*input_stream, line);
 
-         if (input_stream->eof() && line_buffer.empty()) {
-            return true;
+         if (input_stream->eof() && line.empty()) {
+            return false;
          }
          if (input_stream->fail()) {
             error = simdjson::IO_ERROR;
+            return false;
+         }
+         // simdjson reports lines of only whitespace as EMPTY, which are skipped
+         if (line.find_first_not_of(" \t\n\r") != std::string::npos) {
             return true;
          }
+      }
+   }
 
-         error = parser.iterate(line_buffer).get(json_document_buffer);
-         if (error == simdjson::EMPTY) {
-            continue;
-         }
-         return false;
+   [[nodiscard]] simdjson::error_code readError() const { return error; }
+
+  private:
+   bool next() {
+      if (!readRawLine(line_buffer)) {
+         return true;
       }
+      error = parser.iterate(line_buffer).get(json_document_buffer);
+      return false;
    }
 };
 
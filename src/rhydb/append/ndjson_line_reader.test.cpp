@@ -61,3 +61,18 @@ TEST(NdjsonLineReader, validOnTerminatedLine) {
    ++iter;
    ASSERT_TRUE(iter == reader.end());
 }
+
+TEST(NdjsonLineReader, readsRawLinesSkippingBlankOnes) {
+   std::string input = "{\"a\":1}\n\n  \t\n{\"a\":\nnot json\n";
+   std::stringstream input_stream{input};
+   NdjsonLineReader reader{input_stream};
+   std::string line;
+   ASSERT_TRUE(reader.readRawLine(line));
+   ASSERT_EQ(line, "{\"a\":1}");
+   ASSERT_TRUE(reader.readRawLine(line));
+   ASSERT_EQ(line, "{\"a\":");
+   ASSERT_TRUE(reader.readRawLine(line));
+   ASSERT_EQ(line, "not json");
+   ASSERT_FALSE(reader.readRawLine(line));
+   ASSERT_FALSE(reader.readError());
+}
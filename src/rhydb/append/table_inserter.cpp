@@ -3,10 +3,12 @@
 #include <algorithm>
 #include <cmath>
 #include <optional>
+#include <thread>
 #include <utility>
 
 #include "evobench/evobench.hpp"
 #include "rhydb/append/append_exception.h"
+#include "rhydb/append/ingestion_pipeline.h"
 #include "rhydb/common/aa_symbols.h"
 #include "rhydb/common/error.h"
 #include "rhydb/common/nucleotide_symbols.h"
@@ -317,18 +319,49 @@ std::expected<void, std::string> TableInserter::insert(
    const std::vector<SniffedField>& field_order_hint
 ) {
    EVOBENCH_SCOPE_EVERY(20, "TableInserter", "insert");
+   auto success_or_error = parseInto(input_buffer, ndjson_line, field_order_hint);
+   if (!success_or_error.has_value()) {
+      return success_or_error;
+   }
+   if (input_buffer.numBufferedRows() >= storage::column::COLUMN_CHUNK_SIZE) {
+      return flushInputBuffer();
+   }
+   return {};
+}
+
+storage::ColumnGroupBuilder TableInserter::makeRowBuffer() const {
+   return storage::ColumnGroupBuilder{*table->schema, table->columns};
+}
+
+std::expected<void, std::string> TableInserter::parseInto(
+   storage::ColumnGroupBuilder& rows,
+   simdjson::ondemand::document_reference ndjson_line,
+   const std::vector<SniffedField>& field_order_hint
+) {
    ASSIGN_OR_RAISE(auto object, iterateToObject(ndjson_line));
    for (const auto& sniffed_field : field_order_hint) {
       ASSIGN_OR_RAISE(auto column_value, findFieldWithFallbacks(object, sniffed_field));
       auto success_or_error =
-         input_buffer.addJsonValueToColumn(sniffed_field.column_identifier, column_value);
+         rows.addJsonValueToColumn(sniffed_field.column_identifier, column_value);
       if (!success_or_error.has_value()) {
          return success_or_error;
       }
    }
-   if (input_buffer.numBufferedRows() >= storage::column::COLUMN_CHUNK_SIZE) {
-      return flushInputBuffer();
+   return {};
+}
+
+std::expected<void, std::string> TableInserter::insertRows(storage::ColumnGroupBuilder& rows) {
+   const size_t num_rows = rows.numBufferedRows();
+   for (size_t row = 0; row < num_rows; ++row) {
+      rows.moveRowTo(row, input_buffer);
+      if (input_buffer.numBufferedRows() >= storage::column::COLUMN_CHUNK_SIZE) {
+         auto flush_result = flushInputBuffer();
+         if (!flush_result.has_value()) {
+            return flush_result;
+         }
+      }
    }
+   rows.clear();
    return {};
 }
 
@@ -355,14 +388,23 @@ TableInserter::Commit TableInserter::commit() {
    return Commit{};
 }
 
-TableInserter::Commit appendDataToTable(
-   std::shared_ptr<storage::Table> table,
-   NdjsonLineReader& input_data,
-   ClusteredBufferingOptions options
-) {
-   EVOBENCH_SCOPE("TableInserter", "appendDataToTable");
-   TableInserter table_inserter(std::move(table), std::move(options));
+namespace {
 
+size_t numParseWorkers(const IngestionParallelismOptions& parallelism) {
+#ifdef __EMSCRIPTEN__
+   // The browser build has a fixed pool of pthread workers (PTHREAD_POOL_SIZE in
+   // wasm/CMakeLists.txt), ingestion does not take any of them.
+   static_cast<void>(parallelism);
+   return 1;
+#else
+   if (parallelism.num_parse_workers > 0) {
+      return parallelism.num_parse_workers;
+   }
+   return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+#endif
+}
+
+void appendLineByLine(TableInserter& table_inserter, NdjsonLineReader& input_data) {
    size_t line_count = 0;
 
    bool first_line = true;
@@ -399,6 +441,28 @@ TableInserter::Commit appendDataToTable(
          SPDLOG_INFO("Processed {} json objects from the input file", line_count);
       }
    }
+}
+
+}  // namespace
+
+TableInserter::Commit appendDataToTable(
+   std::shared_ptr<storage::Table> table,
+   NdjsonLineReader& input_data,
+   ClusteredBufferingOptions options,
+   IngestionParallelismOptions parallelism
+) {
+   EVOBENCH_SCOPE("TableInserter", "appendDataToTable");
+   TableInserter table_inserter(std::move(table), std::move(options));
+
+   const size_t num_parse_workers = numParseWorkers(parallelism);
+   if (num_parse_workers == 1) {
+      appendLineByLine(table_inserter, input_data);
+   } else {
+      IngestionPipeline pipeline{
+         table_inserter, input_data, num_parse_workers, parallelism.lines_per_batch
+      };
+      pipeline.run();
+   }
 
    return table_inserter.commit();
 }
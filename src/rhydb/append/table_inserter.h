@@ -40,6 +40,17 @@ struct ClusteredBufferingOptions {
    double span_growth_threshold_fraction = 0.10;
 };
 
+/// Controls how many threads ingest the input (see `appendDataToTable`). The result is the same for
+/// every setting.
+struct IngestionParallelismOptions {
+   /// Threads that parse lines and diff their sequences against the local references, 0 uses one
+   /// per core. With 1 the input is ingested on the calling thread alone.
+   size_t num_parse_workers = 0;
+   /// Lines that a worker parses in one go. Larger batches synchronize less, but every queued batch
+   /// holds its raw lines in memory.
+   size_t lines_per_batch = 256;
+};
+
 class TableInserter {
    std::shared_ptr<storage::Table> table;
 
@@ -109,13 +120,34 @@ class TableInserter {
       const std::vector<SniffedField>& field_order_hint
    );
 
+   /// A row buffer for `parseInto`, which diffs sequences against the same local references as
+   /// the inserter does
+   [[nodiscard]] storage::ColumnGroupBuilder makeRowBuffer() const;
+
+   /// Parses one line into `rows` instead of the input buffer. Does not touch the table, so that
+   /// several threads can parse lines (and diff their sequences) at once.
+   [[nodiscard]] static std::expected<void, std::string> parseInto(
+      storage::ColumnGroupBuilder& rows,
+      simdjson::ondemand::document_reference ndjson_line,
+      const std::vector<SniffedField>& field_order_hint
+   );
+
+   /// Inserts the rows that were parsed into `rows` in their order, as if their lines had been
+   /// inserted one by one. Leaves `rows` empty.
+   [[nodiscard]] std::expected<void, std::string> insertRows(storage::ColumnGroupBuilder& rows);
+
    [[nodiscard]] Commit commit();
 };
 
+/// Appends every line of the input to the table. With several parse workers, a reader thread
+/// splits the input into line batches, the workers parse them and diff their sequences in
+/// parallel, and the calling thread inserts the parsed batches in input order (see
+/// `IngestionPipeline`), so rows end up in the same order as with a single thread.
 TableInserter::Commit appendDataToTable(
    std::shared_ptr<rhydb::storage::Table> table,
    NdjsonLineReader& input_data,
-   ClusteredBufferingOptions options = {}
+   ClusteredBufferingOptions options = {},
+   IngestionParallelismOptions parallelism = {}
 );
 
 }  // namespace rhydb::append
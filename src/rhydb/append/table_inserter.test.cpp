@@ -12,8 +12,10 @@
 #include <vector>
 
 #include <fmt/format.h>
+#include <gmock/gmock-matchers.h>
 #include <gtest/gtest.h>
 
+#include "rhydb/append/append_exception.h"
 #include "rhydb/append/ndjson_line_reader.h"
 #include "rhydb/common/nucleotide_symbols.h"
 #include "rhydb/schema/database_schema.h"
@@ -23,7 +25,9 @@
 
 using rhydb::Nucleotide;
 using rhydb::append::appendDataToTable;
+using rhydb::append::AppendException;
 using rhydb::append::ClusteredBufferingOptions;
+using rhydb::append::IngestionParallelismOptions;
 using rhydb::append::NdjsonLineReader;
 using rhydb::schema::ColumnIdentifier;
 using rhydb::schema::ColumnType;
@@ -97,11 +101,12 @@ ClusteredBufferingOptions clusteringOn(size_t num_buffers, double threshold_frac
 void appendRows(
    const std::shared_ptr<Table>& table,
    const std::string& ndjson,
-   ClusteredBufferingOptions options
+   ClusteredBufferingOptions options,
+   IngestionParallelismOptions parallelism = {}
 ) {
    std::stringstream input{ndjson};
    NdjsonLineReader reader{input};
-   appendDataToTable(table, reader, std::move(options));
+   appendDataToTable(table, reader, std::move(options), parallelism);
 }
 
 const rhydb::storage::column::HorizontalCoverageIndex& coverageIndex(const Table& table) {
@@ -121,6 +126,29 @@ std::vector<std::pair<uint32_t, uint32_t>> allRowRanges(const Table& table) {
    return ranges;
 }
 
+// The primary keys in row order.
+std::vector<std::string> primaryKeysInRowOrder(const Table& table) {
+   const auto& primary_key_column = table.columns.string_columns.at(std::string{PK_COLUMN});
+   std::vector<std::string> primary_keys;
+   for (const auto row_id : table.row_layout) {
+      primary_keys.push_back(primary_key_column.getValueString(row_id));
+   }
+   return primary_keys;
+}
+
+// More rows than fit into one chunk, with varying coverage and some null sequences.
+std::string rowsSpanningTwoChunks() {
+   constexpr size_t CHUNK_SIZE = rhydb::storage::column::COLUMN_CHUNK_SIZE;
+   std::string ndjson;
+   for (uint32_t i = 0; i < CHUNK_SIZE + 100; ++i) {
+      ndjson += row(
+         fmt::format("row-{}", i),
+         i % 7 == 0 ? std::nullopt : std::optional{coveredSequence(4, i % 3, 4 - (i % 2))}
+      );
+   }
+   return ndjson;
+}
+
 }  // namespace
 
 TEST(ClusteredBuffering, disjointRangesBeyondThresholdOpenSeparateChunks) {
@@ -234,3 +262,67 @@ TEST(ClusteredBuffering, disabledByDefaultKeepsSingleInOrderBuffer) {
 
    EXPECT_EQ(table->row_layout.numChunks(), 1);
 }
+
+TEST(ParallelIngestion, keepsTheRowOrderOfIngestingLineByLine) {
+   const std::string ndjson = rowsSpanningTwoChunks();
+
+   auto line_by_line = makeTable(4);
+   appendRows(line_by_line, ndjson, {}, {.num_parse_workers = 1});
+   auto parallel = makeTable(4);
+   appendRows(parallel, ndjson, {}, {.num_parse_workers = 4, .lines_per_batch = 7});
+
+   EXPECT_EQ(parallel->row_layout.numChunks(), 2);
+   EXPECT_EQ(parallel->row_layout.numChunks(), line_by_line->row_layout.numChunks());
+   EXPECT_EQ(primaryKeysInRowOrder(*parallel), primaryKeysInRowOrder(*line_by_line));
+   EXPECT_EQ(allRowRanges(*parallel), allRowRanges(*line_by_line));
+}
+
+TEST(ParallelIngestion, clustersLikeIngestingLineByLine) {
+   const std::string ndjson = rowsSpanningTwoChunks();
+
+   auto line_by_line = makeTable(4);
+   appendRows(line_by_line, ndjson, clusteringOn(2), {.num_parse_workers = 1});
+   auto parallel = makeTable(4);
+   appendRows(parallel, ndjson, clusteringOn(2), {.num_parse_workers = 3, .lines_per_batch = 5});
+
+   EXPECT_EQ(primaryKeysInRowOrder(*parallel), primaryKeysInRowOrder(*line_by_line));
+   EXPECT_EQ(allRowRanges(*parallel), allRowRanges(*line_by_line));
+}
+
+TEST(ParallelIngestion, reportsTheFirstInvalidLine) {
+   std::string ndjson;
+   for (size_t i = 0; i < 100; ++i) {
+      ndjson += row(fmt::format("row-{}", i), coveredSequence(4, 0, 4));
+      if (i == 42) {
+         ndjson += R"({"pk":4711,"seq":null})" "\n";
+      }
+      if (i == 87) {
+         ndjson += R"({"pk":"second invalid")" "\n";
+      }
+   }
+   auto table = makeTable(4);
+
+   EXPECT_THAT(
+      [&]() { appendRows(table, ndjson, {}, {.num_parse_workers = 4, .lines_per_batch = 3}); },
+      ThrowsMessage<AppendException>(::testing::HasSubstr(R"({"pk":4711,"seq":null})"))
+   );
+}
+
+TEST(TableInserter, rejectedChunkLeavesAllColumnsUnchanged) {
+   auto table = makeTable(4);
+   appendRows(table, row("first", coveredSequence(4, 0, 4)), ClusteredBufferingOptions{});
+
+   const std::string invalid_insertion =
+      R"({"pk":"second","seq":{"sequence":"AAAA","insertions":["100:ACGT"]}})"
+      "\n";
+   EXPECT_THAT(
+      [&]() { appendRows(table, invalid_insertion, ClusteredBufferingOptions{}); },
+      ThrowsMessage<AppendException>(::testing::HasSubstr("the insertion position (100)"))
+   );
+
+   EXPECT_EQ(table->sequence_count, 1);
+   EXPECT_EQ(table->row_layout.numChunks(), 1);
+   EXPECT_EQ(table->columns.string_columns.at(std::string{PK_COLUMN}).numChunks(), 1);
+   EXPECT_EQ(coverageIndex(*table).start_end.size(), 1);
+   EXPECT_EQ(primaryKeysInRowOrder(*table), std::vector<std::string>{"first"});
+}
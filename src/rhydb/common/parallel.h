@@ -73,4 +73,22 @@ void parallelFor(
    }
 }
 
+/// Runs `func(idx)` for every `idx < count`, on arrow's CPU pool unless this is one of its threads.
+/// A task of the pool must not wait for other tasks of the pool: once all threads wait, the tasks
+/// they wait for can never run.
+void forEachIndex(size_t count, std::invocable<size_t> auto&& func) {
+   auto* pool = arrow::internal::GetCpuThreadPool();
+   if (count < 2 || pool->GetCapacity() < 2 || pool->OwnsThisThread()) {
+      for (size_t idx = 0; idx < count; ++idx) {
+         func(idx);
+      }
+      return;
+   }
+   parallelFor(BlockedRange{0, count}, 1, [&](BlockedRange range) {
+      for (size_t idx = range.begin(); idx < range.end(); ++idx) {
+         func(idx);
+      }
+   });
+}
+
 }  // namespace rhydb::common
@@ -2,11 +2,12 @@
 
 #include <algorithm>
 #include <fstream>
-#include <limits>
-#include <set>
+#include <ranges>
+#include <span>
 #include <sstream>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include <fmt/ranges.h>
 #include <boost/archive/binary_iarchive.hpp>
@@ -55,6 +56,7 @@ void PhyloTree::load(Archive& archive, const unsigned int /*version*/) {
       archive >> *node;
       nodes.emplace(node_id, std::move(node));
    }
+   buildIndex();
 }
 
 template void PhyloTree::save<boost::archive::binary_oarchive>(
@@ -281,6 +283,7 @@ PhyloTree PhyloTree::fromAuspiceJSONString(const std::string& json_string) {
 
    PhyloTree file;
    auto root = parseAuspiceTree(json["tree"], std::nullopt, file.nodes);
+   file.buildIndex();
    return file;
 }
 
@@ -346,6 +349,7 @@ PhyloTree PhyloTree::fromNewickString(const std::string& newick_string) {
       );
    }
 
+   file.buildIndex();
    return file;
 }
 
@@ -401,110 +405,102 @@ std::optional<TreeNodeId> PhyloTree::getTreeNodeId(const std::string& node_label
    return node_id;
 }
 
-roaring::Roaring PhyloTree::getDescendants(const TreeNodeId& node_id) const {
-   auto child_it = nodes.find(node_id);
-   roaring::Roaring result_bitmap;
-   if (child_it == nodes.end() || !child_it->second) {
-      throw std::runtime_error(
-         fmt::format("Node '{}' is null - this is an internal error.", node_id.string)
+void PhyloTree::buildIndex() {
+   nodes_in_pre_order.clear();
+   if (nodes.empty()) {
+      index = PhyloTreeIndex{};
+      return;
+   }
+   nodes_in_pre_order.reserve(nodes.size());
+   auto root = std::ranges::find_if(nodes, [](const auto& entry) {
+      return !entry.second->parent.has_value();
+   });
+   SILO_ASSERT(root != nodes.end());
+
+   std::vector<uint32_t> parents;
+   parents.reserve(nodes.size());
+   // Iterative, the trees can be deeper than the stack allows recursion
+   std::vector<TreeNode*> stack{root->second.get()};
+   while (!stack.empty()) {
+      TreeNode* node = stack.back();
+      stack.pop_back();
+      node->index = static_cast<uint32_t>(nodes_in_pre_order.size());
+      nodes_in_pre_order.push_back(node);
+      parents.push_back(
+         node->parent.has_value() ? nodes.at(node->parent.value())->index : PhyloTreeIndex::NO_NODE
       );
-   }
-   std::function<void(const TreeNodeId&)> dfs = [&](const TreeNodeId& current) {
-      auto current_node = nodes.find(current);
-      if (!current_node->second) {
-         throw std::runtime_error(
-            fmt::format("Node '{}' is null - this is an internal error.", current.string)
-         );
+      // Reversed, so that the children keep their order in the pre-order numbering
+      for (const auto& child : std::ranges::reverse_view(node->children)) {
+         stack.push_back(nodes.at(child).get());
       }
-      if (current_node->second->isLeaf()) {
-         if (current_node->second->row_index.has_value()) {
-            result_bitmap.add(current_node->second->row_index.value());
-         }
-      }
-      for (const auto& child : current_node->second->children) {
-         dfs(child);
+   }
+   SILO_ASSERT_EQ(nodes_in_pre_order.size(), nodes.size());
+
+   index = PhyloTreeIndex{std::move(parents)};
+   for (const TreeNode* node : nodes_in_pre_order) {
+      if (node->row_index.has_value()) {
+         index.bindRow(node->index, static_cast<uint32_t>(node->row_index.value()));
       }
-   };
-   if (child_it->second->isLeaf()) {
-      return result_bitmap;
    }
-   dfs(node_id);
-   return result_bitmap;
 }
 
-void PhyloTree::getSetOfAncestorsAtDepth(
-   const std::set<TreeNodeId>& nodes_to_group,
-   std::set<TreeNodeId>& ancestors_at_depth,
-   int depth
-) const {
-   for (const auto& node_id : nodes_to_group) {
-      auto node_it = nodes.find(node_id);
-      while (node_it != nodes.end() && node_it->second->depth > depth) {
-         if (node_it->second->parent.has_value()) {
-            node_it = nodes.find(node_it->second->parent.value());
-         } else {
-            break;
-         }
-      }
-      if (node_it == nodes.end()) {
-         throw std::runtime_error(fmt::format("Node '{}' does not exist in tree.", node_id.string));
-      }
-      ancestors_at_depth.insert(node_it->first);
+void PhyloTree::setRowIndex(TreeNode& node, uint32_t row_id) {
+   node.row_index = row_id;
+   index.bindRow(node.index, row_id);
+}
+
+roaring::Roaring PhyloTree::getDescendants(const TreeNodeId& node_id) const {
+   auto node_it = nodes.find(node_id);
+   if (node_it == nodes.end() || !node_it->second) {
+      throw std::runtime_error(
+         fmt::format("Node '{}' is null - this is an internal error.", node_id.string)
+      );
    }
+   return index.rowsOfDescendantLeaves(node_it->second->index);
 }
 
-MRCAResponse PhyloTree::getMRCA(const std::unordered_set<std::string>& node_labels) const {
+MRCAResponse PhyloTree::mrcaOfIndexedNodes(std::span<const uint32_t> node_indices) const {
    MRCAResponse response;
-   std::set<TreeNodeId> nodes_to_group;
-   int min_depth = std::numeric_limits<int>::max();
+   const uint32_t mrca = index.lowestCommonAncestor(node_indices);
+   if (mrca == PhyloTreeIndex::NO_NODE) {
+      return response;
+   }
+   const TreeNode* mrca_node = nodes_in_pre_order.at(mrca);
+   response.mrca_node_id = mrca_node->node_id;
+   response.parent_id_of_mrca = mrca_node->parent;
+   response.mrca_depth = mrca_node->depth;
+   return response;
+}
 
+MRCAResponse PhyloTree::getMRCA(const std::unordered_set<std::string>& node_labels) const {
+   std::vector<uint32_t> node_indices;
+   std::vector<std::string> not_in_tree;
    for (const auto& node_label : node_labels) {
       auto node_it = nodes.find(TreeNodeId{node_label});
       if (node_it == nodes.end()) {
-         response.not_in_tree.push_back(node_label);
+         not_in_tree.push_back(node_label);
       } else {
-         nodes_to_group.insert(TreeNodeId{node_label});
-         min_depth = std::min(node_it->second->depth, min_depth);
+         node_indices.push_back(node_it->second->index);
       }
    }
+   MRCAResponse response = mrcaOfIndexedNodes(node_indices);
+   response.not_in_tree = std::move(not_in_tree);
    std::ranges::sort(response.not_in_tree);
-
-   if (nodes_to_group.empty()) {
-      response.mrca_node_id = std::nullopt;
-      response.parent_id_of_mrca = std::nullopt;
-      return response;
-   }
-
-   std::set<TreeNodeId> set_at_min_depth;
-   getSetOfAncestorsAtDepth(nodes_to_group, set_at_min_depth, min_depth);
-
-   while (set_at_min_depth.size() > 1) {
-      SILO_ASSERT(min_depth > 0);
-      min_depth--;
-      std::set<TreeNodeId> next_set_at_min_depth;
-      getSetOfAncestorsAtDepth(nodes_to_group, next_set_at_min_depth, min_depth);
-      set_at_min_depth = next_set_at_min_depth;
-   }
-   if (set_at_min_depth.empty()) {
-      throw std::runtime_error(
-         "No common ancestor found for the provided nodes. This is an internal error."
-      );
-   }
-
-   const TreeNodeId& mrca_node_id = *set_at_min_depth.begin();
-   SILO_ASSERT(nodes.contains(mrca_node_id));
-   const std::shared_ptr<TreeNode> mrca_node = nodes.find(mrca_node_id)->second;
-
-   response.mrca_node_id = mrca_node->node_id;
-   response.parent_id_of_mrca = mrca_node->parent;
-   response.mrca_depth = mrca_node->depth;
    return response;
 }
-namespace {
-bool isInFilter(const std::string& str, const std::unordered_set<std::string>& filter) {
-   return filter.contains(str);
+
+MRCAResponse PhyloTree::getMRCAOfRows(const roaring::Roaring& row_ids) const {
+   std::vector<uint32_t> node_indices;
+   node_indices.reserve(row_ids.cardinality());
+   for (const uint32_t row_id : row_ids) {
+      if (const auto node = index.nodeOfRow(row_id)) {
+         node_indices.push_back(node.value());
+      }
+   }
+   return mrcaOfIndexedNodes(node_indices);
 }
 
+namespace {
 std::string newickJoin(
    const std::vector<NewickFragment>& child_newick_strings,
    const std::string& self_id
@@ -548,50 +544,65 @@ std::optional<float> addBranchLengths(std::optional<float> left, std::optional<f
 }
 }  // namespace
 
-// NOLINTNEXTLINE(misc-no-recursion)
-NewickFragment PhyloTree::partialNewickString(
-   const std::unordered_set<std::string>& filter,
-   const TreeNodeId& ancestor,
+NewickResponse PhyloTree::newickStringOfIndexedNodes(
+   std::vector<uint32_t> node_indices,
    bool contract_unary_nodes
 ) const {
-   NewickFragment response;
-
-   auto node_it = nodes.find(ancestor);
-   SILO_ASSERT(node_it != nodes.end());
-   std::vector<NewickFragment> responses;
-   responses.reserve(node_it->second->children.size());
-   if (node_it->second->isLeaf()) {
-      if (isInFilter(ancestor.string, filter)) {
-         response.fragment = std::make_optional(ancestor.string);
-         response.branch_length = node_it->second->branch_length;
-      } else {
-         response.fragment = std::nullopt;
-         response.branch_length = std::nullopt;
-      }
+   NewickResponse response;
+   std::ranges::sort(node_indices);
+   const auto [duplicates_begin, duplicates_end] = std::ranges::unique(node_indices);
+   node_indices.erase(duplicates_begin, duplicates_end);
+   if (node_indices.empty()) {
+      response.newick_string = "";
       return response;
    }
-   for (const auto& child : node_it->second->children) {
-      responses.push_back(partialNewickString(filter, child, contract_unary_nodes));
-   }
-   std::erase_if(responses, [](const NewickFragment& resp) { return !resp.fragment.has_value(); });
-   if (responses.empty()) {
-      response.fragment = std::nullopt;
-      response.branch_length = std::nullopt;
+   if (node_indices.size() == 1) {
+      response.newick_string = nodes_in_pre_order.at(node_indices.front())->node_id.string + ";";
       return response;
    }
-   if (responses.size() == 1) {
-      if (contract_unary_nodes) {
-         response.fragment = responses[0].fragment;
-         response.branch_length =
-            addBranchLengths(responses[0].branch_length, node_it->second->branch_length);
-      } else {
-         response.fragment = newickJoin({responses[0]}, ancestor.string);
-         response.branch_length = node_it->second->branch_length;
+
+   // The MRCA will be the root of the subtree that contains all selected nodes. Its descendants
+   // are the pre-order interval after it, which is visited backwards so that every node comes
+   // after its children.
+   const uint32_t subtree_root = index.lowestCommonAncestor(node_indices);
+   const uint32_t subtree_end = index.subtreeEnd(subtree_root);
+   std::vector<bool> is_selected(subtree_end - subtree_root, false);
+   for (const uint32_t node : node_indices) {
+      is_selected.at(node - subtree_root) = true;
+   }
+   std::vector<NewickFragment> fragments(subtree_end - subtree_root);
+   for (uint32_t node = subtree_end; node-- > subtree_root;) {
+      const TreeNode& tree_node = *nodes_in_pre_order[node];
+      NewickFragment& fragment = fragments[node - subtree_root];
+      if (index.isLeaf(node)) {
+         if (is_selected[node - subtree_root]) {
+            fragment.fragment = tree_node.node_id.string;
+            fragment.branch_length = tree_node.branch_length;
+         }
+         continue;
       }
-      return response;
+      std::vector<NewickFragment> child_fragments;
+      for (uint32_t child = node + 1; child < index.subtreeEnd(node);
+           child = index.subtreeEnd(child)) {
+         if (fragments[child - subtree_root].fragment.has_value()) {
+            child_fragments.push_back(std::move(fragments[child - subtree_root]));
+         }
+      }
+      if (child_fragments.empty()) {
+         continue;
+      }
+      if (child_fragments.size() == 1 && contract_unary_nodes) {
+         fragment.fragment = std::move(child_fragments.front().fragment);
+         fragment.branch_length =
+            addBranchLengths(child_fragments.front().branch_length, tree_node.branch_length);
+         continue;
+      }
+      fragment.fragment = newickJoin(child_fragments, tree_node.node_id.string);
+      fragment.branch_length = tree_node.branch_length;
    }
-   response.fragment = newickJoin(responses, ancestor.string);
-   response.branch_length = node_it->second->branch_length;
+
+   SILO_ASSERT(fragments.front().fragment.has_value());
+   response.newick_string = fragments.front().fragment.value() + ";";
    return response;
 }
 
@@ -599,37 +610,35 @@ NewickResponse PhyloTree::toNewickString(
    const std::unordered_set<std::string>& filter,
    bool contract_unary_nodes
 ) const {
-   NewickResponse response;
-   std::unordered_set<std::string> filter_in_tree;
+   std::vector<uint32_t> node_indices;
+   std::vector<std::string> not_in_tree;
    for (const auto& node_label : filter) {
       auto node_it = nodes.find(TreeNodeId{node_label});
       if (node_it == nodes.end()) {
-         response.not_in_tree.push_back(node_label);
+         not_in_tree.push_back(node_label);
       } else {
-         filter_in_tree.insert(node_label);
+         node_indices.push_back(node_it->second->index);
       }
    }
+   NewickResponse response =
+      newickStringOfIndexedNodes(std::move(node_indices), contract_unary_nodes);
+   response.not_in_tree = std::move(not_in_tree);
    std::ranges::sort(response.not_in_tree);
-   if (filter_in_tree.empty()) {
-      response.newick_string = "";
-      return response;
-   }
-   if (filter_in_tree.size() == 1) {
-      response.newick_string = *filter_in_tree.begin() + ";";
-      return response;
-   }
-
-   // The MRCA will be the root of the subtree that contains all nodes in the filter.
-   MRCAResponse mrca = getMRCA(filter_in_tree);
-   SILO_ASSERT(mrca.mrca_node_id.has_value());
-   auto mrca_node = nodes.find(mrca.mrca_node_id.value());
-   SILO_ASSERT(mrca_node != nodes.end());
-
-   NewickFragment newick_string =
-      partialNewickString(filter_in_tree, mrca_node->first, contract_unary_nodes);
-   SILO_ASSERT(newick_string.fragment.has_value());
-   response.newick_string = newick_string.fragment.value() + ";";
    return response;
 }
 
+NewickResponse PhyloTree::toNewickStringOfRows(
+   const roaring::Roaring& row_ids,
+   bool contract_unary_nodes
+) const {
+   std::vector<uint32_t> node_indices;
+   node_indices.reserve(row_ids.cardinality());
+   for (const uint32_t row_id : row_ids) {
+      if (const auto node = index.nodeOfRow(row_id)) {
+         node_indices.push_back(node.value());
+      }
+   }
+   return newickStringOfIndexedNodes(std::move(node_indices), contract_unary_nodes);
+}
+
 }  // namespace rhydb::common
\ No newline at end of file
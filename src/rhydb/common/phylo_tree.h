@@ -1,7 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
-#include <set>
+#include <span>
 #include <unordered_set>
 #include <vector>
 
@@ -12,6 +13,7 @@
 
 #include <nlohmann/json.hpp>
 
+#include "rhydb/common/phylo_tree_index.h"
 #include "rhydb/common/tree_node_id.h"
 
 namespace rhydb::common {
@@ -26,6 +28,8 @@ class TreeNode {
    std::optional<TreeNodeId> parent;
    std::optional<float> branch_length;
    int depth;
+   /// The number of this node in the `PhyloTreeIndex` of its tree, not serialized
+   uint32_t index = PhyloTreeIndex::NO_NODE;
 
    [[nodiscard]] bool isLeaf() const { return children.empty(); }
    [[nodiscard]] bool rowIndexExists() const { return row_index.has_value(); }
@@ -71,6 +75,15 @@ class NewickResponse {
 };
 
 class PhyloTree {
+   PhyloTreeIndex index;
+   /// The nodes by their number in `index`
+   std::vector<TreeNode*> nodes_in_pre_order;
+
+   /// Numbers the nodes in pre-order and builds `index`, after parsing or loading the tree
+   void buildIndex();
+
+   [[nodiscard]] MRCAResponse mrcaOfIndexedNodes(std::span<const uint32_t> node_indices) const;
+
   public:
    std::unordered_map<TreeNodeId, std::shared_ptr<TreeNode>> nodes;
 
@@ -86,33 +99,45 @@ class PhyloTree {
 
    static PhyloTree fromFile(const std::filesystem::path& path);
 
+   /// Binds the node to the row of the table that has its label
+   void setRowIndex(TreeNode& node, uint32_t row_id);
+
    // Functions for querying the phylogenetic tree
 
    [[nodiscard]] std::optional<TreeNodeId> getTreeNodeId(const std::string& node_label) const;
 
+   /// Whether a node is bound to the row, see `setRowIndex`
+   [[nodiscard]] bool isRowInTree(uint32_t row_id) const {
+      return index.nodeOfRow(row_id).has_value();
+   }
+
    // returns a bitmap of all descendants node{node_id} that are also in the database
    [[nodiscard]] roaring::Roaring getDescendants(const TreeNodeId& node_id) const;
 
    [[nodiscard]] MRCAResponse getMRCA(const std::unordered_set<std::string>& node_labels) const;
 
+   /// The MRCA of the nodes bound to the rows, rows that are not bound to a node are skipped.
+   /// Only compares node numbers, the labels are not looked up.
+   [[nodiscard]] MRCAResponse getMRCAOfRows(const roaring::Roaring& row_ids) const;
+
    [[nodiscard]] NewickResponse toNewickString(
       const std::unordered_set<std::string>& filter,
       bool contract_unary_nodes = true
    ) const;
 
-   [[nodiscard]] NewickFragment partialNewickString(
-      const std::unordered_set<std::string>& filter,
-      const TreeNodeId& ancestor,
+   /// The subtree spanned by the nodes bound to the rows, rows that are not bound to a node are
+   /// skipped
+   [[nodiscard]] NewickResponse toNewickStringOfRows(
+      const roaring::Roaring& row_ids,
       bool contract_unary_nodes = true
    ) const;
 
-   void getSetOfAncestorsAtDepth(
-      const std::set<TreeNodeId>& nodes_to_group,
-      std::set<TreeNodeId>& ancestors_at_depth,
-      int depth
+  private:
+   [[nodiscard]] NewickResponse newickStringOfIndexedNodes(
+      std::vector<uint32_t> node_indices,
+      bool contract_unary_nodes
    ) const;
 
-  private:
    friend class boost::serialization::access;
    template <class Archive>
    void save(Archive& archive, unsigned int version) const;
@@ -379,3 +379,21 @@ TEST(PhyloTree, correctlyReturnsSubTreeNewickWithContractUnaryNodesWithBranchLen
    auto subtree_one_node = phylo_tree.toNewickString({"A1.1"}, true).newick_string;
    ASSERT_EQ(subtree_one_node, "A1.1;");
 }
+
+TEST(PhyloTree, answersQueriesOverBoundRows) {
+   auto phylo_tree =
+      PhyloTree::fromNewickString("(((A1.1, A1.2)A1,(A2.1)A2)A,(B1,(B2.1,B2.2)B2)B)R;");
+   uint32_t row_id = 0;
+   for (const auto* label : {"A1.1", "A1.2", "A2.1", "B1", "B2.1", "B2.2"}) {
+      phylo_tree.setRowIndex(*phylo_tree.nodes.at(TreeNodeId{label}), row_id++);
+   }
+
+   EXPECT_TRUE(phylo_tree.isRowInTree(5));
+   EXPECT_FALSE(phylo_tree.isRowInTree(6));
+   EXPECT_EQ(phylo_tree.getMRCAOfRows({0, 2}).mrca_node_id, TreeNodeId{"A"});
+   EXPECT_EQ(phylo_tree.getMRCAOfRows({4, 5, 6}).mrca_node_id, TreeNodeId{"B2"});
+   EXPECT_EQ(phylo_tree.getMRCAOfRows({6}).mrca_node_id, std::nullopt);
+   EXPECT_EQ(phylo_tree.toNewickStringOfRows({0, 1, 2}).newick_string, "((A1.1,A1.2)A1,A2.1)A;");
+   EXPECT_EQ(phylo_tree.toNewickStringOfRows({3, 4}, false).newick_string, "(B1,(B2.1)B2)B;");
+   EXPECT_EQ(phylo_tree.getDescendants(TreeNodeId{"B"}), roaring::Roaring({3, 4, 5}));
+}
@@ -0,0 +1,154 @@
+#include "rhydb/common/phylo_tree_index.h"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+#include "rhydb/common/panic.h"
+
+namespace rhydb::common {
+
+PhyloTreeIndex::PhyloTreeIndex(std::vector<uint32_t> parents)
+    : parents(std::move(parents)) {
+   const size_t num_nodes = this->parents.size();
+   SILO_ASSERT_LT(num_nodes, NO_NODE);
+   depths.resize(num_nodes, 0);
+   subtree_ends.resize(num_nodes);
+   node_rows.resize(num_nodes, NO_ROW);
+   if (num_nodes == 0) {
+      return;
+   }
+   SILO_ASSERT(this->parents[0] == NO_NODE);
+   for (uint32_t node = 1; node < num_nodes; ++node) {
+      // In pre-order every parent comes before its children
+      SILO_ASSERT_LT(this->parents[node], node);
+      depths[node] = depths[this->parents[node]] + 1;
+   }
+   for (uint32_t node = 0; node < num_nodes; ++node) {
+      subtree_ends[node] = node + 1;
+   }
+   for (auto node = static_cast<uint32_t>(num_nodes - 1); node > 0; --node) {
+      auto& parent_end = subtree_ends[this->parents[node]];
+      parent_end = std::max(parent_end, subtree_ends[node]);
+   }
+   buildEulerTour();
+}
+
+void PhyloTreeIndex::buildEulerTour() {
+   const auto num_nodes = static_cast<uint32_t>(parents.size());
+   euler_tour.reserve((2 * num_nodes) - 1);
+   first_euler_positions.resize(num_nodes);
+
+   // The path from the root to the current node
+   std::vector<uint32_t> path{0};
+   first_euler_positions[0] = 0;
+   euler_tour.push_back(0);
+   for (uint32_t node = 1; node < num_nodes; ++node) {
+      while (path.back() != parents[node]) {
+         path.pop_back();
+         euler_tour.push_back(path.back());
+      }
+      first_euler_positions[node] = static_cast<uint32_t>(euler_tour.size());
+      euler_tour.push_back(node);
+      path.push_back(node);
+   }
+   while (path.size() > 1) {
+      path.pop_back();
+      euler_tour.push_back(path.back());
+   }
+
+   const size_t num_blocks = (euler_tour.size() + EULER_BLOCK_SIZE - 1) / EULER_BLOCK_SIZE;
+   auto& first_level = block_minima.emplace_back(num_blocks);
+   for (size_t block = 0; block < num_blocks; ++block) {
+      const size_t begin = block * EULER_BLOCK_SIZE;
+      const size_t end = std::min(begin + EULER_BLOCK_SIZE, euler_tour.size());
+      uint32_t shallowest = euler_tour[begin];
+      for (size_t position = begin + 1; position < end; ++position) {
+         shallowest = shallower(shallowest, euler_tour[position]);
+      }
+      first_level[block] = shallowest;
+   }
+   for (size_t span = 2; span <= num_blocks; span *= 2) {
+      const auto& previous_level = block_minima.back();
+      std::vector<uint32_t> level(num_blocks - span + 1);
+      for (size_t block = 0; block < level.size(); ++block) {
+         level[block] = shallower(previous_level[block], previous_level[block + (span / 2)]);
+      }
+      block_minima.push_back(std::move(level));
+   }
+}
+
+uint32_t PhyloTreeIndex::shallowestInEulerTour(size_t first, size_t last) const {
+   const size_t first_block = first / EULER_BLOCK_SIZE;
+   const size_t last_block = last / EULER_BLOCK_SIZE;
+   uint32_t shallowest = euler_tour[first];
+   if (first_block == last_block) {
+      for (size_t position = first + 1; position <= last; ++position) {
+         shallowest = shallower(shallowest, euler_tour[position]);
+      }
+      return shallowest;
+   }
+   for (size_t position = first + 1; position < (first_block + 1) * EULER_BLOCK_SIZE;
+        ++position) {
+      shallowest = shallower(shallowest, euler_tour[position]);
+   }
+   for (size_t position = last_block * EULER_BLOCK_SIZE; position <= last; ++position) {
+      shallowest = shallower(shallowest, euler_tour[position]);
+   }
+   if (first_block + 1 < last_block) {
+      const size_t num_blocks = last_block - first_block - 1;
+      const auto level = static_cast<size_t>(std::bit_width(num_blocks) - 1);
+      const auto& minima = block_minima[level];
+      shallowest = shallower(shallowest, minima[first_block + 1]);
+      shallowest = shallower(shallowest, minima[last_block - (size_t{1} << level)]);
+   }
+   return shallowest;
+}
+
+uint32_t PhyloTreeIndex::lowestCommonAncestor(uint32_t left, uint32_t right) const {
+   size_t first = first_euler_positions[left];
+   size_t last = first_euler_positions[right];
+   if (first > last) {
+      std::swap(first, last);
+   }
+   return shallowestInEulerTour(first, last);
+}
+
+uint32_t PhyloTreeIndex::lowestCommonAncestor(std::span<const uint32_t> nodes) const {
+   if (nodes.empty()) {
+      return NO_NODE;
+   }
+   uint32_t ancestor = nodes.front();
+   for (const uint32_t node : nodes.subspan(1)) {
+      // Nothing is above the root
+      if (ancestor == 0) {
+         break;
+      }
+      ancestor = lowestCommonAncestor(ancestor, node);
+   }
+   return ancestor;
+}
+
+void PhyloTreeIndex::bindRow(uint32_t node, uint32_t row_id) {
+   SILO_ASSERT_LT(row_id, NO_ROW);
+   if (row_id >= row_nodes.size()) {
+      row_nodes.resize(static_cast<size_t>(row_id) + 1, NO_NODE);
+   }
+   node_rows[node] = row_id;
+   row_nodes[row_id] = node;
+}
+
+roaring::Roaring PhyloTreeIndex::rowsOfDescendantLeaves(uint32_t node) const {
+   std::vector<uint32_t> rows;
+   for (uint32_t descendant = node + 1; descendant < subtree_ends[node]; ++descendant) {
+      if (isLeaf(descendant) && node_rows[descendant] != NO_ROW) {
+         rows.push_back(node_rows[descendant]);
+      }
+   }
+   std::ranges::sort(rows);
+   roaring::Roaring result;
+   result.addMany(rows.size(), rows.data());
+   return result;
+}
+
+}  // namespace rhydb::common
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <roaring/roaring.hh>
+
+namespace rhydb::common {
+
+/// The topology of a phylogenetic tree in flat arrays, so that queries over many nodes neither
+/// follow pointers nor hash labels. The nodes are numbered in DFS pre-order: the descendants of a
+/// node are the nodes in `(node, subtreeEnd(node))`, the first child of an inner node is
+/// `node + 1` and the next sibling of a child `child` is `subtreeEnd(child)`.
+///
+/// The lowest common ancestor of two nodes is the shallowest node between their first occurrences
+/// in the Euler tour of the tree. It is found with a sparse table over blocks of the tour and a
+/// scan of at most two partial blocks, which keeps the table small for trees with millions of
+/// nodes.
+class PhyloTreeIndex {
+  public:
+   static constexpr uint32_t NO_NODE = std::numeric_limits<uint32_t>::max();
+   static constexpr uint32_t NO_ROW = std::numeric_limits<uint32_t>::max();
+
+  private:
+   static constexpr size_t EULER_BLOCK_SIZE = 32;
+
+   std::vector<uint32_t> parents;
+   std::vector<uint32_t> subtree_ends;
+   std::vector<uint32_t> depths;
+
+   std::vector<uint32_t> euler_tour;
+   std::vector<uint32_t> first_euler_positions;
+   /// `block_minima[level][block]` is the shallowest node of the `2^level` blocks of the Euler
+   /// tour that start at `block`
+   std::vector<std::vector<uint32_t>> block_minima;
+
+   /// The row bound to each node, `NO_ROW` if none is
+   std::vector<uint32_t> node_rows;
+   /// The node bound to each global row id, `NO_NODE` if none is
+   std::vector<uint32_t> row_nodes;
+
+   [[nodiscard]] uint32_t shallower(uint32_t left, uint32_t right) const {
+      return depths[right] < depths[left] ? right : left;
+   }
+
+   /// The shallowest node of the Euler tour in `[first, last]`
+   [[nodiscard]] uint32_t shallowestInEulerTour(size_t first, size_t last) const;
+
+   void buildEulerTour();
+
+  public:
+   PhyloTreeIndex() = default;
+
+   /// `parents[node]` is the parent of every node in pre-order, `NO_NODE` for the root, which is
+   /// the first node
+   explicit PhyloTreeIndex(std::vector<uint32_t> parents);
+
+   [[nodiscard]] size_t numNodes() const { return parents.size(); }
+
+   [[nodiscard]] uint32_t parent(uint32_t node) const { return parents[node]; }
+
+   [[nodiscard]] uint32_t depth(uint32_t node) const { return depths[node]; }
+
+   /// The first node after `node` in pre-order that is not one of its descendants
+   [[nodiscard]] uint32_t subtreeEnd(uint32_t node) const { return subtree_ends[node]; }
+
+   [[nodiscard]] bool isLeaf(uint32_t node) const { return subtree_ends[node] == node + 1; }
+
+   [[nodiscard]] uint32_t lowestCommonAncestor(uint32_t left, uint32_t right) const;
+
+   /// `NO_NODE` if `nodes` is empty
+   [[nodiscard]] uint32_t lowestCommonAncestor(std::span<const uint32_t> nodes) const;
+
+   void bindRow(uint32_t node, uint32_t row_id);
+
+   [[nodiscard]] std::optional<uint32_t> nodeOfRow(uint32_t row_id) const {
+      if (row_id >= row_nodes.size() || row_nodes[row_id] == NO_NODE) {
+         return std::nullopt;
+      }
+      return row_nodes[row_id];
+   }
+
+   /// The rows bound to the leaves below `node`, one pass over its pre-order interval
+   [[nodiscard]] roaring::Roaring rowsOfDescendantLeaves(uint32_t node) const;
+};
+
+}  // namespace rhydb::common
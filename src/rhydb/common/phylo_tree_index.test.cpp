@@ -0,0 +1,87 @@
+#include "rhydb/common/phylo_tree_index.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using rhydb::common::PhyloTreeIndex;
+
+namespace {
+// A random tree in pre-order: every node is attached to a node on the path to its predecessor
+std::vector<uint32_t> randomPreOrderParents(uint32_t num_nodes, uint32_t seed) {
+   std::mt19937 generator{seed};
+   std::vector<uint32_t> parents{PhyloTreeIndex::NO_NODE};
+   std::vector<uint32_t> path{0};
+   for (uint32_t node = 1; node < num_nodes; ++node) {
+      std::uniform_int_distribution<size_t> path_length{1, path.size()};
+      path.resize(path_length(generator));
+      parents.push_back(path.back());
+      path.push_back(node);
+   }
+   return parents;
+}
+
+uint32_t naiveLowestCommonAncestor(const PhyloTreeIndex& index, uint32_t left, uint32_t right) {
+   while (index.depth(left) > index.depth(right)) {
+      left = index.parent(left);
+   }
+   while (index.depth(right) > index.depth(left)) {
+      right = index.parent(right);
+   }
+   while (left != right) {
+      left = index.parent(left);
+      right = index.parent(right);
+   }
+   return left;
+}
+}  // namespace
+
+TEST(PhyloTreeIndex, lowestCommonAncestorMatchesWalkingUpTheTree) {
+   const PhyloTreeIndex under_test{randomPreOrderParents(5000, 42)};
+
+   std::mt19937 generator{7};
+   std::uniform_int_distribution<uint32_t> random_node{0, 4999};
+   for (int i = 0; i < 10000; ++i) {
+      const uint32_t left = random_node(generator);
+      const uint32_t right = random_node(generator);
+      ASSERT_EQ(
+         under_test.lowestCommonAncestor(left, right),
+         naiveLowestCommonAncestor(under_test, left, right)
+      );
+   }
+}
+
+TEST(PhyloTreeIndex, descendantsAreThePreOrderInterval) {
+   // 0 -> (1 -> (2, 3), 4 -> (5))
+   const PhyloTreeIndex under_test{{PhyloTreeIndex::NO_NODE, 0, 1, 1, 0, 4}};
+
+   EXPECT_EQ(under_test.subtreeEnd(0), 6);
+   EXPECT_EQ(under_test.subtreeEnd(1), 4);
+   EXPECT_EQ(under_test.subtreeEnd(4), 6);
+   EXPECT_TRUE(under_test.isLeaf(2));
+   EXPECT_FALSE(under_test.isLeaf(4));
+   EXPECT_EQ(under_test.depth(5), 2);
+
+   const std::vector<uint32_t> cousins{2, 3, 5};
+   EXPECT_EQ(under_test.lowestCommonAncestor(cousins), 0);
+   const std::vector<uint32_t> siblings{3, 2};
+   EXPECT_EQ(under_test.lowestCommonAncestor(siblings), 1);
+   EXPECT_EQ(under_test.lowestCommonAncestor(std::vector<uint32_t>{}), PhyloTreeIndex::NO_NODE);
+}
+
+TEST(PhyloTreeIndex, returnsTheRowsOfTheLeavesBelowANode) {
+   PhyloTreeIndex under_test{{PhyloTreeIndex::NO_NODE, 0, 1, 1, 0, 4}};
+   under_test.bindRow(2, 70000);
+   under_test.bindRow(3, 5);
+   under_test.bindRow(5, 6);
+   // Inner nodes do not contribute their rows
+   under_test.bindRow(4, 7);
+
+   EXPECT_EQ(under_test.rowsOfDescendantLeaves(1), roaring::Roaring({5, 70000}));
+   EXPECT_EQ(under_test.rowsOfDescendantLeaves(0), roaring::Roaring({5, 6, 70000}));
+   EXPECT_EQ(under_test.rowsOfDescendantLeaves(3), roaring::Roaring{});
+   EXPECT_EQ(under_test.nodeOfRow(70000), 2);
+   EXPECT_EQ(under_test.nodeOfRow(8), std::nullopt);
+}
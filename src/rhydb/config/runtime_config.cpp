@@ -42,9 +42,51 @@ ConfigKeyPath apiEstimatedStartupTimeOptionKey() {
 ConfigKeyPath softMemoryLimitOptionKey() {
    return YamlFile::stringToConfigKeyPath("api.softMemoryLimit");
 }
+ConfigKeyPath apiTableScanThreadsOptionKey() {
+   return YamlFile::stringToConfigKeyPath("api.threadsForTableScans");
+}
+ConfigKeyPath apiMemoryMappedLoadOptionKey() {
+   return YamlFile::stringToConfigKeyPath("api.memoryMappedLoad");
+}
+ConfigKeyPath apiQueryResultCacheSizeOptionKey() {
+   return YamlFile::stringToConfigKeyPath("api.queryResultCacheSizeInMegabytes");
+}
+ConfigKeyPath apiFilterBitmapCacheSizeOptionKey() {
+   return YamlFile::stringToConfigKeyPath("api.filterBitmapCacheSizeInMegabytes");
+}
+ConfigKeyPath apiMaxRunningCheapQueriesOptionKey() {
+   return YamlFile::stringToConfigKeyPath("api.maxRunningCheapQueries");
+}
+ConfigKeyPath apiMaxRunningHeavyQueriesOptionKey() {
+   return YamlFile::stringToConfigKeyPath("api.maxRunningHeavyQueries");
+}
+ConfigKeyPath apiMaxQueuedQueriesPerLaneOptionKey() {
+   return YamlFile::stringToConfigKeyPath("api.maxQueuedQueriesPerLane");
+}
+ConfigKeyPath apiHeavyQueryThresholdOptionKey() {
+   return YamlFile::stringToConfigKeyPath("api.heavyQueryThresholdInMegabytes");
+}
+ConfigKeyPath apiQueryMemoryBudgetOptionKey() {
+   return YamlFile::stringToConfigKeyPath("api.queryMemoryBudgetInMegabytes");
+}
+ConfigKeyPath apiMaxQueryQueueTimeOptionKey() {
+   return YamlFile::stringToConfigKeyPath("api.maxQueryQueueTimeInSeconds");
+}
+ConfigKeyPath apiResponseBufferSizeOptionKey() {
+   return YamlFile::stringToConfigKeyPath("api.responseBufferSizeInMegabytes");
+}
+ConfigKeyPath apiResponseSendTimeoutOptionKey() {
+   return YamlFile::stringToConfigKeyPath("api.responseSendTimeoutInSeconds");
+}
 ConfigKeyPath queryMaterializationOptionKey() {
    return YamlFile::stringToConfigKeyPath("query.materializationCutoff");
 }
+ConfigKeyPath queryTableScanPrefetchOptionKey() {
+   return YamlFile::stringToConfigKeyPath("query.tableScanPrefetchBatches");
+}
+ConfigKeyPath queryTableScanParallelismOptionKey() {
+   return YamlFile::stringToConfigKeyPath("query.tableScanParallelism");
+}
 
 }  // namespace
 
@@ -105,6 +147,86 @@ ConfigSpecification RuntimeConfig::getConfigSpecification() {
                "this value, malloc_trim is called. \n"
                "Only supported on Linux."
             ),
+            ConfigAttributeSpecification::createWithDefault(
+               apiTableScanThreadsOptionKey(),
+               ConfigValue::fromInt32(0),
+               "The number of threads that produce the result rows of table scans, shared by \n"
+               "all queries. If set to 0 it will be set to the number of processors."
+            ),
+            ConfigAttributeSpecification::createWithDefault(
+               apiMemoryMappedLoadOptionKey(),
+               ConfigValue::fromBool(false),
+               "Memory-map the column files of a data version instead of copying them into \n"
+               "memory. Loading is faster, the files' pages are shared with other processes \n"
+               "that map them, and they are only read from disk when queries access them."
+            ),
+            ConfigAttributeSpecification::createWithDefault(
+               apiQueryResultCacheSizeOptionKey(),
+               ConfigValue::fromUint32(64),
+               "The memory in megabytes for the responses of recent queries, which are sent \n"
+               "again without executing the query until a new data version is loaded. \n"
+               "Responses larger than an eighth of it are not cached. 0 disables the cache."
+            ),
+            ConfigAttributeSpecification::createWithDefault(
+               apiFilterBitmapCacheSizeOptionKey(),
+               ConfigValue::fromUint32(64),
+               "The memory in megabytes for the evaluated filters of recent queries, which \n"
+               "later queries with the same filters or parts of them reuse. Only filters \n"
+               "that took long to evaluate for their size are cached. 0 disables the cache."
+            ),
+            ConfigAttributeSpecification::createWithDefault(
+               apiMaxRunningCheapQueriesOptionKey(),
+               ConfigValue::fromUint32(0),
+               "The maximum number of cheap queries that are executed at the same time. \n"
+               "Further queries wait in the queue of their lane. If set to 0, only the \n"
+               "worker threads limit them."
+            ),
+            ConfigAttributeSpecification::createWithDefault(
+               apiMaxRunningHeavyQueriesOptionKey(),
+               ConfigValue::fromUint32(2),
+               "The maximum number of heavy queries that are executed at the same time, \n"
+               "i.e. queries that return sequences or are estimated to materialize more \n"
+               "than api.heavyQueryThresholdInMegabytes. If set to 0, there is no limit."
+            ),
+            ConfigAttributeSpecification::createWithDefault(
+               apiMaxQueuedQueriesPerLaneOptionKey(),
+               ConfigValue::fromUint32(16),
+               "The maximum number of queries that wait for a free slot in the cheap and \n"
+               "in the heavy lane each. Further queries are rejected with a 503 error."
+            ),
+            ConfigAttributeSpecification::createWithDefault(
+               apiHeavyQueryThresholdOptionKey(),
+               ConfigValue::fromUint32(256),
+               "Queries whose result is estimated to take at least this many megabytes \n"
+               "are heavy."
+            ),
+            ConfigAttributeSpecification::createWithDefault(
+               apiQueryMemoryBudgetOptionKey(),
+               ConfigValue::fromUint32(0),
+               "The memory in megabytes that the results of all running queries may take. \n"
+               "Heavy queries wait while their estimate does not fit, and queries fail \n"
+               "when they exceed it. 0 disables the budget."
+            ),
+            ConfigAttributeSpecification::createWithDefault(
+               apiMaxQueryQueueTimeOptionKey(),
+               ConfigValue::fromUint32(60),
+               "The maximum time in seconds that a query waits for a free slot in its \n"
+               "lane before it is rejected with a 503 error."
+            ),
+            ConfigAttributeSpecification::createWithDefault(
+               apiResponseBufferSizeOptionKey(),
+               ConfigValue::fromUint32(16),
+               "The memory in megabytes that buffers the result of a query while it is sent. \n"
+               "Results are sent by a separate thread, so that the worker thread and the \n"
+               "query are released as soon as the result is produced, and the query is \n"
+               "paused while the buffer is full. 0 sends results on the worker threads."
+            ),
+            ConfigAttributeSpecification::createWithDefault(
+               apiResponseSendTimeoutOptionKey(),
+               ConfigValue::fromUint32(120),
+               "The time in seconds after which the connection to a client that does not \n"
+               "receive any bytes of its result is closed."
+            ),
             ConfigAttributeSpecification::createWithDefault(
                queryMaterializationOptionKey(),
                ConfigValue::fromUint32(DEFAULT_ARROW_BATCH_SIZE),
@@ -112,6 +234,19 @@ ConfigSpecification RuntimeConfig::getConfigSpecification() {
                "in memory before sending it to the client. If it affects more rows, \n"
                "it will be streamed by constructing the result items lazily."
             ),
+            ConfigAttributeSpecification::createWithDefault(
+               queryTableScanPrefetchOptionKey(),
+               ConfigValue::fromUint32(2),
+               "The number of result batches that a table scan produces ahead, while the \n"
+               "current batch is still being sent to the client."
+            ),
+            ConfigAttributeSpecification::createWithDefault(
+               queryTableScanParallelismOptionKey(),
+               ConfigValue::fromUint32(2),
+               "The maximum number of result batches of a single table scan that are \n"
+               "produced at the same time. Limits the share of the table scan threads \n"
+               "that one query can occupy."
+            ),
          }
    };
 }
@@ -160,9 +295,51 @@ void RuntimeConfig::overwriteFrom(const VerifiedConfigAttributes& config_source)
    if (auto var = config_source.getUint32(softMemoryLimitOptionKey())) {
       api_options.soft_memory_limit = var.value();
    }
+   if (auto var = config_source.getInt32(apiTableScanThreadsOptionKey())) {
+      api_options.table_scan_threads = var.value();
+   }
+   if (auto var = config_source.getBool(apiMemoryMappedLoadOptionKey())) {
+      api_options.memory_mapped_load = var.value();
+   }
+   if (auto var = config_source.getUint32(apiQueryResultCacheSizeOptionKey())) {
+      api_options.query_result_cache_size_in_megabytes = var.value();
+   }
+   if (auto var = config_source.getUint32(apiFilterBitmapCacheSizeOptionKey())) {
+      api_options.filter_bitmap_cache_size_in_megabytes = var.value();
+   }
+   if (auto var = config_source.getUint32(apiMaxRunningCheapQueriesOptionKey())) {
+      api_options.max_running_cheap_queries = var.value();
+   }
+   if (auto var = config_source.getUint32(apiMaxRunningHeavyQueriesOptionKey())) {
+      api_options.max_running_heavy_queries = var.value();
+   }
+   if (auto var = config_source.getUint32(apiMaxQueuedQueriesPerLaneOptionKey())) {
+      api_options.max_queued_queries_per_lane = var.value();
+   }
+   if (auto var = config_source.getUint32(apiHeavyQueryThresholdOptionKey())) {
+      api_options.heavy_query_threshold_in_megabytes = var.value();
+   }
+   if (auto var = config_source.getUint32(apiQueryMemoryBudgetOptionKey())) {
+      api_options.query_memory_budget_in_megabytes = var.value();
+   }
+   if (auto var = config_source.getUint32(apiMaxQueryQueueTimeOptionKey())) {
+      api_options.max_query_queue_time_in_seconds = var.value();
+   }
+   if (auto var = config_source.getUint32(apiResponseBufferSizeOptionKey())) {
+      api_options.response_buffer_size_in_megabytes = var.value();
+   }
+   if (auto var = config_source.getUint32(apiResponseSendTimeoutOptionKey())) {
+      api_options.response_send_timeout_in_seconds = var.value();
+   }
    if (auto var = config_source.getUint32(queryMaterializationOptionKey())) {
       query_options.materialization_cutoff = var.value();
    }
+   if (auto var = config_source.getUint32(queryTableScanPrefetchOptionKey())) {
+      query_options.table_scan_prefetch_batches = var.value();
+   }
+   if (auto var = config_source.getUint32(queryTableScanParallelismOptionKey())) {
+      query_options.table_scan_parallelism = var.value();
+   }
 }
 
 }  // namespace rhydb::config
@@ -174,10 +351,27 @@ NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
    max_connections,
    parallel_threads,
    port,
-   estimated_startup_end
+   estimated_startup_end,
+   table_scan_threads,
+   memory_mapped_load,
+   query_result_cache_size_in_megabytes,
+   filter_bitmap_cache_size_in_megabytes,
+   max_running_cheap_queries,
+   max_running_heavy_queries,
+   max_queued_queries_per_lane,
+   heavy_query_threshold_in_megabytes,
+   query_memory_budget_in_megabytes,
+   max_query_queue_time_in_seconds,
+   response_buffer_size_in_megabytes,
+   response_send_timeout_in_seconds
 )
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(rhydb::config::QueryOptions, materialization_cutoff)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
+   rhydb::config::QueryOptions,
+   materialization_cutoff,
+   table_scan_prefetch_batches,
+   table_scan_parallelism
+)
 
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
    rhydb::config::RuntimeConfig,
@@ -17,11 +17,25 @@ class ApiOptions {
    std::optional<std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds>>
       estimated_startup_end;
    uint32_t soft_memory_limit;
+   int32_t table_scan_threads;
+   bool memory_mapped_load = false;
+   uint32_t query_result_cache_size_in_megabytes = 0;
+   uint32_t filter_bitmap_cache_size_in_megabytes = 0;
+   uint32_t max_running_cheap_queries = 0;
+   uint32_t max_running_heavy_queries = 2;
+   uint32_t max_queued_queries_per_lane = 16;
+   uint32_t heavy_query_threshold_in_megabytes = 256;
+   uint32_t query_memory_budget_in_megabytes = 0;
+   uint32_t max_query_queue_time_in_seconds = 60;
+   uint32_t response_buffer_size_in_megabytes = 0;
+   uint32_t response_send_timeout_in_seconds = 120;
 };
 
 class QueryOptions {
   public:
    size_t materialization_cutoff;
+   size_t table_scan_prefetch_batches = 2;
+   size_t table_scan_parallelism = 2;
 };
 
 class RuntimeConfig {
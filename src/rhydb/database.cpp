@@ -1,5 +1,7 @@
 #include "rhydb/database.h"
 
+#include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <map>
@@ -13,6 +15,7 @@
 #include <arrow/io/memory.h>
 #include <arrow/ipc/writer.h>
 #include <fmt/format.h>
+#include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 
 #include "rhydb/append/table_inserter.h"
@@ -293,6 +296,11 @@ void Database::updateColumn(
       );
    }
    auto& table = *maybe_table->second;
+   if (table.isMemoryMapped()) {
+      throw query_engine::IllegalQueryException(
+         fmt::format("The table '{}' was loaded memory-mapped and cannot be updated", table_name)
+      );
+   }
 
    const auto column = table.schema->getColumn(column_name);
    if (!column.has_value()) {
@@ -342,6 +350,14 @@ DatabaseInfo Database::getDatabaseInfo() const {
    return database_info;
 }
 
+nlohmann::json Database::getChunkStatistics() const {
+   nlohmann::json chunk_statistics = nlohmann::json::object();
+   for (const auto& [table_name, table] : tables) {
+      chunk_statistics[table_name.getName()] = table->getChunkStatistics();
+   }
+   return chunk_statistics;
+}
+
 const std::string DATABASE_SCHEMA_FILENAME = "database_schema.silo";
 const std::string DATA_VERSION_FILENAME = "data_version.silo";
 
@@ -423,8 +439,15 @@ std::optional<Database> Database::loadDatabaseStateFromPath(
    return std::nullopt;
 }
 
-Database Database::loadDatabaseState(const rhydb::RhyDBDataSource& silo_data_source) {
-   SPDLOG_INFO("Loading database from data source: {}", silo_data_source.toDebugString());
+Database Database::loadDatabaseState(
+   const rhydb::RhyDBDataSource& silo_data_source,
+   persistence::LoadMode load_mode
+) {
+   SPDLOG_INFO(
+      "Loading database {}from data source: {}",
+      load_mode == persistence::LoadMode::MEMORY_MAPPED ? "memory-mapped " : "",
+      silo_data_source.toDebugString()
+   );
    const auto save_directory = silo_data_source.path;
 
    const auto database_schema_path = save_directory / DATABASE_SCHEMA_FILENAME;
@@ -434,7 +457,31 @@ Database Database::loadDatabaseState(const rhydb::RhyDBDataSource& silo_data_sou
 
    for (const auto& [table_name, _] : schema.tables) {
       SPDLOG_DEBUG("Loading data for table {}", table_name.getName());
-      database.tables.at(table_name)->loadData(save_directory / (table_name.getName() + ".silo"));
+      const auto start = std::chrono::steady_clock::now();
+      const auto column_statistics = database.tables.at(table_name)->loadData(
+         save_directory / (table_name.getName() + ".silo"), load_mode
+      );
+      const auto table_duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+         std::chrono::steady_clock::now() - start
+      );
+      uint64_t table_size_in_bytes = 0;
+      for (const auto& column : column_statistics) {
+         table_size_in_bytes += column.size_in_bytes;
+         SPDLOG_INFO(
+            "Loaded column '{}' of table '{}' ({} bytes) in {} ms",
+            column.column.name,
+            table_name.getName(),
+            column.size_in_bytes,
+            std::chrono::duration_cast<std::chrono::milliseconds>(column.duration).count()
+         );
+      }
+      SPDLOG_INFO(
+         "Loaded table '{}' ({} columns, {} bytes) in {} ms",
+         table_name.getName(),
+         column_statistics.size(),
+         table_size_in_bytes,
+         table_duration.count()
+      );
    }
 
    database.data_version_ = loadDataVersion(save_directory / DATA_VERSION_FILENAME);
@@ -453,6 +500,9 @@ DataVersion::Timestamp Database::getDataVersionTimestamp() const {
 }
 
 void Database::updateDataVersion() {
+   for (const auto& [_, table] : tables) {
+      table->markModified();
+   }
    data_version_ = DataVersion::mineDataVersion();
    SPDLOG_DEBUG("Data version was set to {}", data_version_.toString());
 }
@@ -6,6 +6,7 @@
 #include "rhydb/common/data_version.h"
 #include "rhydb/common/silo_directory.h"
 #include "rhydb/database_info.h"
+#include "rhydb/persistence/load_mode.h"
 #include "rhydb/query_engine/query_plan.h"
 #include "rhydb/schema/database_schema.h"
 #include "rhydb/storage/table.h"
@@ -92,10 +93,19 @@ class Database {
       const std::filesystem::path& save_directory
    );
 
-   static Database loadDatabaseState(const RhyDBDataSource& silo_data_source);
+   /// With `LoadMode::MEMORY_MAPPED`, the returned database keeps the column files mapped and
+   /// cannot be appended to or updated.
+   static Database loadDatabaseState(
+      const RhyDBDataSource& silo_data_source,
+      persistence::LoadMode load_mode = persistence::LoadMode::COPY
+   );
 
    [[nodiscard]] virtual DatabaseInfo getDatabaseInfo() const;
 
+   /// The zone maps of the value columns of every table (see `Table::getChunkStatistics`), by
+   /// table name
+   [[nodiscard]] nlohmann::json getChunkStatistics() const;
+
    [[nodiscard]] virtual DataVersion::Timestamp getDataVersionTimestamp() const;
 
    [[nodiscard]] std::string executeQueryAsArrowIpc(const std::string& query_string) const;
@@ -1,13 +1,19 @@
 #include "rhydb/database.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <map>
+#include <sstream>
+#include <string>
 
 #include <fmt/format.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 
 #include "config/source/yaml_file.h"
 #include "rhydb/common/lineage_tree.h"
@@ -15,9 +21,11 @@
 #include "rhydb/config/preprocessing_config.h"
 #include "rhydb/database_info.h"
 #include "rhydb/initialize/initializer.h"
+#include "rhydb/persistence/exception.h"
 #include "rhydb/query_engine/illegal_query_exception.h"
 #include "rhydb/query_engine/planner.h"
 #include "rhydb/storage/reference_genomes.h"
+#include "rhydb/storage/table_manifest.h"
 #include "rhydb/test/query_fixture.test.h"
 
 using rhydb::config::PreprocessingConfig;
@@ -96,6 +104,117 @@ TEST(DatabaseTest, shouldSaveAndReloadDatabaseWithoutErrors) {
    }
 }
 
+TEST(DatabaseTest, shouldRejectCorruptedColumnFileOnLoad) {
+   auto first_database = buildTestDatabase();
+
+   const std::filesystem::path directory =
+      std::filesystem::temp_directory_path() / "silo_corrupted_column_test";
+   std::filesystem::remove_all(directory);
+   first_database->saveDatabaseState(directory);
+
+   const auto versioned_directory = directory / first_database->getDataVersionTimestamp().value;
+   const auto column_file = versioned_directory / "default" / "column_0.silo";
+   ASSERT_TRUE(std::filesystem::is_regular_file(column_file));
+   {
+      std::fstream file(column_file, std::ios::in | std::ios::out | std::ios::binary);
+      file.seekg(-1, std::ios::end);
+      const char last_byte = static_cast<char>(file.get());
+      file.seekp(-1, std::ios::end);
+      file.put(static_cast<char>(~last_byte));
+   }
+
+   const rhydb::RhyDBDataSource data_source =
+      rhydb::RhyDBDataSource::checkValidDataSource(versioned_directory);
+   EXPECT_THROW(
+      rhydb::Database::loadDatabaseState(data_source), rhydb::persistence::LoadDatabaseException
+   );
+
+   std::filesystem::remove_all(directory);
+}
+
+TEST(DatabaseTest, shouldRejectTableManifestThatListsAColumnTwice) {
+   auto first_database = buildTestDatabase();
+
+   const std::filesystem::path directory =
+      std::filesystem::temp_directory_path() / "silo_duplicated_manifest_column_test";
+   std::filesystem::remove_all(directory);
+   first_database->saveDatabaseState(directory);
+
+   const auto versioned_directory = directory / first_database->getDataVersionTimestamp().value;
+   const auto manifest_path = versioned_directory / "default.silo";
+   rhydb::storage::TableManifest manifest;
+   {
+      std::ifstream file(manifest_path, std::ios::binary);
+      boost::archive::binary_iarchive input_archive(file);
+      input_archive >> manifest;
+   }
+   ASSERT_GE(manifest.column_files.size(), 2);
+   // The number of entries still matches the schema, but the second column is missing
+   manifest.column_files.at(1) = manifest.column_files.at(0);
+   {
+      std::ofstream file(manifest_path, std::ios::binary | std::ios::trunc);
+      boost::archive::binary_oarchive output_archive(file);
+      output_archive << manifest;
+   }
+
+   const rhydb::RhyDBDataSource data_source =
+      rhydb::RhyDBDataSource::checkValidDataSource(versioned_directory);
+   EXPECT_THROW(
+      rhydb::Database::loadDatabaseState(data_source), rhydb::persistence::LoadDatabaseException
+   );
+
+   std::filesystem::remove_all(directory);
+}
+
+TEST(DatabaseTest, shouldRejectCorruptedBitmapInColumnFileOnLoad) {
+   auto first_database = buildTestDatabase();
+
+   const std::filesystem::path directory =
+      std::filesystem::temp_directory_path() / "silo_corrupted_bitmap_test";
+   std::filesystem::remove_all(directory);
+   first_database->saveDatabaseState(directory);
+   const auto versioned_directory = directory / first_database->getDataVersionTimestamp().value;
+
+   // The frozen header of a roaring bitmap with a single container: the cookie 13766 and the
+   // container count 1 in the upper 17 bits, little endian
+   const std::string frozen_header{"\xC6\xB5\x00\x00", 4};
+   bool corrupted = false;
+   for (const auto& entry : std::filesystem::directory_iterator(versioned_directory / "default")) {
+      const auto file_name = entry.path().filename().string();
+      // Only column files, not their segments (`column_<n>.<version>.<checksum>.silo`)
+      if (!file_name.starts_with("column_") || std::ranges::count(file_name, '.') != 1) {
+         continue;
+      }
+      std::fstream file(entry.path(), std::ios::in | std::ios::out | std::ios::binary);
+      const std::string content{
+         std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}
+      };
+      const auto header_position = content.find(frozen_header);
+      if (header_position == std::string::npos) {
+         continue;
+      }
+      // The container's type code directly precedes the header, overwrite it with an invalid one
+      file.clear();
+      file.seekp(static_cast<std::streamoff>(header_position) - 1);
+      file.put('\xFF');
+      corrupted = true;
+      break;
+   }
+   ASSERT_TRUE(corrupted);
+
+   const rhydb::RhyDBDataSource data_source =
+      rhydb::RhyDBDataSource::checkValidDataSource(versioned_directory);
+   EXPECT_THROW(
+      rhydb::Database::loadDatabaseState(data_source), rhydb::persistence::LoadDatabaseException
+   );
+   EXPECT_THROW(
+      rhydb::Database::loadDatabaseState(data_source, rhydb::persistence::LoadMode::MEMORY_MAPPED),
+      rhydb::persistence::LoadDatabaseException
+   );
+
+   std::filesystem::remove_all(directory);
+}
+
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
 TEST(DatabaseTest, shouldReturnCorrectDatabaseInfoAfterAppendingNewSequences) {
    // If this load fails, the serialization version likely needs to be increased
@@ -246,6 +365,118 @@ using rhydb::storage::column::ColumnMetadata;
 using rhydb::storage::column::SequenceColumnMetadata;
 using rhydb::storage::column::StringColumnMetadata;
 
+TEST(DatabaseTest, memoryMappedLoadAnswersLikeCopiedLoadAndIsReadOnly) {
+   auto first_database = buildTestDatabase();
+
+   const std::filesystem::path directory =
+      std::filesystem::temp_directory_path() / "silo_memory_mapped_test";
+   std::filesystem::remove_all(directory);
+   first_database->saveDatabaseState(directory);
+   const rhydb::RhyDBDataSource data_source = rhydb::RhyDBDataSource::checkValidDataSource(
+      directory / first_database->getDataVersionTimestamp().value
+   );
+
+   auto copied = rhydb::Database::loadDatabaseState(data_source);
+   auto mapped =
+      rhydb::Database::loadDatabaseState(data_source, rhydb::persistence::LoadMode::MEMORY_MAPPED);
+
+   EXPECT_EQ(mapped.getDatabaseInfo().sequence_count, copied.getDatabaseInfo().sequence_count);
+   for (const std::string filter :
+        {"age = 4", "age = null", "test_boolean_column = true", "division = 'Bern'",
+         "float_value = null"}) {
+      EXPECT_EQ(countWhere(mapped, filter), countWhere(copied, filter)) << filter;
+   }
+
+   const std::string table = rhydb::schema::TableName::getDefault().getName();
+   EXPECT_THROW(
+      mapped.updateColumn(table, "age", "100", "age = 4"),
+      rhydb::query_engine::IllegalQueryException
+   );
+
+   std::filesystem::remove_all(directory);
+}
+
+TEST(DatabaseTest, saveAfterAppendReusesTheSegmentsOfLoadedChunks) {
+   auto first_database = buildTestDatabase();
+
+   const std::filesystem::path directory =
+      std::filesystem::temp_directory_path() / "silo_incremental_append_test";
+   std::filesystem::remove_all(directory);
+   first_database->saveDatabaseState(directory / "base");
+   const auto base_directory =
+      directory / "base" / first_database->getDataVersionTimestamp().value;
+   auto database = rhydb::Database::loadDatabaseState(
+      rhydb::RhyDBDataSource::checkValidDataSource(base_directory)
+   );
+
+   std::stringstream more_data{
+      R"({"primaryKey": "key6", "pango_lineage": "XBB", "date": "2021-03-19", "region": "Europe", "country": "Switzerland", "division": "Solothurn", "unsorted_date": "2021-02-10", "age": 54, "qc_value": 0.94, "test_boolean_column": true, "float_value": null, "main": {"sequence": "ACGTACGT", "insertions": []}, "testSecondSequence": {"sequence": "ACGT", "insertions": []}, "unaligned_main": "ACGTACGT", "unaligned_testSecondSequence": "ACGT", "E": {"sequence": "MYSF*", "insertions": ["4:EPE"]}, "M": {"sequence": "XXXX*", "insertions": []}})"
+   };
+   database.appendData(rhydb::schema::TableName::getDefault(), more_data);
+   database.saveDatabaseState(directory / "appended");
+   const auto appended_directory =
+      directory / "appended" / database.getDataVersionTimestamp().value;
+
+   // Column files are named `column_<idx>.silo`, segments have further name components
+   const auto is_segment = [](const std::filesystem::path& path) {
+      return std::ranges::count(path.filename().string(), '.') > 1;
+   };
+   size_t reused_segments = 0;
+   size_t new_segments = 0;
+   for (const auto& file : std::filesystem::directory_iterator(base_directory / "default")) {
+      const auto name = file.path().filename();
+      if (is_segment(name)) {
+         const auto appended_segment = appended_directory / "default" / name;
+         ASSERT_TRUE(std::filesystem::exists(appended_segment)) << name;
+         EXPECT_TRUE(std::filesystem::equivalent(file.path(), appended_segment)) << name;
+         ++reused_segments;
+      }
+   }
+   for (const auto& file : std::filesystem::directory_iterator(appended_directory / "default")) {
+      const auto name = file.path().filename();
+      if (is_segment(name) && !std::filesystem::exists(base_directory / "default" / name)) {
+         ++new_segments;
+      }
+   }
+   EXPECT_GT(reused_segments, 0);
+   EXPECT_GT(new_segments, 0);
+
+   auto reloaded = rhydb::Database::loadDatabaseState(
+      rhydb::RhyDBDataSource::checkValidDataSource(appended_directory)
+   );
+   EXPECT_EQ(reloaded.getDatabaseInfo().sequence_count, 6);
+   for (const std::string filter :
+        {"age = 54",
+         "age = null",
+         "division = 'Solothurn'",
+         "date = '2021-03-19'::date",
+         "nucleotideEquals(position:=1, symbol:='A', sequenceName:='main')",
+         "nucleotideEquals(position:=8, symbol:='T', sequenceName:='main')",
+         "hasMutation(position:=2, sequenceName:='main')",
+         "aminoAcidEquals(position:=2, symbol:='Y', sequenceName:='E')"}) {
+      EXPECT_EQ(countWhere(reloaded, filter), countWhere(database, filter)) << filter;
+   }
+
+   std::filesystem::remove_all(directory);
+}
+
+TEST(DatabaseTest, updateColumnRejectsUpdatingThePrimaryKey) {
+   rhydb::Database database;
+   const ColumnIdentifier primary_key{.name = "key", .type = ColumnType::STRING};
+   const std::map<ColumnIdentifier, std::shared_ptr<ColumnMetadata>> column_metadata{
+      {primary_key, std::make_shared<StringColumnMetadata>(primary_key.name)},
+   };
+   const rhydb::schema::TableName table_name{"keys"};
+   database.createTable(table_name, std::make_shared<TableSchema>(column_metadata, primary_key));
+   std::stringstream data{R"({"key":"id_1"})" "\n" R"({"key":"id_2"})"};
+   database.appendData(table_name, data);
+
+   EXPECT_THAT(
+      [&]() { database.updateColumn(table_name.getName(), "key", "'id_3'", "key = 'id_1'"); },
+      ThrowsMessage<rhydb::query_engine::IllegalQueryException>(::testing::HasSubstr("primary key"))
+   );
+}
+
 TEST(DatabaseTest, canCreateMultipleTablesAndAddData) {
    rhydb::Database database;
    ColumnIdentifier primary_key{.name = "key", .type = ColumnType::STRING};
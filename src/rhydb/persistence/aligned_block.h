@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+
+#include <fmt/format.h>
+#include <boost/serialization/binary_object.hpp>
+
+#include "rhydb/persistence/checksummed_file.h"
+#include "rhydb/persistence/exception.h"
+#include "rhydb/persistence/mapped_file.h"
+
+namespace rhydb::persistence {
+
+/// Alignment of the blocks written by `saveAlignedBlock`, relative to the start of the file. Covers
+/// every fixed-width value type and frozen roaring bitmaps, which need 32 bytes.
+constexpr size_t BLOCK_ALIGNMENT = 64;
+
+/// The bytes of a block read by `loadAlignedBlock`. They are either borrowed in place from a
+/// memory-mapped file or an aligned copy owned by this object.
+class LoadedBlock {
+   struct FreeDeleter {
+      void operator()(char* data) const { std::free(data); }
+   };
+
+   std::unique_ptr<char, FreeDeleter> owned;
+   std::span<const char> bytes_;
+
+   LoadedBlock() = default;
+
+  public:
+   static LoadedBlock borrowed(std::span<const char> bytes) {
+      LoadedBlock block;
+      block.bytes_ = bytes;
+      return block;
+   }
+
+   static LoadedBlock allocate(size_t size_in_bytes) {
+      // std::aligned_alloc requires a non-zero multiple of the alignment
+      const size_t allocation_size = ((size_in_bytes / BLOCK_ALIGNMENT) + 1) * BLOCK_ALIGNMENT;
+      LoadedBlock block;
+      block.owned.reset(static_cast<char*>(std::aligned_alloc(BLOCK_ALIGNMENT, allocation_size)));
+      if (block.owned == nullptr) {
+         throw std::bad_alloc();
+      }
+      block.bytes_ = {block.owned.get(), size_in_bytes};
+      return block;
+   }
+
+   [[nodiscard]] bool isBorrowed() const { return owned == nullptr; }
+
+   [[nodiscard]] std::span<const char> bytes() const { return bytes_; }
+
+   [[nodiscard]] char* mutableData() { return owned.get(); }
+};
+
+/// Writes `bytes` so that they start at a multiple of `BLOCK_ALIGNMENT` in the file, if the
+/// archive writes to the active `ChecksummingFileWriter`. Other archives get no padding.
+template <class Archive>
+void saveAlignedBlock(Archive& archive, std::span<const char> bytes) {
+   static constexpr std::array<char, BLOCK_ALIGNMENT> ZEROS{};
+
+   uint64_t size_in_bytes = bytes.size();
+   uint32_t padding = 0;
+   // clang-format off
+   archive & size_in_bytes;
+   if (const auto* writer = ChecksummingFileWriter::active()) {
+      const size_t block_start = writer->position() + sizeof(padding);
+      padding = (BLOCK_ALIGNMENT - (block_start % BLOCK_ALIGNMENT)) % BLOCK_ALIGNMENT;
+   }
+   archive & padding;
+   // NOLINTBEGIN(cppcoreguidelines-pro-type-const-cast)
+   archive & boost::serialization::make_binary_object(const_cast<char*>(ZEROS.data()), padding);
+   archive & boost::serialization::make_binary_object(
+      const_cast<char*>(bytes.data()), size_in_bytes
+   );
+   // NOLINTEND(cppcoreguidelines-pro-type-const-cast)
+   // clang-format on
+}
+
+/// Reads a block written by `saveAlignedBlock`. If the archive reads from the active
+/// `MappedFileReader` and the block is aligned in memory, it is borrowed from the mapping instead
+/// of being copied.
+template <class Archive>
+LoadedBlock loadAlignedBlock(Archive& archive) {
+   uint64_t size_in_bytes = 0;
+   uint32_t padding = 0;
+   // clang-format off
+   archive & size_in_bytes;
+   archive & padding;
+   // clang-format on
+   if (padding >= BLOCK_ALIGNMENT) {
+      throw LoadDatabaseException(fmt::format("Invalid padding {} of an aligned block", padding));
+   }
+
+   if (auto* reader = MappedFileReader::active()) {
+      reader->borrow(padding);
+      const auto bytes = reader->borrow(size_in_bytes);
+      if (reinterpret_cast<uintptr_t>(bytes.data()) % BLOCK_ALIGNMENT == 0) {
+         return LoadedBlock::borrowed(bytes);
+      }
+      auto block = LoadedBlock::allocate(size_in_bytes);
+      std::memcpy(block.mutableData(), bytes.data(), size_in_bytes);
+      return block;
+   }
+
+   std::array<char, BLOCK_ALIGNMENT> discarded_padding{};
+   auto block = LoadedBlock::allocate(size_in_bytes);
+   // clang-format off
+   archive & boost::serialization::make_binary_object(discarded_padding.data(), padding);
+   archive & boost::serialization::make_binary_object(block.mutableData(), size_in_bytes);
+   // clang-format on
+   return block;
+}
+
+}  // namespace rhydb::persistence
@@ -0,0 +1,166 @@
+#include "rhydb/persistence/aligned_block.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/string.hpp>
+#include <roaring/roaring.hh>
+
+#include "rhydb/persistence/exception.h"
+#include "rhydb/roaring_util/roaring_serialize.h"
+#include "rhydb/storage/column/chunked_value_buffer.h"
+
+using rhydb::persistence::BLOCK_ALIGNMENT;
+using rhydb::persistence::ChecksummingFileWriter;
+using rhydb::persistence::MappedFile;
+using rhydb::persistence::MappedFileReader;
+using rhydb::storage::column::ChunkedValueBuffer;
+using rhydb::storage::column::RowId;
+
+namespace {
+
+struct TestData {
+   // An odd-sized field first, so that the blocks after it need padding
+   std::string prefix = "odd";
+   ChunkedValueBuffer<int64_t> values;
+   roaring::Roaring bitmap;
+
+   template <class Archive>
+   void serialize(Archive& archive, const uint32_t /*version*/) {
+      // clang-format off
+      archive & prefix;
+      archive & values;
+      archive & bitmap;
+      // clang-format on
+   }
+};
+
+TestData makeTestData() {
+   TestData data;
+   std::vector<int64_t> first_chunk(1000);
+   std::iota(first_chunk.begin(), first_chunk.end(), 0);
+   data.values.appendChunk(std::move(first_chunk));
+   data.values.appendChunk({-1, -2, -3});
+   data.bitmap.addRange(0, 100000);
+   data.bitmap.add(1U << 20);
+   data.bitmap.runOptimize();
+   return data;
+}
+
+std::filesystem::path saveToFile(const TestData& data, const std::string& name) {
+   const auto path = std::filesystem::temp_directory_path() / ("silo_aligned_block_" + name);
+   ChecksummingFileWriter writer{path};
+   {
+      const ChecksummingFileWriter::ActiveScope active_writer{writer};
+      boost::archive::binary_oarchive output_archive(writer);
+      output_archive << data;
+   }
+   writer.finish();
+   return path;
+}
+
+void expectEqualToTestData(const TestData& loaded) {
+   const auto expected = makeTestData();
+   EXPECT_EQ(loaded.prefix, expected.prefix);
+   ASSERT_EQ(loaded.values.numChunks(), 2);
+   EXPECT_EQ(loaded.values.chunkSize(0), 1000);
+   EXPECT_EQ(loaded.values.at(RowId{.chunk_id = 0, .row_in_chunk = 999}), 999);
+   EXPECT_EQ(loaded.values.at(RowId{.chunk_id = 1, .row_in_chunk = 2}), -3);
+   EXPECT_EQ(loaded.bitmap, expected.bitmap);
+}
+
+}  // namespace
+
+TEST(AlignedBlock, mappedLoadBorrowsAlignedBlocksFromTheFile) {
+   const auto path = saveToFile(makeTestData(), "mapped");
+   const auto file = MappedFile::open(path);
+   const auto file_begin = reinterpret_cast<uintptr_t>(file->bytes().data());
+   const auto file_end = file_begin + file->bytes().size();
+
+   TestData loaded;
+   {
+      MappedFileReader reader{file};
+      const MappedFileReader::ActiveScope active_reader{reader};
+      boost::archive::binary_iarchive input_archive(reader);
+      input_archive >> loaded;
+      EXPECT_EQ(MappedFileReader::active(), &reader);
+   }
+   EXPECT_EQ(MappedFileReader::active(), nullptr);
+
+   const auto chunk_begin = reinterpret_cast<uintptr_t>(loaded.values.chunk(0).data());
+   EXPECT_GE(chunk_begin, file_begin);
+   EXPECT_LT(chunk_begin, file_end);
+   EXPECT_EQ((chunk_begin - file_begin) % BLOCK_ALIGNMENT, 0);
+   expectEqualToTestData(loaded);
+
+   // Overwriting a value copies the mapped chunk instead of writing to the file
+   loaded.values.setValue(RowId{.chunk_id = 0, .row_in_chunk = 0}, 42);
+   EXPECT_EQ(loaded.values.at(RowId{.chunk_id = 0, .row_in_chunk = 0}), 42);
+   const auto copied_chunk_begin = reinterpret_cast<uintptr_t>(loaded.values.chunk(0).data());
+   EXPECT_TRUE(copied_chunk_begin < file_begin || copied_chunk_begin >= file_end);
+
+   std::filesystem::remove(path);
+}
+
+TEST(AlignedBlock, streamLoadCopiesTheBlocks) {
+   const auto path = saveToFile(makeTestData(), "stream");
+
+   TestData loaded;
+   {
+      std::ifstream input(path, std::ios::binary);
+      boost::archive::binary_iarchive input_archive(input);
+      input_archive >> loaded;
+   }
+   expectEqualToTestData(loaded);
+
+   std::filesystem::remove(path);
+}
+
+TEST(AlignedBlock, unpaddedBlocksCanBeLoaded) {
+   std::stringstream buffer;
+   {
+      const auto data = makeTestData();
+      boost::archive::binary_oarchive output_archive(buffer);
+      output_archive << data;
+   }
+   TestData loaded;
+   {
+      boost::archive::binary_iarchive input_archive(buffer);
+      input_archive >> loaded;
+   }
+   expectEqualToTestData(loaded);
+}
+
+TEST(AlignedBlock, corruptedBitmapBlockIsRejected) {
+   const auto path = saveToFile(makeTestData(), "corrupted_bitmap");
+   {
+      // The bitmap is the last block of the file, its frozen header is in the last four bytes
+      std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+      file.seekp(-4, std::ios::end);
+      file.put('\0');
+   }
+
+   {
+      TestData loaded;
+      std::ifstream input(path, std::ios::binary);
+      boost::archive::binary_iarchive input_archive(input);
+      EXPECT_THROW(input_archive >> loaded, rhydb::persistence::LoadDatabaseException);
+   }
+   {
+      TestData loaded;
+      MappedFileReader reader{MappedFile::open(path)};
+      const MappedFileReader::ActiveScope active_reader{reader};
+      boost::archive::binary_iarchive input_archive(reader);
+      EXPECT_THROW(input_archive >> loaded, rhydb::persistence::LoadDatabaseException);
+   }
+
+   std::filesystem::remove(path);
+}
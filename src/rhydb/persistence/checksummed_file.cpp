@@ -0,0 +1,124 @@
+#include "rhydb/persistence/checksummed_file.h"
+
+#include <utility>
+
+#include <arrow/util/crc32.h>
+#include <fmt/format.h>
+
+#include "rhydb/persistence/exception.h"
+
+namespace rhydb::persistence {
+
+namespace {
+
+constexpr size_t BUFFER_SIZE = 1 << 20;
+
+thread_local ChecksummingFileWriter* active_writer = nullptr;
+
+}  // namespace
+
+ChecksummingFileWriter::ChecksummingFileWriter(std::filesystem::path path_)
+    : path(std::move(path_)),
+      buffer(BUFFER_SIZE) {
+   if (file.open(path, std::ios::out | std::ios::binary | std::ios::trunc) == nullptr) {
+      throw SaveDatabaseException(fmt::format("Output file {} could not be opened.", path.string())
+      );
+   }
+   setp(buffer.data(), buffer.data() + buffer.size());
+}
+
+FileFingerprint ChecksummingFileWriter::finish() {
+   if (sync() != 0 || file.close() == nullptr) {
+      throw SaveDatabaseException(fmt::format("Could not write output file {}.", path.string()));
+   }
+   return fingerprint;
+}
+
+size_t ChecksummingFileWriter::position() const {
+   return fingerprint.size_in_bytes + static_cast<size_t>(pptr() - pbase());
+}
+
+ChecksummingFileWriter* ChecksummingFileWriter::active() {
+   return active_writer;
+}
+
+ChecksummingFileWriter::ActiveScope::ActiveScope(ChecksummingFileWriter& writer)
+    : previous(active_writer) {
+   active_writer = &writer;
+}
+
+ChecksummingFileWriter::ActiveScope::~ActiveScope() {
+   active_writer = previous;
+}
+
+ChecksummingFileWriter::int_type ChecksummingFileWriter::overflow(int_type character) {
+   if (!writeBuffer()) {
+      return traits_type::eof();
+   }
+   if (!traits_type::eq_int_type(character, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(character);
+      pbump(1);
+   }
+   return traits_type::not_eof(character);
+}
+
+int ChecksummingFileWriter::sync() {
+   return writeBuffer() && file.pubsync() == 0 ? 0 : -1;
+}
+
+bool ChecksummingFileWriter::writeBuffer() {
+   const auto size = static_cast<std::streamsize>(pptr() - pbase());
+   if (size == 0) {
+      return true;
+   }
+   fingerprint.checksum =
+      arrow::internal::crc32(fingerprint.checksum, pbase(), static_cast<size_t>(size));
+   fingerprint.size_in_bytes += size;
+   if (file.sputn(pbase(), size) != size) {
+      return false;
+   }
+   setp(buffer.data(), buffer.data() + buffer.size());
+   return true;
+}
+
+ChecksummingFileReader::ChecksummingFileReader(std::filesystem::path path_)
+    : path(std::move(path_)),
+      buffer(BUFFER_SIZE) {
+   if (file.open(path, std::ios::in | std::ios::binary) == nullptr) {
+      throw LoadDatabaseException(fmt::format("Input file {} could not be opened.", path.string()));
+   }
+   setg(buffer.data(), buffer.data(), buffer.data());
+}
+
+FileFingerprint ChecksummingFileReader::finish() {
+   // Everything up to egptr() has already been fingerprinted, discard it and read on
+   setg(eback(), egptr(), egptr());
+   while (!traits_type::eq_int_type(underflow(), traits_type::eof())) {
+      setg(eback(), egptr(), egptr());
+   }
+   file.close();
+   return fingerprint;
+}
+
+ChecksummingFileReader::int_type ChecksummingFileReader::underflow() {
+   if (gptr() < egptr()) {
+      return traits_type::to_int_type(*gptr());
+   }
+   const std::streamsize size =
+      file.sgetn(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+   if (size <= 0) {
+      return traits_type::eof();
+   }
+   fingerprint.checksum =
+      arrow::internal::crc32(fingerprint.checksum, buffer.data(), static_cast<size_t>(size));
+   fingerprint.size_in_bytes += size;
+   setg(buffer.data(), buffer.data(), buffer.data() + size);
+   return traits_type::to_int_type(*gptr());
+}
+
+FileFingerprint fingerprintFile(const std::filesystem::path& path) {
+   ChecksummingFileReader reader{path};
+   return reader.finish();
+}
+
+}  // namespace rhydb::persistence
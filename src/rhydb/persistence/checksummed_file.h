@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <streambuf>
+#include <vector>
+
+#include <boost/serialization/access.hpp>
+
+namespace rhydb::persistence {
+
+/// Size and CRC32 of a file's content. Recorded when a file is saved and compared when it is
+/// loaded again, to detect truncated or otherwise corrupted files.
+struct FileFingerprint {
+   uint64_t size_in_bytes = 0;
+   uint32_t checksum = 0;
+
+   bool operator==(const FileFingerprint& other) const = default;
+
+   template <class Archive>
+   void serialize(Archive& archive, [[maybe_unused]] const uint32_t version) {
+      // clang-format off
+      archive & size_in_bytes;
+      archive & checksum;
+      // clang-format on
+   }
+};
+
+/// Stream buffer that writes to a file and fingerprints all bytes written through it. Intended to
+/// be wrapped by a boost archive.
+class ChecksummingFileWriter : public std::streambuf {
+   std::filesystem::path path;
+   std::filebuf file;
+   std::vector<char> buffer;
+   FileFingerprint fingerprint;
+
+  public:
+   /// Throws a `SaveDatabaseException` if the file cannot be created.
+   explicit ChecksummingFileWriter(std::filesystem::path path);
+
+   /// Writes all buffered bytes, closes the file and returns the fingerprint of its content.
+   FileFingerprint finish();
+
+   /// Number of bytes written so far
+   [[nodiscard]] size_t position() const;
+
+   /// The writer that the current thread serializes to, nullptr if there is none. Lets
+   /// serialization code align blocks to their offset in the file (see `saveAlignedBlock`).
+   static ChecksummingFileWriter* active();
+
+   /// Makes a writer the active writer of the current thread for the lifetime of the scope.
+   class ActiveScope {
+      ChecksummingFileWriter* previous;
+
+     public:
+      explicit ActiveScope(ChecksummingFileWriter& writer);
+      ~ActiveScope();
+
+      ActiveScope(const ActiveScope&) = delete;
+      ActiveScope& operator=(const ActiveScope&) = delete;
+      ActiveScope(ActiveScope&&) = delete;
+      ActiveScope& operator=(ActiveScope&&) = delete;
+   };
+
+  protected:
+   int_type overflow(int_type character) override;
+
+   int sync() override;
+
+  private:
+   bool writeBuffer();
+};
+
+/// Stream buffer that reads from a file and fingerprints all bytes read through it. Intended to be
+/// wrapped by a boost archive.
+class ChecksummingFileReader : public std::streambuf {
+   std::filesystem::path path;
+   std::filebuf file;
+   std::vector<char> buffer;
+   FileFingerprint fingerprint;
+
+  public:
+   /// Throws a `LoadDatabaseException` if the file cannot be opened.
+   explicit ChecksummingFileReader(std::filesystem::path path);
+
+   /// Reads the remainder of the file and returns the fingerprint of its whole content.
+   FileFingerprint finish();
+
+  protected:
+   int_type underflow() override;
+};
+
+/// Reads the whole file and returns the fingerprint of its content. Throws a
+/// `LoadDatabaseException` if the file cannot be opened.
+FileFingerprint fingerprintFile(const std::filesystem::path& path);
+
+}  // namespace rhydb::persistence
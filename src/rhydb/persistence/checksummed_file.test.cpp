@@ -0,0 +1,91 @@
+#include "rhydb/persistence/checksummed_file.h"
+
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "rhydb/persistence/exception.h"
+
+using rhydb::persistence::ChecksummingFileReader;
+using rhydb::persistence::ChecksummingFileWriter;
+using rhydb::persistence::FileFingerprint;
+
+namespace {
+
+std::filesystem::path testFile(const std::string& name) {
+   return std::filesystem::temp_directory_path() / ("silo_checksummed_file_" + name);
+}
+
+FileFingerprint writeFile(const std::filesystem::path& path, const std::string& content) {
+   ChecksummingFileWriter writer{path};
+   {
+      std::ostream output{&writer};
+      output << content;
+   }
+   return writer.finish();
+}
+
+}  // namespace
+
+TEST(ChecksummedFile, readerSeesWrittenContentAndSameFingerprint) {
+   const auto path = testFile("round_trip");
+   // Larger than the internal buffer, so that it is flushed several times
+   const std::string content = std::string(3'000'000, 'A') + "some tail";
+   const auto written = writeFile(path, content);
+   EXPECT_EQ(written.size_in_bytes, content.size());
+
+   ChecksummingFileReader reader{path};
+   std::string read_back;
+   {
+      std::istream input{&reader};
+      read_back.assign(std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{});
+   }
+   EXPECT_EQ(read_back, content);
+   EXPECT_EQ(reader.finish(), written);
+
+   std::filesystem::remove(path);
+}
+
+TEST(ChecksummedFile, finishFingerprintsTheUnreadRemainder) {
+   const auto path = testFile("partial_read");
+   const auto written = writeFile(path, "0123456789");
+
+   ChecksummingFileReader reader{path};
+   {
+      std::istream input{&reader};
+      std::string first_part(3, '\0');
+      input.read(first_part.data(), 3);
+      EXPECT_EQ(first_part, "012");
+   }
+   EXPECT_EQ(reader.finish(), written);
+
+   std::filesystem::remove(path);
+}
+
+TEST(ChecksummedFile, detectsCorruptedContent) {
+   const auto path = testFile("corrupted");
+   const auto written = writeFile(path, "some content that will be modified");
+   {
+      std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+      file.seekp(5);
+      file.put('X');
+   }
+
+   ChecksummingFileReader reader{path};
+   const auto read = reader.finish();
+   EXPECT_EQ(read.size_in_bytes, written.size_in_bytes);
+   EXPECT_NE(read.checksum, written.checksum);
+
+   std::filesystem::remove(path);
+}
+
+TEST(ChecksummedFile, throwsWhenTheInputFileDoesNotExist) {
+   EXPECT_THROW(
+      ChecksummingFileReader{testFile("does_not_exist")}, rhydb::persistence::LoadDatabaseException
+   );
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+namespace rhydb::persistence {
+
+/// How the column files of a saved database are read.
+enum class LoadMode : uint8_t {
+   /// Deserializes all columns into memory owned by the database, which can then be appended to
+   /// and updated.
+   COPY,
+   /// Memory-maps the column files and uses roaring bitmaps and fixed-width value buffers in place.
+   /// The loaded tables are read-only.
+   MEMORY_MAPPED,
+};
+
+}  // namespace rhydb::persistence
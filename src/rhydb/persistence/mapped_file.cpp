@@ -0,0 +1,114 @@
+#include "rhydb/persistence/mapped_file.h"
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+#include "rhydb/persistence/exception.h"
+
+namespace rhydb::persistence {
+
+namespace {
+
+thread_local MappedFileReader* active_reader = nullptr;
+
+}  // namespace
+
+MappedFile::MappedFile(std::filesystem::path path, const char* data, size_t size)
+    : path(std::move(path)),
+      data(data),
+      size(size) {}
+
+std::shared_ptr<const MappedFile> MappedFile::open(const std::filesystem::path& path) {
+   const int file_descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+   if (file_descriptor < 0) {
+      throw LoadDatabaseException(fmt::format(
+         "Input file {} could not be opened: {}", path.string(), std::strerror(errno)
+      ));
+   }
+   struct stat file_status {};
+   if (::fstat(file_descriptor, &file_status) != 0) {
+      const int error = errno;
+      ::close(file_descriptor);
+      throw LoadDatabaseException(fmt::format(
+         "Could not determine the size of input file {}: {}", path.string(), std::strerror(error)
+      ));
+   }
+   const auto size = static_cast<size_t>(file_status.st_size);
+   if (size == 0) {
+      ::close(file_descriptor);
+      return std::shared_ptr<const MappedFile>(new MappedFile(path, nullptr, 0));
+   }
+   void* data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, file_descriptor, 0);
+   const int error = errno;
+   // The mapping stays valid after the file descriptor is closed
+   ::close(file_descriptor);
+   if (data == MAP_FAILED) {
+      throw LoadDatabaseException(fmt::format(
+         "Input file {} could not be memory-mapped: {}", path.string(), std::strerror(error)
+      ));
+   }
+   return std::shared_ptr<const MappedFile>(
+      new MappedFile(path, static_cast<const char*>(data), size)
+   );
+}
+
+MappedFile::~MappedFile() {
+   if (data != nullptr) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+      ::munmap(const_cast<char*>(data), size);
+   }
+}
+
+MappedFileReader::MappedFileReader(std::shared_ptr<const MappedFile> file_)
+    : file(std::move(file_)) {
+   // The get area is the whole mapping, streambuf only hands out non-const pointers
+   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+   auto* begin = const_cast<char*>(file->bytes().data());
+   setg(begin, begin, begin + file->bytes().size());
+}
+
+MappedFileReader* MappedFileReader::active() {
+   return active_reader;
+}
+
+MappedFileReader::ActiveScope::ActiveScope(MappedFileReader& reader)
+    : previous(active_reader) {
+   active_reader = &reader;
+}
+
+MappedFileReader::ActiveScope::~ActiveScope() {
+   active_reader = previous;
+}
+
+std::span<const char> MappedFileReader::borrow(size_t length) {
+   if (static_cast<size_t>(egptr() - gptr()) < length) {
+      throw LoadDatabaseException(fmt::format(
+         "Unexpected end of input file {} at byte {}", file->getPath().string(), position()
+      ));
+   }
+   const std::span<const char> borrowed{gptr(), length};
+   // gbump only takes an int, blocks can be larger
+   setg(eback(), gptr() + length, egptr());
+   return borrowed;
+}
+
+size_t MappedFileReader::position() const {
+   return static_cast<size_t>(gptr() - eback());
+}
+
+MappedFileReader::int_type MappedFileReader::underflow() {
+   if (gptr() < egptr()) {
+      return traits_type::to_int_type(*gptr());
+   }
+   return traits_type::eof();
+}
+
+}  // namespace rhydb::persistence
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <streambuf>
+
+namespace rhydb::persistence {
+
+/// Read-only memory mapping of a whole file. The file's pages are shared with every other process
+/// that maps it and are only read from disk when they are first accessed.
+class MappedFile {
+   std::filesystem::path path;
+   const char* data = nullptr;
+   size_t size = 0;
+
+   MappedFile(std::filesystem::path path, const char* data, size_t size);
+
+  public:
+   /// Throws a `LoadDatabaseException` if the file cannot be opened or mapped.
+   static std::shared_ptr<const MappedFile> open(const std::filesystem::path& path);
+
+   ~MappedFile();
+
+   MappedFile(const MappedFile&) = delete;
+   MappedFile& operator=(const MappedFile&) = delete;
+   MappedFile(MappedFile&&) = delete;
+   MappedFile& operator=(MappedFile&&) = delete;
+
+   [[nodiscard]] std::span<const char> bytes() const { return {data, size}; }
+
+   [[nodiscard]] const std::filesystem::path& getPath() const { return path; }
+};
+
+/// Stream buffer that reads a `MappedFile`. While a reader is active on the current thread (see
+/// `ActiveScope`), deserialization code can take byte ranges of the file in place with `borrow`
+/// instead of copying them. Whoever keeps borrowed bytes must also keep the `MappedFile` alive.
+class MappedFileReader : public std::streambuf {
+   std::shared_ptr<const MappedFile> file;
+
+  public:
+   explicit MappedFileReader(std::shared_ptr<const MappedFile> file);
+
+   /// The reader that the current thread deserializes from, nullptr if there is none.
+   static MappedFileReader* active();
+
+   /// Makes a reader the active reader of the current thread for the lifetime of the scope.
+   class ActiveScope {
+      MappedFileReader* previous;
+
+     public:
+      explicit ActiveScope(MappedFileReader& reader);
+      ~ActiveScope();
+
+      ActiveScope(const ActiveScope&) = delete;
+      ActiveScope& operator=(const ActiveScope&) = delete;
+      ActiveScope(ActiveScope&&) = delete;
+      ActiveScope& operator=(ActiveScope&&) = delete;
+   };
+
+   /// Consumes the next `length` bytes of the file and returns them in place. Throws a
+   /// `LoadDatabaseException` if the file ends before.
+   std::span<const char> borrow(size_t length);
+
+   /// Number of bytes consumed so far
+   [[nodiscard]] size_t position() const;
+
+   [[nodiscard]] const std::shared_ptr<const MappedFile>& getFile() const { return file; }
+
+  protected:
+   int_type underflow() override;
+};
+
+}  // namespace rhydb::persistence
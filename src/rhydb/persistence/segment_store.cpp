@@ -0,0 +1,142 @@
+#include "rhydb/persistence/segment_store.h"
+
+#include <fstream>
+#include <system_error>
+#include <utility>
+
+#include <fmt/format.h>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+
+#include "rhydb/persistence/exception.h"
+
+namespace rhydb::persistence {
+
+namespace {
+
+thread_local SegmentStore* active_store = nullptr;
+
+}  // namespace
+
+SegmentStore::SegmentStore(std::filesystem::path directory, std::string new_segment_prefix)
+    : directory(std::move(directory)),
+      new_segment_prefix(std::move(new_segment_prefix)) {}
+
+SegmentStore::SegmentStore(std::filesystem::path directory, LoadMode load_mode)
+    : directory(std::move(directory)),
+      load_mode(load_mode) {}
+
+SegmentStore* SegmentStore::active() {
+   return active_store;
+}
+
+SegmentStore::ActiveScope::ActiveScope(SegmentStore& store)
+    : previous(active_store) {
+   active_store = &store;
+}
+
+SegmentStore::ActiveScope::~ActiveScope() {
+   active_store = previous;
+}
+
+ChunkLocation SegmentStore::writeSegment(
+   const std::function<void(boost::archive::binary_oarchive&)>& write
+) {
+   const auto segment_name = fmt::format("{}.{}", new_segment_prefix, segments_written++);
+   // Segments may be hard links shared with older data versions, so an existing file must never be
+   // written to. The segment is written to a fresh file and renamed into place.
+   const auto temporary_path = directory / (segment_name + ".tmp");
+   std::filesystem::remove(temporary_path);
+   ChecksummingFileWriter writer{temporary_path};
+   {
+      const ChecksummingFileWriter::ActiveScope active_writer{writer};
+      boost::archive::binary_oarchive output_archive(writer);
+      write(output_archive);
+   }
+   ChunkLocation location{.segment_fingerprint = writer.finish()};
+   // The checksum in the name keeps it unique against reused segments of a data version with the
+   // same name
+   location.segment_file =
+      fmt::format("{}.{:08x}.silo", segment_name, location.segment_fingerprint.checksum);
+   std::filesystem::rename(temporary_path, directory / location.segment_file);
+   return location;
+}
+
+ChunkLocation SegmentStore::reuseSegment(const ChunkOrigin& origin) {
+   const auto source = origin.directory / origin.location.segment_file;
+   const auto target = directory / origin.location.segment_file;
+   if (std::filesystem::exists(target)) {
+      return origin.location;
+   }
+   std::error_code error;
+   std::filesystem::create_hard_link(source, target, error);
+   if (error) {
+      std::filesystem::copy_file(source, target, error);
+   }
+   if (error) {
+      throw SaveDatabaseException(fmt::format(
+         "Could not link or copy segment {} to {}: {}",
+         source.string(),
+         target.string(),
+         error.message()
+      ));
+   }
+   return origin.location;
+}
+
+void SegmentStore::readSegment(
+   const ChunkLocation& location,
+   const std::function<void(boost::archive::binary_iarchive&)>& read
+) {
+   const auto path = directory / location.segment_file;
+   const auto& expected = location.segment_fingerprint;
+   if (load_mode == LoadMode::MEMORY_MAPPED) {
+      auto file = MappedFile::open(path);
+      if (file->bytes().size() != expected.size_in_bytes) {
+         throw LoadDatabaseException(fmt::format(
+            "Segment file {} is corrupted: expected {} bytes, found {} bytes",
+            path.string(),
+            expected.size_in_bytes,
+            file->bytes().size()
+         ));
+      }
+      MappedFileReader reader{file};
+      {
+         const MappedFileReader::ActiveScope active_reader{reader};
+         boost::archive::binary_iarchive input_archive(reader);
+         read(input_archive);
+      }
+      bytes_loaded += expected.size_in_bytes;
+      mapped_segments.push_back(std::move(file));
+      return;
+   }
+
+   // Checked before deserializing, like the column files
+   const auto fingerprint = fingerprintFile(path);
+   if (fingerprint != expected) {
+      throw LoadDatabaseException(fmt::format(
+         "Segment file {} is corrupted: expected {} bytes with checksum {:08x}, found {} bytes "
+         "with checksum {:08x}",
+         path.string(),
+         expected.size_in_bytes,
+         expected.checksum,
+         fingerprint.size_in_bytes,
+         fingerprint.checksum
+      ));
+   }
+   std::ifstream file(path, std::ios::binary);
+   if (!file) {
+      throw LoadDatabaseException(fmt::format("Input file {} could not be opened.", path.string()));
+   }
+   {
+      boost::archive::binary_iarchive input_archive(file);
+      read(input_archive);
+   }
+   bytes_loaded += fingerprint.size_in_bytes;
+}
+
+std::vector<std::shared_ptr<const MappedFile>> SegmentStore::takeMappedSegments() {
+   return std::exchange(mapped_segments, {});
+}
+
+}  // namespace rhydb::persistence
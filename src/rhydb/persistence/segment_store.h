@@ -0,0 +1,192 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/string.hpp>
+
+#include "rhydb/persistence/checksummed_file.h"
+#include "rhydb/persistence/exception.h"
+#include "rhydb/persistence/load_mode.h"
+#include "rhydb/persistence/mapped_file.h"
+
+namespace boost::archive {
+class binary_iarchive;
+class binary_oarchive;
+}  // namespace boost::archive
+
+namespace rhydb::persistence {
+
+/// Reference from a column file to one chunk of a segment file.
+struct ChunkLocation {
+   /// Relative to the column directory of the data version
+   std::string segment_file;
+   uint32_t index_in_segment = 0;
+   FileFingerprint segment_fingerprint;
+
+   template <class Archive>
+   void serialize(Archive& archive, [[maybe_unused]] const uint32_t version) {
+      // clang-format off
+      archive & segment_file;
+      archive & index_in_segment;
+      archive & segment_fingerprint;
+      // clang-format on
+   }
+};
+
+/// Where a loaded chunk came from, so that saving it again can reuse its segment file.
+struct ChunkOrigin {
+   std::filesystem::path directory;
+   ChunkLocation location;
+};
+
+/// Segment files hold the immutable chunks of a column, separately from the column's global
+/// structures in its column file. A segment is never changed once written, so the segments of
+/// chunks that were loaded and are saved unchanged into a new data version are hard-linked from
+/// the old version instead of being written again. Appending to a database therefore only writes
+/// segments for the new chunks.
+///
+/// While a store is active on the current thread (see `ActiveScope`), `ChunkedValueBuffer` and the
+/// sequence indexes put their chunks into segments of this store (see `saveChunksToSegments`).
+class SegmentStore {
+   std::filesystem::path directory;
+   std::string new_segment_prefix;
+   LoadMode load_mode = LoadMode::COPY;
+   size_t segments_written = 0;
+   uint64_t bytes_loaded = 0;
+   std::vector<std::shared_ptr<const MappedFile>> mapped_segments;
+
+  public:
+   /// Store for saving into `directory`. New segments are named
+   /// `<new_segment_prefix>.<n>.<checksum>.silo`.
+   SegmentStore(std::filesystem::path directory, std::string new_segment_prefix);
+
+   /// Store for loading from `directory`
+   SegmentStore(std::filesystem::path directory, LoadMode load_mode);
+
+   /// The store of the current thread, nullptr if there is none.
+   static SegmentStore* active();
+
+   /// Makes a store the active store of the current thread for the lifetime of the scope.
+   class ActiveScope {
+      SegmentStore* previous;
+
+     public:
+      explicit ActiveScope(SegmentStore& store);
+      ~ActiveScope();
+
+      ActiveScope(const ActiveScope&) = delete;
+      ActiveScope& operator=(const ActiveScope&) = delete;
+      ActiveScope(ActiveScope&&) = delete;
+      ActiveScope& operator=(ActiveScope&&) = delete;
+   };
+
+   [[nodiscard]] const std::filesystem::path& getDirectory() const { return directory; }
+
+   /// Writes a new segment with the content written by `write` and returns where it is. The
+   /// `index_in_segment` of the returned location is 0.
+   ChunkLocation writeSegment(const std::function<void(boost::archive::binary_oarchive&)>& write);
+
+   /// Makes the segment of a chunk that was loaded from `origin` available in this store's
+   /// directory, by hard-linking it (or copying it, where hard links are not possible).
+   ChunkLocation reuseSegment(const ChunkOrigin& origin);
+
+   /// Reads the segment `location` points to with `read`. Depending on the load mode, the segment
+   /// is memory-mapped or read and checked against its fingerprint.
+   void readSegment(
+      const ChunkLocation& location,
+      const std::function<void(boost::archive::binary_iarchive&)>& read
+   );
+
+   /// Bytes of all segments read so far
+   [[nodiscard]] uint64_t getBytesLoaded() const { return bytes_loaded; }
+
+   /// Segments that were memory-mapped. Must be kept alive as long as the loaded chunks.
+   std::vector<std::shared_ptr<const MappedFile>> takeMappedSegments();
+};
+
+/// Saves the chunks `[0, num_chunks)` of a structure that is split by chunk. A chunk for which
+/// `origin_of(chunk_idx)` returns a `ChunkOrigin` reuses its segment, all others are written with
+/// `save_chunk(archive, chunk_idx)` into one new segment. Returns the location of every chunk.
+template <typename OriginOf, typename SaveChunk>
+std::vector<ChunkLocation> saveChunksToSegments(
+   SegmentStore& store,
+   size_t num_chunks,
+   const OriginOf& origin_of,
+   const SaveChunk& save_chunk
+) {
+   std::vector<ChunkLocation> locations(num_chunks);
+   std::vector<size_t> new_chunks;
+   for (size_t chunk_idx = 0; chunk_idx < num_chunks; ++chunk_idx) {
+      const std::optional<ChunkOrigin> origin = origin_of(chunk_idx);
+      if (origin.has_value()) {
+         locations.at(chunk_idx) = store.reuseSegment(origin.value());
+      } else {
+         new_chunks.push_back(chunk_idx);
+      }
+   }
+   if (new_chunks.empty()) {
+      return locations;
+   }
+   const auto segment = store.writeSegment([&](auto& segment_archive) {
+      size_t num_new_chunks = new_chunks.size();
+      // clang-format off
+      segment_archive & num_new_chunks;
+      // clang-format on
+      for (const size_t chunk_idx : new_chunks) {
+         save_chunk(segment_archive, chunk_idx);
+      }
+   });
+   for (size_t index_in_segment = 0; index_in_segment < new_chunks.size(); ++index_in_segment) {
+      auto& location = locations.at(new_chunks.at(index_in_segment));
+      location = segment;
+      location.index_in_segment = static_cast<uint32_t>(index_in_segment);
+   }
+   return locations;
+}
+
+/// Reads the chunks at `locations`, in their order, that were saved by `saveChunksToSegments`.
+/// `load_chunk(archive)` reads one chunk and returns it. Every segment file is read once.
+template <typename Chunk, typename LoadChunk>
+std::vector<Chunk> loadChunksFromSegments(
+   SegmentStore& store,
+   const std::vector<ChunkLocation>& locations,
+   const LoadChunk& load_chunk
+) {
+   std::map<std::string, std::vector<Chunk>> segments;
+   std::vector<Chunk> chunks;
+   chunks.reserve(locations.size());
+   for (const auto& location : locations) {
+      auto segment = segments.find(location.segment_file);
+      if (segment == segments.end()) {
+         segment = segments.emplace(location.segment_file, std::vector<Chunk>{}).first;
+         store.readSegment(location, [&](auto& segment_archive) {
+            size_t num_chunks = 0;
+            // clang-format off
+            segment_archive & num_chunks;
+            // clang-format on
+            for (size_t chunk_idx = 0; chunk_idx < num_chunks; ++chunk_idx) {
+               segment->second.push_back(load_chunk(segment_archive));
+            }
+         });
+      }
+      if (location.index_in_segment >= segment->second.size()) {
+         throw LoadDatabaseException(fmt::format(
+            "Segment file {} has no chunk {}", location.segment_file, location.index_in_segment
+         ));
+      }
+      chunks.push_back(std::move(segment->second.at(location.index_in_segment)));
+   }
+   return chunks;
+}
+
+}  // namespace rhydb::persistence
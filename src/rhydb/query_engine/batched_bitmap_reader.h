@@ -23,6 +23,9 @@ class BatchedBitmapReader {
     */
    std::optional<roaring::Roaring> nextBatch();
 
+   /// The rows that are not part of a batch yet
+   [[nodiscard]] size_t remainingRows() const { return cardinality - num_rows_produced; }
+
   private:
    roaring::Roaring bitmap;
    size_t num_rows_produced = 0;
@@ -0,0 +1,152 @@
+#include "rhydb/query_engine/cancellation_token.h"
+
+#include <utility>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "rhydb/common/panic.h"
+
+namespace rhydb::query_engine {
+
+namespace {
+
+thread_local std::shared_ptr<CancellationToken> active_token = nullptr;
+
+std::atomic<uint64_t> total_cancelled_queries = 0;
+std::atomic<uint64_t> total_skipped_rows = 0;
+
+int64_t toNanoseconds(std::chrono::steady_clock::time_point time_point) {
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(time_point.time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+std::string_view cancellationReasonToString(CancellationReason reason) {
+   switch (reason) {
+      case CancellationReason::NONE:
+         return "not cancelled";
+      case CancellationReason::DEADLINE:
+         return "the deadline passed";
+      case CancellationReason::CLIENT_GONE:
+         return "the client went away";
+      case CancellationReason::FAILED:
+         return "the result could not be completed";
+   }
+   SILO_UNREACHABLE();
+}
+
+QueryCancelledException::QueryCancelledException(
+   std::string_view request_id,
+   CancellationReason reason
+)
+    : std::runtime_error(fmt::format(
+         "Request Id [{}] - The query was cancelled because {}.",
+         request_id,
+         cancellationReasonToString(reason)
+      )),
+      reason_(reason) {}
+
+CancellationToken::CancellationToken(
+   std::string request_id,
+   std::optional<Clock::time_point> deadline
+)
+    : request_id(std::move(request_id)) {
+   setDeadline(deadline);
+}
+
+CancellationToken::~CancellationToken() {
+   const CancellationReason final_reason = reason.load();
+   if (final_reason == CancellationReason::NONE) {
+      return;
+   }
+   const auto stopped_after = std::chrono::nanoseconds{
+      toNanoseconds(Clock::now()) - cancelled_at_in_nanoseconds.load()
+   };
+   SPDLOG_INFO(
+      "Request Id [{}] - Cancelled because {}, all work stopped {} ms later, skipping {} rows. "
+      "{} queries cancelled so far, skipping {} rows.",
+      request_id,
+      cancellationReasonToString(final_reason),
+      std::chrono::duration_cast<std::chrono::milliseconds>(stopped_after).count(),
+      skipped_rows.load(),
+      total_cancelled_queries.load(),
+      total_skipped_rows.load()
+   );
+}
+
+void CancellationToken::setDeadline(std::optional<Clock::time_point> deadline) {
+   deadline_in_nanoseconds = deadline.has_value() ? toNanoseconds(*deadline) : NO_DEADLINE;
+}
+
+void CancellationToken::cancelIfNotYet(CancellationReason new_reason) const {
+   CancellationReason expected = CancellationReason::NONE;
+   if (reason.compare_exchange_strong(expected, new_reason)) {
+      cancelled_at_in_nanoseconds = toNanoseconds(Clock::now());
+      ++total_cancelled_queries;
+   }
+}
+
+void CancellationToken::cancel(CancellationReason cancellation_reason) {
+   SILO_ASSERT(cancellation_reason != CancellationReason::NONE);
+   cancelIfNotYet(cancellation_reason);
+}
+
+bool CancellationToken::isCancelled() const {
+   if (reason.load(std::memory_order_relaxed) != CancellationReason::NONE) {
+      return true;
+   }
+   const int64_t deadline = deadline_in_nanoseconds.load(std::memory_order_relaxed);
+   if (deadline != NO_DEADLINE && toNanoseconds(Clock::now()) >= deadline) {
+      cancelIfNotYet(CancellationReason::DEADLINE);
+      return true;
+   }
+   return false;
+}
+
+CancellationReason CancellationToken::cancellationReason() const {
+   // Notices a passed deadline
+   [[maybe_unused]] const bool cancelled = isCancelled();
+   return reason.load();
+}
+
+void CancellationToken::throwIfCancelled(size_t skipped_rows) {
+   if (isCancelled()) {
+      addSkippedRows(skipped_rows);
+      throw QueryCancelledException(request_id, reason.load());
+   }
+}
+
+void CancellationToken::addSkippedRows(size_t rows) {
+   skipped_rows += rows;
+   total_skipped_rows += rows;
+}
+
+const std::shared_ptr<CancellationToken>& CancellationToken::active() {
+   return active_token;
+}
+
+void CancellationToken::throwIfActiveCancelled(size_t skipped_rows) {
+   if (active_token != nullptr) {
+      active_token->throwIfCancelled(skipped_rows);
+   }
+}
+
+CancellationToken::Statistics CancellationToken::statistics() {
+   return {
+      .cancelled_queries = total_cancelled_queries.load(),
+      .skipped_rows = total_skipped_rows.load()
+   };
+}
+
+CancellationToken::ActiveScope::ActiveScope(std::shared_ptr<CancellationToken> token)
+    : previous(std::move(active_token)) {
+   active_token = std::move(token);
+}
+
+CancellationToken::ActiveScope::~ActiveScope() {
+   active_token = std::move(previous);
+}
+
+}  // namespace rhydb::query_engine
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace rhydb::query_engine {
+
+/// Why a query stopped before it produced its complete result
+enum class CancellationReason : uint8_t {
+   NONE,
+   /// The query did not make progress before its deadline
+   DEADLINE,
+   /// The client went away or stopped reading the result
+   CLIENT_GONE,
+   /// The result can no longer be completed, e.g. because writing it failed
+   FAILED
+};
+
+[[nodiscard]] std::string_view cancellationReasonToString(CancellationReason reason);
+
+/// Thrown from the work of a query after its `CancellationToken` was cancelled
+class QueryCancelledException : public std::runtime_error {
+   CancellationReason reason_;
+
+  public:
+   QueryCancelledException(std::string_view request_id, CancellationReason reason);
+
+   [[nodiscard]] CancellationReason reason() const { return reason_; }
+};
+
+/// Tells the work of one query whether anybody still waits for its result. The token is
+/// cancelled explicitly, e.g. when the client went away, or implicitly once its deadline passed.
+///
+/// Filter evaluation and the producers of the plan check the token at chunk granularity and stop
+/// with `QueryCancelledException` or a `Cancelled` status, reporting the rows they skipped. The
+/// token of the query that is planned on a thread is the active token of that thread (see
+/// `ActiveScope`), so that the operators of the filter need not pass it on; producers that run on
+/// other threads keep the token that was active when they were created. Thread-safe.
+class CancellationToken {
+   using Clock = std::chrono::steady_clock;
+
+   /// The time since the epoch of `Clock`, `NO_DEADLINE` if there is none
+   static constexpr int64_t NO_DEADLINE = INT64_MAX;
+
+   std::string request_id;
+   mutable std::atomic<CancellationReason> reason = CancellationReason::NONE;
+   std::atomic<int64_t> deadline_in_nanoseconds = NO_DEADLINE;
+   mutable std::atomic<int64_t> cancelled_at_in_nanoseconds = 0;
+   std::atomic<uint64_t> skipped_rows = 0;
+
+   void cancelIfNotYet(CancellationReason new_reason) const;
+
+  public:
+   /// The cancellations of all queries since the start of the process
+   struct Statistics {
+      uint64_t cancelled_queries;
+      uint64_t skipped_rows;
+   };
+
+   explicit CancellationToken(
+      std::string request_id,
+      std::optional<Clock::time_point> deadline = std::nullopt
+   );
+
+   CancellationToken(const CancellationToken& other) = delete;
+   CancellationToken& operator=(const CancellationToken& other) = delete;
+
+   /// Logs how quickly the work of a cancelled query stopped and what it skipped
+   ~CancellationToken();
+
+   /// Replaces the deadline, `std::nullopt` removes it. A passed deadline cancels the token the
+   /// next time it is checked, a cancelled token stays cancelled.
+   void setDeadline(std::optional<Clock::time_point> deadline);
+
+   void setTimeout(std::chrono::seconds timeout) { setDeadline(Clock::now() + timeout); }
+
+   /// Has no effect if the token is already cancelled
+   void cancel(CancellationReason cancellation_reason);
+
+   [[nodiscard]] bool isCancelled() const;
+
+   [[nodiscard]] CancellationReason cancellationReason() const;
+
+   /// Throws `QueryCancelledException` if the token is cancelled, after recording that the work
+   /// on `skipped_rows` rows is skipped
+   void throwIfCancelled(size_t skipped_rows = 0);
+
+   /// Records that the work on `rows` rows is skipped because the token was cancelled
+   void addSkippedRows(size_t rows);
+
+   [[nodiscard]] uint64_t skippedRows() const { return skipped_rows.load(); }
+
+   [[nodiscard]] const std::string& requestId() const { return request_id; }
+
+   /// The active token of the current thread, nullptr if there is none
+   [[nodiscard]] static const std::shared_ptr<CancellationToken>& active();
+
+   /// `throwIfCancelled` on the active token of the current thread, if there is one
+   static void throwIfActiveCancelled(size_t skipped_rows = 0);
+
+   [[nodiscard]] static Statistics statistics();
+
+   /// Makes a token the active token of the current thread for the lifetime of the scope.
+   /// `token` may be nullptr, then the thread has no active token within the scope.
+   class ActiveScope {
+      std::shared_ptr<CancellationToken> previous;
+
+     public:
+      explicit ActiveScope(std::shared_ptr<CancellationToken> token);
+      ~ActiveScope();
+
+      ActiveScope(const ActiveScope&) = delete;
+      ActiveScope& operator=(const ActiveScope&) = delete;
+      ActiveScope(ActiveScope&&) = delete;
+      ActiveScope& operator=(ActiveScope&&) = delete;
+   };
+};
+
+}  // namespace rhydb::query_engine
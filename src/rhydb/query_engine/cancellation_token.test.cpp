@@ -0,0 +1,80 @@
+#include "rhydb/query_engine/cancellation_token.h"
+
+#include <chrono>
+#include <future>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+using rhydb::query_engine::CancellationReason;
+using rhydb::query_engine::CancellationToken;
+using rhydb::query_engine::QueryCancelledException;
+
+TEST(CancellationToken, keepsTheFirstReasonItWasCancelledFor) {
+   CancellationToken under_test{"some_id"};
+   EXPECT_FALSE(under_test.isCancelled());
+   EXPECT_EQ(under_test.cancellationReason(), CancellationReason::NONE);
+
+   under_test.cancel(CancellationReason::CLIENT_GONE);
+   under_test.cancel(CancellationReason::FAILED);
+
+   EXPECT_TRUE(under_test.isCancelled());
+   EXPECT_EQ(under_test.cancellationReason(), CancellationReason::CLIENT_GONE);
+}
+
+TEST(CancellationToken, isCancelledOncePastItsDeadline) {
+   const auto in_an_hour = std::chrono::steady_clock::now() + std::chrono::hours{1};
+   CancellationToken under_test{"some_id", in_an_hour};
+   EXPECT_FALSE(under_test.isCancelled());
+
+   under_test.setDeadline(std::chrono::steady_clock::now() - std::chrono::milliseconds{1});
+   EXPECT_TRUE(under_test.isCancelled());
+
+   // A cancelled token stays cancelled
+   under_test.setDeadline(std::nullopt);
+   EXPECT_TRUE(under_test.isCancelled());
+   EXPECT_EQ(under_test.cancellationReason(), CancellationReason::DEADLINE);
+}
+
+TEST(CancellationToken, countsTheRowsThatCancelledWorkSkipped) {
+   const auto before = CancellationToken::statistics();
+   {
+      CancellationToken under_test{"some_id"};
+      under_test.throwIfCancelled(100);
+      EXPECT_EQ(under_test.skippedRows(), 0);
+
+      under_test.cancel(CancellationReason::DEADLINE);
+      EXPECT_THROW(under_test.throwIfCancelled(100), QueryCancelledException);
+      under_test.addSkippedRows(20);
+      EXPECT_EQ(under_test.skippedRows(), 120);
+   }
+   const auto after = CancellationToken::statistics();
+   EXPECT_EQ(after.cancelled_queries - before.cancelled_queries, 1);
+   EXPECT_EQ(after.skipped_rows - before.skipped_rows, 120);
+}
+
+TEST(CancellationToken, activeTokenIsScopedToTheThread) {
+   EXPECT_EQ(CancellationToken::active(), nullptr);
+   // Does nothing without an active token
+   CancellationToken::throwIfActiveCancelled();
+
+   auto outer = std::make_shared<CancellationToken>("outer");
+   auto inner = std::make_shared<CancellationToken>("inner");
+   inner->cancel(CancellationReason::CLIENT_GONE);
+   {
+      const CancellationToken::ActiveScope outer_scope{outer};
+      EXPECT_EQ(CancellationToken::active(), outer);
+      {
+         const CancellationToken::ActiveScope inner_scope{inner};
+         EXPECT_EQ(CancellationToken::active(), inner);
+         EXPECT_THROW(CancellationToken::throwIfActiveCancelled(), QueryCancelledException);
+         EXPECT_EQ(
+            std::async(std::launch::async, [] { return CancellationToken::active(); }).get(),
+            nullptr
+         );
+      }
+      EXPECT_EQ(CancellationToken::active(), outer);
+      CancellationToken::throwIfActiveCancelled();
+   }
+   EXPECT_EQ(CancellationToken::active(), nullptr);
+}
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <span>
 #include <type_traits>
 #include <utility>
@@ -11,6 +12,8 @@
 
 #include <roaring/roaring.hh>
 
+#include "rhydb/common/panic.h"
+
 namespace rhydb::query_engine {
 
 using roaring_util::RoaringContainer;
@@ -117,6 +120,17 @@ bool CopyOnWriteBitmap::isEmpty() const {
    return keys.empty();
 }
 
+size_t CopyOnWriteBitmap::sizeInBytes() const {
+   size_t size_in_bytes =
+      (keys.capacity() * sizeof(uint16_t)) + (containers.capacity() * sizeof(Container));
+   for (const auto& container : containers) {
+      if (const auto* owned = std::get_if<RoaringContainer>(&container)) {
+         size_in_bytes += owned->sizeInBytes();
+      }
+   }
+   return size_in_bytes;
+}
+
 uint64_t CopyOnWriteBitmap::andCardinality(const CopyOnWriteBitmap& other) const {
    uint64_t total = 0;
    size_t left = 0;
@@ -296,6 +310,27 @@ CopyOnWriteBitmap CopyOnWriteBitmap::fastUnion(const std::vector<CopyOnWriteBitm
    return result;
 }
 
+CopyOnWriteBitmap CopyOnWriteBitmap::concatenate(std::vector<CopyOnWriteBitmap>&& parts) {
+   CopyOnWriteBitmap result;
+   size_t total_containers = 0;
+   for (const auto& part : parts) {
+      total_containers += part.keys.size();
+   }
+   result.keys.reserve(total_containers);
+   result.containers.reserve(total_containers);
+   for (auto& part : parts) {
+      if (part.keys.empty()) {
+         continue;
+      }
+      SILO_ASSERT(result.keys.empty() || result.keys.back() < part.keys.front());
+      result.keys.insert(result.keys.end(), part.keys.begin(), part.keys.end());
+      std::ranges::move(part.containers, std::back_inserter(result.containers));
+      part.keys.clear();
+      part.containers.clear();
+   }
+   return result;
+}
+
 CopyOnWriteBitmap CopyOnWriteBitmap::fromContainerViews(
    std::vector<std::pair<uint16_t, RoaringContainerView>> container_views
 ) {
@@ -350,8 +385,15 @@ CopyOnWriteBitmap CopyOnWriteBitmap::fromContainerViews(
 }
 
 roaring::Roaring CopyOnWriteBitmap::toRoaring() const {
+   return toRoaring(0, static_cast<uint32_t>(UINT16_MAX) + 1);
+}
+
+roaring::Roaring CopyOnWriteBitmap::toRoaring(uint32_t first_key, uint32_t end_key) const {
    roaring::Roaring result;
-   for (size_t idx = 0; idx < keys.size(); ++idx) {
+   const auto first_idx =
+      static_cast<size_t>(std::ranges::lower_bound(keys, first_key) - keys.begin());
+   const auto end_idx = static_cast<size_t>(std::ranges::lower_bound(keys, end_key) - keys.begin());
+   for (size_t idx = first_idx; idx < end_idx; ++idx) {
       const auto container_view = viewOf(containers[idx]);
       auto* clone = roaring::internal::container_clone(
          container_view.rawContainer(), container_view.getTypecode()
@@ -73,6 +73,9 @@ class CopyOnWriteBitmap {
 
    [[nodiscard]] bool isEmpty() const;
 
+   /// The memory held by this bitmap. Viewed containers are owned elsewhere and not counted.
+   [[nodiscard]] size_t sizeInBytes() const;
+
    /// Forward iterator over the bitmap's containers in ascending key order. Dereferencing yields a
    /// `{key, view}` pair by value - the 2^16 block key (the high 16 bits of the row ids it holds)
    /// and a non-owning view of its container - without materializing any intermediate collection.
@@ -132,6 +135,11 @@ class CopyOnWriteBitmap {
    /// Union of many bitmaps, computed container-by-container in a single k-way merge.
    [[nodiscard]] static CopyOnWriteBitmap fastUnion(const std::vector<CopyOnWriteBitmap>& bitmaps);
 
+   /// Joins bitmaps over disjoint, ascending key ranges by moving their containers into one bitmap,
+   /// without any set operation. Every key of `parts[i]` must be smaller than every key of
+   /// `parts[i + 1]`, as for bitmaps computed for consecutive ranges of chunks.
+   [[nodiscard]] static CopyOnWriteBitmap concatenate(std::vector<CopyOnWriteBitmap>&& parts);
+
    /// Builds a bitmap that *views* externally-owned containers (e.g. a column index's stored
    /// containers) rather than cloning them: a key with a single container becomes a zero-copy
    /// view, and keys shared by several containers are OR-ed into one owning container. The viewed
@@ -144,6 +152,10 @@ class CopyOnWriteBitmap {
    /// Materializes into a standalone `roaring::Roaring`. Intended for the end of a query only,
    /// where the result is handed to a consumer -- not for intermediate computation.
    [[nodiscard]] roaring::Roaring toRoaring() const;
+
+   /// Materializes the containers with keys in `[first_key, end_key)` only, e.g. the rows of a
+   /// range of chunks that is processed independently of the others.
+   [[nodiscard]] roaring::Roaring toRoaring(uint32_t first_key, uint32_t end_key) const;
 };
 
 }  // namespace rhydb::query_engine
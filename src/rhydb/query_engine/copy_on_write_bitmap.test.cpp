@@ -184,6 +184,33 @@ TEST(CopyOnWriteBitmap, fastUnionIsOrderIndependentAndMatchesRepeatedOrEqual) {
    } while (std::ranges::next_permutation(order).found);
 }
 
+TEST(CopyOnWriteBitmap, concatenateJoinsBitmapsOfConsecutiveKeyRanges) {
+   const roaring::Roaring viewed{1, 5, 100};
+   roaring::Roaring owned;
+   owned.add((1U << 16) + 3);
+   owned.add((3U << 16) + 7);
+
+   std::vector<CopyOnWriteBitmap> parts;
+   parts.emplace_back(&viewed);
+   parts.emplace_back();
+   parts.emplace_back(roaring::Roaring{owned});
+   const CopyOnWriteBitmap concatenated = CopyOnWriteBitmap::concatenate(std::move(parts));
+
+   EXPECT_EQ(concatenated.toRoaring(), multiContainer());
+   EXPECT_TRUE(CopyOnWriteBitmap::concatenate({}).isEmpty());
+}
+
+TEST(CopyOnWriteBitmap, toRoaringOfKeyRangeMaterializesOnlyThoseContainers) {
+   const roaring::Roaring source = multiContainer();
+   const CopyOnWriteBitmap under_test{&source};
+
+   roaring::Roaring expected;
+   expected.add((1U << 16) + 3);
+   EXPECT_EQ(under_test.toRoaring(1, 3), expected);
+   EXPECT_EQ(under_test.toRoaring(0, 1), (roaring::Roaring{1, 5, 100}));
+   EXPECT_TRUE(under_test.toRoaring(4, 10).isEmpty());
+}
+
 TEST(CopyOnWriteBitmap, iteratingContainersReconstructsRowIdsInAscendingOrder) {
    const roaring::Roaring source = multiContainer();
    const CopyOnWriteBitmap under_test{&source};
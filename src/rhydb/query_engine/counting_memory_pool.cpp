@@ -0,0 +1,103 @@
+#include "rhydb/query_engine/counting_memory_pool.h"
+
+#include <fmt/format.h>
+
+namespace rhydb::query_engine {
+
+CountingMemoryPool::CountingMemoryPool(
+   arrow::MemoryPool* parent,
+   std::optional<int64_t> limit_in_bytes
+)
+    : parent(parent),
+      limit_in_bytes(limit_in_bytes) {}
+
+arrow::Status CountingMemoryPool::reserve(int64_t size) {
+   const int64_t new_bytes_in_use = bytes_in_use.fetch_add(size) + size;
+   if (limit_in_bytes.has_value() && new_bytes_in_use > limit_in_bytes.value()) {
+      bytes_in_use.fetch_sub(size);
+      return arrow::Status::OutOfMemory(fmt::format(
+         "Allocating {} bytes would exceed the memory limit of {} bytes, of which {} are in use",
+         size,
+         limit_in_bytes.value(),
+         new_bytes_in_use - size
+      ));
+   }
+   int64_t peak = peak_bytes_in_use.load();
+   while (new_bytes_in_use > peak &&
+          !peak_bytes_in_use.compare_exchange_weak(peak, new_bytes_in_use)) {
+   }
+   return arrow::Status::OK();
+}
+
+void CountingMemoryPool::release(int64_t size) {
+   bytes_in_use.fetch_sub(size);
+}
+
+arrow::Status CountingMemoryPool::Allocate(int64_t size, int64_t alignment, uint8_t** out) {
+   ARROW_RETURN_NOT_OK(reserve(size));
+   auto status = parent->Allocate(size, alignment, out);
+   if (!status.ok()) {
+      release(size);
+      return status;
+   }
+   total_bytes.fetch_add(size);
+   allocations.fetch_add(1);
+   return status;
+}
+
+arrow::Status CountingMemoryPool::Reallocate(
+   int64_t old_size,
+   int64_t new_size,
+   int64_t alignment,
+   uint8_t** ptr
+) {
+   const int64_t growth = new_size - old_size;
+   if (growth > 0) {
+      ARROW_RETURN_NOT_OK(reserve(growth));
+   }
+   auto status = parent->Reallocate(old_size, new_size, alignment, ptr);
+   if (!status.ok()) {
+      if (growth > 0) {
+         release(growth);
+      }
+      return status;
+   }
+   if (growth > 0) {
+      total_bytes.fetch_add(growth);
+   } else {
+      release(-growth);
+   }
+   allocations.fetch_add(1);
+   return status;
+}
+
+void CountingMemoryPool::Free(uint8_t* buffer, int64_t size, int64_t alignment) {
+   parent->Free(buffer, size, alignment);
+   release(size);
+}
+
+void CountingMemoryPool::ReleaseUnused() {
+   parent->ReleaseUnused();
+}
+
+int64_t CountingMemoryPool::bytes_allocated() const {
+   return bytes_in_use.load();
+}
+
+int64_t CountingMemoryPool::max_memory() const {
+   return peak_bytes_in_use.load();
+}
+
+int64_t CountingMemoryPool::total_bytes_allocated() const {
+   return total_bytes.load();
+}
+
+int64_t CountingMemoryPool::num_allocations() const {
+   return allocations.load();
+}
+
+std::string CountingMemoryPool::backend_name() const {
+   return parent->backend_name();
+}
+
+}  // namespace rhydb::query_engine
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include <arrow/memory_pool.h>
+#include <arrow/status.h>
+
+namespace rhydb::query_engine {
+
+/// Counts the memory that arrow allocates through it and passes the allocations on to `parent`.
+/// With a `limit_in_bytes`, allocations that would exceed it fail with `OutOfMemory` instead.
+///
+/// Pools can be stacked: a pool per query on top of a pool shared by all queries accounts for
+/// both the memory of every query and the memory of all queries together. Thread-safe.
+class CountingMemoryPool final : public arrow::MemoryPool {
+   arrow::MemoryPool* parent;
+   std::optional<int64_t> limit_in_bytes;
+
+   std::atomic<int64_t> bytes_in_use = 0;
+   std::atomic<int64_t> peak_bytes_in_use = 0;
+   std::atomic<int64_t> total_bytes = 0;
+   std::atomic<int64_t> allocations = 0;
+
+   arrow::Status reserve(int64_t size);
+   void release(int64_t size);
+
+  public:
+   explicit CountingMemoryPool(
+      arrow::MemoryPool* parent = arrow::default_memory_pool(),
+      std::optional<int64_t> limit_in_bytes = std::nullopt
+   );
+
+   CountingMemoryPool(const CountingMemoryPool& other) = delete;
+   CountingMemoryPool& operator=(const CountingMemoryPool& other) = delete;
+
+   using arrow::MemoryPool::Allocate;
+   using arrow::MemoryPool::Free;
+   using arrow::MemoryPool::Reallocate;
+
+   arrow::Status Allocate(int64_t size, int64_t alignment, uint8_t** out) override;
+   arrow::Status Reallocate(int64_t old_size, int64_t new_size, int64_t alignment, uint8_t** ptr)
+      override;
+   void Free(uint8_t* buffer, int64_t size, int64_t alignment) override;
+   void ReleaseUnused() override;
+
+   [[nodiscard]] int64_t bytes_allocated() const override;
+   [[nodiscard]] int64_t max_memory() const override;
+   [[nodiscard]] int64_t total_bytes_allocated() const override;
+   [[nodiscard]] int64_t num_allocations() const override;
+   [[nodiscard]] std::string backend_name() const override;
+
+   [[nodiscard]] std::optional<int64_t> limitInBytes() const { return limit_in_bytes; }
+};
+
+}  // namespace rhydb::query_engine
@@ -0,0 +1,71 @@
+#include "rhydb/query_engine/counting_memory_pool.h"
+
+#include <string>
+
+#include <arrow/buffer.h>
+#include <arrow/builder.h>
+#include <gtest/gtest.h>
+
+using rhydb::query_engine::CountingMemoryPool;
+
+TEST(CountingMemoryPool, countsTheBytesInUseAndTheirPeak) {
+   CountingMemoryPool under_test;
+   uint8_t* first = nullptr;
+   uint8_t* second = nullptr;
+   ASSERT_TRUE(under_test.Allocate(1000, &first).ok());
+   ASSERT_TRUE(under_test.Allocate(500, &second).ok());
+   EXPECT_EQ(under_test.bytes_allocated(), 1500);
+
+   ASSERT_TRUE(under_test.Reallocate(500, 2000, &second).ok());
+   EXPECT_EQ(under_test.bytes_allocated(), 3000);
+   under_test.Free(first, 1000);
+   under_test.Free(second, 2000);
+
+   EXPECT_EQ(under_test.bytes_allocated(), 0);
+   EXPECT_EQ(under_test.max_memory(), 3000);
+   EXPECT_EQ(under_test.total_bytes_allocated(), 3000);
+   EXPECT_EQ(under_test.num_allocations(), 3);
+}
+
+TEST(CountingMemoryPool, failsAllocationsThatWouldExceedTheLimit) {
+   CountingMemoryPool under_test{arrow::default_memory_pool(), 1000};
+   uint8_t* allowed = nullptr;
+   ASSERT_TRUE(under_test.Allocate(800, &allowed).ok());
+
+   uint8_t* too_large = nullptr;
+   EXPECT_TRUE(under_test.Allocate(300, &too_large).IsOutOfMemory());
+   EXPECT_TRUE(under_test.Reallocate(800, 1200, &allowed).IsOutOfMemory());
+   EXPECT_EQ(under_test.bytes_allocated(), 800);
+
+   under_test.Free(allowed, 800);
+   EXPECT_TRUE(under_test.Allocate(1000, &allowed).ok());
+   under_test.Free(allowed, 1000);
+}
+
+TEST(CountingMemoryPool, passesAllocationsOnToItsParentWhoseLimitAppliesToAllChildren) {
+   CountingMemoryPool shared{arrow::default_memory_pool(), 1000};
+   CountingMemoryPool first_query{&shared};
+   CountingMemoryPool second_query{&shared};
+
+   uint8_t* first = nullptr;
+   ASSERT_TRUE(first_query.Allocate(600, &first).ok());
+   uint8_t* second = nullptr;
+   EXPECT_TRUE(second_query.Allocate(600, &second).IsOutOfMemory());
+   EXPECT_EQ(second_query.bytes_allocated(), 0);
+   EXPECT_EQ(shared.bytes_allocated(), 600);
+
+   first_query.Free(first, 600);
+   EXPECT_EQ(shared.bytes_allocated(), 0);
+}
+
+TEST(CountingMemoryPool, countsTheBuffersOfArrowBuilders) {
+   CountingMemoryPool under_test;
+   {
+      arrow::StringBuilder builder{&under_test};
+      ASSERT_TRUE(builder.Append(std::string(10'000, 'A')).ok());
+      auto array = builder.Finish();
+      ASSERT_TRUE(array.ok());
+      EXPECT_GE(under_test.bytes_allocated(), 10'000);
+   }
+   EXPECT_EQ(under_test.bytes_allocated(), 0);
+}
@@ -0,0 +1,318 @@
+#include "rhydb/query_engine/exec_node/ndjson_serializer.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define RHYDB_JSON_ESCAPE_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#define RHYDB_JSON_ESCAPE_NEON
+#include <arm_neon.h>
+#endif
+
+#include <arrow/array/array_binary.h>
+#include <arrow/array/array_primitive.h>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include "rhydb/common/date32.h"
+
+namespace rhydb::query_engine::exec_node {
+
+namespace {
+
+/// The longest rendering of a number: nlohmann writes doubles into a buffer of 64 bytes
+constexpr size_t MAX_NUMBER_LENGTH = 64;
+/// The longest escape sequence of a byte, `\u001f`
+constexpr size_t MAX_ESCAPED_BYTE_LENGTH = 6;
+constexpr size_t SIMD_WIDTH = 16;
+
+constexpr std::string_view NULL_LITERAL = "null";
+
+bool needsEscape(uint8_t byte) {
+   return byte < 0x20 || byte == '"' || byte == '\\';
+}
+
+/// Writes the escape sequence of `byte`, the same as nlohmann::json::dump
+char* writeEscapedByte(char* out, uint8_t byte) {
+   static constexpr std::string_view HEX_DIGITS = "0123456789abcdef";
+   *out++ = '\\';
+   switch (byte) {
+      case '"':
+         *out++ = '"';
+         break;
+      case '\\':
+         *out++ = '\\';
+         break;
+      case '\b':
+         *out++ = 'b';
+         break;
+      case '\f':
+         *out++ = 'f';
+         break;
+      case '\n':
+         *out++ = 'n';
+         break;
+      case '\r':
+         *out++ = 'r';
+         break;
+      case '\t':
+         *out++ = 't';
+         break;
+      default:
+         *out++ = 'u';
+         *out++ = '0';
+         *out++ = '0';
+         *out++ = HEX_DIGITS[byte >> 4];
+         *out++ = HEX_DIGITS[byte & 0xF];
+   }
+   return out;
+}
+
+/// Writes `value` escaped to `out`, which needs room for `MAX_ESCAPED_BYTE_LENGTH` bytes per
+/// byte of `value`. Blocks of 16 bytes without anything to escape are copied as a whole.
+char* writeEscaped(char* out, std::string_view value) {
+   const char* in = value.data();
+   const char* const end = in + value.size();
+#if defined(RHYDB_JSON_ESCAPE_SSE2)
+   const __m128i quote = _mm_set1_epi8('"');
+   const __m128i backslash = _mm_set1_epi8('\\');
+   const __m128i max_control = _mm_set1_epi8(0x1F);
+   while (static_cast<size_t>(end - in) >= SIMD_WIDTH) {
+      const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+      // There is room for the whole block, even if all of its bytes need to be escaped
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out), block);
+      const __m128i is_control = _mm_cmpeq_epi8(_mm_max_epu8(block, max_control), max_control);
+      const __m128i is_special = _mm_or_si128(
+         _mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, backslash)), is_control
+      );
+      const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(is_special));
+      if (mask == 0) {
+         in += SIMD_WIDTH;
+         out += SIMD_WIDTH;
+         continue;
+      }
+      const auto clean_length = static_cast<size_t>(std::countr_zero(mask));
+      in += clean_length;
+      out = writeEscapedByte(out + clean_length, static_cast<uint8_t>(*in++));
+   }
+#elif defined(RHYDB_JSON_ESCAPE_NEON)
+   const uint8x16_t quote = vdupq_n_u8('"');
+   const uint8x16_t backslash = vdupq_n_u8('\\');
+   const uint8x16_t first_printable = vdupq_n_u8(0x20);
+   while (static_cast<size_t>(end - in) >= SIMD_WIDTH) {
+      const uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(in));
+      vst1q_u8(reinterpret_cast<uint8_t*>(out), block);
+      const uint8x16_t is_special = vorrq_u8(
+         vorrq_u8(vceqq_u8(block, quote), vceqq_u8(block, backslash)),
+         vcltq_u8(block, first_printable)
+      );
+      // Four bits per byte
+      const uint64_t mask = vget_lane_u64(
+         vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(is_special), 4)), 0
+      );
+      if (mask == 0) {
+         in += SIMD_WIDTH;
+         out += SIMD_WIDTH;
+         continue;
+      }
+      const auto clean_length = static_cast<size_t>(std::countr_zero(mask) / 4);
+      in += clean_length;
+      out = writeEscapedByte(out + clean_length, static_cast<uint8_t>(*in++));
+   }
+#endif
+   for (; in != end; ++in) {
+      const auto byte = static_cast<uint8_t>(*in);
+      if (needsEscape(byte)) {
+         out = writeEscapedByte(out, byte);
+      } else {
+         *out++ = *in;
+      }
+   }
+   return out;
+}
+
+char* writeDigits(char* out, unsigned value, size_t digits) {
+   for (size_t digit = digits; digit > 0; --digit) {
+      out[digit - 1] = static_cast<char>('0' + (value % 10));
+      value /= 10;
+   }
+   return out + digits;
+}
+
+/// Writes `date` as `"YYYY-MM-DD"`, the same as the quoted `common::date32ToString`
+char* writeDate(char* out, common::Date32 date) {
+   const std::chrono::year_month_day ymd{std::chrono::sys_days{std::chrono::days{date}}};
+   const int year = static_cast<int>(ymd.year());
+   if (year < 0 || year > 9999) {
+      const std::string date_string = common::date32ToString(date);
+      *out++ = '"';
+      out = std::copy(date_string.begin(), date_string.end(), out);
+      *out++ = '"';
+      return out;
+   }
+   *out++ = '"';
+   out = writeDigits(out, static_cast<unsigned>(year), 4);
+   *out++ = '-';
+   out = writeDigits(out, static_cast<unsigned>(ymd.month()), 2);
+   *out++ = '-';
+   out = writeDigits(out, static_cast<unsigned>(ymd.day()), 2);
+   *out++ = '"';
+   return out;
+}
+
+/// Writes `value` like nlohmann::json::dump, i.e. the shortest representation that round-trips,
+/// with a `.0` for integral values and `null` for NaN and infinity
+char* writeDouble(char* out, double value) {
+   if (!std::isfinite(value)) {
+      return std::copy(NULL_LITERAL.begin(), NULL_LITERAL.end(), out);
+   }
+   return nlohmann::detail::to_chars(out, out + MAX_NUMBER_LENGTH, value);
+}
+
+template <typename T>
+char* writeInteger(char* out, T value) {
+   return std::to_chars(out, out + MAX_NUMBER_LENGTH, value).ptr;
+}
+
+}  // namespace
+
+void appendJsonString(std::string& output, std::string_view value) {
+   const size_t old_size = output.size();
+   output.resize(old_size + 2 + (MAX_ESCAPED_BYTE_LENGTH * value.size()));
+   char* out = output.data() + old_size;
+   *out++ = '"';
+   out = writeEscaped(out, value);
+   *out++ = '"';
+   output.resize(static_cast<size_t>(out - output.data()));
+}
+
+NdjsonSerializer::NdjsonSerializer(const arrow::Schema& schema) {
+   bool first_column = true;
+   for (const auto& field : schema.fields()) {
+      std::string key_prefix = first_column ? "{" : ",";
+      first_column = false;
+      appendJsonString(key_prefix, field->name());
+      key_prefix += ':';
+      key_prefixes.push_back(std::move(key_prefix));
+   }
+}
+
+char* NdjsonSerializer::reserve(size_t size) {
+   if (buffer.size() - used < size) {
+      buffer.resize(std::max(buffer.size() * 2, used + size));
+   }
+   return buffer.data() + used;
+}
+
+void NdjsonSerializer::append(std::string_view bytes) {
+   char* out = reserve(bytes.size());
+   std::memcpy(out, bytes.data(), bytes.size());
+   used += bytes.size();
+}
+
+arrow::Status NdjsonSerializer::appendRows(
+   const std::vector<std::shared_ptr<arrow::Array>>& columns,
+   size_t first_row,
+   size_t end_row
+) {
+   if (columns.size() != key_prefixes.size()) {
+      return arrow::Status::Invalid(
+         fmt::format("Expected {} columns, got {}", key_prefixes.size(), columns.size())
+      );
+   }
+   for (const auto& column : columns) {
+      switch (column->type_id()) {
+         case arrow::Type::NA:
+         case arrow::Type::BOOL:
+         case arrow::Type::INT32:
+         case arrow::Type::INT64:
+         case arrow::Type::FLOAT:
+         case arrow::Type::DOUBLE:
+         case arrow::Type::DATE32:
+         case arrow::Type::STRING:
+            break;
+         default:
+            return arrow::Status::NotImplemented(
+               "Cannot write values of type ", column->type()->ToString(), " as JSON"
+            );
+      }
+   }
+
+   for (size_t row = first_row; row < end_row; ++row) {
+      if (key_prefixes.empty()) {
+         append("{");
+      }
+      for (size_t column_idx = 0; column_idx < columns.size(); ++column_idx) {
+         append(key_prefixes[column_idx]);
+         const arrow::Array& column = *columns[column_idx];
+         const auto row_idx = static_cast<int64_t>(row);
+         if (column.IsNull(row_idx)) {
+            append(NULL_LITERAL);
+            continue;
+         }
+         switch (column.type_id()) {
+            case arrow::Type::BOOL:
+               append(
+                  static_cast<const arrow::BooleanArray&>(column).Value(row_idx) ? "true" : "false"
+               );
+               break;
+            case arrow::Type::INT32:
+               commit(writeInteger(
+                  reserve(MAX_NUMBER_LENGTH),
+                  static_cast<const arrow::Int32Array&>(column).Value(row_idx)
+               ));
+               break;
+            case arrow::Type::INT64:
+               commit(writeInteger(
+                  reserve(MAX_NUMBER_LENGTH),
+                  static_cast<const arrow::Int64Array&>(column).Value(row_idx)
+               ));
+               break;
+            case arrow::Type::FLOAT:
+               // nlohmann::json holds floats as doubles
+               commit(writeDouble(
+                  reserve(MAX_NUMBER_LENGTH),
+                  static_cast<double>(static_cast<const arrow::FloatArray&>(column).Value(row_idx))
+               ));
+               break;
+            case arrow::Type::DOUBLE:
+               commit(writeDouble(
+                  reserve(MAX_NUMBER_LENGTH),
+                  static_cast<const arrow::DoubleArray&>(column).Value(row_idx)
+               ));
+               break;
+            case arrow::Type::DATE32:
+               commit(writeDate(
+                  reserve(MAX_NUMBER_LENGTH),
+                  static_cast<const arrow::Date32Array&>(column).Value(row_idx)
+               ));
+               break;
+            case arrow::Type::STRING: {
+               const std::string_view value =
+                  static_cast<const arrow::StringArray&>(column).GetView(row_idx);
+               char* out = reserve(2 + (MAX_ESCAPED_BYTE_LENGTH * value.size()));
+               *out++ = '"';
+               out = writeEscaped(out, value);
+               *out++ = '"';
+               commit(out);
+               break;
+            }
+            default:
+               // Only NA, whose values are all null
+               append(NULL_LITERAL);
+         }
+      }
+      append("}\n");
+   }
+   return arrow::Status::OK();
+}
+
+}  // namespace rhydb::query_engine::exec_node
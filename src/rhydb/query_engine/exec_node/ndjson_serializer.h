@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <arrow/array.h>
+#include <arrow/status.h>
+#include <arrow/type.h>
+
+namespace rhydb::query_engine::exec_node {
+
+/// Appends `value` as a JSON string literal, i.e. quoted and escaped like nlohmann::json::dump
+/// does. Bytes outside of ASCII are copied as they are.
+void appendJsonString(std::string& output, std::string_view value);
+
+/// Renders the rows of arrow arrays as NDJSON lines into one contiguous buffer, which is reused
+/// between batches. The escaped keys of the schema are rendered once, the values are formatted
+/// without streams or temporary strings.
+class NdjsonSerializer {
+   /// `{"name":` for the first column, `,"name":` for the others
+   std::vector<std::string> key_prefixes;
+   std::vector<char> buffer;
+   size_t used = 0;
+
+   /// Room for at least `size` more bytes, which are taken with `commit`
+   char* reserve(size_t size);
+
+   void commit(const char* end) { used = static_cast<size_t>(end - buffer.data()); }
+
+   void append(std::string_view bytes);
+
+  public:
+   explicit NdjsonSerializer(const arrow::Schema& schema);
+
+   /// Appends one line for each of the rows `[first_row, end_row)` of `columns`, which hold the
+   /// columns of the schema in its order
+   arrow::Status appendRows(
+      const std::vector<std::shared_ptr<arrow::Array>>& columns,
+      size_t first_row,
+      size_t end_row
+   );
+
+   [[nodiscard]] std::string_view view() const { return {buffer.data(), used}; }
+
+   [[nodiscard]] size_t size() const { return used; }
+
+   /// Empties the buffer, but keeps its memory
+   void clear() { used = 0; }
+};
+
+}  // namespace rhydb::query_engine::exec_node
@@ -0,0 +1,108 @@
+#include "rhydb/query_engine/exec_node/ndjson_serializer.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+using rhydb::query_engine::exec_node::appendJsonString;
+using rhydb::query_engine::exec_node::NdjsonSerializer;
+
+namespace {
+
+template <typename Builder, typename T>
+std::shared_ptr<arrow::Array> makeArray(const std::vector<std::optional<T>>& values) {
+   Builder builder;
+   for (const auto& value : values) {
+      if (value.has_value()) {
+         EXPECT_TRUE(builder.Append(*value).ok());
+      } else {
+         EXPECT_TRUE(builder.AppendNull().ok());
+      }
+   }
+   std::shared_ptr<arrow::Array> array;
+   EXPECT_TRUE(builder.Finish(&array).ok());
+   return array;
+}
+
+}  // namespace
+
+TEST(NdjsonSerializer, escapesStringsLikeNlohmannJson) {
+   const std::vector<std::string> values{
+      "",
+      "plain",
+      "quote \" and backslash \\",
+      std::string{"control \x01\x1f\b\f\n\r\t and nul \0 end", 35},
+      "a string longer than sixteen bytes with a \" after the first block",
+      "\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"",
+      "non-ascii \xc3\xa4\xe2\x82\xac stays as it is"
+   };
+   for (const auto& value : values) {
+      std::string output;
+      appendJsonString(output, value);
+      EXPECT_EQ(output, nlohmann::json(value).dump());
+   }
+}
+
+TEST(NdjsonSerializer, rendersAllValueTypesLikeNlohmannJson) {
+   const auto schema = arrow::schema({
+      arrow::field("int \"32\"", arrow::int32()),
+      arrow::field("int64", arrow::int64()),
+      arrow::field("double", arrow::float64()),
+      arrow::field("float", arrow::float32()),
+      arrow::field("date", arrow::date32()),
+      arrow::field("string", arrow::utf8()),
+      arrow::field("bool", arrow::boolean()),
+   });
+   const std::vector<std::shared_ptr<arrow::Array>> columns{
+      makeArray<arrow::Int32Builder, int32_t>(
+         {std::numeric_limits<int32_t>::min(), std::nullopt, 7}
+      ),
+      makeArray<arrow::Int64Builder, int64_t>({std::numeric_limits<int64_t>::min(), -1, 0}),
+      makeArray<arrow::DoubleBuilder, double>(
+         {0.1, 1e300, std::numeric_limits<double>::infinity()}
+      ),
+      makeArray<arrow::FloatBuilder, float>({0.1F, 3.0F, std::nullopt}),
+      makeArray<arrow::Date32Builder, int32_t>({0, 19'000, -1}),
+      makeArray<arrow::StringBuilder, std::string>({"a\"b", std::nullopt, ""}),
+      makeArray<arrow::BooleanBuilder, bool>({true, false, std::nullopt}),
+   };
+   NdjsonSerializer serializer{*schema};
+   ASSERT_TRUE(serializer.appendRows(columns, 0, 1).ok());
+   ASSERT_TRUE(serializer.appendRows(columns, 1, 3).ok());
+
+   EXPECT_EQ(
+      std::string{serializer.view()},
+      "{\"int \\\"32\\\"\":-2147483648,\"int64\":-9223372036854775808,\"double\":0.1,"
+      "\"float\":0.10000000149011612,\"date\":\"1970-01-01\",\"string\":\"a\\\"b\","
+      "\"bool\":true}\n"
+      "{\"int \\\"32\\\"\":null,\"int64\":-1,\"double\":1e+300,\"float\":3.0,"
+      "\"date\":\"2022-01-08\",\"string\":null,\"bool\":false}\n"
+      "{\"int \\\"32\\\"\":7,\"int64\":0,\"double\":null,\"float\":null,"
+      "\"date\":\"1969-12-31\",\"string\":\"\",\"bool\":null}\n"
+   );
+
+   serializer.clear();
+   EXPECT_EQ(serializer.size(), 0);
+}
+
+TEST(NdjsonSerializer, writesEmptyObjectsWithoutColumns) {
+   NdjsonSerializer serializer{*arrow::schema({})};
+   ASSERT_TRUE(serializer.appendRows({}, 0, 2).ok());
+   EXPECT_EQ(std::string{serializer.view()}, "{}\n{}\n");
+}
+
+TEST(NdjsonSerializer, rejectsUnsupportedTypes) {
+   NdjsonSerializer serializer{*arrow::schema({arrow::field("unsigned", arrow::uint64())})};
+   arrow::UInt64Builder builder;
+   ASSERT_TRUE(builder.Append(1).ok());
+   std::shared_ptr<arrow::Array> array;
+   ASSERT_TRUE(builder.Finish(&array).ok());
+   EXPECT_TRUE(serializer.appendRows({array}, 0, 1).IsNotImplemented());
+}
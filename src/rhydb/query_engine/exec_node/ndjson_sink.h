@@ -1,5 +1,7 @@
 #pragma once
 
+#include <ostream>
+
 #include <arrow/acero/exec_plan.h>
 #include <arrow/acero/options.h>
 #include <arrow/acero/query_context.h>
@@ -7,17 +9,25 @@
 #include <spdlog/spdlog.h>
 
 #include "rhydb/query_engine/exec_node/arrow_batch_sink.h"
+#include "rhydb/query_engine/exec_node/ndjson_serializer.h"
 
 namespace rhydb::query_engine::exec_node {
 
+/// Writes the batches as NDJSON. The lines are collected in the buffer of the serializer and
+/// written to the output stream in blocks of at least `WRITE_BLOCK_SIZE` bytes, the stream is only
+/// flushed by `finish`.
 class NdjsonSink : public ArrowBatchSink {
    std::ostream* output_stream;
    std::shared_ptr<arrow::Schema> schema;
+   NdjsonSerializer serializer;
+
+   arrow::Status writeBuffer();
 
   public:
    NdjsonSink(std::ostream* output_stream_, std::shared_ptr<arrow::Schema> schema_)
        : output_stream(output_stream_),
-         schema(std::move(schema_)) {}
+         schema(std::move(schema_)),
+         serializer(*schema) {}
 
    arrow::Status writeBatch(const arrow::compute::ExecBatch& batch) override;
    arrow::Status finish() override;
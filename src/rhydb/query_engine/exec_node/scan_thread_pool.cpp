@@ -0,0 +1,37 @@
+#include "rhydb/query_engine/exec_node/scan_thread_pool.h"
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+#include "rhydb/common/panic.h"
+
+namespace rhydb::query_engine::exec_node {
+
+namespace {
+
+int32_t numberOfProcessors() {
+   return std::max(1, static_cast<int32_t>(std::thread::hardware_concurrency()));
+}
+
+}  // namespace
+
+arrow::internal::ThreadPool* getScanThreadPool() {
+   // Eternal, because scan tasks may still be queued when static destructors run at exit.
+   static const std::shared_ptr<arrow::internal::ThreadPool> scan_thread_pool = [] {
+      auto pool = arrow::internal::ThreadPool::MakeEternal(numberOfProcessors());
+      SILO_ASSERT(pool.ok());
+      return pool.MoveValueUnsafe();
+   }();
+   return scan_thread_pool.get();
+}
+
+arrow::Status setScanThreadPoolCapacity(int32_t num_threads) {
+   if (num_threads < 0) {
+      return arrow::Status::Invalid("The number of scan threads must not be negative");
+   }
+   return getScanThreadPool()->SetCapacity(num_threads == 0 ? numberOfProcessors() : num_threads
+   );
+}
+
+}  // namespace rhydb::query_engine::exec_node
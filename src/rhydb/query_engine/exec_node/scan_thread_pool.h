@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+#include <arrow/status.h>
+#include <arrow/util/thread_pool.h>
+
+namespace rhydb::query_engine::exec_node {
+
+/// The process-wide thread pool on which table scans materialize their batches.
+///
+/// It is deliberately separate from arrow's CPU thread pool: acero runs its own tasks on the CPU
+/// pool and can block there while waiting for source batches
+/// (https://github.com/apache/arrow/issues/47641, https://github.com/apache/arrow/issues/47642).
+/// Producing the batches on the same pool would let all of its threads wait for work that no
+/// thread is left to run. The threads are created once and reused by all queries.
+arrow::internal::ThreadPool* getScanThreadPool();
+
+/// Resizes the scan thread pool. `num_threads == 0` selects the number of processors.
+arrow::Status setScanThreadPoolCapacity(int32_t num_threads);
+
+}  // namespace rhydb::query_engine::exec_node
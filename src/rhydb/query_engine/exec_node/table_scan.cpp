@@ -1,6 +1,15 @@
 #include "rhydb/query_engine/exec_node/table_scan.h"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string_view>
 #include <utility>
+#include <vector>
 
+#include <arrow/acero/query_context.h>
+#include <arrow/util/thread_pool.h>
 #include <roaring/containers/array.h>
 #include <roaring/containers/bitset.h>
 #include <roaring/containers/containers.h>
@@ -10,6 +19,7 @@
 
 #include "evobench/evobench.hpp"
 #include "rhydb/query_engine/batched_bitmap_reader.h"
+#include "rhydb/query_engine/exec_node/scan_thread_pool.h"
 #include "rhydb/storage/column/column_type_visitor.h"
 
 namespace rhydb::query_engine::exec_node {
@@ -49,10 +59,7 @@ arrow::Status appendSequences(
       reconstructNonNullSequences(sequence_column, row_ids - sequence_column.null_bitmap);
 
    ARROW_RETURN_NOT_OK(output_array.Reserve(row_ids.cardinality()));
-   auto reference_sequence =
-      SymbolType::sequenceToString(sequence_column.metadata->reference_sequence);
-   auto dictionary = std::make_shared<rhydb::ZstdCDictionary>(reference_sequence, 3);
-   rhydb::ZstdCompressor compressor{dictionary};
+   auto compressor = sequence_column.reference_compressor_pool->acquire();
 
    auto reconstructed_sequence_iterator = reconstructed_non_null_sequences.begin();
    for (auto row_id : row_ids) {
@@ -61,7 +68,7 @@ arrow::Status appendSequences(
       } else {
          auto& reconstructed_sequence = *reconstructed_sequence_iterator;
          ARROW_RETURN_NOT_OK(output_array.Append(
-            compressor.compress(reconstructed_sequence.data(), reconstructed_sequence.size())
+            compressor->compress(reconstructed_sequence.data(), reconstructed_sequence.size())
          ));
          reconstructed_sequence_iterator++;
       }
@@ -131,12 +138,23 @@ arrow::Status ColumnEntryAppender::operator()<storage::column::ZstdCompressedStr
       );
    const auto& column =
       table.columns.getColumns<storage::column::ZstdCompressedStringColumn>().at(column_name);
+   // The values are views into the arenas of the column, so that the builder's buffers can be
+   // sized once and every value is copied straight into them
+   std::vector<std::optional<std::string_view>> values;
+   values.reserve(row_ids.cardinality());
+   int64_t total_size = 0;
    for (auto row_id : row_ids) {
-      auto value = column.getCompressed(storage::column::RowId::fromGlobal(row_id));
+      const auto& value =
+         values.emplace_back(column.getCompressed(storage::column::RowId::fromGlobal(row_id)));
+      total_size += static_cast<int64_t>(value.value_or(std::string_view{}).size());
+   }
+   ARROW_RETURN_NOT_OK(array->Reserve(static_cast<int64_t>(values.size())));
+   ARROW_RETURN_NOT_OK(array->ReserveData(total_size));
+   for (const auto& value : values) {
       if (value.has_value()) {
-         ARROW_RETURN_NOT_OK(array->Append(value.value()));
+         array->UnsafeAppend(value.value());
       } else {
-         ARROW_RETURN_NOT_OK(array->AppendNull());
+         array->UnsafeAppendNull();
       }
    }
    return arrow::Status::OK();
@@ -175,11 +193,14 @@ arrow::Status ColumnEntryAppender::operator()(
 
 }  // namespace
 
-ExecBatchBuilder::ExecBatchBuilder(std::vector<rhydb::schema::ColumnIdentifier> output_fields_)
+ExecBatchBuilder::ExecBatchBuilder(
+   std::vector<rhydb::schema::ColumnIdentifier> output_fields_,
+   arrow::MemoryPool* memory_pool
+)
     : output_fields(std::move(output_fields_)) {
    for (const auto& [name, type] : output_fields) {
       storage::column::visit(type, [&]<storage::column::Column Column>() {
-         array_builders[type].emplace(name, std::make_shared<ArrowBuilder<Column>>());
+         array_builders[type].emplace(name, std::make_shared<ArrowBuilder<Column>>(memory_pool));
       });
    }
 }
@@ -213,19 +234,227 @@ arrow::Result<arrow::ExecBatch> ExecBatchBuilder::finishBatch() {
    return arrow::compute::ExecBatch::Make(data);
 }
 
-arrow::Result<std::optional<arrow::ExecBatch>> TableScanGenerator::produceNextBatch() {
-   EVOBENCH_SCOPE("TableScanGenerator", "produceNextBatch");
-   while (current_bitmap_reader.has_value()) {
-      auto row_ids = current_bitmap_reader.value().nextBatch();
-      if (row_ids.has_value()) {
-         ARROW_RETURN_NOT_OK(exec_batch_builder.appendEntries(*table, row_ids.value()));
-         ARROW_ASSIGN_OR_RAISE(auto batch, exec_batch_builder.finishBatch());
-         SPDLOG_DEBUG("Finished arrow::ExecBatch with length: {}", batch.length);
-         return batch;
+class TableScanGenerator::State : public std::enable_shared_from_this<State> {
+   using BatchFuture = arrow::Future<std::optional<arrow::ExecBatch>>;
+
+   struct PendingBatch {
+      roaring::Roaring row_ids;
+      BatchFuture future;
+      bool started = false;
+   };
+
+   const std::vector<rhydb::schema::ColumnIdentifier> columns;
+   const std::shared_ptr<const storage::Table> table;
+   arrow::MemoryPool* const memory_pool;
+   const std::shared_ptr<CancellationToken> cancellation_token;
+   arrow::internal::Executor* const callback_executor;
+   const size_t max_queued_batches;
+   const size_t max_parallel_batches;
+
+   std::mutex mutex;
+   BatchedBitmapReader bitmap_reader;
+   bool bitmap_reader_exhausted = false;
+   // Batches that were cut from the bitmap but not yet handed to the consumer, in row id order
+   std::deque<PendingBatch> queued_batches;
+   size_t num_running_batches = 0;
+
+  public:
+   State(
+      std::vector<rhydb::schema::ColumnIdentifier> columns,
+      const CopyOnWriteBitmap& bitmap_filter,
+      std::shared_ptr<const storage::Table> table,
+      const config::QueryOptions& query_options,
+      arrow::MemoryPool* memory_pool,
+      std::shared_ptr<CancellationToken> cancellation_token,
+      arrow::internal::Executor* callback_executor
+   )
+       : columns(std::move(columns)),
+         table(std::move(table)),
+         memory_pool(memory_pool),
+         cancellation_token(std::move(cancellation_token)),
+         callback_executor(
+            callback_executor != nullptr ? callback_executor : arrow::internal::GetCpuThreadPool()
+         ),
+#ifdef __EMSCRIPTEN__
+         // In the browser build we produce each batch synchronously when it is requested.
+         // Handing batches to other threads starves or deadlocks Emscripten's fixed pthread
+         // worker pool (PTHREAD_POOL_SIZE in wasm/CMakeLists.txt) on larger datasets. The arrow
+         // issues the scan thread pool works around do not affect the browser build, which runs
+         // acero with a single-threaded executor.
+         max_queued_batches(1),
+         max_parallel_batches(1),
+#else
+         max_queued_batches(query_options.table_scan_prefetch_batches + 1),
+         max_parallel_batches(std::max<size_t>(query_options.table_scan_parallelism, 1)),
+#endif
+         bitmap_reader(bitmap_filter.toRoaring(), query_options.materialization_cutoff) {
+   }
+
+   BatchFuture nextBatch() {
+      SPDLOG_TRACE("TableScanGenerator::operator()");
+      std::vector<PendingBatch> batches_to_start;
+      BatchFuture next_batch;
+      {
+         const std::lock_guard lock{mutex};
+         if (isCancelled()) {
+            // The batches that are queued or still in the bitmap are never produced
+            for (const auto& batch : queued_batches) {
+               if (!batch.started) {
+                  cancellation_token->addSkippedRows(batch.row_ids.cardinality());
+               }
+            }
+            queued_batches.clear();
+            cancellation_token->addSkippedRows(bitmap_reader.remainingRows());
+            bitmap_reader_exhausted = true;
+            return BatchFuture::MakeFinished(cancelledStatus());
+         }
+         cutBatchesFromBitmap();
+         if (queued_batches.empty()) {
+            return BatchFuture::MakeFinished(std::nullopt);
+         }
+         batches_to_start = takeStartableBatches();
+         next_batch = queued_batches.front().future;
+         queued_batches.pop_front();
       }
-      current_bitmap_reader = std::nullopt;
+      startBatches(std::move(batches_to_start));
+#ifdef __EMSCRIPTEN__
+      return next_batch;
+#else
+      // The batch is finished on a scan thread, which must not run the consumer's continuations:
+      // a consumer that is held up would keep the thread from producing the batches of other scans
+      return callback_executor->Transfer(std::move(next_batch));
+#endif
    }
-   return std::nullopt;
+
+  private:
+   [[nodiscard]] bool isCancelled() const {
+      return cancellation_token != nullptr && cancellation_token->isCancelled();
+   }
+
+   [[nodiscard]] arrow::Status cancelledStatus() const {
+      return arrow::Status::Cancelled(
+         QueryCancelledException{
+            cancellation_token->requestId(), cancellation_token->cancellationReason()
+         }
+            .what()
+      );
+   }
+
+   // Requires `mutex` to be held
+   void cutBatchesFromBitmap() {
+      while (!bitmap_reader_exhausted && queued_batches.size() < max_queued_batches) {
+         auto row_ids = bitmap_reader.nextBatch();
+         if (!row_ids.has_value()) {
+            bitmap_reader_exhausted = true;
+            break;
+         }
+         queued_batches.push_back(
+            PendingBatch{.row_ids = std::move(row_ids.value()), .future = BatchFuture::Make()}
+         );
+      }
+   }
+
+   // Requires `mutex` to be held. Batches are started in row id order, so that the one the
+   // consumer waits for is never overtaken by prefetched ones.
+   std::vector<PendingBatch> takeStartableBatches() {
+      std::vector<PendingBatch> batches_to_start;
+      for (auto& batch : queued_batches) {
+         if (num_running_batches >= max_parallel_batches) {
+            break;
+         }
+         if (batch.started) {
+            continue;
+         }
+         batch.started = true;
+         ++num_running_batches;
+         batches_to_start.push_back(
+            PendingBatch{.row_ids = std::move(batch.row_ids), .future = batch.future}
+         );
+      }
+      return batches_to_start;
+   }
+
+   // Must not be called with `mutex` held: finishing a future runs the consumer's callbacks,
+   // which may request the next batch right away.
+   void startBatches(std::vector<PendingBatch> batches) {
+      for (auto& batch : batches) {
+#ifdef __EMSCRIPTEN__
+         runBatch(std::move(batch));
+#else
+         auto future = batch.future;
+         auto status = getScanThreadPool()->Spawn(
+            [self = shared_from_this(), batch = std::move(batch)]() mutable {
+               self->runBatch(std::move(batch));
+            }
+         );
+         if (!status.ok()) {
+            finishBatch(std::move(future), std::move(status));
+         }
+#endif
+      }
+   }
+
+   void runBatch(PendingBatch batch) {
+      EVOBENCH_SCOPE("TableScanGenerator", "produceNextBatch");
+      // The batch runs on a scan thread, which knows nothing about the query
+      const CancellationToken::ActiveScope active_token{cancellation_token};
+      arrow::Result<std::optional<arrow::ExecBatch>> result;
+      if (isCancelled()) {
+         cancellation_token->addSkippedRows(batch.row_ids.cardinality());
+         finishBatch(batch.future, cancelledStatus());
+         return;
+      }
+      try {
+         result = materializeBatch(batch.row_ids);
+      } catch (const std::exception& exception) {
+         result = arrow::Status::ExecutionError(exception.what());
+      }
+      finishBatch(batch.future, std::move(result));
+   }
+
+   void finishBatch(BatchFuture future, arrow::Result<std::optional<arrow::ExecBatch>> result) {
+      std::vector<PendingBatch> batches_to_start;
+      {
+         const std::lock_guard lock{mutex};
+         --num_running_batches;
+         batches_to_start = takeStartableBatches();
+      }
+      startBatches(std::move(batches_to_start));
+      future.MarkFinished(std::move(result));
+   }
+
+   arrow::Result<std::optional<arrow::ExecBatch>> materializeBatch(const roaring::Roaring& row_ids
+   ) {
+      // Every batch gets its own builder, so that batches can be materialized concurrently
+      ExecBatchBuilder exec_batch_builder{columns, memory_pool};
+      ARROW_RETURN_NOT_OK(exec_batch_builder.appendEntries(*table, row_ids));
+      ARROW_ASSIGN_OR_RAISE(auto batch, exec_batch_builder.finishBatch());
+      SPDLOG_DEBUG("Finished arrow::ExecBatch with length: {}", batch.length);
+      return batch;
+   }
+};
+
+TableScanGenerator::TableScanGenerator(
+   const std::vector<rhydb::schema::ColumnIdentifier>& columns,
+   CopyOnWriteBitmap bitmap_filter,
+   std::shared_ptr<const storage::Table> table,
+   const config::QueryOptions& query_options,
+   arrow::MemoryPool* memory_pool,
+   std::shared_ptr<CancellationToken> cancellation_token,
+   arrow::internal::Executor* callback_executor
+)
+    : state(std::make_shared<State>(
+         columns,
+         bitmap_filter,
+         std::move(table),
+         query_options,
+         memory_pool,
+         std::move(cancellation_token),
+         callback_executor
+      )) {}
+
+arrow::Future<std::optional<arrow::ExecBatch>> TableScanGenerator::operator()() {
+   return state->nextBatch();
 }
 
 arrow::Result<arrow::acero::ExecNode*> makeTableScan(
@@ -233,10 +462,16 @@ arrow::Result<arrow::acero::ExecNode*> makeTableScan(
    const std::vector<rhydb::schema::ColumnIdentifier>& columns,
    CopyOnWriteBitmap bitmap_filter_,
    std::shared_ptr<const storage::Table> table,
-   size_t batch_size_cutoff
+   const config::QueryOptions& query_options
 ) {
    const exec_node::TableScanGenerator generator(
-      columns, std::move(bitmap_filter_), std::move(table), batch_size_cutoff
+      columns,
+      std::move(bitmap_filter_),
+      std::move(table),
+      query_options,
+      plan->query_context()->memory_pool(),
+      CancellationToken::active(),
+      plan->query_context()->executor()
    );
    const arrow::acero::SourceNodeOptions source_node_options{
       exec_node::columnsToArrowSchema(columns), generator, arrow::Ordering::Implicit()
@@ -7,10 +7,12 @@
 #include <arrow/acero/options.h>
 #include <arrow/builder.h>
 #include <arrow/record_batch.h>
+#include <arrow/util/thread_pool.h>
 #include <spdlog/spdlog.h>
 #include <nlohmann/json_fwd.hpp>
 
-#include "rhydb/query_engine/batched_bitmap_reader.h"
+#include "rhydb/config/runtime_config.h"
+#include "rhydb/query_engine/cancellation_token.h"
 #include "rhydb/query_engine/copy_on_write_bitmap.h"
 #include "rhydb/query_engine/exec_node/arrow_util.h"
 #include "rhydb/storage/table.h"
@@ -23,7 +25,10 @@ class ExecBatchBuilder {
    std::vector<rhydb::schema::ColumnIdentifier> output_fields;
 
   public:
-   explicit ExecBatchBuilder(std::vector<rhydb::schema::ColumnIdentifier> output_fields);
+   ExecBatchBuilder(
+      std::vector<rhydb::schema::ColumnIdentifier> output_fields,
+      arrow::MemoryPool* memory_pool
+   );
 
    template <storage::column::Column Column>
    std::map<std::string, ArrowBuilder<Column>*> getColumnTypeArrayBuilders() {
@@ -39,69 +44,49 @@ class ExecBatchBuilder {
    arrow::Result<arrow::ExecBatch> finishBatch();
 };
 
+/// The source of a table scan: produces the rows in `bitmap_filter` in row id order, at most
+/// `materialization_cutoff + 1` rows per batch.
+///
+/// Batches are materialized on the scan thread pool (see `getScanThreadPool`). While the consumer
+/// processes one batch, up to `table_scan_prefetch_batches` following batches are produced in
+/// the background, at most `table_scan_parallelism` of them at the same time. Batches are always
+/// handed out in order. Copies of a generator share their state, as acero stores the generator
+/// in a `std::function`. The batches are allocated from `memory_pool`, the pool of the plan.
+///
+/// The consumer's continuations run on `callback_executor` (arrow's CPU thread pool if none is
+/// given), never on the scan thread pool. A consumer that is held up, e.g. by backpressure from a
+/// slow client, thereby never blocks a scan thread that other queries need for their batches.
+///
+/// Once `cancellation_token` is cancelled, batches that did not start yet are not materialized
+/// and the generator fails with a `Cancelled` status, so that an abandoned query does not keep
+/// the scan threads busy.
 class TableScanGenerator {
-   ExecBatchBuilder exec_batch_builder;
+   class State;
 
-   CopyOnWriteBitmap bitmap_filter;
-
-   std::optional<BatchedBitmapReader> current_bitmap_reader;
-
-   const std::shared_ptr<const storage::Table> table;
+   std::shared_ptr<State> state;
 
   public:
    TableScanGenerator(
       const std::vector<rhydb::schema::ColumnIdentifier>& columns,
-      CopyOnWriteBitmap bitmap_filter_,
+      CopyOnWriteBitmap bitmap_filter,
       std::shared_ptr<const storage::Table> table,
-      size_t batch_size_cutoff
-   )
-       : exec_batch_builder(columns),
-         bitmap_filter(std::move(bitmap_filter_)),
-         table(std::move(table)) {
-      current_bitmap_reader = BatchedBitmapReader{bitmap_filter.toRoaring(), batch_size_cutoff};
-   }
-
-   arrow::Future<std::optional<arrow::ExecBatch>> operator()() {
-      SPDLOG_TRACE("TableScanGenerator::operator()");
-      auto future = arrow::Future<std::optional<arrow::ExecBatch>>::Make();
-#ifdef __EMSCRIPTEN__
-      // In the browser build we produce the batch synchronously. Spawning a
-      // detached pthread per batch (as the native path does below) starves or
-      // deadlocks Emscripten's fixed pthread worker pool (PTHREAD_POOL_SIZE in
-      // wasm/CMakeLists.txt) on larger datasets. The arrow issues worked around
-      // below do not affect the browser build, which runs acero with a
-      // single-threaded executor.
-      try {
-         auto result = produceNextBatch();
-         future.MarkFinished(std::move(result));
-      } catch (const std::exception& exception) {
-         future.MarkFinished(arrow::Status::ExecutionError(exception.what()));
-      }
-#else
-      // We do this to guard against https://github.com/apache/arrow/issues/47641
-      // and https://github.com/apache/arrow/issues/47642
-      std::thread([future, this]() mutable {
-         try {
-            auto result = produceNextBatch();
-            future.MarkFinished(std::move(result));
-         } catch (const std::exception& exception) {
-            future.MarkFinished(arrow::Status::ExecutionError(exception.what()));
-         }
-      }).detach();
-#endif
-      return future;
-   };
+      const config::QueryOptions& query_options,
+      arrow::MemoryPool* memory_pool,
+      std::shared_ptr<CancellationToken> cancellation_token = nullptr,
+      arrow::internal::Executor* callback_executor = nullptr
+   );
 
-  private:
-   arrow::Result<std::optional<arrow::ExecBatch>> produceNextBatch();
+   arrow::Future<std::optional<arrow::ExecBatch>> operator()();
 };
 
+/// The scan is cancelled with the active `CancellationToken` of the planning thread. Its batches are
+/// handed to the plan on the executor of the plan.
 arrow::Result<arrow::acero::ExecNode*> makeTableScan(
    arrow::acero::ExecPlan* plan,
    const std::vector<rhydb::schema::ColumnIdentifier>& columns,
    CopyOnWriteBitmap bitmap_filter_,
    std::shared_ptr<const storage::Table> table,
-   size_t batch_size_cutoff
+   const config::QueryOptions& query_options
 );
 
 }  // namespace rhydb::query_engine::exec_node
@@ -0,0 +1,224 @@
+#include <atomic>
+#include <future>
+#include <optional>
+#include <sstream>
+#include <thread>
+
+#include <arrow/memory_pool.h>
+#include <arrow/util/thread_pool.h>
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <roaring/roaring.hh>
+
+#include "rhydb/query_engine/copy_on_write_bitmap.h"
+#include "rhydb/query_engine/exec_node/scan_thread_pool.h"
+#include "rhydb/query_engine/exec_node/table_scan.h"
+#include "rhydb/test/query_fixture.test.h"
+
+namespace {
+using nlohmann::json;
+
+using rhydb::ReferenceGenomes;
+using rhydb::config::QueryOptions;
+using rhydb::test::QueryTestData;
+using rhydb::test::QueryTestScenario;
+
+constexpr int NUMBER_OF_ROWS = 50;
+
+std::vector<json> makeData() {
+   std::vector<json> data;
+   for (int row = 0; row < NUMBER_OF_ROWS; ++row) {
+      data.push_back(
+         {{"key", fmt::format("id{:02}", row)},
+          {"value", row},
+          {"segment1", nullptr},
+          {"gene1", nullptr},
+          {"unaligned_segment1", nullptr}}
+      );
+   }
+   return data;
+}
+
+json makeExpectedRows() {
+   json rows = json::array();
+   for (int row = 0; row < NUMBER_OF_ROWS; ++row) {
+      rows.push_back({{"key", fmt::format("id{:02}", row)}, {"value", row}});
+   }
+   return rows;
+}
+
+const auto DATABASE_CONFIG =
+   R"(
+schema:
+  instanceName: "dummy name"
+  metadata:
+    - name: "key"
+      type: "string"
+    - name: "value"
+      type: "int"
+  primaryKey: "key"
+)";
+
+const auto REFERENCE_GENOMES = ReferenceGenomes{
+   {{"segment1", "A"}},
+   {{"gene1", "*"}},
+};
+
+const QueryTestData TEST_DATA{
+   .ndjson_input_data = makeData(),
+   .database_config = DATABASE_CONFIG,
+   .reference_genomes = REFERENCE_GENOMES
+};
+
+// A materialization cutoff of 0 produces one batch per row, so the batches of these scenarios
+// are materialized out of order on the scan threads. They must still be returned in row order.
+
+const QueryTestScenario ONE_BATCH_AT_A_TIME = {
+   .name = "ONE_BATCH_AT_A_TIME",
+   .query = "default.project({key, value})",
+   .expected_query_result = makeExpectedRows(),
+   .query_options = QueryOptions{
+      .materialization_cutoff = 0, .table_scan_prefetch_batches = 0, .table_scan_parallelism = 1
+   }
+};
+
+const QueryTestScenario PREFETCH_WITHOUT_PARALLELISM = {
+   .name = "PREFETCH_WITHOUT_PARALLELISM",
+   .query = "default.project({key, value})",
+   .expected_query_result = makeExpectedRows(),
+   .query_options = QueryOptions{
+      .materialization_cutoff = 0, .table_scan_prefetch_batches = 8, .table_scan_parallelism = 1
+   }
+};
+
+const QueryTestScenario PREFETCH_WITH_PARALLELISM = {
+   .name = "PREFETCH_WITH_PARALLELISM",
+   .query = "default.project({key, value})",
+   .expected_query_result = makeExpectedRows(),
+   .query_options = QueryOptions{
+      .materialization_cutoff = 0, .table_scan_prefetch_batches = 8, .table_scan_parallelism = 4
+   }
+};
+
+const QueryTestScenario PARALLELISM_ABOVE_PREFETCH = {
+   .name = "PARALLELISM_ABOVE_PREFETCH",
+   .query = "default.project({key, value})",
+   .expected_query_result = makeExpectedRows(),
+   .query_options = QueryOptions{
+      .materialization_cutoff = 0, .table_scan_prefetch_batches = 1, .table_scan_parallelism = 16
+   }
+};
+
+const QueryTestScenario PREFETCH_BEYOND_END_OF_FILTER = {
+   .name = "PREFETCH_BEYOND_END_OF_FILTER",
+   .query = "default.filter(value < 3).project({key, value})",
+   .expected_query_result = json::parse(
+      R"([{"key": "id00", "value": 0},
+          {"key": "id01", "value": 1},
+          {"key": "id02", "value": 2}])"
+   ),
+   .query_options = QueryOptions{
+      .materialization_cutoff = 0, .table_scan_prefetch_batches = 8, .table_scan_parallelism = 4
+   }
+};
+
+const QueryTestScenario EMPTY_FILTER_WITH_PREFETCH = {
+   .name = "EMPTY_FILTER_WITH_PREFETCH",
+   .query = "default.filter(value < 0).project({key, value})",
+   .expected_query_result = json::array(),
+   .query_options = QueryOptions{
+      .materialization_cutoff = 0, .table_scan_prefetch_batches = 8, .table_scan_parallelism = 4
+   }
+};
+
+}  // namespace
+
+QUERY_TEST(
+   TableScanTest,
+   TEST_DATA,
+   ::testing::Values(
+      ONE_BATCH_AT_A_TIME,
+      PREFETCH_WITHOUT_PARALLELISM,
+      PREFETCH_WITH_PARALLELISM,
+      PARALLELISM_ABOVE_PREFETCH,
+      PREFETCH_BEYOND_END_OF_FILTER,
+      EMPTY_FILTER_WITH_PREFETCH
+   )
+);
+
+// A consumer that is held up must not keep a scan thread from producing the batches of other
+// scans. With a single scan thread, the second scan only finishes if the continuation of the
+// stalled consumer runs elsewhere.
+TEST(TableScanGenerator, stalledConsumerDoesNotBlockOtherScans) {
+   using rhydb::query_engine::CopyOnWriteBitmap;
+   using rhydb::query_engine::exec_node::setScanThreadPoolCapacity;
+   using rhydb::query_engine::exec_node::TableScanGenerator;
+
+   auto database = std::make_shared<rhydb::Database>();
+   rhydb::initialize::Initializer::createTableInDatabase(
+      rhydb::schema::TableName::getDefault(),
+      rhydb::config::DatabaseConfig::getValidatedConfig(DATABASE_CONFIG),
+      REFERENCE_GENOMES,
+      {},
+      rhydb::common::PhyloTree{},
+      /*without_unaligned_sequences=*/false,
+      *database
+   );
+   std::stringstream ndjson;
+   for (const auto& row : makeData()) {
+      ndjson << row.dump() << "\n";
+   }
+   database->appendData(rhydb::schema::TableName::getDefault(), ndjson);
+   const auto table = database->tables.at(rhydb::schema::TableName::getDefault());
+   const std::vector<rhydb::schema::ColumnIdentifier> columns{
+      {.name = "value", .type = rhydb::schema::ColumnType::INT32}
+   };
+   const QueryOptions options{
+      .materialization_cutoff = 0, .table_scan_prefetch_batches = 0, .table_scan_parallelism = 1
+   };
+   auto callback_pool = arrow::internal::ThreadPool::Make(2).ValueOrDie();
+
+   ASSERT_TRUE(setScanThreadPoolCapacity(1).ok());
+   TableScanGenerator stalled_scan{
+      columns,
+      CopyOnWriteBitmap{roaring::Roaring{0, 1}},
+      table,
+      options,
+      arrow::default_memory_pool(),
+      nullptr,
+      callback_pool.get()
+   };
+   std::promise<void> release_consumer;
+   const std::shared_future<void> consumer_released = release_consumer.get_future().share();
+   std::atomic<bool> consumer_stalled = false;
+   auto stalled_consumer =
+      stalled_scan().Then([&](const std::optional<arrow::ExecBatch>& /*batch*/) {
+         consumer_stalled = true;
+         consumer_released.wait();
+      });
+   while (!consumer_stalled) {
+      std::this_thread::yield();
+   }
+
+   TableScanGenerator other_scan{
+      columns,
+      CopyOnWriteBitmap{roaring::Roaring{2, 3}},
+      table,
+      options,
+      arrow::default_memory_pool(),
+      nullptr,
+      callback_pool.get()
+   };
+   auto other_batch = other_scan();
+   const bool other_scan_finished = other_batch.Wait(/*seconds=*/30.0);
+
+   release_consumer.set_value();
+   stalled_consumer.Wait();
+   ASSERT_TRUE(setScanThreadPoolCapacity(0).ok());
+
+   ASSERT_TRUE(other_scan_finished);
+   ASSERT_TRUE(other_batch.result().ok());
+   ASSERT_TRUE(other_batch.result()->has_value());
+   EXPECT_EQ(other_batch.result()->value().length, 1);
+}
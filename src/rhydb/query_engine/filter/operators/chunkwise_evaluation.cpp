@@ -0,0 +1,132 @@
+#include "rhydb/query_engine/filter/operators/chunkwise_evaluation.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <roaring/roaring.hh>
+
+#include "evobench/evobench.hpp"
+#include "rhydb/query_engine/cancellation_token.h"
+#include "rhydb/roaring_util/bitmap_builder.h"
+
+namespace rhydb::query_engine::filter::operators {
+
+namespace {
+
+/// The null containers of a bitmap, looked up for ascending keys
+class NullContainers {
+   const roaring::internal::roaring_array_t& containers;
+   std::span<const uint16_t> keys;
+   size_t position;
+
+  public:
+   NullContainers(const roaring::Roaring& null_bitmap, size_t first_key)
+       : containers(null_bitmap.roaring.high_low_container),
+         keys(containers.keys, static_cast<size_t>(containers.size)),
+         position(static_cast<size_t>(
+            std::lower_bound(keys.begin(), keys.end(), first_key) - keys.begin()
+         )) {}
+
+   /// The index of the container of `key` in the bitmap, if it has one. `key` must not be smaller
+   /// than in the previous call.
+   [[nodiscard]] std::optional<size_t> find(uint16_t key) {
+      while (position < keys.size() && keys[position] < key) {
+         ++position;
+      }
+      if (position < keys.size() && keys[position] == key) {
+         return position;
+      }
+      return std::nullopt;
+   }
+
+   [[nodiscard]] const roaring::internal::container_t* container(size_t index) const {
+      return containers.containers[index];
+   }
+
+   [[nodiscard]] uint8_t typecode(size_t index) const { return containers.typecodes[index]; }
+};
+
+}  // namespace
+
+roaring::Roaring evaluateChunkwise(
+   const storage::column::RowLayout& row_layout,
+   const roaring::Roaring& null_bitmap,
+   bool with_nulls,
+   size_t first_chunk,
+   size_t end_chunk,
+   const std::function<ChunkMatch(size_t chunk_idx)>& match_chunk,
+   const std::function<void(size_t chunk_idx, std::span<uint64_t, CHUNK_BITSET_WORDS> words)>&
+      compare_chunk
+) {
+   EVOBENCH_SCOPE("ChunkwiseEvaluation", "evaluateChunkwise");
+   NullContainers null_containers{null_bitmap, first_chunk};
+   roaring::Roaring result;
+   for (size_t chunk_idx = first_chunk; chunk_idx < end_chunk; ++chunk_idx) {
+      CancellationToken::throwIfActiveCancelled(
+         (end_chunk - chunk_idx) * storage::column::COLUMN_CHUNK_SIZE
+      );
+      const auto chunk_id = static_cast<uint16_t>(chunk_idx);
+      const auto null_idx = null_containers.find(chunk_id);
+      const ChunkMatch chunk_match = match_chunk(chunk_idx);
+
+      if (chunk_match == ChunkMatch::NO_ROWS) {
+         if (with_nulls && null_idx.has_value()) {
+            const uint8_t typecode = null_containers.typecode(*null_idx);
+            roaring_util::appendContainer(
+               result,
+               chunk_id,
+               roaring::internal::container_clone(null_containers.container(*null_idx), typecode),
+               typecode
+            );
+         }
+         continue;
+      }
+
+      roaring::internal::container_t* container = nullptr;
+      uint8_t typecode = 0;
+      if (chunk_match == ChunkMatch::ALL_ROWS) {
+         container = roaring::internal::container_range_of_ones(
+            0, row_layout.chunkSize(chunk_id), &typecode
+         );
+         if (with_nulls) {
+            // The non-null rows and the null rows match, i.e. all rows
+            roaring_util::appendContainer(result, chunk_id, container, typecode);
+            continue;
+         }
+      } else {
+         auto* bitset = roaring::internal::bitset_container_create();
+         compare_chunk(
+            chunk_idx, std::span<uint64_t, CHUNK_BITSET_WORDS>{bitset->words, CHUNK_BITSET_WORDS}
+         );
+         bitset->cardinality = roaring::internal::bitset_container_compute_cardinality(bitset);
+         container = bitset;
+         typecode = BITSET_CONTAINER_TYPE;
+      }
+
+      if (!null_idx.has_value()) {
+         roaring_util::appendContainer(result, chunk_id, container, typecode);
+         continue;
+      }
+      // Null rows hold arbitrary values, so their bits are overwritten with `with_nulls`
+      const auto* null_container = null_containers.container(*null_idx);
+      const uint8_t null_typecode = null_containers.typecode(*null_idx);
+      uint8_t result_typecode = 0;
+      roaring::internal::container_t* result_container = nullptr;
+      if (with_nulls) {
+         result_container = roaring::internal::container_or(
+            container, typecode, null_container, null_typecode, &result_typecode
+         );
+      } else {
+         result_container = roaring::internal::container_andnot(
+            container, typecode, null_container, null_typecode, &result_typecode
+         );
+      }
+      roaring::internal::container_free(container, typecode);
+      roaring_util::appendContainer(result, chunk_id, result_container, result_typecode);
+   }
+   return result;
+}
+
+}  // namespace rhydb::query_engine::filter::operators
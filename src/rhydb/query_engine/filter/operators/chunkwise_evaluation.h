@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+
+#include <roaring/roaring.hh>
+
+#include "rhydb/common/panic.h"
+#include "rhydb/query_engine/filter/operators/comparator.h"
+#include "rhydb/storage/column/column.h"
+#include "rhydb/storage/column/row_layout.h"
+#include "rhydb/storage/column/zone_map.h"
+
+namespace rhydb::query_engine::filter::operators {
+
+/// The number of 64-bit words of a roaring bitset container, which holds the rows of one chunk
+constexpr size_t CHUNK_BITSET_WORDS = storage::column::COLUMN_CHUNK_SIZE / 64;
+
+/// Which non-null rows of a chunk match a predicate, as far as the zone map of the chunk tells
+enum class ChunkMatch : uint8_t {
+   NO_ROWS,
+   SOME_ROWS,
+   ALL_ROWS
+};
+
+/// Whether the non-null values of a chunk with `zone_map` compare to `value`
+template <typename T, typename Value>
+[[nodiscard]] ChunkMatch matchZoneMap(
+   const storage::column::ZoneMap<T>& zone_map,
+   Comparator comparator,
+   const Value& value
+) {
+   if (zone_map.allNull()) {
+      return ChunkMatch::NO_ROWS;
+   }
+   if (!zone_map.hasBounds()) {
+      return ChunkMatch::SOME_ROWS;
+   }
+   const T& min = *zone_map.min;
+   const T& max = *zone_map.max;
+   // `ALL_ROWS` if all values in the bounds match, `NO_ROWS` if none does
+   const auto decide = [](bool all_match, bool none_match) {
+      if (all_match) {
+         return ChunkMatch::ALL_ROWS;
+      }
+      return none_match ? ChunkMatch::NO_ROWS : ChunkMatch::SOME_ROWS;
+   };
+   const bool only_value = min == value && max == value;
+   const bool outside_bounds = value < min || max < value;
+   switch (comparator) {
+      case Comparator::EQUALS:
+         return decide(only_value, outside_bounds);
+      case Comparator::NOT_EQUALS:
+         return decide(outside_bounds, only_value);
+      case Comparator::LESS:
+         return decide(max < value, !(min < value));
+      case Comparator::HIGHER:
+         return decide(value < min, !(value < max));
+      case Comparator::LESS_OR_EQUALS:
+         return decide(max <= value, value < min);
+      case Comparator::HIGHER_OR_EQUALS:
+         return decide(value <= min, max < value);
+   }
+   SILO_UNREACHABLE();
+}
+
+/// The values from `lower` on, up to `upper` inclusive or exclusive, as `upper_comparator` is
+/// `LESS_OR_EQUALS` or `LESS`
+template <typename T>
+struct ValueRange {
+   T lower;
+   T upper;
+   Comparator upper_comparator = Comparator::LESS_OR_EQUALS;
+
+   [[nodiscard]] bool contains(const T& value) const {
+      const bool below_upper =
+         upper_comparator == Comparator::LESS ? value < upper : value <= upper;
+      return lower <= value && below_upper;
+   }
+};
+
+/// Whether the non-null values of a chunk with `zone_map` lie in `range`
+template <typename T, typename Value>
+[[nodiscard]] ChunkMatch matchZoneMap(
+   const storage::column::ZoneMap<T>& zone_map,
+   const ValueRange<Value>& range
+) {
+   const ChunkMatch lower_match =
+      matchZoneMap(zone_map, Comparator::HIGHER_OR_EQUALS, range.lower);
+   const ChunkMatch upper_match = matchZoneMap(zone_map, range.upper_comparator, range.upper);
+   if (lower_match == ChunkMatch::NO_ROWS || upper_match == ChunkMatch::NO_ROWS) {
+      return ChunkMatch::NO_ROWS;
+   }
+   if (lower_match == ChunkMatch::ALL_ROWS && upper_match == ChunkMatch::ALL_ROWS) {
+      return ChunkMatch::ALL_ROWS;
+   }
+   return ChunkMatch::SOME_ROWS;
+}
+
+/// The match of the negated predicate, which matches the non-null rows that the predicate does not
+[[nodiscard]] inline ChunkMatch negateChunkMatch(ChunkMatch chunk_match) {
+   switch (chunk_match) {
+      case ChunkMatch::NO_ROWS:
+         return ChunkMatch::ALL_ROWS;
+      case ChunkMatch::SOME_ROWS:
+         return ChunkMatch::SOME_ROWS;
+      case ChunkMatch::ALL_ROWS:
+         return ChunkMatch::NO_ROWS;
+   }
+   SILO_UNREACHABLE();
+}
+
+/// Computes the rows of the chunks `[first_chunk, end_chunk)` that match a predicate on the values
+/// of a column, one chunk at a time. `match_chunk(chunk_idx)` tells from the zone map which
+/// non-null rows of a chunk match. Only for `SOME_ROWS` are the values looked at:
+/// `compare_chunk(chunk_idx, words)` then sets the bits of the matching rows of the chunk. The null
+/// rows (the rows of `null_bitmap`) are part of the result iff `with_nulls`, they are removed
+/// from or added to every chunk's result with its null container in bulk. Stops with
+/// `QueryCancelledException` between chunks once the active `CancellationToken` is cancelled.
+[[nodiscard]] roaring::Roaring evaluateChunkwise(
+   const storage::column::RowLayout& row_layout,
+   const roaring::Roaring& null_bitmap,
+   bool with_nulls,
+   size_t first_chunk,
+   size_t end_chunk,
+   const std::function<ChunkMatch(size_t chunk_idx)>& match_chunk,
+   const std::function<void(size_t chunk_idx, std::span<uint64_t, CHUNK_BITSET_WORDS> words)>&
+      compare_chunk
+);
+
+}  // namespace rhydb::query_engine::filter::operators
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "rhydb/common/panic.h"
+
+namespace rhydb::query_engine::filter::operators {
+
+enum class Comparator : uint8_t {
+   EQUALS,
+   LESS,
+   HIGHER,
+   LESS_OR_EQUALS,
+   HIGHER_OR_EQUALS,
+   NOT_EQUALS
+};
+
+inline std::string displayComparator(Comparator comparator) {
+   switch (comparator) {
+      case Comparator::EQUALS:
+         return "=";
+      case Comparator::NOT_EQUALS:
+         return "!=";
+      case Comparator::LESS:
+         return "<";
+      case Comparator::HIGHER:
+         return ">";
+      case Comparator::LESS_OR_EQUALS:
+         return "<=";
+      case Comparator::HIGHER_OR_EQUALS:
+         return ">=";
+   }
+   SILO_UNREACHABLE();
+}
+
+}  // namespace rhydb::query_engine::filter::operators
@@ -0,0 +1,639 @@
+#include "rhydb/query_engine/filter/operators/compare_kernels.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define RHYDB_COMPARE_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+#include <roaring/roaring.hh>
+
+#include "evobench/evobench.hpp"
+#include "rhydb/common/panic.h"
+
+namespace rhydb::query_engine::filter::operators {
+
+namespace {
+
+constexpr size_t BITS_PER_WORD = 64;
+
+template <Comparator COMPARATOR, typename T>
+bool compares(T lhs, T rhs) {
+   if constexpr (COMPARATOR == Comparator::EQUALS) {
+      return lhs == rhs;
+   } else if constexpr (COMPARATOR == Comparator::NOT_EQUALS) {
+      return lhs != rhs;
+   } else if constexpr (COMPARATOR == Comparator::LESS) {
+      return lhs < rhs;
+   } else if constexpr (COMPARATOR == Comparator::HIGHER) {
+      return lhs > rhs;
+   } else if constexpr (COMPARATOR == Comparator::LESS_OR_EQUALS) {
+      return lhs <= rhs;
+   } else {
+      return lhs >= rhs;
+   }
+}
+
+/// Fills the words from `first_word` on, the last of which may be partial. Branch-free, so that
+/// the compiler can vectorize it for the instruction set of the build.
+template <Comparator COMPARATOR, typename T>
+void compareScalar(std::span<const T> values, T value, uint64_t* words, size_t first_word) {
+   for (size_t offset = first_word * BITS_PER_WORD; offset < values.size();
+        offset += BITS_PER_WORD) {
+      const size_t count = std::min(BITS_PER_WORD, values.size() - offset);
+      uint64_t word = 0;
+      for (size_t bit = 0; bit < count; ++bit) {
+         word |= static_cast<uint64_t>(compares<COMPARATOR>(values[offset + bit], value)) << bit;
+      }
+      words[offset / BITS_PER_WORD] = word;
+   }
+}
+
+#ifdef RHYDB_COMPARE_KERNELS_X86
+
+/// AVX2 only has equality and greater-than comparisons for integers, the other comparators are
+/// computed as the complement of one of them
+constexpr bool isComplementOfIntegerCompare(Comparator comparator) {
+   return comparator == Comparator::NOT_EQUALS || comparator == Comparator::LESS_OR_EQUALS ||
+          comparator == Comparator::HIGHER_OR_EQUALS;
+}
+
+/// Ordered, non-signalling predicates, except for `!=` which like in C++ holds for NaN
+constexpr int floatingPointPredicate(Comparator comparator) {
+   switch (comparator) {
+      case Comparator::EQUALS:
+         return _CMP_EQ_OQ;
+      case Comparator::NOT_EQUALS:
+         return _CMP_NEQ_UQ;
+      case Comparator::LESS:
+         return _CMP_LT_OQ;
+      case Comparator::HIGHER:
+         return _CMP_GT_OQ;
+      case Comparator::LESS_OR_EQUALS:
+         return _CMP_LE_OQ;
+      case Comparator::HIGHER_OR_EQUALS:
+         return _CMP_GE_OQ;
+   }
+   SILO_UNREACHABLE();
+}
+
+constexpr int integerPredicate(Comparator comparator) {
+   switch (comparator) {
+      case Comparator::EQUALS:
+         return _MM_CMPINT_EQ;
+      case Comparator::NOT_EQUALS:
+         return _MM_CMPINT_NE;
+      case Comparator::LESS:
+         return _MM_CMPINT_LT;
+      case Comparator::HIGHER:
+         return _MM_CMPINT_NLE;
+      case Comparator::LESS_OR_EQUALS:
+         return _MM_CMPINT_LE;
+      case Comparator::HIGHER_OR_EQUALS:
+         return _MM_CMPINT_NLT;
+   }
+   SILO_UNREACHABLE();
+}
+
+template <Comparator COMPARATOR>
+__attribute__((target("avx2"))) __m256i compareIntegersAvx2(__m256i data, __m256i value) {
+   if constexpr (COMPARATOR == Comparator::EQUALS || COMPARATOR == Comparator::NOT_EQUALS) {
+      return _mm256_cmpeq_epi32(data, value);
+   } else if constexpr (COMPARATOR == Comparator::HIGHER ||
+                        COMPARATOR == Comparator::LESS_OR_EQUALS) {
+      return _mm256_cmpgt_epi32(data, value);
+   } else {
+      return _mm256_cmpgt_epi32(value, data);
+   }
+}
+
+template <Comparator COMPARATOR>
+__attribute__((target("avx2"))) __m256i compareIntegers64Avx2(__m256i data, __m256i value) {
+   if constexpr (COMPARATOR == Comparator::EQUALS || COMPARATOR == Comparator::NOT_EQUALS) {
+      return _mm256_cmpeq_epi64(data, value);
+   } else if constexpr (COMPARATOR == Comparator::HIGHER ||
+                        COMPARATOR == Comparator::LESS_OR_EQUALS) {
+      return _mm256_cmpgt_epi64(data, value);
+   } else {
+      return _mm256_cmpgt_epi64(value, data);
+   }
+}
+
+template <Comparator COMPARATOR>
+__attribute__((target("avx2"))) uint64_t compareWordAvx2(const int32_t* block, __m256i value) {
+   uint64_t word = 0;
+   for (size_t lane = 0; lane < BITS_PER_WORD; lane += 8) {
+      const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + lane));
+      const __m256i mask = compareIntegersAvx2<COMPARATOR>(data, value);
+      word |= static_cast<uint64_t>(
+                 static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(mask)))
+              )
+              << lane;
+   }
+   return isComplementOfIntegerCompare(COMPARATOR) ? ~word : word;
+}
+
+template <Comparator COMPARATOR>
+__attribute__((target("avx2"))) uint64_t compareWordAvx2(const int64_t* block, __m256i value) {
+   uint64_t word = 0;
+   for (size_t lane = 0; lane < BITS_PER_WORD; lane += 4) {
+      const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + lane));
+      const __m256i mask = compareIntegers64Avx2<COMPARATOR>(data, value);
+      word |= static_cast<uint64_t>(
+                 static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(mask)))
+              )
+              << lane;
+   }
+   return isComplementOfIntegerCompare(COMPARATOR) ? ~word : word;
+}
+
+template <Comparator COMPARATOR>
+__attribute__((target("avx2"))) uint64_t compareWordAvx2(const double* block, __m256d value) {
+   constexpr int PREDICATE = floatingPointPredicate(COMPARATOR);
+   uint64_t word = 0;
+   for (size_t lane = 0; lane < BITS_PER_WORD; lane += 4) {
+      const __m256d mask = _mm256_cmp_pd(_mm256_loadu_pd(block + lane), value, PREDICATE);
+      word |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_pd(mask))) << lane;
+   }
+   return word;
+}
+
+__attribute__((target("avx2"))) __m256i broadcastAvx2(int32_t value) {
+   return _mm256_set1_epi32(value);
+}
+
+__attribute__((target("avx2"))) __m256i broadcastAvx2(int64_t value) {
+   return _mm256_set1_epi64x(value);
+}
+
+__attribute__((target("avx2"))) __m256d broadcastAvx2(double value) {
+   return _mm256_set1_pd(value);
+}
+
+template <Comparator COMPARATOR, typename T>
+__attribute__((target("avx2"))) void compareAvx2(
+   std::span<const T> values,
+   T value,
+   uint64_t* words
+) {
+   const auto broadcast_value = broadcastAvx2(value);
+   const size_t full_words = values.size() / BITS_PER_WORD;
+   for (size_t word_idx = 0; word_idx < full_words; ++word_idx) {
+      words[word_idx] =
+         compareWordAvx2<COMPARATOR>(values.data() + (word_idx * BITS_PER_WORD), broadcast_value);
+   }
+   compareScalar<COMPARATOR>(values, value, words, full_words);
+}
+
+template <Comparator COMPARATOR>
+__attribute__((target("avx512f"))) uint64_t compareWordAvx512(
+   const int32_t* block,
+   __m512i value
+) {
+   constexpr int PREDICATE = integerPredicate(COMPARATOR);
+   uint64_t word = 0;
+   for (size_t lane = 0; lane < BITS_PER_WORD; lane += 16) {
+      const __m512i data = _mm512_loadu_si512(block + lane);
+      word |= static_cast<uint64_t>(_mm512_cmp_epi32_mask(data, value, PREDICATE)) << lane;
+   }
+   return word;
+}
+
+template <Comparator COMPARATOR>
+__attribute__((target("avx512f"))) uint64_t compareWordAvx512(
+   const int64_t* block,
+   __m512i value
+) {
+   constexpr int PREDICATE = integerPredicate(COMPARATOR);
+   uint64_t word = 0;
+   for (size_t lane = 0; lane < BITS_PER_WORD; lane += 8) {
+      const __m512i data = _mm512_loadu_si512(block + lane);
+      word |= static_cast<uint64_t>(_mm512_cmp_epi64_mask(data, value, PREDICATE)) << lane;
+   }
+   return word;
+}
+
+template <Comparator COMPARATOR>
+__attribute__((target("avx512f"))) uint64_t compareWordAvx512(const double* block, __m512d value) {
+   constexpr int PREDICATE = floatingPointPredicate(COMPARATOR);
+   uint64_t word = 0;
+   for (size_t lane = 0; lane < BITS_PER_WORD; lane += 8) {
+      const __m512d data = _mm512_loadu_pd(block + lane);
+      word |= static_cast<uint64_t>(_mm512_cmp_pd_mask(data, value, PREDICATE)) << lane;
+   }
+   return word;
+}
+
+__attribute__((target("avx512f"))) __m512i broadcastAvx512(int32_t value) {
+   return _mm512_set1_epi32(value);
+}
+
+__attribute__((target("avx512f"))) __m512i broadcastAvx512(int64_t value) {
+   return _mm512_set1_epi64(value);
+}
+
+__attribute__((target("avx512f"))) __m512d broadcastAvx512(double value) {
+   return _mm512_set1_pd(value);
+}
+
+template <Comparator COMPARATOR, typename T>
+__attribute__((target("avx512f"))) void compareAvx512(
+   std::span<const T> values,
+   T value,
+   uint64_t* words
+) {
+   const auto broadcast_value = broadcastAvx512(value);
+   const size_t full_words = values.size() / BITS_PER_WORD;
+   for (size_t word_idx = 0; word_idx < full_words; ++word_idx) {
+      words[word_idx] = compareWordAvx512<COMPARATOR>(
+         values.data() + (word_idx * BITS_PER_WORD), broadcast_value
+      );
+   }
+   compareScalar<COMPARATOR>(values, value, words, full_words);
+}
+
+#endif
+
+template <Comparator COMPARATOR, typename T>
+void compareWithIsa(
+   std::span<const T> values,
+   T value,
+   uint64_t* words,
+   [[maybe_unused]] CompareKernelIsa isa
+) {
+#ifdef RHYDB_COMPARE_KERNELS_X86
+   if (isa == CompareKernelIsa::AVX512) {
+      compareAvx512<COMPARATOR>(values, value, words);
+      return;
+   }
+   if (isa == CompareKernelIsa::AVX2) {
+      compareAvx2<COMPARATOR>(values, value, words);
+      return;
+   }
+#endif
+   compareScalar<COMPARATOR>(values, value, words, 0);
+}
+
+template <typename T>
+void compareToBitsetImpl(
+   std::span<const T> values,
+   Comparator comparator,
+   T value,
+   std::span<uint64_t, CHUNK_BITSET_WORDS> words,
+   CompareKernelIsa isa
+) {
+   SILO_ASSERT_LE(values.size(), storage::column::COLUMN_CHUNK_SIZE);
+   SILO_ASSERT(isa <= detectCompareKernelIsa());
+   const size_t used_words = (values.size() + BITS_PER_WORD - 1) / BITS_PER_WORD;
+   std::fill(words.begin() + static_cast<std::ptrdiff_t>(used_words), words.end(), 0);
+   switch (comparator) {
+      case Comparator::EQUALS:
+         compareWithIsa<Comparator::EQUALS>(values, value, words.data(), isa);
+         return;
+      case Comparator::NOT_EQUALS:
+         compareWithIsa<Comparator::NOT_EQUALS>(values, value, words.data(), isa);
+         return;
+      case Comparator::LESS:
+         compareWithIsa<Comparator::LESS>(values, value, words.data(), isa);
+         return;
+      case Comparator::HIGHER:
+         compareWithIsa<Comparator::HIGHER>(values, value, words.data(), isa);
+         return;
+      case Comparator::LESS_OR_EQUALS:
+         compareWithIsa<Comparator::LESS_OR_EQUALS>(values, value, words.data(), isa);
+         return;
+      case Comparator::HIGHER_OR_EQUALS:
+         compareWithIsa<Comparator::HIGHER_OR_EQUALS>(values, value, words.data(), isa);
+         return;
+   }
+   SILO_UNREACHABLE();
+}
+
+/// Inverts the first `count` bits of `words`, the bits past them stay cleared
+void invertBits(std::span<uint64_t, CHUNK_BITSET_WORDS> words, size_t count) {
+   const size_t full_words = count / BITS_PER_WORD;
+   for (size_t word_idx = 0; word_idx < full_words; ++word_idx) {
+      words[word_idx] = ~words[word_idx];
+   }
+   const size_t remaining_bits = count % BITS_PER_WORD;
+   if (remaining_bits != 0) {
+      words[full_words] = ~words[full_words] & ((uint64_t{1} << remaining_bits) - 1);
+   }
+}
+
+/// Sets the bits of the rows of `values` that lie in `range` if `within`, or outside of it
+/// otherwise
+template <typename T>
+void compareRangeToBitset(
+   std::span<const T> values,
+   const ValueRange<T>& range,
+   bool within,
+   std::span<uint64_t, CHUNK_BITSET_WORDS> words,
+   CompareKernelIsa isa
+) {
+   compareToBitset(values, Comparator::HIGHER_OR_EQUALS, range.lower, words, isa);
+   std::array<uint64_t, CHUNK_BITSET_WORDS> upper_words;
+   compareToBitset(values, range.upper_comparator, range.upper, upper_words, isa);
+   for (size_t word_idx = 0; word_idx < CHUNK_BITSET_WORDS; ++word_idx) {
+      words[word_idx] &= upper_words[word_idx];
+   }
+   if (!within) {
+      invertBits(words, values.size());
+   }
+}
+
+/// Sets the bits `[begin, end)` of `words` and clears all others
+void setBitRange(std::span<uint64_t, CHUNK_BITSET_WORDS> words, size_t begin, size_t end) {
+   std::ranges::fill(words, 0);
+   if (begin >= end) {
+      return;
+   }
+   const size_t first_word = begin / BITS_PER_WORD;
+   const size_t last_word = (end - 1) / BITS_PER_WORD;
+   std::fill(
+      words.begin() + static_cast<std::ptrdiff_t>(first_word),
+      words.begin() + static_cast<std::ptrdiff_t>(last_word) + 1,
+      ~uint64_t{0}
+   );
+   words[first_word] &= ~uint64_t{0} << (begin % BITS_PER_WORD);
+   words[last_word] &= ~uint64_t{0} >> (BITS_PER_WORD - 1 - ((end - 1) % BITS_PER_WORD));
+}
+
+/// The rows of a chunk with ascending `values` that compare to `value` are one range, or all rows
+/// but one range for `!=`. Two binary searches find it instead of comparing every value. A NaN
+/// `value` only differs from every value, like in `compareToBitset`; the searches cannot find that.
+template <typename T>
+void compareSortedToBitset(
+   std::span<const T> values,
+   Comparator comparator,
+   T value,
+   std::span<uint64_t, CHUNK_BITSET_WORDS> words
+) {
+   if constexpr (std::is_floating_point_v<T>) {
+      if (std::isnan(value)) {
+         setBitRange(words, 0, comparator == Comparator::NOT_EQUALS ? values.size() : 0);
+         return;
+      }
+   }
+   const auto lower = static_cast<size_t>(std::ranges::lower_bound(values, value) - values.begin());
+   const auto upper = static_cast<size_t>(std::ranges::upper_bound(values, value) - values.begin());
+   switch (comparator) {
+      case Comparator::EQUALS:
+         setBitRange(words, lower, upper);
+         return;
+      case Comparator::NOT_EQUALS:
+         setBitRange(words, lower, upper);
+         invertBits(words, values.size());
+         return;
+      case Comparator::LESS:
+         setBitRange(words, 0, lower);
+         return;
+      case Comparator::HIGHER:
+         setBitRange(words, upper, values.size());
+         return;
+      case Comparator::LESS_OR_EQUALS:
+         setBitRange(words, 0, upper);
+         return;
+      case Comparator::HIGHER_OR_EQUALS:
+         setBitRange(words, lower, values.size());
+         return;
+   }
+   SILO_UNREACHABLE();
+}
+
+/// Like `compareRangeToBitset`, for a chunk with ascending `values`
+template <typename T>
+void compareSortedRangeToBitset(
+   std::span<const T> values,
+   const ValueRange<T>& range,
+   bool within,
+   std::span<uint64_t, CHUNK_BITSET_WORDS> words
+) {
+   if constexpr (std::is_floating_point_v<T>) {
+      // No value lies in a range with a NaN bound
+      if (std::isnan(range.lower) || std::isnan(range.upper)) {
+         setBitRange(words, 0, within ? 0 : values.size());
+         return;
+      }
+   }
+   const auto begin = std::ranges::lower_bound(values, range.lower);
+   const auto end = range.upper_comparator == Comparator::LESS
+                       ? std::ranges::lower_bound(begin, values.end(), range.upper)
+                       : std::ranges::upper_bound(begin, values.end(), range.upper);
+   setBitRange(
+      words,
+      static_cast<size_t>(begin - values.begin()),
+      static_cast<size_t>(end - values.begin())
+   );
+   if (!within) {
+      invertBits(words, values.size());
+   }
+}
+
+}  // namespace
+
+CompareKernelIsa detectCompareKernelIsa() {
+   static const CompareKernelIsa detected_isa = [] {
+#ifdef RHYDB_COMPARE_KERNELS_X86
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx512f")) {
+         return CompareKernelIsa::AVX512;
+      }
+      if (__builtin_cpu_supports("avx2")) {
+         return CompareKernelIsa::AVX2;
+      }
+#endif
+      return CompareKernelIsa::SCALAR;
+   }();
+   return detected_isa;
+}
+
+std::string_view compareKernelIsaName(CompareKernelIsa isa) {
+   switch (isa) {
+      case CompareKernelIsa::SCALAR:
+         return "scalar";
+      case CompareKernelIsa::AVX2:
+         return "avx2";
+      case CompareKernelIsa::AVX512:
+         return "avx512";
+   }
+   SILO_UNREACHABLE();
+}
+
+void compareToBitset(
+   std::span<const int32_t> values,
+   Comparator comparator,
+   int32_t value,
+   std::span<uint64_t, CHUNK_BITSET_WORDS> words,
+   CompareKernelIsa isa
+) {
+   compareToBitsetImpl(values, comparator, value, words, isa);
+}
+
+void compareToBitset(
+   std::span<const int64_t> values,
+   Comparator comparator,
+   int64_t value,
+   std::span<uint64_t, CHUNK_BITSET_WORDS> words,
+   CompareKernelIsa isa
+) {
+   compareToBitsetImpl(values, comparator, value, words, isa);
+}
+
+void compareToBitset(
+   std::span<const double> values,
+   Comparator comparator,
+   double value,
+   std::span<uint64_t, CHUNK_BITSET_WORDS> words,
+   CompareKernelIsa isa
+) {
+   compareToBitsetImpl(values, comparator, value, words, isa);
+}
+
+template <typename T>
+roaring::Roaring compareChunksToValue(
+   const storage::column::ChunkedValueBuffer<T>& values,
+   const std::vector<storage::column::ZoneMap<T>>& zone_maps,
+   const roaring::Roaring& null_bitmap,
+   const storage::column::RowLayout& row_layout,
+   Comparator comparator,
+   T value,
+   bool with_nulls,
+   size_t first_chunk,
+   size_t end_chunk
+) {
+   EVOBENCH_SCOPE("CompareKernels", "compareChunksToValue");
+   const CompareKernelIsa isa = detectCompareKernelIsa();
+   return evaluateChunkwise(
+      row_layout,
+      null_bitmap,
+      with_nulls,
+      first_chunk,
+      end_chunk,
+      [&](size_t chunk_idx) { return matchZoneMap(zone_maps.at(chunk_idx), comparator, value); },
+      [&](size_t chunk_idx, std::span<uint64_t, CHUNK_BITSET_WORDS> words) {
+         if (zone_maps.at(chunk_idx).is_sorted) {
+            compareSortedToBitset(values.chunk(chunk_idx), comparator, value, words);
+         } else {
+            compareToBitset(values.chunk(chunk_idx), comparator, value, words, isa);
+         }
+      }
+   );
+}
+
+template <typename T>
+roaring::Roaring compareChunksToRange(
+   const storage::column::ChunkedValueBuffer<T>& values,
+   const std::vector<storage::column::ZoneMap<T>>& zone_maps,
+   const roaring::Roaring& null_bitmap,
+   const storage::column::RowLayout& row_layout,
+   const ValueRange<T>& range,
+   bool within,
+   bool with_nulls,
+   size_t first_chunk,
+   size_t end_chunk
+) {
+   EVOBENCH_SCOPE("CompareKernels", "compareChunksToRange");
+   const CompareKernelIsa isa = detectCompareKernelIsa();
+   return evaluateChunkwise(
+      row_layout,
+      null_bitmap,
+      with_nulls,
+      first_chunk,
+      end_chunk,
+      [&](size_t chunk_idx) {
+         const ChunkMatch chunk_match = matchZoneMap(zone_maps.at(chunk_idx), range);
+         return within ? chunk_match : negateChunkMatch(chunk_match);
+      },
+      [&](size_t chunk_idx, std::span<uint64_t, CHUNK_BITSET_WORDS> words) {
+         if (zone_maps.at(chunk_idx).is_sorted) {
+            compareSortedRangeToBitset(values.chunk(chunk_idx), range, within, words);
+         } else {
+            compareRangeToBitset(values.chunk(chunk_idx), range, within, words, isa);
+         }
+      }
+   );
+}
+
+template roaring::Roaring compareChunksToValue<int32_t>(
+   const storage::column::ChunkedValueBuffer<int32_t>& values,
+   const std::vector<storage::column::ZoneMap<int32_t>>& zone_maps,
+   const roaring::Roaring& null_bitmap,
+   const storage::column::RowLayout& row_layout,
+   Comparator comparator,
+   int32_t value,
+   bool with_nulls,
+   size_t first_chunk,
+   size_t end_chunk
+);
+
+template roaring::Roaring compareChunksToValue<int64_t>(
+   const storage::column::ChunkedValueBuffer<int64_t>& values,
+   const std::vector<storage::column::ZoneMap<int64_t>>& zone_maps,
+   const roaring::Roaring& null_bitmap,
+   const storage::column::RowLayout& row_layout,
+   Comparator comparator,
+   int64_t value,
+   bool with_nulls,
+   size_t first_chunk,
+   size_t end_chunk
+);
+
+template roaring::Roaring compareChunksToValue<double>(
+   const storage::column::ChunkedValueBuffer<double>& values,
+   const std::vector<storage::column::ZoneMap<double>>& zone_maps,
+   const roaring::Roaring& null_bitmap,
+   const storage::column::RowLayout& row_layout,
+   Comparator comparator,
+   double value,
+   bool with_nulls,
+   size_t first_chunk,
+   size_t end_chunk
+);
+
+template roaring::Roaring compareChunksToRange<int32_t>(
+   const storage::column::ChunkedValueBuffer<int32_t>& values,
+   const std::vector<storage::column::ZoneMap<int32_t>>& zone_maps,
+   const roaring::Roaring& null_bitmap,
+   const storage::column::RowLayout& row_layout,
+   const ValueRange<int32_t>& range,
+   bool within,
+   bool with_nulls,
+   size_t first_chunk,
+   size_t end_chunk
+);
+
+template roaring::Roaring compareChunksToRange<int64_t>(
+   const storage::column::ChunkedValueBuffer<int64_t>& values,
+   const std::vector<storage::column::ZoneMap<int64_t>>& zone_maps,
+   const roaring::Roaring& null_bitmap,
+   const storage::column::RowLayout& row_layout,
+   const ValueRange<int64_t>& range,
+   bool within,
+   bool with_nulls,
+   size_t first_chunk,
+   size_t end_chunk
+);
+
+template roaring::Roaring compareChunksToRange<double>(
+   const storage::column::ChunkedValueBuffer<double>& values,
+   const std::vector<storage::column::ZoneMap<double>>& zone_maps,
+   const roaring::Roaring& null_bitmap,
+   const storage::column::RowLayout& row_layout,
+   const ValueRange<double>& range,
+   bool within,
+   bool with_nulls,
+   size_t first_chunk,
+   size_t end_chunk
+);
+
+}  // namespace rhydb::query_engine::filter::operators
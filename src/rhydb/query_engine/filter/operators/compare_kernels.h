@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <roaring/roaring.hh>
+
+#include "rhydb/query_engine/filter/operators/chunkwise_evaluation.h"
+#include "rhydb/query_engine/filter/operators/comparator.h"
+#include "rhydb/storage/column/chunked_value_buffer.h"
+#include "rhydb/storage/column/row_layout.h"
+#include "rhydb/storage/column/zone_map.h"
+
+namespace rhydb::query_engine::filter::operators {
+
+/// The instruction sets the compare kernels are implemented with. The kernels are compiled for all
+/// of them regardless of the target of the build, the one that is used is chosen at runtime.
+enum class CompareKernelIsa : uint8_t {
+   SCALAR,
+   AVX2,
+   AVX512
+};
+
+/// The best instruction set that the CPU the process runs on supports
+[[nodiscard]] CompareKernelIsa detectCompareKernelIsa();
+
+[[nodiscard]] std::string_view compareKernelIsaName(CompareKernelIsa isa);
+
+/// Sets bit `i` of `words` iff `values[i] <comparator> value`, all bits past `values.size()` are
+/// cleared. `values` must hold at most one chunk, i.e. `COLUMN_CHUNK_SIZE` values.
+void compareToBitset(
+   std::span<const int32_t> values,
+   Comparator comparator,
+   int32_t value,
+   std::span<uint64_t, CHUNK_BITSET_WORDS> words,
+   CompareKernelIsa isa = detectCompareKernelIsa()
+);
+
+void compareToBitset(
+   std::span<const int64_t> values,
+   Comparator comparator,
+   int64_t value,
+   std::span<uint64_t, CHUNK_BITSET_WORDS> words,
+   CompareKernelIsa isa = detectCompareKernelIsa()
+);
+
+void compareToBitset(
+   std::span<const double> values,
+   Comparator comparator,
+   double value,
+   std::span<uint64_t, CHUNK_BITSET_WORDS> words,
+   CompareKernelIsa isa = detectCompareKernelIsa()
+);
+
+/// The rows of the chunks `[first_chunk, end_chunk)` whose value compares to `value`. Null rows
+/// (the rows of `null_bitmap`) are part of the result iff `with_nulls`. Chunks whose zone map shows
+/// that none or all of their values match are not looked at, the others are compared into a bitset
+/// container (see `evaluateChunkwise`). In chunks whose zone map shows that they are sorted the
+/// matching rows are one range, which is found by binary search.
+template <typename T>
+[[nodiscard]] roaring::Roaring compareChunksToValue(
+   const storage::column::ChunkedValueBuffer<T>& values,
+   const std::vector<storage::column::ZoneMap<T>>& zone_maps,
+   const roaring::Roaring& null_bitmap,
+   const storage::column::RowLayout& row_layout,
+   Comparator comparator,
+   T value,
+   bool with_nulls,
+   size_t first_chunk,
+   size_t end_chunk
+);
+
+/// Like `compareChunksToValue`, for the rows whose value lies in `range` if `within`, or outside of
+/// it otherwise. Both bounds are compared in the same pass over a chunk.
+template <typename T>
+[[nodiscard]] roaring::Roaring compareChunksToRange(
+   const storage::column::ChunkedValueBuffer<T>& values,
+   const std::vector<storage::column::ZoneMap<T>>& zone_maps,
+   const roaring::Roaring& null_bitmap,
+   const storage::column::RowLayout& row_layout,
+   const ValueRange<T>& range,
+   bool within,
+   bool with_nulls,
+   size_t first_chunk,
+   size_t end_chunk
+);
+
+}  // namespace rhydb::query_engine::filter::operators
@@ -0,0 +1,462 @@
+#include "rhydb/query_engine/filter/operators/compare_kernels.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <roaring/roaring.hh>
+
+#include "rhydb/query_engine/filter/operators/selection.h"
+#include "rhydb/storage/column/column_metadata.h"
+#include "rhydb/storage/column/date32_column.h"
+#include "rhydb/storage/column/float_column.h"
+#include "rhydb/storage/column/int_column.h"
+#include "rhydb/storage/column/row_id.h"
+#include "rhydb/storage/column/row_layout.h"
+#include "rhydb/storage/column/string_column.h"
+
+using rhydb::query_engine::filter::operators::CHUNK_BITSET_WORDS;
+using rhydb::query_engine::filter::operators::Comparator;
+using rhydb::query_engine::filter::operators::CompareKernelIsa;
+using rhydb::query_engine::filter::operators::CompareToRangeSelection;
+using rhydb::query_engine::filter::operators::compareToBitset;
+using rhydb::query_engine::filter::operators::CompareToValueSelection;
+using rhydb::query_engine::filter::operators::detectCompareKernelIsa;
+using rhydb::query_engine::filter::operators::Predicate;
+using rhydb::query_engine::filter::operators::ValueRange;
+using rhydb::storage::column::COLUMN_CHUNK_SIZE;
+using rhydb::storage::column::ColumnMetadata;
+using rhydb::storage::column::Date32Column;
+using rhydb::storage::column::FloatColumn;
+using rhydb::storage::column::Int32Column;
+using rhydb::storage::column::Int64Column;
+using rhydb::storage::column::RowId;
+using rhydb::storage::column::RowLayout;
+using rhydb::storage::column::StringColumn;
+using rhydb::storage::column::StringColumnMetadata;
+
+namespace {
+
+constexpr std::array<Comparator, 6> ALL_COMPARATORS = {
+   Comparator::EQUALS,
+   Comparator::NOT_EQUALS,
+   Comparator::LESS,
+   Comparator::HIGHER,
+   Comparator::LESS_OR_EQUALS,
+   Comparator::HIGHER_OR_EQUALS
+};
+
+template <typename T>
+bool compares(T lhs, Comparator comparator, T rhs) {
+   switch (comparator) {
+      case Comparator::EQUALS:
+         return lhs == rhs;
+      case Comparator::NOT_EQUALS:
+         return lhs != rhs;
+      case Comparator::LESS:
+         return lhs < rhs;
+      case Comparator::HIGHER:
+         return lhs > rhs;
+      case Comparator::LESS_OR_EQUALS:
+         return lhs <= rhs;
+      case Comparator::HIGHER_OR_EQUALS:
+         return lhs >= rhs;
+   }
+   return false;
+}
+
+std::vector<CompareKernelIsa> supportedInstructionSets() {
+   std::vector<CompareKernelIsa> result{CompareKernelIsa::SCALAR};
+   if (detectCompareKernelIsa() >= CompareKernelIsa::AVX2) {
+      result.push_back(CompareKernelIsa::AVX2);
+   }
+   if (detectCompareKernelIsa() >= CompareKernelIsa::AVX512) {
+      result.push_back(CompareKernelIsa::AVX512);
+   }
+   return result;
+}
+
+/// Small values around the compared value 3, so that every comparator has matches
+template <typename T>
+std::vector<T> randomValues(size_t count, std::mt19937& rng) {
+   std::uniform_int_distribution<int32_t> distribution(-5, 10);
+   std::vector<T> values(count);
+   for (auto& value : values) {
+      value = static_cast<T>(distribution(rng));
+   }
+   return values;
+}
+
+template <typename T>
+void expectKernelsMatchComparingEachValue(const std::vector<T>& values) {
+   const T compared_value = 3;
+   for (const CompareKernelIsa isa : supportedInstructionSets()) {
+      for (const Comparator comparator : ALL_COMPARATORS) {
+         std::array<uint64_t, CHUNK_BITSET_WORDS> words{};
+         words.fill(~uint64_t{0});
+         compareToBitset(std::span<const T>{values}, comparator, compared_value, words, isa);
+         for (size_t idx = 0; idx < COLUMN_CHUNK_SIZE; ++idx) {
+            const bool expected =
+               idx < values.size() && compares(values.at(idx), comparator, compared_value);
+            const bool actual = ((words.at(idx / 64) >> (idx % 64)) & 1) != 0;
+            ASSERT_EQ(actual, expected) << "isa " << static_cast<int>(isa) << ", comparator "
+                                        << static_cast<int>(comparator) << ", index " << idx;
+         }
+      }
+   }
+}
+
+/// Appends a full and a partial chunk with a null in every seventh row
+template <typename ColumnType>
+void appendChunksWithNulls(ColumnType& column, std::mt19937& rng) {
+   for (const size_t chunk_size : {COLUMN_CHUNK_SIZE, size_t{1000}}) {
+      typename ColumnType::Builder builder;
+      const auto values = randomValues<typename ColumnType::value_type>(chunk_size, rng);
+      for (size_t row = 0; row < chunk_size; ++row) {
+         if (row % 7 == 0) {
+            builder.insertNull();
+         } else {
+            builder.insert(values.at(row));
+         }
+      }
+      ASSERT_TRUE(column.appendChunk(builder.finalize()).has_value());
+   }
+}
+
+void expectBitmapMatchesRowByRowEvaluation(
+   const Predicate& under_test,
+   const RowLayout& row_layout
+) {
+   roaring::Roaring expected;
+   roaring::Roaring expected_in_second_chunk;
+   for (const RowId row_id : row_layout) {
+      if (under_test.match(row_id)) {
+         expected.add(row_id.toGlobal());
+         if (row_id.chunk_id == 1) {
+            expected_in_second_chunk.add(row_id.toGlobal());
+         }
+      }
+   }
+   EXPECT_EQ(under_test.makeBitmap(row_layout), expected) << under_test.toString();
+   EXPECT_EQ(under_test.makeBitmapForChunks(row_layout, 1, 2), expected_in_second_chunk)
+      << under_test.toString();
+}
+
+template <typename ColumnType>
+void expectChunkwiseBitmapMatchesRowByRowEvaluation() {
+   auto metadata = std::make_shared<ColumnMetadata>("test");
+   ColumnType column{metadata.get()};
+   std::mt19937 rng(42);
+   appendChunksWithNulls(column, rng);
+   const auto row_layout = RowLayout::of(COLUMN_CHUNK_SIZE, 1000);
+
+   for (const Comparator comparator : ALL_COMPARATORS) {
+      for (const bool with_nulls : {false, true}) {
+         SCOPED_TRACE(with_nulls);
+         expectBitmapMatchesRowByRowEvaluation(
+            CompareToValueSelection<ColumnType>{column, comparator, 3, with_nulls}, row_layout
+         );
+      }
+   }
+}
+
+template <typename ColumnType>
+void expectRangeBitmapMatchesRowByRowEvaluation() {
+   using value_type = ColumnType::value_type;
+   auto metadata = std::make_shared<ColumnMetadata>("test");
+   ColumnType column{metadata.get()};
+   std::mt19937 rng(43);
+   appendChunksWithNulls(column, rng);
+   const auto row_layout = RowLayout::of(COLUMN_CHUNK_SIZE, 1000);
+
+   for (const Comparator upper_comparator : {Comparator::LESS, Comparator::LESS_OR_EQUALS}) {
+      for (const bool within : {false, true}) {
+         for (const bool with_nulls : {false, true}) {
+            SCOPED_TRACE(with_nulls);
+            const ValueRange<value_type> range{
+               .lower = -2, .upper = 5, .upper_comparator = upper_comparator
+            };
+            const CompareToRangeSelection<ColumnType> under_test{
+               column, range, within, with_nulls
+            };
+            expectBitmapMatchesRowByRowEvaluation(under_test, row_layout);
+            expectBitmapMatchesRowByRowEvaluation(*under_test.negate(), row_layout);
+         }
+      }
+   }
+}
+
+/// Appends chunks whose values lie in `[0, 9]`, `[10, 19]` and `[20, 29]`, with a null in every
+/// fifth row, so that the zone maps of the chunks do not overlap
+template <typename ColumnType>
+void appendChunksWithDisjointBounds(ColumnType& column) {
+   for (const int32_t chunk_offset : {0, 10, 20}) {
+      typename ColumnType::Builder builder;
+      for (int32_t row = 0; row < 1000; ++row) {
+         if (row % 5 == 0) {
+            builder.insertNull();
+         } else {
+            builder.insert(static_cast<typename ColumnType::value_type>(chunk_offset + (row % 10)));
+         }
+      }
+      ASSERT_TRUE(column.appendChunk(builder.finalize()).has_value());
+   }
+}
+
+template <typename ColumnType>
+void expectZoneMapsSkipAndTakeWholeChunks() {
+   using value_type = ColumnType::value_type;
+   auto metadata = std::make_shared<ColumnMetadata>("test");
+   ColumnType column{metadata.get()};
+   appendChunksWithDisjointBounds(column);
+   const auto row_layout = RowLayout::of(1000, 1000, 1000);
+
+   // Every chunk lies entirely below, above or inside the compared values for one of them
+   for (const int32_t compared_value : {-1, 9, 10, 15, 19, 20, 30}) {
+      for (const Comparator comparator : ALL_COMPARATORS) {
+         for (const bool with_nulls : {false, true}) {
+            SCOPED_TRACE(with_nulls);
+            expectBitmapMatchesRowByRowEvaluation(
+               CompareToValueSelection<ColumnType>{
+                  column, comparator, static_cast<value_type>(compared_value), with_nulls
+               },
+               row_layout
+            );
+         }
+      }
+   }
+   for (const bool within : {false, true}) {
+      for (const bool with_nulls : {false, true}) {
+         SCOPED_TRACE(with_nulls);
+         expectBitmapMatchesRowByRowEvaluation(
+            CompareToRangeSelection<ColumnType>{
+               column, ValueRange<value_type>{.lower = 10, .upper = 19}, within, with_nulls
+            },
+            row_layout
+         );
+         expectBitmapMatchesRowByRowEvaluation(
+            CompareToRangeSelection<ColumnType>{
+               column, ValueRange<value_type>{.lower = 5, .upper = 25}, within, with_nulls
+            },
+            row_layout
+         );
+      }
+   }
+}
+
+/// Compares a full and a partial chunk whose non-null values ascend within the chunk but not across
+/// the chunks, like data that is appended in batches, with a null in every seventh row
+template <typename ColumnType>
+void expectSortedChunksAreBinarySearched() {
+   using value_type = ColumnType::value_type;
+   auto metadata = std::make_shared<ColumnMetadata>("test");
+   ColumnType column{metadata.get()};
+   std::mt19937 rng(44);
+   for (const size_t chunk_size : {COLUMN_CHUNK_SIZE, size_t{1000}}) {
+      auto values = randomValues<value_type>(chunk_size, rng);
+      std::ranges::sort(values);
+      typename ColumnType::Builder builder;
+      for (size_t row = 0; row < chunk_size; ++row) {
+         if (row % 7 == 0) {
+            builder.insertNull();
+         } else {
+            builder.insert(values.at(row));
+         }
+      }
+      ASSERT_TRUE(column.appendChunk(builder.finalize()).has_value());
+   }
+   ASSERT_TRUE(column.getZoneMaps().at(0).is_sorted);
+   ASSERT_TRUE(column.getZoneMaps().at(1).is_sorted);
+   const auto row_layout = RowLayout::of(COLUMN_CHUNK_SIZE, 1000);
+
+   for (const int32_t compared_value : {-6, -5, 3, 10, 11}) {
+      for (const Comparator comparator : ALL_COMPARATORS) {
+         for (const bool with_nulls : {false, true}) {
+            SCOPED_TRACE(with_nulls);
+            expectBitmapMatchesRowByRowEvaluation(
+               CompareToValueSelection<ColumnType>{
+                  column, comparator, static_cast<value_type>(compared_value), with_nulls
+               },
+               row_layout
+            );
+         }
+      }
+   }
+   for (const Comparator upper_comparator : {Comparator::LESS, Comparator::LESS_OR_EQUALS}) {
+      for (const bool within : {false, true}) {
+         for (const int32_t upper : {-2, 5, 10}) {
+            const ValueRange<value_type> range{
+               .lower = -2,
+               .upper = static_cast<value_type>(upper),
+               .upper_comparator = upper_comparator
+            };
+            expectBitmapMatchesRowByRowEvaluation(
+               CompareToRangeSelection<ColumnType>{column, range, within, false}, row_layout
+            );
+         }
+      }
+   }
+}
+
+}  // namespace
+
+TEST(CompareKernels, int32KernelsMatchComparingEachValue) {
+   std::mt19937 rng(1);
+   for (const size_t count : {size_t{0}, size_t{1}, size_t{63}, size_t{64}, size_t{1000}}) {
+      expectKernelsMatchComparingEachValue(randomValues<int32_t>(count, rng));
+   }
+   expectKernelsMatchComparingEachValue(randomValues<int32_t>(COLUMN_CHUNK_SIZE, rng));
+   expectKernelsMatchComparingEachValue(std::vector<int32_t>{
+      std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max(), 3, -3
+   });
+}
+
+TEST(CompareKernels, int64KernelsMatchComparingEachValue) {
+   std::mt19937 rng(2);
+   for (const size_t count : {size_t{0}, size_t{1}, size_t{63}, size_t{64}, size_t{1000}}) {
+      expectKernelsMatchComparingEachValue(randomValues<int64_t>(count, rng));
+   }
+   expectKernelsMatchComparingEachValue(randomValues<int64_t>(COLUMN_CHUNK_SIZE, rng));
+   expectKernelsMatchComparingEachValue(std::vector<int64_t>{
+      std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(), 3, -3
+   });
+}
+
+TEST(CompareKernels, floatKernelsMatchComparingEachValueIncludingNaN) {
+   std::mt19937 rng(3);
+   auto values = randomValues<double>(COLUMN_CHUNK_SIZE - 5, rng);
+   for (size_t idx = 0; idx < values.size(); idx += 13) {
+      values.at(idx) = std::nan("");
+   }
+   values.at(1) = std::numeric_limits<double>::infinity();
+   values.at(2) = 3.0000001;
+   expectKernelsMatchComparingEachValue(values);
+}
+
+TEST(CompareKernels, int32ColumnBitmapMatchesRowByRowEvaluation) {
+   expectChunkwiseBitmapMatchesRowByRowEvaluation<Int32Column>();
+}
+
+TEST(CompareKernels, int64ColumnBitmapMatchesRowByRowEvaluation) {
+   expectChunkwiseBitmapMatchesRowByRowEvaluation<Int64Column>();
+}
+
+TEST(CompareKernels, floatColumnBitmapMatchesRowByRowEvaluation) {
+   expectChunkwiseBitmapMatchesRowByRowEvaluation<FloatColumn>();
+}
+
+TEST(CompareKernels, date32ColumnBitmapMatchesRowByRowEvaluation) {
+   expectChunkwiseBitmapMatchesRowByRowEvaluation<Date32Column>();
+}
+
+TEST(CompareKernels, int32RangeBitmapMatchesRowByRowEvaluation) {
+   expectRangeBitmapMatchesRowByRowEvaluation<Int32Column>();
+}
+
+TEST(CompareKernels, floatRangeBitmapMatchesRowByRowEvaluation) {
+   expectRangeBitmapMatchesRowByRowEvaluation<FloatColumn>();
+}
+
+TEST(CompareKernels, date32RangeBitmapMatchesRowByRowEvaluation) {
+   expectRangeBitmapMatchesRowByRowEvaluation<Date32Column>();
+}
+
+TEST(CompareKernels, sortedInt32ChunksAreBinarySearched) {
+   expectSortedChunksAreBinarySearched<Int32Column>();
+}
+
+TEST(CompareKernels, sortedDate32ChunksAreBinarySearched) {
+   expectSortedChunksAreBinarySearched<Date32Column>();
+}
+
+TEST(CompareKernels, sortedFloatChunksAreBinarySearched) {
+   expectSortedChunksAreBinarySearched<FloatColumn>();
+}
+
+TEST(CompareKernels, sortedFloatChunksMatchNoValueForNaN) {
+   auto metadata = std::make_shared<ColumnMetadata>("test");
+   FloatColumn column{metadata.get()};
+   FloatColumn::Builder builder;
+   for (int32_t row = 0; row < 1000; ++row) {
+      if (row % 7 == 0) {
+         builder.insertNull();
+      } else {
+         builder.insert(static_cast<double>(row) / 10.0);
+      }
+   }
+   ASSERT_TRUE(column.appendChunk(builder.finalize()).has_value());
+   ASSERT_TRUE(column.getZoneMaps().at(0).is_sorted);
+   const auto row_layout = RowLayout::of(1000);
+   const double nan = std::numeric_limits<double>::quiet_NaN();
+
+   for (const Comparator comparator : ALL_COMPARATORS) {
+      for (const bool with_nulls : {false, true}) {
+         SCOPED_TRACE(with_nulls);
+         expectBitmapMatchesRowByRowEvaluation(
+            CompareToValueSelection<FloatColumn>{column, comparator, nan, with_nulls}, row_layout
+         );
+      }
+   }
+   EXPECT_TRUE(CompareToValueSelection<FloatColumn>{column, Comparator::EQUALS, nan, false}
+                  .makeBitmap(row_layout)
+                  .isEmpty());
+   for (const bool within : {false, true}) {
+      expectBitmapMatchesRowByRowEvaluation(
+         CompareToRangeSelection<FloatColumn>{
+            column, ValueRange<double>{.lower = nan, .upper = 50.0}, within, false
+         },
+         row_layout
+      );
+      expectBitmapMatchesRowByRowEvaluation(
+         CompareToRangeSelection<FloatColumn>{
+            column, ValueRange<double>{.lower = 1.0, .upper = nan}, within, false
+         },
+         row_layout
+      );
+   }
+}
+
+TEST(CompareKernels, int64ZoneMapsSkipAndTakeWholeChunks) {
+   expectZoneMapsSkipAndTakeWholeChunks<Int64Column>();
+}
+
+TEST(CompareKernels, floatZoneMapsSkipAndTakeWholeChunks) {
+   expectZoneMapsSkipAndTakeWholeChunks<FloatColumn>();
+}
+
+TEST(CompareKernels, stringZoneMapsSkipAndTakeWholeChunks) {
+   StringColumnMetadata metadata{"test"};
+   StringColumn column{&metadata};
+   for (const std::string prefix : {"a", "b", "c"}) {
+      StringColumn::Builder builder;
+      for (int32_t row = 0; row < 1000; ++row) {
+         if (row % 5 == 0) {
+            builder.insertNull();
+         } else {
+            builder.insert(prefix + std::to_string(row % 10) + "-longer-than-a-short-string");
+         }
+      }
+      ASSERT_TRUE(column.appendChunk(builder.finalize()).has_value());
+   }
+   const auto row_layout = RowLayout::of(1000, 1000, 1000);
+
+   for (const std::string_view compared_value : {"a", "b", "b5", "c9-z", "d"}) {
+      for (const Comparator comparator : ALL_COMPARATORS) {
+         for (const bool with_nulls : {false, true}) {
+            SCOPED_TRACE(with_nulls);
+            const CompareToValueSelection<StringColumn> under_test{
+               column, comparator, compared_value, with_nulls
+            };
+            expectBitmapMatchesRowByRowEvaluation(under_test, row_layout);
+         }
+      }
+   }
+}
@@ -1,5 +1,7 @@
 #include "rhydb/query_engine/filter/operators/intersection.h"
 
+#include <cstddef>
+#include <iterator>
 #include <string>
 #include <utility>
 #include <vector>
@@ -11,6 +13,7 @@
 #include "rhydb/query_engine/copy_on_write_bitmap.h"
 #include "rhydb/query_engine/filter/operators/complement.h"
 #include "rhydb/query_engine/filter/operators/operator.h"
+#include "rhydb/query_engine/filter/operators/parallel_evaluation.h"
 #include "rhydb/query_engine/query_compilation_exception.h"
 
 namespace rhydb::query_engine::filter::operators {
@@ -58,18 +61,21 @@ Type Intersection::type() const {
 
 CopyOnWriteBitmap Intersection::evaluate() const {
    EVOBENCH_SCOPE("Intersection", "evaluate");
-   std::vector<CopyOnWriteBitmap> children_bm;
-   children_bm.reserve(children.size());
-   std::ranges::transform(children, std::back_inserter(children_bm), [&](const auto& child) {
-      return child->evaluate();
-   });
-   std::vector<CopyOnWriteBitmap> negated_children_bm;
-   negated_children_bm.reserve(negated_children.size());
-   std::ranges::transform(
-      negated_children,
-      std::back_inserter(negated_children_bm),
-      [&](const auto& child) { return child->evaluate(); }
+   std::vector<const Operator*> all_children;
+   all_children.reserve(children.size() + negated_children.size());
+   for (const auto& child : children) {
+      all_children.push_back(child.get());
+   }
+   for (const auto& child : negated_children) {
+      all_children.push_back(child.get());
+   }
+   std::vector<CopyOnWriteBitmap> children_bm =
+      evaluateChildren(all_children, row_layout.numRows());
+   std::vector<CopyOnWriteBitmap> negated_children_bm(
+      std::make_move_iterator(children_bm.begin() + static_cast<ptrdiff_t>(children.size())),
+      std::make_move_iterator(children_bm.end())
    );
+   children_bm.resize(children.size());
    // Sort ascending, such that intermediate results are kept small
    std::ranges::sort(
       children_bm,
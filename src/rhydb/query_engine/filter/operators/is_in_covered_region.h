@@ -34,6 +34,8 @@ class IsInCoveredRegion : public Predicate {
    [[nodiscard]] bool match(storage::column::RowId row_id) const override;
    [[nodiscard]] roaring::Roaring makeBitmap(const storage::column::RowLayout& row_layout
    ) const override;
+   /// The coverage bitmap is computed for all rows at once
+   [[nodiscard]] bool canEvaluateByChunks() const override { return false; }
    [[nodiscard]] double estimateSelectivity(uint32_t row_count) const override;
 
    [[nodiscard]] std::unique_ptr<Predicate> copy() const override;
@@ -0,0 +1,115 @@
+#include "rhydb/query_engine/filter/operators/parallel_evaluation.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <arrow/util/thread_pool.h>
+
+#include "evobench/evobench.hpp"
+#include "rhydb/common/parallel.h"
+#include "rhydb/query_engine/cancellation_token.h"
+
+namespace rhydb::query_engine::filter::operators {
+
+namespace {
+
+/// More ranges than threads, so that threads that finish early can take over the remaining work
+/// when the matching rows are unevenly distributed over the chunks
+constexpr size_t CHUNK_RANGES_PER_THREAD = 4;
+
+/// Operators that only wrap existing bitmaps, which is faster than handing them to another thread
+bool isTrivialToEvaluate(const Operator& child) {
+   const Type type = child.type();
+   return type == EMPTY || type == FULL || type == INDEX_SCAN;
+}
+
+}  // namespace
+
+bool shouldEvaluateInParallel(size_t row_count) {
+   if (row_count < PARALLEL_EVALUATION_MIN_ROWS) {
+      return false;
+   }
+   auto* pool = arrow::internal::GetCpuThreadPool();
+   return pool->GetCapacity() > 1 && !pool->OwnsThisThread();
+}
+
+std::vector<CopyOnWriteBitmap> evaluateChildren(
+   const std::vector<const Operator*>& children,
+   size_t row_count
+) {
+   std::vector<CopyOnWriteBitmap> results(children.size());
+   std::vector<size_t> expensive_children;
+   for (size_t child_idx = 0; child_idx < children.size(); ++child_idx) {
+      if (isTrivialToEvaluate(*children.at(child_idx))) {
+         results.at(child_idx) = children.at(child_idx)->evaluate();
+      } else {
+         expensive_children.push_back(child_idx);
+      }
+   }
+
+   if (expensive_children.size() < 2 || !shouldEvaluateInParallel(row_count)) {
+      for (const size_t child_idx : expensive_children) {
+         CancellationToken::throwIfActiveCancelled(row_count);
+         results.at(child_idx) = children.at(child_idx)->evaluate();
+      }
+      return results;
+   }
+
+   EVOBENCH_SCOPE("ParallelEvaluation", "evaluateChildren");
+   const auto cancellation_token = CancellationToken::active();
+   common::parallelFor(
+      common::BlockedRange{0, expensive_children.size()},
+      1,
+      [&](common::BlockedRange range) {
+         const CancellationToken::ActiveScope active_token{cancellation_token};
+         for (size_t idx = range.begin(); idx < range.end(); ++idx) {
+            CancellationToken::throwIfActiveCancelled(row_count);
+            const size_t child_idx = expensive_children.at(idx);
+            results.at(child_idx) = children.at(child_idx)->evaluate();
+         }
+      }
+   );
+   return results;
+}
+
+std::vector<CopyOnWriteBitmap> evaluateChildren(const OperatorVector& children, size_t row_count) {
+   std::vector<const Operator*> child_pointers;
+   child_pointers.reserve(children.size());
+   for (const auto& child : children) {
+      child_pointers.push_back(child.get());
+   }
+   return evaluateChildren(child_pointers, row_count);
+}
+
+CopyOnWriteBitmap evaluateByChunkRanges(
+   const storage::column::RowLayout& row_layout,
+   size_t row_count,
+   const std::function<CopyOnWriteBitmap(size_t first_chunk, size_t end_chunk)>& evaluate_chunks
+) {
+   const size_t num_chunks = row_layout.numChunks();
+   if (num_chunks < 2 || !shouldEvaluateInParallel(row_count)) {
+      return evaluate_chunks(0, num_chunks);
+   }
+
+   EVOBENCH_SCOPE("ParallelEvaluation", "evaluateByChunkRanges");
+   const auto num_threads =
+      static_cast<size_t>(std::max(1, arrow::internal::GetCpuThreadPool()->GetCapacity()));
+   const size_t num_ranges = std::min(num_chunks, num_threads * CHUNK_RANGES_PER_THREAD);
+   std::vector<CopyOnWriteBitmap> range_results(num_ranges);
+   const auto cancellation_token = CancellationToken::active();
+   common::parallelFor(common::BlockedRange{0, num_ranges}, 1, [&](common::BlockedRange ranges) {
+      // The tasks run on the threads of arrow's pool, which know nothing about the query
+      const CancellationToken::ActiveScope active_token{cancellation_token};
+      for (size_t range_idx = ranges.begin(); range_idx < ranges.end(); ++range_idx) {
+         const size_t first_chunk = range_idx * num_chunks / num_ranges;
+         const size_t end_chunk = (range_idx + 1) * num_chunks / num_ranges;
+         CancellationToken::throwIfActiveCancelled(
+            (end_chunk - first_chunk) * storage::column::COLUMN_CHUNK_SIZE
+         );
+         range_results.at(range_idx) = evaluate_chunks(first_chunk, end_chunk);
+      }
+   });
+   return CopyOnWriteBitmap::concatenate(std::move(range_results));
+}
+
+}  // namespace rhydb::query_engine::filter::operators
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "rhydb/query_engine/copy_on_write_bitmap.h"
+#include "rhydb/query_engine/filter/operators/operator.h"
+#include "rhydb/storage/column/row_layout.h"
+
+namespace rhydb::query_engine::filter::operators {
+
+/// Work over fewer rows than this is always done on the calling thread, where it is faster than
+/// handing it to other threads
+constexpr size_t PARALLEL_EVALUATION_MIN_ROWS = size_t{1} << 20;
+
+/// Whether work over `row_count` rows should be spread over arrow's CPU thread pool. Never true on
+/// a thread of that pool itself: waiting there for other tasks of the pool could occupy all of its
+/// threads with waiting, so nested operators are evaluated on the thread that evaluates the parent.
+[[nodiscard]] bool shouldEvaluateInParallel(size_t row_count);
+
+/// Evaluates all `children` of an operator over `row_count` rows. Independent children that do more
+/// than wrapping an existing bitmap are evaluated concurrently if `shouldEvaluateInParallel`, with
+/// the active `CancellationToken` of the calling thread.
+[[nodiscard]] std::vector<CopyOnWriteBitmap> evaluateChildren(
+   const std::vector<const Operator*>& children,
+   size_t row_count
+);
+
+[[nodiscard]] std::vector<CopyOnWriteBitmap> evaluateChildren(
+   const OperatorVector& children,
+   size_t row_count
+);
+
+/// Computes a bitmap that is chunk-local, i.e. whose rows of a chunk only depend on that chunk.
+/// `evaluate_chunks(first_chunk, end_chunk)` must return the rows of chunks
+/// `[first_chunk, end_chunk)`. If `shouldEvaluateInParallel(row_count)`, the chunks are split into
+/// ranges that are computed concurrently and whose results are concatenated, otherwise all chunks
+/// are computed with a single call on the calling thread.
+[[nodiscard]] CopyOnWriteBitmap evaluateByChunkRanges(
+   const storage::column::RowLayout& row_layout,
+   size_t row_count,
+   const std::function<CopyOnWriteBitmap(size_t first_chunk, size_t end_chunk)>& evaluate_chunks
+);
+
+}  // namespace rhydb::query_engine::filter::operators
@@ -0,0 +1,222 @@
+#include "rhydb/query_engine/filter/operators/parallel_evaluation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <arrow/util/thread_pool.h>
+#include <gtest/gtest.h>
+#include <roaring/roaring.hh>
+
+#include "rhydb/query_engine/cancellation_token.h"
+#include "rhydb/query_engine/filter/operators/index_scan.h"
+#include "rhydb/query_engine/filter/operators/selection.h"
+#include "rhydb/query_engine/filter/operators/threshold.h"
+#include "rhydb/storage/column/column.h"
+#include "rhydb/storage/column/row_id.h"
+
+using rhydb::query_engine::CancellationReason;
+using rhydb::query_engine::CancellationToken;
+using rhydb::query_engine::CopyOnWriteBitmap;
+using rhydb::query_engine::QueryCancelledException;
+using rhydb::query_engine::filter::operators::evaluateByChunkRanges;
+using rhydb::query_engine::filter::operators::IndexScan;
+using rhydb::query_engine::filter::operators::OperatorVector;
+using rhydb::query_engine::filter::operators::PARALLEL_EVALUATION_MIN_ROWS;
+using rhydb::query_engine::filter::operators::Predicate;
+using rhydb::query_engine::filter::operators::Selection;
+using rhydb::query_engine::filter::operators::Threshold;
+using rhydb::storage::column::COLUMN_CHUNK_SIZE;
+using rhydb::storage::column::RowId;
+using rhydb::storage::column::RowLayout;
+
+namespace {
+
+// Enough full chunks to exceed the cutoff for parallel evaluation
+RowLayout largeRowLayout() {
+   RowLayout row_layout;
+   const size_t num_chunks = (PARALLEL_EVALUATION_MIN_ROWS / COLUMN_CHUNK_SIZE) + 4;
+   for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+      row_layout.appendChunk(COLUMN_CHUNK_SIZE);
+   }
+   return row_layout;
+}
+
+class RowInChunkDivisibleBy : public Predicate {
+   uint16_t divisor;
+
+  public:
+   explicit RowInChunkDivisibleBy(uint16_t divisor)
+       : divisor(divisor) {}
+
+   [[nodiscard]] std::string toString() const override { return "RowInChunkDivisibleBy"; }
+
+   [[nodiscard]] bool match(RowId row_id) const override {
+      return row_id.row_in_chunk % divisor == 0;
+   }
+
+   [[nodiscard]] std::unique_ptr<Predicate> copy() const override {
+      return std::make_unique<RowInChunkDivisibleBy>(divisor);
+   }
+
+   [[nodiscard]] std::unique_ptr<Predicate> negate() const override { return nullptr; }
+};
+
+}  // namespace
+
+TEST(ParallelEvaluation, evaluateByChunkRangesCoversEveryChunkExactlyOnce) {
+   const RowLayout row_layout = largeRowLayout();
+
+   std::mutex mutex;
+   std::vector<size_t> calls_per_chunk(row_layout.numChunks());
+   const CopyOnWriteBitmap result = evaluateByChunkRanges(
+      row_layout,
+      row_layout.numRows(),
+      [&](size_t first_chunk, size_t end_chunk) {
+         roaring::Roaring chunk_starts;
+         const std::scoped_lock lock{mutex};
+         for (size_t chunk = first_chunk; chunk < end_chunk; ++chunk) {
+            ++calls_per_chunk.at(chunk);
+            chunk_starts.add(RowId::chunkStart(static_cast<uint16_t>(chunk)));
+         }
+         return CopyOnWriteBitmap{std::move(chunk_starts)};
+      }
+   );
+
+   EXPECT_EQ(result.cardinality(), row_layout.numChunks());
+   for (const size_t calls : calls_per_chunk) {
+      EXPECT_EQ(calls, 1);
+   }
+}
+
+TEST(ParallelEvaluation, evaluateByChunkRangesKeepsSmallInputsInOneCall) {
+   const RowLayout row_layout = RowLayout::of(10, 20, 30);
+
+   size_t calls = 0;
+   const CopyOnWriteBitmap result = evaluateByChunkRanges(
+      row_layout,
+      row_layout.numRows(),
+      [&](size_t first_chunk, size_t end_chunk) {
+         ++calls;
+         EXPECT_EQ(first_chunk, 0);
+         EXPECT_EQ(end_chunk, 3);
+         return CopyOnWriteBitmap{roaring::Roaring{1, 2}};
+      }
+   );
+
+   EXPECT_EQ(calls, 1);
+   EXPECT_EQ(result.toRoaring(), (roaring::Roaring{1, 2}));
+}
+
+TEST(ParallelEvaluation, selectionOverManyChunksMatchesRowByRowEvaluation) {
+   const RowLayout row_layout = largeRowLayout();
+
+   std::vector<std::unique_ptr<Predicate>> predicates;
+   predicates.push_back(std::make_unique<RowInChunkDivisibleBy>(3));
+   predicates.push_back(std::make_unique<RowInChunkDivisibleBy>(5));
+   const Selection under_test{std::move(predicates), row_layout};
+
+   roaring::Roaring expected;
+   for (const RowId row_id : row_layout) {
+      if (row_id.row_in_chunk % 15 == 0) {
+         expected.add(row_id.toGlobal());
+      }
+   }
+   EXPECT_EQ(under_test.evaluate().toRoaring(), expected);
+}
+
+TEST(ParallelEvaluation, thresholdOverManyChunksMatchesCountingPerRow) {
+   const RowLayout row_layout = largeRowLayout();
+
+   std::vector<roaring::Roaring> bitmaps(4);
+   for (const RowId row_id : row_layout) {
+      const uint32_t row = row_id.toGlobal();
+      for (size_t idx = 0; idx < bitmaps.size(); ++idx) {
+         if ((row / (idx + 2)) % 2 == 0) {
+            bitmaps.at(idx).add(row);
+         }
+      }
+   }
+   const auto make_children = [&](size_t first, size_t end) {
+      OperatorVector children;
+      for (size_t idx = first; idx < end; ++idx) {
+         children.push_back(
+            std::make_unique<IndexScan>(CopyOnWriteBitmap{&bitmaps.at(idx)}, row_layout)
+         );
+      }
+      return children;
+   };
+   // Two non-negated and two negated children, at least two of which have to match
+   const Threshold under_test{make_children(0, 2), make_children(2, 4), 2, false, row_layout};
+
+   roaring::Roaring expected;
+   for (const RowId row_id : row_layout) {
+      const uint32_t row = row_id.toGlobal();
+      const int matches = static_cast<int>(bitmaps.at(0).contains(row)) +
+                          static_cast<int>(bitmaps.at(1).contains(row)) +
+                          static_cast<int>(!bitmaps.at(2).contains(row)) +
+                          static_cast<int>(!bitmaps.at(3).contains(row));
+      if (matches >= 2) {
+         expected.add(row);
+      }
+   }
+   EXPECT_EQ(under_test.evaluate().toRoaring(), expected);
+}
+
+TEST(ParallelEvaluation, cancelledQueryStopsOnEveryThreadBeforeLookingAtARow) {
+   const RowLayout row_layout = largeRowLayout();
+   auto cancellation_token = std::make_shared<CancellationToken>("some_id");
+   cancellation_token->cancel(CancellationReason::CLIENT_GONE);
+   const CancellationToken::ActiveScope active_token{cancellation_token};
+
+   const Selection under_test{std::make_unique<RowInChunkDivisibleBy>(3), row_layout};
+
+   EXPECT_THROW(std::ignore = under_test.evaluate(), QueryCancelledException);
+   EXPECT_EQ(cancellation_token->skippedRows(), row_layout.numRows());
+}
+
+TEST(ParallelEvaluation, cancellingDuringEvaluationStopsTheTasksOnOtherThreads) {
+   auto* pool = arrow::internal::GetCpuThreadPool();
+   const int previous_capacity = pool->GetCapacity();
+   ASSERT_TRUE(pool->SetCapacity(std::max(previous_capacity, 2)).ok());
+   const auto num_threads = static_cast<size_t>(pool->GetCapacity());
+   // More chunk ranges than threads, so that some tasks only start after the cancellation
+   RowLayout row_layout = largeRowLayout();
+   while (row_layout.numChunks() < 2 * num_threads) {
+      row_layout.appendChunk(COLUMN_CHUNK_SIZE);
+   }
+   const size_t num_ranges = std::min(row_layout.numChunks(), 4 * num_threads);
+
+   auto cancellation_token = std::make_shared<CancellationToken>("some_id");
+   const CancellationToken::ActiveScope active_token{cancellation_token};
+   std::atomic<size_t> calls = 0;
+   std::atomic<size_t> calls_without_the_token = 0;
+   EXPECT_THROW(
+      std::ignore = evaluateByChunkRanges(
+         row_layout,
+         row_layout.numRows(),
+         [&](size_t /*first_chunk*/, size_t /*end_chunk*/) {
+            if (CancellationToken::active() != cancellation_token) {
+               ++calls_without_the_token;
+            }
+            if (++calls == 1) {
+               cancellation_token->cancel(CancellationReason::CLIENT_GONE);
+            }
+            return CopyOnWriteBitmap{};
+         }
+      ),
+      QueryCancelledException
+   );
+   ASSERT_TRUE(pool->SetCapacity(previous_capacity).ok());
+
+   EXPECT_EQ(calls_without_the_token, 0);
+   // The tasks that started after the cancellation did not call back
+   EXPECT_LT(calls, num_ranges);
+   EXPECT_GT(cancellation_token->skippedRows(), 0);
+}
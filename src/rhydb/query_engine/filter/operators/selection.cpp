@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cmath>
 #include <compare>
+#include <cstddef>
 #include <iterator>
 #include <ranges>
 #include <utility>
@@ -15,9 +16,11 @@
 #include "evobench/evobench.hpp"
 #include "rhydb/common/german_string.h"
 #include "rhydb/common/panic.h"
+#include "rhydb/query_engine/cancellation_token.h"
 #include "rhydb/query_engine/copy_on_write_bitmap.h"
 #include "rhydb/query_engine/filter/operators/complement.h"
 #include "rhydb/query_engine/filter/operators/operator.h"
+#include "rhydb/query_engine/filter/operators/parallel_evaluation.h"
 #include "rhydb/roaring_util/roaring_container.h"
 
 namespace rhydb::query_engine::filter::operators {
@@ -103,41 +106,71 @@ CopyOnWriteBitmap Selection::evaluate() const {
       // For a small child, matching each of its rows against every predicate is cheaper than
       // materializing the first predicate over the whole partition.
       if (child_bitmap.cardinality() <= row_layout.numRows() / 10) {
+         return filterCandidates(child_bitmap, 0);
+      }
+      candidates = std::move(child_bitmap);
+      candidates &= makeFirstPredicateBitmap();
+   } else {
+      candidates = makeFirstPredicateBitmap();
+   }
+
+   // `candidates` already satisfies predicates.front(); apply the remaining predicates row by row.
+   if (predicates.size() == 1) {
+      return candidates;
+   }
+   return filterCandidates(candidates, 1);
+}
+
+CopyOnWriteBitmap Selection::makeFirstPredicateBitmap() const {
+   const auto& predicate = predicates.front();
+   if (!predicate->canEvaluateByChunks()) {
+      return CopyOnWriteBitmap{predicate->makeBitmap(row_layout)};
+   }
+   return evaluateByChunkRanges(
+      row_layout,
+      row_layout.numRows(),
+      [&](size_t first_chunk, size_t end_chunk) {
+         return CopyOnWriteBitmap{
+            predicate->makeBitmapForChunks(row_layout, first_chunk, end_chunk)
+         };
+      }
+   );
+}
+
+CopyOnWriteBitmap Selection::filterCandidates(
+   const CopyOnWriteBitmap& candidates,
+   size_t first_predicate
+) const {
+   const auto remaining_predicates = std::ranges::subrange(
+      predicates.begin() + static_cast<std::ptrdiff_t>(first_predicate), predicates.end()
+   );
+   return evaluateByChunkRanges(
+      row_layout,
+      candidates.cardinality(),
+      [&](size_t first_chunk, size_t end_chunk) {
          roaring::Roaring result;
-         for (const auto& [chunk_id, container_view] : child_bitmap) {
+         for (const auto& [chunk_id, container_view] : candidates) {
+            if (chunk_id < first_chunk) {
+               continue;
+            }
+            if (chunk_id >= end_chunk) {
+               break;
+            }
+            CancellationToken::throwIfActiveCancelled(
+               (end_chunk - chunk_id) * storage::column::COLUMN_CHUNK_SIZE
+            );
             for (const uint16_t row_in_chunk : container_view) {
                const storage::column::RowId row_id{
                   .chunk_id = chunk_id, .row_in_chunk = row_in_chunk
                };
-               if (matchesPredicates(predicates, row_id)) {
+               if (matchesPredicates(remaining_predicates, row_id)) {
                   result.add(row_id.toGlobal());
                }
             }
          }
          return CopyOnWriteBitmap{std::move(result)};
       }
-      candidates = std::move(child_bitmap);
-      candidates &= CopyOnWriteBitmap{predicates.front()->makeBitmap(row_layout)};
-   } else {
-      candidates = CopyOnWriteBitmap{predicates.front()->makeBitmap(row_layout)};
-   }
-
-   // `candidates` already satisfies predicates.front(); apply the remaining predicates row by row.
-   if (predicates.size() == 1) {
-      return CopyOnWriteBitmap{std::move(candidates)};
-   }
-   const auto remaining_predicates =
-      std::ranges::subrange(predicates.begin() + 1, predicates.end());
-   roaring::Roaring result;
-   for (const auto& [chunk_id, container_view] : candidates) {
-      for (const uint16_t row_in_chunk : container_view) {
-         const storage::column::RowId row_id{.chunk_id = chunk_id, .row_in_chunk = row_in_chunk};
-         if (matchesPredicates(remaining_predicates, row_id)) {
-            result.add(row_id.toGlobal());
-         }
-      }
-   }
-   return CopyOnWriteBitmap{std::move(result)};
+   );
 }
 
 std::unique_ptr<Operator> Selection::negate(std::unique_ptr<Selection>&& selection) {
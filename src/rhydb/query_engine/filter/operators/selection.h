@@ -1,14 +1,20 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <string>
 #include <vector>
 
+#include "rhydb/query_engine/cancellation_token.h"
 #include "rhydb/query_engine/copy_on_write_bitmap.h"
+#include "rhydb/query_engine/filter/operators/chunkwise_evaluation.h"
+#include "rhydb/query_engine/filter/operators/comparator.h"
+#include "rhydb/query_engine/filter/operators/compare_kernels.h"
 #include "rhydb/query_engine/filter/operators/operator.h"
 #include "rhydb/schema/database_schema.h"
 #include "rhydb/storage/column/column.h"
@@ -28,50 +34,65 @@ class Predicate {
    [[nodiscard]] virtual std::string toString() const = 0;
    [[nodiscard]] virtual bool match(storage::column::RowId row_id) const = 0;
    // Often there are faster ways to generate the results, than calling match on each row.
-   // Optimise that case by overriding this method
+   // Optimise that case by overriding makeBitmapForChunks, or makeBitmap together with
+   // canEvaluateByChunks if the result can only be computed for all chunks at once
    [[nodiscard]] virtual roaring::Roaring makeBitmap(const storage::column::RowLayout& row_layout
+   ) const {
+      return makeBitmapForChunks(row_layout, 0, row_layout.numChunks());
+   };
+   /// The matching rows of the chunks `[first_chunk, end_chunk)` of `row_layout`
+   [[nodiscard]] virtual roaring::Roaring makeBitmapForChunks(
+      const storage::column::RowLayout& row_layout,
+      size_t first_chunk,
+      size_t end_chunk
    ) const {
       roaring::Roaring result;
-      for (const storage::column::RowId row_id : row_layout) {
-         if (match(row_id)) {
-            result.add(row_id.toGlobal());
+      for (size_t chunk_idx = first_chunk; chunk_idx < end_chunk; ++chunk_idx) {
+         CancellationToken::throwIfActiveCancelled(
+            (end_chunk - chunk_idx) * storage::column::COLUMN_CHUNK_SIZE
+         );
+         const auto chunk_id = static_cast<uint16_t>(chunk_idx);
+         const uint32_t chunk_size = row_layout.chunkSize(chunk_id);
+         for (uint32_t row_in_chunk = 0; row_in_chunk < chunk_size; ++row_in_chunk) {
+            const storage::column::RowId row_id{
+               .chunk_id = chunk_id, .row_in_chunk = static_cast<uint16_t>(row_in_chunk)
+            };
+            if (match(row_id)) {
+               result.add(row_id.toGlobal());
+            }
          }
       }
       return result;
    };
+   /// Whether `makeBitmapForChunks` computes the same rows as `makeBitmap`, so that the chunks can
+   /// be split up and evaluated concurrently
+   [[nodiscard]] virtual bool canEvaluateByChunks() const { return true; }
    [[nodiscard]] virtual double estimateSelectivity(uint32_t /*row_count*/) const { return 0.5; }
    [[nodiscard]] virtual std::unique_ptr<Predicate> copy() const = 0;
    [[nodiscard]] virtual std::unique_ptr<Predicate> negate() const = 0;
-};
 
-using PredicateVector = std::vector<std::unique_ptr<Predicate>>;
-
-enum class Comparator : uint8_t {
-   EQUALS,
-   LESS,
-   HIGHER,
-   LESS_OR_EQUALS,
-   HIGHER_OR_EQUALS,
-   NOT_EQUALS
+  protected:
+   /// Sets the bits of the rows of the chunk `chunk_idx` that `match`
+   void matchChunkRowByRow(
+      const storage::column::RowLayout& row_layout,
+      size_t chunk_idx,
+      std::span<uint64_t, CHUNK_BITSET_WORDS> words
+   ) const {
+      std::ranges::fill(words, 0);
+      const auto chunk_id = static_cast<uint16_t>(chunk_idx);
+      const uint32_t chunk_size = row_layout.chunkSize(chunk_id);
+      for (uint32_t row_in_chunk = 0; row_in_chunk < chunk_size; ++row_in_chunk) {
+         const storage::column::RowId row_id{
+            .chunk_id = chunk_id, .row_in_chunk = static_cast<uint16_t>(row_in_chunk)
+         };
+         if (match(row_id)) {
+            words[row_in_chunk / 64] |= uint64_t{1} << (row_in_chunk % 64);
+         }
+      }
+   }
 };
 
-inline std::string displayComparator(Comparator comparator) {
-   switch (comparator) {
-      case Comparator::EQUALS:
-         return "=";
-      case Comparator::NOT_EQUALS:
-         return "!=";
-      case Comparator::LESS:
-         return "<";
-      case Comparator::HIGHER:
-         return ">";
-      case Comparator::LESS_OR_EQUALS:
-         return "<=";
-      case Comparator::HIGHER_OR_EQUALS:
-         return ">=";
-   }
-   SILO_UNREACHABLE();
-}
+using PredicateVector = std::vector<std::unique_ptr<Predicate>>;
 
 template <storage::column::Column ColumnType>
 class CompareToValueSelection : public Predicate {
@@ -130,6 +151,45 @@ class CompareToValueSelection : public Predicate {
       SILO_UNREACHABLE();
    }
 
+   /// Chunks whose zone map shows that none or all of their rows match are skipped or taken as a
+   /// whole. Columns of fixed-width values compare the other chunks a whole chunk at a time (see
+   /// `compareChunksToValue`), the other columns row by row.
+   [[nodiscard]] roaring::Roaring makeBitmapForChunks(
+      const storage::column::RowLayout& row_layout,
+      size_t first_chunk,
+      size_t end_chunk
+   ) const override {
+      if constexpr (requires { column.getValueBuffer(); }) {
+         return compareChunksToValue(
+            column.getValueBuffer(),
+            column.getZoneMaps(),
+            column.null_bitmap,
+            row_layout,
+            comparator,
+            value,
+            with_nulls,
+            first_chunk,
+            end_chunk
+         );
+      } else if constexpr (requires { column.getZoneMaps(); }) {
+         return evaluateChunkwise(
+            row_layout,
+            column.null_bitmap,
+            with_nulls,
+            first_chunk,
+            end_chunk,
+            [&](size_t chunk_idx) {
+               return matchZoneMap(column.getZoneMaps().at(chunk_idx), comparator, value);
+            },
+            [&](size_t chunk_idx, std::span<uint64_t, CHUNK_BITSET_WORDS> words) {
+               matchChunkRowByRow(row_layout, chunk_idx, words);
+            }
+         );
+      } else {
+         return Predicate::makeBitmapForChunks(row_layout, first_chunk, end_chunk);
+      }
+   }
+
    [[nodiscard]] std::unique_ptr<Predicate> copy() const override {
       return std::make_unique<CompareToValueSelection<ColumnType>>(column, comparator, value);
    }
@@ -170,6 +230,84 @@ bool CompareToValueSelection<rhydb::storage::column::StringColumn>::match(
    rhydb::storage::column::RowId row_id
 ) const;
 
+/// Matches the rows whose value lies in `range` if `within`, or outside of it otherwise. Both
+/// bounds of a between are checked in one predicate, so that the zone maps can tell whether a chunk
+/// lies entirely inside or outside of the range.
+template <storage::column::Column ColumnType>
+   requires requires(const ColumnType& column) { column.getValueBuffer(); }
+class CompareToRangeSelection : public Predicate {
+   using value_type = ColumnType::value_type;
+
+   const ColumnType& column;
+   ValueRange<value_type> range;
+   bool within;
+   bool with_nulls;
+
+  public:
+   CompareToRangeSelection(
+      const ColumnType& column,
+      ValueRange<value_type> range,
+      bool within,
+      bool with_nulls
+   )
+       : column(column),
+         range(range),
+         within(within),
+         with_nulls(with_nulls) {}
+
+   CompareToRangeSelection(const ColumnType& column, ValueRange<value_type> range)
+       : CompareToRangeSelection(column, range, true, false) {}
+
+   [[nodiscard]] std::string toString() const override {
+      return fmt::format(
+         "${} {} {}in [{}, {}{}",
+         schema::columnTypeToString(ColumnType::TYPE),
+         column.metadata->column_name,
+         within ? "" : "not ",
+         range.lower,
+         range.upper,
+         range.upper_comparator == Comparator::LESS ? ")" : "]"
+      );
+   }
+
+   [[nodiscard]] bool match(storage::column::RowId row_id) const override {
+      if (column.isNull(row_id)) {
+         return with_nulls;
+      }
+      return range.contains(column.getValue(row_id)) == within;
+   }
+
+   [[nodiscard]] roaring::Roaring makeBitmapForChunks(
+      const storage::column::RowLayout& row_layout,
+      size_t first_chunk,
+      size_t end_chunk
+   ) const override {
+      return compareChunksToRange(
+         column.getValueBuffer(),
+         column.getZoneMaps(),
+         column.null_bitmap,
+         row_layout,
+         range,
+         within,
+         with_nulls,
+         first_chunk,
+         end_chunk
+      );
+   }
+
+   [[nodiscard]] std::unique_ptr<Predicate> copy() const override {
+      return std::make_unique<CompareToRangeSelection<ColumnType>>(
+         column, range, within, with_nulls
+      );
+   }
+
+   [[nodiscard]] std::unique_ptr<Predicate> negate() const override {
+      return std::make_unique<CompareToRangeSelection<ColumnType>>(
+         column, range, !within, !with_nulls
+      );
+   }
+};
+
 class Selection : public Operator {
    friend class scalar_expressions::And;
 
@@ -215,6 +353,16 @@ class Selection : public Operator {
    static std::unique_ptr<Operator> negate(std::unique_ptr<Selection>&& selection);
 
   private:
+   /// The bitmap of the first (most selective) predicate
+   [[nodiscard]] CopyOnWriteBitmap makeFirstPredicateBitmap() const;
+
+   /// The rows of `candidates` that match all predicates from `first_predicate` on, checked row by
+   /// row
+   [[nodiscard]] CopyOnWriteBitmap filterCandidates(
+      const CopyOnWriteBitmap& candidates,
+      size_t first_predicate
+   ) const;
+
    template <std::ranges::range PredicateRange>
    [[nodiscard]] static bool matchesPredicates(
       const PredicateRange& predicates,
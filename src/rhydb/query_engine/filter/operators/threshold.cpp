@@ -1,5 +1,7 @@
 #include "rhydb/query_engine/filter/operators/threshold.h"
 
+#include <cstddef>
+#include <iterator>
 #include <string>
 #include <utility>
 #include <vector>
@@ -8,9 +10,11 @@
 
 #include "evobench/evobench.hpp"
 #include "rhydb/common/string_utils.h"
+#include "rhydb/query_engine/cancellation_token.h"
 #include "rhydb/query_engine/copy_on_write_bitmap.h"
 #include "rhydb/query_engine/filter/operators/complement.h"
 #include "rhydb/query_engine/filter/operators/operator.h"
+#include "rhydb/query_engine/filter/operators/parallel_evaluation.h"
 #include "rhydb/query_engine/query_compilation_exception.h"
 
 namespace rhydb::query_engine::filter::operators {
@@ -63,6 +67,47 @@ Type Threshold::type() const {
 
 CopyOnWriteBitmap Threshold::evaluate() const {
    EVOBENCH_SCOPE("Threshold", "evaluate");
+   std::vector<const Operator*> all_children;
+   all_children.reserve(non_negated_children.size() + negated_children.size());
+   for (const auto& child : non_negated_children) {
+      all_children.push_back(child.get());
+   }
+   for (const auto& child : negated_children) {
+      all_children.push_back(child.get());
+   }
+   std::vector<CopyOnWriteBitmap> non_negated_bitmaps =
+      evaluateChildren(all_children, row_layout.numRows());
+   const std::vector<CopyOnWriteBitmap> negated_bitmaps(
+      std::make_move_iterator(
+         non_negated_bitmaps.begin() + static_cast<ptrdiff_t>(non_negated_children.size())
+      ),
+      std::make_move_iterator(non_negated_bitmaps.end())
+   );
+   non_negated_bitmaps.resize(non_negated_children.size());
+
+   // The count of matching children of a row only depends on the row itself, so the dynamic
+   // program runs independently for ranges of chunks
+   return evaluateByChunkRanges(
+      row_layout,
+      row_layout.numRows(),
+      [&](size_t first_chunk, size_t end_chunk) {
+         return CopyOnWriteBitmap{
+            evaluateChunks(non_negated_bitmaps, negated_bitmaps, first_chunk, end_chunk)
+         };
+      }
+   );
+}
+
+roaring::Roaring Threshold::evaluateChunks(
+   const std::vector<CopyOnWriteBitmap>& non_negated_bitmaps,
+   const std::vector<CopyOnWriteBitmap>& negated_bitmaps,
+   size_t first_chunk,
+   size_t end_chunk
+) const {
+   const auto chunks_of = [&](const CopyOnWriteBitmap& bitmap) {
+      return bitmap.toRoaring(first_chunk, end_chunk);
+   };
+
    uint32_t dp_table_size;
    if (this->match_exactly) {
       // We need to keep track of the ones that matched too many
@@ -71,27 +116,28 @@ CopyOnWriteBitmap Threshold::evaluate() const {
       dp_table_size = number_of_matchers;
    }
    std::vector<roaring::Roaring> bitmaps(dp_table_size);
-   if (non_negated_children.empty()) {
-      bitmaps[0] = negated_children[0]->evaluate().toRoaring();
+   if (non_negated_bitmaps.empty()) {
+      bitmaps[0] = chunks_of(negated_bitmaps[0]);
    } else {
-      bitmaps[0] = non_negated_children[0]->evaluate().toRoaring();
+      bitmaps[0] = chunks_of(non_negated_bitmaps[0]);
    }
 
-   if (non_negated_children.empty()) {
-      row_layout.complementInPlace(bitmaps[0]);
+   if (non_negated_bitmaps.empty()) {
+      row_layout.complementInPlace(bitmaps[0], first_chunk, end_chunk);
    }
 
    // NOLINTBEGIN(readability-identifier-length)
    const int max_table_index = static_cast<int>(dp_table_size - 1);
-   const int non_negated_child_count = static_cast<int>(non_negated_children.size());
-   const int negated_child_count = static_cast<int>(negated_children.size());
+   const int non_negated_child_count = static_cast<int>(non_negated_bitmaps.size());
+   const int negated_child_count = static_cast<int>(negated_bitmaps.size());
    const int n = static_cast<int>(number_of_matchers);  // The threshold
    const int k = static_cast<int>(
-      non_negated_children.size() + negated_children.size()
+      non_negated_bitmaps.size() + negated_bitmaps.size()
    );  // Number of loop iterations
 
    for (int i = 1; i < non_negated_child_count; ++i) {
-      const roaring::Roaring bitmap = non_negated_children[i]->evaluate().toRoaring();
+      CancellationToken::throwIfActiveCancelled();
+      const roaring::Roaring bitmap = chunks_of(non_negated_bitmaps[i]);
       // positions higher than (i-1) cannot have been reached yet, are therefore all 0s and the
       // conjunction would return 0
       // positions lower than n - k + i - 1 are unable to affect the result, because only (k - i)
@@ -110,9 +156,10 @@ CopyOnWriteBitmap Threshold::evaluate() const {
    // with the inverse of the negated bitmap
    // We hope the case of flipping does not occur, as 'k - i' might always be '< n - 1'
    // (Number of children left is less than the distance we need to cross to reach the result)
-   const int took_first_offset = non_negated_children.empty() ? 1 : 0;
+   const int took_first_offset = non_negated_bitmaps.empty() ? 1 : 0;
    for (int local_i = took_first_offset; local_i < negated_child_count; ++local_i) {
-      roaring::Roaring bitmap = negated_children[local_i]->evaluate().toRoaring();
+      CancellationToken::throwIfActiveCancelled();
+      roaring::Roaring bitmap = chunks_of(negated_bitmaps[local_i]);
       const int i = local_i + non_negated_child_count;
       // positions higher than (i-1) cannot have been reached yet, are therefore all 0s and the
       // conjunction would return 0
@@ -122,7 +169,7 @@ CopyOnWriteBitmap Threshold::evaluate() const {
          bitmaps[j] |= bitmaps[j - 1] - bitmap;
       }
       if (k - i > n - 1) {
-         row_layout.complementInPlace(bitmap);
+         row_layout.complementInPlace(bitmap, first_chunk, end_chunk);
          bitmaps[0] |= bitmap;
       }
    }
@@ -132,9 +179,9 @@ CopyOnWriteBitmap Threshold::evaluate() const {
       // Because exact, we remove all that have too many
       bitmaps[number_of_matchers - 1] -= bitmaps[number_of_matchers];
 
-      return CopyOnWriteBitmap(std::move(bitmaps[number_of_matchers - 1]));
+      return std::move(bitmaps[number_of_matchers - 1]);
    }
-   return CopyOnWriteBitmap(std::move(bitmaps.back()));
+   return std::move(bitmaps.back());
 }
 
 std::unique_ptr<Operator> Threshold::negate(std::unique_ptr<Threshold>&& threshold) {
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
+
+#include <roaring/roaring.hh>
 
 #include "rhydb/query_engine/copy_on_write_bitmap.h"
 #include "rhydb/query_engine/filter/operators/operator.h"
@@ -36,6 +40,15 @@ class Threshold : public Operator {
    [[nodiscard]] std::string toString() const override;
 
    static std::unique_ptr<Operator> negate(std::unique_ptr<Threshold>&& threshold);
+
+  private:
+   /// The result for the rows of the chunks `[first_chunk, end_chunk)`
+   [[nodiscard]] roaring::Roaring evaluateChunks(
+      const std::vector<CopyOnWriteBitmap>& non_negated_bitmaps,
+      const std::vector<CopyOnWriteBitmap>& negated_bitmaps,
+      size_t first_chunk,
+      size_t end_chunk
+   ) const;
 };
 
 }  // namespace rhydb::query_engine::filter::operators
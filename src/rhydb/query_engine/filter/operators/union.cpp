@@ -11,6 +11,7 @@
 #include "rhydb/query_engine/copy_on_write_bitmap.h"
 #include "rhydb/query_engine/filter/operators/complement.h"
 #include "rhydb/query_engine/filter/operators/operator.h"
+#include "rhydb/query_engine/filter/operators/parallel_evaluation.h"
 
 namespace rhydb::query_engine::filter::operators {
 
@@ -33,12 +34,7 @@ Type Union::type() const {
 
 CopyOnWriteBitmap Union::evaluate() const {
    EVOBENCH_SCOPE("Union", "evaluate");
-   std::vector<CopyOnWriteBitmap> child_res;
-   child_res.reserve(children.size());
-   for (const auto& child : children) {
-      child_res.push_back(child->evaluate());
-   }
-   return CopyOnWriteBitmap::fastUnion(child_res);
+   return CopyOnWriteBitmap::fastUnion(evaluateChildren(children, row_layout.numRows()));
 }
 
 std::unique_ptr<Operator> Union::negate(std::unique_ptr<Union>&& union_operator) {
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "rhydb/query_engine/copy_on_write_bitmap.h"
+#include "rhydb/query_engine/scalar_expressions/filter_bitmap_cache.h"
 #include "rhydb/query_engine/scalar_expressions/scalar_expression.h"
 #include "rhydb/storage/table.h"
 
@@ -16,8 +17,7 @@ CopyOnWriteBitmap computeFilter(
    const storage::Table& table
 ) {
    auto rewritten = filter->rewrite(table, ScalarExpression::AmbiguityMode::NONE);
-   auto compiled = rewritten->compile(table);
-   return compiled->evaluate();
+   return scalar_expressions::evaluateWithFilterCache(*rewritten, table);
 }
 
 }  // namespace rhydb::query_engine::operators
@@ -17,6 +17,7 @@
 
 #include "rhydb/common/aa_symbols.h"
 #include "rhydb/common/nucleotide_symbols.h"
+#include "rhydb/query_engine/cancellation_token.h"
 #include "rhydb/query_engine/copy_on_write_bitmap.h"
 #include "rhydb/query_engine/exec_node/arrow_util.h"
 #include "rhydb/query_engine/exec_node/schema_output_builder.h"
@@ -70,6 +71,7 @@ arrow::Status addAggregatedInsertionsToInsertionCounts(
    if (bitmap_cardinality == table.row_layout.numRows()) {
       for (const auto& [position, insertions_at_position] :
            sequence_column.insertion_index.getInsertionPositions()) {
+         CancellationToken::throwIfActiveCancelled();
          for (const auto& insertion : insertions_at_position.insertions) {
             all_insertions[PositionAndInsertionKey{position, insertion.value}] +=
                insertion.row_ids.cardinality();
@@ -78,6 +80,7 @@ arrow::Status addAggregatedInsertionsToInsertionCounts(
    } else {
       for (const auto& [position, insertions_at_position] :
            sequence_column.insertion_index.getInsertionPositions()) {
+         CancellationToken::throwIfActiveCancelled();
          for (const auto& insertion : insertions_at_position.insertions) {
             const uint32_t count = insertion.row_ids.and_cardinality(filter_bitmap);
             if (count > 0) {
@@ -128,6 +131,7 @@ arrow::Result<arrow::acero::ExecNode*> InsertionsNode<SymbolType>::addToExecPlan
        output_fields,
        bitmap_filter,
        sequence_columns_handle,
+       cancellation_token = CancellationToken::active(),
        already_produced = false]() mutable -> arrow::Future<std::optional<arrow::ExecBatch>> {
       if (already_produced) {
          const std::optional<arrow::ExecBatch> result = std::nullopt;
@@ -137,10 +141,16 @@ arrow::Result<arrow::acero::ExecNode*> InsertionsNode<SymbolType>::addToExecPlan
 
       exec_node::SchemaOutputBuilder output_builder{output_fields};
 
-      for (const auto& [sequence_name, _] : sequence_columns_handle) {
-         ARROW_RETURN_NOT_OK(addAggregatedInsertionsToInsertionCounts<SymbolType>(
-            sequence_name, bitmap_filter, *table_handle, output_builder
-         ));
+      // The producer runs on a thread of the plan's executor
+      const CancellationToken::ActiveScope active_token{cancellation_token};
+      try {
+         for (const auto& [sequence_name, _] : sequence_columns_handle) {
+            ARROW_RETURN_NOT_OK(addAggregatedInsertionsToInsertionCounts<SymbolType>(
+               sequence_name, bitmap_filter, *table_handle, output_builder
+            ));
+         }
+      } catch (const QueryCancelledException& exception) {
+         return arrow::Status::Cancelled(exception.what());
       }
 
       ARROW_ASSIGN_OR_RAISE(
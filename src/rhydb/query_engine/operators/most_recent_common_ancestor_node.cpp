@@ -1,5 +1,6 @@
 #include "rhydb/query_engine/operators/most_recent_common_ancestor_node.h"
 
+#include <algorithm>
 #include <functional>
 #include <map>
 #include <memory>
@@ -13,6 +14,7 @@
 #include <fmt/format.h>
 #include <fmt/ranges.h>
 #include <nlohmann/json.hpp>
+#include <roaring/roaring.hh>
 
 #include "rhydb/common/phylo_tree.h"
 #include "rhydb/query_engine/copy_on_write_bitmap.h"
@@ -26,35 +28,40 @@
 
 namespace {
 
-struct NodeValuesResult {
-   std::unordered_set<std::string> node_values;
-   uint32_t missing_node_count = 0;
+struct NodesMissingFromTree {
+   /// The distinct values that are not labels of the tree, sorted
+   std::vector<std::string> not_in_tree;
+   uint32_t null_count = 0;
 };
 
-NodeValuesResult getNodeValuesFromTable(
+// Only the rows without a bound tree node are looked at by value, the others are passed to the
+// tree as row ids
+NodesMissingFromTree getNodesMissingFromTree(
    const rhydb::storage::Table& table,
    const std::string& column_name,
-   rhydb::query_engine::CopyOnWriteBitmap& bitmap_filter
+   const rhydb::common::PhyloTree& phylo_tree,
+   const roaring::Roaring& filter_bitmap
 ) {
-   const roaring::Roaring filter_bitmap = bitmap_filter.toRoaring();
-   const size_t num_rows = filter_bitmap.cardinality();
-   std::unordered_set<std::string> all_tree_node_ids;
-   uint32_t num_empty = 0;
-   all_tree_node_ids.reserve(num_rows);
+   std::unordered_set<std::string> not_in_tree;
+   uint32_t null_count = 0;
 
    const auto& string_column = table.columns.string_columns.at(column_name);
 
    for (const uint32_t row_in_table : filter_bitmap) {
+      if (phylo_tree.isRowInTree(row_in_table)) {
+         continue;
+      }
       const auto row_id = rhydb::storage::column::RowId::fromGlobal(row_in_table);
       if (!string_column.isNull(row_id)) {
-         auto value = string_column.getValueString(row_id);
-         all_tree_node_ids.insert(value);
+         not_in_tree.insert(string_column.getValueString(row_id));
       } else {
-         ++num_empty;
+         ++null_count;
       }
    }
-   return NodeValuesResult{
-      .node_values = std::move(all_tree_node_ids), .missing_node_count = num_empty
+   std::vector<std::string> sorted_not_in_tree{not_in_tree.begin(), not_in_tree.end()};
+   std::ranges::sort(sorted_not_in_tree);
+   return NodesMissingFromTree{
+      .not_in_tree = std::move(sorted_not_in_tree), .null_count = null_count
    };
 }
 
@@ -136,15 +143,18 @@ arrow::Result<arrow::acero::ExecNode*> MostRecentCommonAncestorNode::addToExecPl
 
       exec_node::SchemaOutputBuilder output_builder{output_fields};
 
-      auto node_vals = getNodeValuesFromTable(*table_handle, column_name_copy, bitmap_filter);
+      const roaring::Roaring filter_bitmap = bitmap_filter.toRoaring();
+      auto missing_nodes =
+         getNodesMissingFromTree(*table_handle, column_name_copy, phylo_tree, filter_bitmap);
 
-      common::MRCAResponse mrca_resp = phylo_tree.getMRCA(node_vals.node_values);
+      common::MRCAResponse mrca_resp = phylo_tree.getMRCAOfRows(filter_bitmap);
+      mrca_resp.not_in_tree = std::move(missing_nodes.not_in_tree);
       std::optional<std::string> mrca_node =
          mrca_resp.mrca_node_id.transform([](const auto& node_id) { return node_id.string; });
       std::optional<std::string> mrca_parent =
          mrca_resp.parent_id_of_mrca.transform([](const auto& node_id) { return node_id.string; });
       auto missing_count =
-         static_cast<int32_t>(node_vals.missing_node_count + mrca_resp.not_in_tree.size());
+         static_cast<int32_t>(missing_nodes.null_count + mrca_resp.not_in_tree.size());
 
       ARROW_RETURN_NOT_OK(output_builder.addValueIfContainedInOutput("mrcaNode", [&]() {
          return mrca_node;
@@ -16,10 +16,12 @@
 #include "rhydb/common/aa_symbols.h"
 #include "rhydb/common/nucleotide_symbols.h"
 #include "rhydb/common/symbol_map.h"
+#include "rhydb/query_engine/cancellation_token.h"
 #include "rhydb/query_engine/copy_on_write_bitmap.h"
 #include "rhydb/query_engine/exec_node/arrow_util.h"
 #include "rhydb/query_engine/exec_node/schema_output_builder.h"
 #include "rhydb/query_engine/operators/compute_filter.h"
+#include "rhydb/roaring_util/roaring_container.h"
 #include "rhydb/schema/database_schema.h"
 #include "rhydb/storage/column/sequence_column.h"
 #include "rhydb/storage/table.h"
@@ -33,9 +35,6 @@ using rhydb::storage::column::VerticalSequenceIndex;
 template <typename SymbolType>
 using SequenceDiffKey = typename VerticalSequenceIndex<SymbolType>::SequenceDiffKey;
 
-template <typename SymbolType>
-using SequenceDiff = typename VerticalSequenceIndex<SymbolType>::SequenceDiff;
-
 __attribute__((noinline)) void initializeCountsWithSequenceCount(
    std::vector<uint32_t>& count_per_local_reference_position,
    uint32_t sequence_count
@@ -139,15 +138,18 @@ template <typename SymbolType>
 void countActualMutations(
    SymbolMap<SymbolType, std::vector<uint32_t>>& count_of_mutations_per_position,
    std::vector<uint32_t>& count_per_local_reference_position,
-   const std::map<SequenceDiffKey<SymbolType>, SequenceDiff<SymbolType>>& vertical_bitmaps
+   const VerticalSequenceIndex<SymbolType>& vertical_sequence_index
 ) {
    EVOBENCH_SCOPE("Mutations", "countActualMutations");
-   for (const auto& [sequence_diff_key, sequence_diff] : vertical_bitmaps) {
-      count_of_mutations_per_position[sequence_diff_key.symbol][sequence_diff_key.position] +=
-         sequence_diff.getCardinality();
-      count_per_local_reference_position[sequence_diff_key.position] -=
-         sequence_diff.getCardinality();
-   }
+   vertical_sequence_index.forEachSequenceDiff(
+      [&](const SequenceDiffKey<SymbolType>& sequence_diff_key,
+          roaring_util::RoaringContainerView sequence_diff) {
+         count_of_mutations_per_position[sequence_diff_key.symbol][sequence_diff_key.position] +=
+            sequence_diff.getCardinality();
+         count_per_local_reference_position[sequence_diff_key.position] -=
+            sequence_diff.getCardinality();
+      }
+   );
 }
 
 template <typename SymbolType>
@@ -155,28 +157,36 @@ void countActualFilteredMutations(
    SymbolMap<SymbolType, std::vector<uint32_t>>& count_of_mutations_per_position,
    std::vector<uint32_t>& count_per_local_reference_position,
    const roaring::Roaring& filter,
-   const std::map<SequenceDiffKey<SymbolType>, SequenceDiff<SymbolType>>& vertical_bitmaps
+   const VerticalSequenceIndex<SymbolType>& vertical_sequence_index
 ) {
    EVOBENCH_SCOPE("Mutations", "countActualFilteredMutations");
    const auto& filter_roaring_array = filter.roaring.high_low_container;
-   std::map<size_t, roaring::internal::container_t*> filter_containers;
-   std::map<size_t, uint8_t> filter_container_typecodes;
+   if (filter_roaring_array.size == 0) {
+      return;
+   }
+   // Dense lookup of the filter's container by v_index; the sweep below visits every stored diff
+   const size_t max_v_index = filter_roaring_array.keys[filter_roaring_array.size - 1];
+   std::vector<const roaring::internal::container_t*> filter_containers(max_v_index + 1, nullptr);
+   std::vector<uint8_t> filter_container_typecodes(max_v_index + 1);
    for (int32_t idx = 0; idx < filter_roaring_array.size; ++idx) {
       filter_containers[filter_roaring_array.keys[idx]] = filter_roaring_array.containers[idx];
       filter_container_typecodes[filter_roaring_array.keys[idx]] =
          filter_roaring_array.typecodes[idx];
    }
 
-   for (const auto& [sequence_diff_key, sequence_diff] : vertical_bitmaps) {
-      auto iter = filter_containers.find(sequence_diff_key.v_index);
-      if (iter != filter_containers.end()) {
-         auto filter_container = iter->second;
-         const uint8_t filter_container_typecode =
-            filter_container_typecodes.at(sequence_diff_key.v_index);
-
+   vertical_sequence_index.forEachSequenceDiff(
+      [&](const SequenceDiffKey<SymbolType>& sequence_diff_key,
+          roaring_util::RoaringContainerView sequence_diff) {
+         if (sequence_diff_key.v_index > max_v_index) {
+            return;
+         }
+         const auto* filter_container = filter_containers[sequence_diff_key.v_index];
+         if (filter_container == nullptr) {
+            return;
+         }
          auto contained_count = roaring::internal::container_and_cardinality(
             filter_container,
-            filter_container_typecode,
+            filter_container_typecodes[sequence_diff_key.v_index],
             sequence_diff.rawContainer(),
             sequence_diff.getTypecode()
          );
@@ -185,7 +195,7 @@ void countActualFilteredMutations(
             contained_count;
          count_per_local_reference_position[sequence_diff_key.position] -= contained_count;
       }
-   }
+   );
 }
 
 template <typename SymbolType>
@@ -219,17 +229,19 @@ void addMutationCountsForMixedBitmaps(
    initializeCountsWithSequenceCount(
       count_per_local_reference_position, filter_bitmap.cardinality()
    );
+   CancellationToken::throwIfActiveCancelled(filter_bitmap.cardinality());
    subtractFilteredNCounts(
       count_per_local_reference_position,
       filter_bitmap,
       sequence_length,
       sequence_column.horizontal_coverage_index
    );
+   CancellationToken::throwIfActiveCancelled(filter_bitmap.cardinality());
    countActualFilteredMutations(
       count_of_mutations_per_position,
       count_per_local_reference_position,
       filter_bitmap,
-      sequence_column.vertical_sequence_index.vertical_bitmaps
+      sequence_column.vertical_sequence_index
    );
    accumulateFinalCounts(
       count_per_local_reference_position, local_reference, count_of_mutations_per_position
@@ -248,6 +260,7 @@ void addMutationCountsForFullBitmaps(
    initializeCountsWithSequenceCount(
       count_per_local_reference_position, sequence_column.sequence_count
    );
+   CancellationToken::throwIfActiveCancelled(sequence_column.sequence_count);
    subtractHorizontalBitmapCounts(
       count_per_local_reference_position,
       sequence_column.horizontal_coverage_index.horizontal_bitmaps
@@ -255,10 +268,11 @@ void addMutationCountsForFullBitmaps(
    subtractStartAndEndNCounts(
       count_per_local_reference_position, sequence_column.horizontal_coverage_index, sequence_length
    );
+   CancellationToken::throwIfActiveCancelled(sequence_column.sequence_count);
    countActualMutations(
       count_of_mutations_per_position,
       count_per_local_reference_position,
-      sequence_column.vertical_sequence_index.vertical_bitmaps
+      sequence_column.vertical_sequence_index
    );
    accumulateFinalCounts(
       count_per_local_reference_position, local_reference, count_of_mutations_per_position
@@ -387,6 +401,7 @@ arrow::Result<arrow::acero::ExecNode*> MutationsNode<SymbolType>::addToExecPlan(
        output_fields,
        bitmap_filter = std::move(bitmap_filter),
        sequence_column_identifiers,
+       cancellation_token = CancellationToken::active(),
        already_produced = false]() mutable -> arrow::Future<std::optional<arrow::ExecBatch>> {
       if (already_produced) {
          const std::optional<arrow::ExecBatch> result = std::nullopt;
@@ -396,19 +411,26 @@ arrow::Result<arrow::acero::ExecNode*> MutationsNode<SymbolType>::addToExecPlan(
 
       exec_node::SchemaOutputBuilder output_builder(output_fields);
 
-      for (const auto& sequence_column_identifier : sequence_column_identifiers) {
-         const storage::column::SequenceColumn<SymbolType>& sequence_column =
-            table_handle->columns.template getColumns<storage::column::SequenceColumn<SymbolType>>()
-               .at(sequence_column_identifier.name);
-
-         ARROW_RETURN_NOT_OK(addMutationsToOutput<SymbolType>(
-            sequence_column_identifier.name,
-            sequence_column,
-            given_min_proportion,
-            bitmap_filter,
-            table_handle->row_layout.numRows(),
-            output_builder
-         ));
+      // The producer runs on a thread of the plan's executor
+      const CancellationToken::ActiveScope active_token{cancellation_token};
+      try {
+         for (const auto& sequence_column_identifier : sequence_column_identifiers) {
+            const storage::column::SequenceColumn<SymbolType>& sequence_column =
+               table_handle->columns
+                  .template getColumns<storage::column::SequenceColumn<SymbolType>>()
+                  .at(sequence_column_identifier.name);
+
+            ARROW_RETURN_NOT_OK(addMutationsToOutput<SymbolType>(
+               sequence_column_identifier.name,
+               sequence_column,
+               given_min_proportion,
+               bitmap_filter,
+               table_handle->row_layout.numRows(),
+               output_builder
+            ));
+         }
+      } catch (const QueryCancelledException& exception) {
+         return arrow::Status::Cancelled(exception.what());
       }
       ARROW_ASSIGN_OR_RAISE(
          const std::vector<arrow::Datum> result_columns, output_builder.finish()
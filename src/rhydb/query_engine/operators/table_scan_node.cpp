@@ -27,9 +27,7 @@ arrow::Result<arrow::acero::ExecNode*> TableScanNode::addToExecPlan(
 ) const {
    auto bitmap_filter = computeFilter(filter, *table);
 
-   return exec_node::makeTableScan(
-      &plan, fields, std::move(bitmap_filter), table, query_options.materialization_cutoff
-   );
+   return exec_node::makeTableScan(&plan, fields, std::move(bitmap_filter), table, query_options);
 }
 
 nlohmann::json TableScanNode::toJson() const {
@@ -3,6 +3,7 @@
 #include <stdexcept>
 
 #include <arrow/acero/exec_plan.h>
+#include <arrow/compute/exec.h>
 #include <fmt/format.h>
 #include <nlohmann/json.hpp>
 
@@ -30,19 +31,28 @@ arrow::Result<QueryPlan> planQueryOrError(
    const operators::QueryNode& node,
    const std::map<schema::TableName, std::shared_ptr<storage::Table>>& tables,
    const config::QueryOptions& query_options,
-   std::string_view request_id
+   std::string_view request_id,
+   arrow::MemoryPool* memory_pool,
+   const std::shared_ptr<CancellationToken>& cancellation_token
 ) {
-   ARROW_ASSIGN_OR_RAISE(auto arrow_plan, arrow::acero::ExecPlan::Make());
+   const arrow::compute::ExecContext exec_context{
+      memory_pool, arrow::compute::threaded_exec_context()->executor()
+   };
+   ARROW_ASSIGN_OR_RAISE(auto arrow_plan, arrow::acero::ExecPlan::Make(exec_context));
+   // The nodes evaluate their filters and create their producers with the token of the query
+   const CancellationToken::ActiveScope active_token{cancellation_token};
    ARROW_ASSIGN_OR_RAISE(auto* top_node, node.addToExecPlan(*arrow_plan, tables, query_options));
-   return QueryPlan::makeQueryPlan(std::move(arrow_plan), top_node, request_id);
+   ARROW_ASSIGN_OR_RAISE(
+      auto query_plan, QueryPlan::makeQueryPlan(std::move(arrow_plan), top_node, request_id)
+   );
+   query_plan.cancellation_token = cancellation_token;
+   return query_plan;
 }
 
 }  // namespace
 
-QueryPlan Planner::planQuery(
+operators::QueryNodePtr Planner::optimize(
    operators::QueryNodePtr node,
-   const std::map<schema::TableName, std::shared_ptr<storage::Table>>& tables,
-   const config::QueryOptions& query_options,
    std::string_view request_id
 ) {
    auto log_plan = [&](std::string_view phase) {
@@ -69,7 +79,19 @@ QueryPlan Planner::planQuery(
    log_plan("after BitmapAggregationRewritePass");
    node = NodeResolutionPass::run(std::move(node));
    log_plan("after NodeResolutionPass");
-   auto result = planQueryOrError(*node, tables, query_options, request_id);
+   return node;
+}
+
+QueryPlan Planner::planOptimizedQuery(
+   const operators::QueryNode& node,
+   const std::map<schema::TableName, std::shared_ptr<storage::Table>>& tables,
+   const config::QueryOptions& query_options,
+   std::string_view request_id,
+   arrow::MemoryPool* memory_pool,
+   std::shared_ptr<CancellationToken> cancellation_token
+) {
+   auto result =
+      planQueryOrError(node, tables, query_options, request_id, memory_pool, cancellation_token);
    if (!result.ok()) {
       throw std::runtime_error(
          fmt::format("Error when planning query execution: {}", result.status().ToString())
@@ -78,6 +100,16 @@ QueryPlan Planner::planQuery(
    return std::move(result.ValueUnsafe());
 }
 
+QueryPlan Planner::planQuery(
+   operators::QueryNodePtr node,
+   const std::map<schema::TableName, std::shared_ptr<storage::Table>>& tables,
+   const config::QueryOptions& query_options,
+   std::string_view request_id
+) {
+   node = optimize(std::move(node), request_id);
+   return planOptimizedQuery(*node, tables, query_options, request_id);
+}
+
 QueryPlan Planner::planSaneqlQuery(
    std::string_view query_string,
    const std::map<schema::TableName, std::shared_ptr<storage::Table>>& tables,
@@ -2,6 +2,9 @@
 
 #include <string_view>
 
+#include <arrow/memory_pool.h>
+
+#include "rhydb/query_engine/cancellation_token.h"
 #include "rhydb/query_engine/operators/query_node.h"
 #include "rhydb/query_engine/query_plan.h"
 
@@ -16,6 +19,26 @@ class Planner {
       std::string_view request_id
    );
 
+   /// Runs the optimizer passes over `node`, e.g. to identify a query by its optimized plan
+   /// (`QueryNode::toJson`) before planning its execution
+   static operators::QueryNodePtr optimize(
+      operators::QueryNodePtr node,
+      std::string_view request_id
+   );
+
+   /// Plans the execution of a query that was already optimized. The batches of the plan are
+   /// allocated from `memory_pool`, which has to outlive the plan, e.g. to account for the memory
+   /// of the query with a `CountingMemoryPool`. The filters, which are evaluated while planning,
+   /// and the execution of the plan stop once `cancellation_token` is cancelled.
+   static QueryPlan planOptimizedQuery(
+      const operators::QueryNode& node,
+      const std::map<schema::TableName, std::shared_ptr<storage::Table>>& tables,
+      const config::QueryOptions& query_options,
+      std::string_view request_id,
+      arrow::MemoryPool* memory_pool = arrow::default_memory_pool(),
+      std::shared_ptr<CancellationToken> cancellation_token = nullptr
+   );
+
    static QueryPlan planSaneqlQuery(
       std::string_view query_string,
       const std::map<schema::TableName, std::shared_ptr<storage::Table>>& tables,
@@ -0,0 +1,120 @@
+#include "rhydb/query_engine/query_cost.h"
+
+#include <map>
+#include <string>
+#include <type_traits>
+
+#include <nlohmann/json.hpp>
+
+#include "rhydb/common/panic.h"
+#include "rhydb/query_engine/operator_visitor.h"
+#include "rhydb/query_engine/scalar_expressions/filter_bitmap_cache.h"
+
+namespace rhydb::query_engine {
+
+namespace {
+
+/// Including the offset into the values of the array
+constexpr uint64_t STRING_VALUE_SIZE = 32;
+/// Unaligned sequences, whose length is not known before they are decompressed
+constexpr uint64_t ZSTD_COMPRESSED_STRING_VALUE_SIZE = 1024;
+
+template <typename SymbolType>
+uint64_t referenceLength(
+   const std::map<std::string, storage::column::SequenceColumn<SymbolType>>& columns,
+   const std::string& name
+) {
+   const auto column = columns.find(name);
+   return column == columns.end() ? 0 : column->second.metadata->reference_sequence.size();
+}
+
+uint64_t estimatedCardinality(
+   const scalar_expressions::ScalarExpression& filter,
+   const storage::Table& table
+) {
+   auto& cache = scalar_expressions::getFilterBitmapCache();
+   if (cache.enabled()) {
+      if (const auto key = scalar_expressions::filterCacheKey(filter, table)) {
+         if (const auto cached_bitmap = cache.peek(*key)) {
+            return cached_bitmap->cardinality();
+         }
+      }
+   }
+   return table.sequence_count;
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+void addCost(operators::QueryNode& node, QueryCostEstimate& estimate) {
+   operators::visit(node, [&](auto& concrete_node) {
+      using Node = std::remove_cvref_t<decltype(concrete_node)>;
+      if constexpr (std::is_same_v<Node, operators::TableScanNode>) {
+         const uint64_t rows = estimatedCardinality(*concrete_node.filter, *concrete_node.table);
+         uint64_t row_size = 0;
+         for (const auto& field : concrete_node.fields) {
+            row_size += estimatedValueSizeInBytes(*concrete_node.table, field);
+            estimate.reconstructs_sequences |= schema::isSequenceColumn(field.type);
+         }
+         estimate.rows += rows;
+         estimate.materialized_bytes += rows * row_size;
+      } else if constexpr (requires {
+                              concrete_node.table;
+                              concrete_node.filter;
+                           }) {
+         estimate.rows += estimatedCardinality(*concrete_node.filter, *concrete_node.table);
+      }
+      if constexpr (requires { concrete_node.child; }) {
+         addCost(*concrete_node.child, estimate);
+      }
+      if constexpr (requires {
+                       concrete_node.left;
+                       concrete_node.right;
+                    }) {
+         addCost(*concrete_node.left, estimate);
+         addCost(*concrete_node.right, estimate);
+      }
+   });
+}
+
+}  // namespace
+
+void to_json(nlohmann::json& json, const QueryCostEstimate& estimate) {
+   json = nlohmann::json{
+      {"rows", estimate.rows},
+      {"materializedBytes", estimate.materialized_bytes},
+      {"reconstructsSequences", estimate.reconstructs_sequences},
+   };
+}
+
+uint64_t estimatedValueSizeInBytes(
+   const storage::Table& table,
+   const schema::ColumnIdentifier& column
+) {
+   switch (column.type) {
+      case schema::ColumnType::STRING:
+      case schema::ColumnType::DICTIONARY_ENCODED:
+         return STRING_VALUE_SIZE;
+      case schema::ColumnType::BOOL:
+         return 1;
+      case schema::ColumnType::DATE32:
+      case schema::ColumnType::INT32:
+         return 4;
+      case schema::ColumnType::INT64:
+      case schema::ColumnType::FLOAT:
+         return 8;
+      case schema::ColumnType::NUCLEOTIDE_SEQUENCE:
+         return referenceLength(table.columns.nuc_columns, column.name);
+      case schema::ColumnType::AMINO_ACID_SEQUENCE:
+         return referenceLength(table.columns.aa_columns, column.name);
+      case schema::ColumnType::ZSTD_COMPRESSED_STRING:
+         return ZSTD_COMPRESSED_STRING_VALUE_SIZE;
+   }
+   SILO_UNREACHABLE();
+}
+
+QueryCostEstimate estimateQueryCost(operators::QueryNode& query) {
+   QueryCostEstimate estimate;
+   addCost(query, estimate);
+   return estimate;
+}
+
+}  // namespace rhydb::query_engine
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+#include <nlohmann/json_fwd.hpp>
+
+#include "rhydb/query_engine/operators/query_node.h"
+#include "rhydb/schema/database_schema.h"
+#include "rhydb/storage/table.h"
+
+namespace rhydb::query_engine {
+
+/// What a query costs to execute, estimated from its optimized plan before it is executed
+struct QueryCostEstimate {
+   /// The rows that the leaves of the plan read from their tables. An upper bound, unless the
+   /// filters of the leaves are in the filter bitmap cache (see `getFilterBitmapCache`).
+   uint64_t rows = 0;
+   /// The rows that table scans materialize times the estimated size of the scanned values
+   uint64_t materialized_bytes = 0;
+   /// Whether a table scan reconstructs sequences, the most expensive values to materialize
+   bool reconstructs_sequences = false;
+};
+
+void to_json(nlohmann::json& json, const QueryCostEstimate& estimate);
+
+/// The estimated size of a value of `column` of `table` in a result batch. Sequences are as long
+/// as their reference.
+[[nodiscard]] uint64_t estimatedValueSizeInBytes(
+   const storage::Table& table,
+   const schema::ColumnIdentifier& column
+);
+
+/// Sums the costs of all leaves of the optimized `query`. The rows of a leaf are the cardinality of
+/// its filter if the filter bitmap cache holds it, and the rows of its table otherwise. Limits are
+/// not taken into account, as most of them only apply after all rows were scanned.
+[[nodiscard]] QueryCostEstimate estimateQueryCost(operators::QueryNode& query);
+
+}  // namespace rhydb::query_engine
@@ -0,0 +1,89 @@
+#include "rhydb/query_engine/query_cost.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "rhydb/common/nucleotide_symbols.h"
+#include "rhydb/query_engine/operators/count_filter_node.h"
+#include "rhydb/query_engine/operators/table_scan_node.h"
+#include "rhydb/query_engine/operators/union_all_node.h"
+#include "rhydb/query_engine/scalar_expressions/literal.h"
+#include "rhydb/schema/database_schema.h"
+#include "rhydb/storage/column/column_metadata.h"
+#include "rhydb/storage/column/sequence_column.h"
+#include "rhydb/storage/column/string_column.h"
+#include "rhydb/storage/table.h"
+
+using rhydb::Nucleotide;
+using rhydb::query_engine::estimateQueryCost;
+using rhydb::schema::ColumnIdentifier;
+using rhydb::schema::ColumnType;
+namespace scalar_expressions = rhydb::query_engine::scalar_expressions;
+namespace operators = rhydb::query_engine::operators;
+
+namespace {
+
+const ColumnIdentifier NUC_COLUMN{.name = "nuc", .type = ColumnType::NUCLEOTIDE_SEQUENCE};
+const ColumnIdentifier ID_COLUMN{.name = "id", .type = ColumnType::STRING};
+constexpr size_t REFERENCE_LENGTH = 100;
+constexpr uint32_t ROWS = 1000;
+
+/// A table of `ROWS` rows without data: the estimate only reads the schema and the row count
+std::shared_ptr<rhydb::storage::Table> tableWithRows() {
+   using rhydb::storage::column::ColumnMetadata;
+   using rhydb::storage::column::SequenceColumnMetadata;
+   using rhydb::storage::column::StringColumnMetadata;
+
+   std::map<ColumnIdentifier, std::shared_ptr<ColumnMetadata>> col_meta{
+      {ID_COLUMN, std::make_shared<StringColumnMetadata>(ID_COLUMN.name)},
+      {NUC_COLUMN,
+       std::make_shared<SequenceColumnMetadata<Nucleotide>>(
+          NUC_COLUMN.name, std::vector<Nucleotide::Symbol>(REFERENCE_LENGTH, Nucleotide::Symbol::A)
+       )}
+   };
+   auto schema = std::make_shared<rhydb::schema::TableSchema>(std::move(col_meta), ID_COLUMN);
+   auto table =
+      std::make_shared<rhydb::storage::Table>(rhydb::schema::TableName::getDefault(), schema);
+   table->sequence_count = ROWS;
+   return table;
+}
+
+operators::QueryNodePtr makeScan(std::vector<ColumnIdentifier> fields) {
+   return std::make_unique<operators::TableScanNode>(
+      tableWithRows(), std::make_unique<scalar_expressions::BoolLiteral>(true), std::move(fields)
+   );
+}
+
+}  // namespace
+
+TEST(EstimateQueryCost, sequencesAreAsLargeAsTheirReference) {
+   const auto scan = makeScan({ID_COLUMN, NUC_COLUMN});
+   const auto estimate = estimateQueryCost(*scan);
+   EXPECT_EQ(estimate.rows, ROWS);
+   const uint64_t id_size =
+      rhydb::query_engine::estimatedValueSizeInBytes(*tableWithRows(), ID_COLUMN);
+   EXPECT_EQ(estimate.materialized_bytes, ROWS * (REFERENCE_LENGTH + id_size));
+   EXPECT_TRUE(estimate.reconstructs_sequences);
+}
+
+TEST(EstimateQueryCost, countsDoNotMaterializeRows) {
+   operators::CountFilterNode count{
+      tableWithRows(), std::make_unique<scalar_expressions::BoolLiteral>(true)
+   };
+   const auto estimate = estimateQueryCost(count);
+   EXPECT_EQ(estimate.rows, ROWS);
+   EXPECT_EQ(estimate.materialized_bytes, 0);
+   EXPECT_FALSE(estimate.reconstructs_sequences);
+}
+
+TEST(EstimateQueryCost, sumsTheCostsOfAllLeaves) {
+   operators::UnionAllNode union_all{makeScan({ID_COLUMN}), makeScan({ID_COLUMN})};
+   const auto single = estimateQueryCost(*makeScan({ID_COLUMN}));
+   const auto estimate = estimateQueryCost(union_all);
+   EXPECT_EQ(estimate.rows, 2 * single.rows);
+   EXPECT_EQ(estimate.materialized_bytes, 2 * single.materialized_bytes);
+   EXPECT_FALSE(estimate.reconstructs_sequences);
+}
@@ -1,5 +1,7 @@
 #include "rhydb/query_engine/query_plan.h"
 
+#include <chrono>
+
 #include <arrow/acero/query_context.h>
 #include <arrow/array.h>
 #include <arrow/compute/ordering.h>
@@ -63,12 +65,22 @@ arrow::Status QueryPlan::executeAndWriteImpl(
    );
 
    // Ensure plan is stopped on any exit path (timeout/error/exception).
-   const struct PlanStopGuard {
+   struct PlanStopGuard {
       std::string_view request_id;
       std::shared_ptr<arrow::acero::ExecPlan> plan;
+      std::shared_ptr<CancellationToken> cancellation_token;
+      bool finished_all_batches = false;
 
       ~PlanStopGuard() {
          constexpr double GRACE_SHUTDOWN_SECONDS = 5.0;  // avoid hanging on teardown
+         if (cancellation_token != nullptr) {
+            cancellation_token->setDeadline(std::nullopt);
+            // Producers that are still running stop at their next check instead of filling
+            // batches nobody reads. Keeps the reason if the token was cancelled before.
+            if (!finished_all_batches) {
+               cancellation_token->cancel(CancellationReason::FAILED);
+            }
+         }
          try {
             if (plan) {
                SPDLOG_DEBUG(
@@ -104,14 +116,32 @@ arrow::Status QueryPlan::executeAndWriteImpl(
             );
          }
       }
-   } guard{.request_id = request_id, .plan = arrow_plan};
+   } guard{.request_id = request_id, .plan = arrow_plan, .cancellation_token = cancellation_token};
+
+   // The sink cannot write anymore, most likely because the client went away
+   const auto cancel_if_client_gone = [&](const arrow::Status& status) {
+      if (status.IsIOError() && cancellation_token != nullptr) {
+         cancellation_token->cancel(CancellationReason::CLIENT_GONE);
+      }
+      return status;
+   };
 
    while (true) {
+      if (cancellation_token != nullptr) {
+         cancellation_token->setTimeout(std::chrono::seconds{timeout_in_seconds});
+      }
       const arrow::Future<std::optional<arrow::ExecBatch>> future_batch = results_generator();
       SPDLOG_DEBUG("Request Id [{}] - QueryPlan - await the next batch", request_id);
       const bool finished_batch_in_time =
          future_batch.Wait(static_cast<double>(timeout_in_seconds));
+      if (cancellation_token != nullptr) {
+         // Writing the batch to a slow client does not count against the timeout
+         cancellation_token->setDeadline(std::nullopt);
+      }
       if (!finished_batch_in_time) {
+         if (cancellation_token != nullptr) {
+            cancellation_token->cancel(CancellationReason::DEADLINE);
+         }
          SPDLOG_WARN(
             "Request Id [{}] - QueryPlan - Batch wait timed out after {} s — stopping plan.",
             request_id,
@@ -139,9 +169,10 @@ arrow::Status QueryPlan::executeAndWriteImpl(
          optional_batch.value().length
       );
 
-      ARROW_RETURN_NOT_OK(output_sink.writeBatch(optional_batch.value()));
+      ARROW_RETURN_NOT_OK(cancel_if_client_gone(output_sink.writeBatch(optional_batch.value())));
    };
-   ARROW_RETURN_NOT_OK(output_sink.finish());
+   ARROW_RETURN_NOT_OK(cancel_if_client_gone(output_sink.finish()));
+   guard.finished_all_batches = true;
    SPDLOG_DEBUG("Request Id [{}] - QueryPlan - Finished reading all batches.", request_id);
    return arrow::Status::OK();
 }
@@ -152,6 +183,13 @@ void QueryPlan::executeAndWrite(
 ) {
    auto status = executeAndWriteImpl(output_sink, timeout_in_seconds);
    if (!status.ok()) {
+      if (status.IsCancelled()) {
+         throw QueryCancelledException(
+            request_id,
+            cancellation_token != nullptr ? cancellation_token->cancellationReason()
+                                          : CancellationReason::FAILED
+         );
+      }
       if (status.IsIOError()) {
          SPDLOG_WARN(
             "The request {} encountered an IO Error when sending the response. We expect that the "
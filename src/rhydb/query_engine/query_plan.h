@@ -10,6 +10,7 @@
 #include <arrow/compute/ordering.h>
 #include <arrow/util/async_generator_fwd.h>
 
+#include "rhydb/query_engine/cancellation_token.h"
 #include "rhydb/query_engine/exec_node/arrow_batch_sink.h"
 
 namespace rhydb::query_engine {
@@ -29,6 +30,9 @@ class QueryPlan {
    std::string_view request_id;
    // The arrow ordering of the rows this plan emits
    arrow::compute::Ordering result_ordering = arrow::compute::Ordering::Unordered();
+   // Cancelled when the plan stops early, so that its producers stop as well. While the plan waits
+   // for a batch, the token's deadline is the timeout of that batch.
+   std::shared_ptr<CancellationToken> cancellation_token;
 
    static arrow::Result<QueryPlan> makeQueryPlan(
       std::shared_ptr<arrow::acero::ExecPlan> arrow_plan,
@@ -36,6 +40,8 @@ class QueryPlan {
       std::string_view request_id
    );
 
+   /// Throws `QueryCancelledException` if the producers of the plan stopped because its
+   /// `cancellation_token` was cancelled
    void executeAndWrite(exec_node::ArrowBatchSink& output_sink, uint64_t timeout_in_seconds);
 
   private:
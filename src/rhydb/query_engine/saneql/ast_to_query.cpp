@@ -513,7 +513,8 @@ ScalarExpressionPtr handleInsertionContains(
    const BoundArguments& args,
    const std::vector<schema::ColumnIdentifier>& schema
 ) {
-   auto position = extractUint32Literal(args.at("position"));
+   // Without a position, insertions at any position are searched
+   auto position = args.getOptionalUint32("position");
    auto value = extractStringLiteral(args.at("value"));
    CHECK_SILO_QUERY(
       !value.empty(),
@@ -1701,7 +1702,7 @@ ScalarFunctionRegistry::ScalarFunctionRegistry() {
    registerFunction("hasAAMutation", has_mutation_sig, handleHasMutation<AminoAcid>);
 
    auto insertion_contains_sig =
-      FunctionSignature{{named("position"), named("value"), named("sequenceName")}};
+      FunctionSignature{{named("position", false), named("value"), named("sequenceName")}};
    registerFunction("insertionContains", insertion_contains_sig, handleInsertionContains<Nucleotide>);
    registerFunction("aminoAcidInsertionContains", insertion_contains_sig, handleInsertionContains<AminoAcid>);
 
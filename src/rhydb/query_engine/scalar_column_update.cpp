@@ -64,6 +64,11 @@ void assignScalarLiteralToColumn(
                column.name
             ));
          }
+         if (string_column.hasPrimaryKeyIndex()) {
+            throw IllegalQueryException(fmt::format(
+               "Column '{}' is the primary key of its table and cannot be updated", column.name
+            ));
+         }
          string_column.update(
             row_ids, is_null ? std::nullopt : std::optional{ast::extractStringLiteral(*literal)}
          );
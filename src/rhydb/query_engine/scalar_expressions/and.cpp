@@ -1,6 +1,7 @@
 #include "rhydb/query_engine/scalar_expressions/and.h"
 
 #include <algorithm>
+#include <array>
 #include <memory>
 #include <string>
 #include <utility>
@@ -19,6 +20,7 @@
 #include "rhydb/query_engine/filter/operators/selection.h"
 #include "rhydb/query_engine/filter/operators/union.h"
 #include "rhydb/query_engine/illegal_query_exception.h"
+#include "rhydb/query_engine/scalar_expressions/filter_bitmap_cache.h"
 #include "rhydb/query_engine/scalar_expressions/scalar_expression.h"
 
 namespace rhydb::query_engine::scalar_expressions {
@@ -36,6 +38,10 @@ std::string And::toString() const {
    return res;
 }
 
+std::optional<std::string> And::cacheKey() const {
+   return compositeCacheKey("And", children);
+}
+
 std::vector<schema::ColumnIdentifier> And::freeIUs() const {
    std::vector<schema::ColumnIdentifier> result;
    for (const auto& child : children) {
@@ -48,6 +54,15 @@ std::vector<schema::ColumnIdentifier> And::freeIUs() const {
 
 namespace {
 
+/// The child operators whose parts `compileChildren` merges into the operator of the `And`
+constexpr std::array MERGED_CHILD_TYPES{
+   filter::operators::EMPTY,
+   filter::operators::FULL,
+   filter::operators::INTERSECTION,
+   filter::operators::COMPLEMENT,
+   filter::operators::SELECTION,
+};
+
 void logCompiledChildren(
    OperatorVector& non_negated_child_operators,
    OperatorVector& negated_child_operators,
@@ -96,7 +111,7 @@ std::tuple<OperatorVector, OperatorVector, filter::operators::PredicateVector> A
       children,
       std::back_inserter(unprocessed_child_operators),
       [&](const std::unique_ptr<ScalarExpression>& expression) {
-         return expression->compile(table);
+         return compileWithFilterCache(*expression, table, MERGED_CHILD_TYPES);
       }
    );
    OperatorVector non_negated_child_operators;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -35,6 +36,7 @@ class And : public ScalarExpression {
    }
 
    [[nodiscard]] std::string toString() const override;
+   [[nodiscard]] std::optional<std::string> cacheKey() const override;
    static constexpr Kind KIND = Kind::AND;
    [[nodiscard]] Kind kind() const override { return KIND; }
 
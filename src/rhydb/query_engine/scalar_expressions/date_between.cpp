@@ -40,6 +40,15 @@ std::string DateBetween::toString() const {
    return res;
 }
 
+std::optional<std::string> DateBetween::cacheKey() const {
+   return fmt::format(
+      "DateBetween({},{},{})",
+      cacheKeyString(column.name),
+      date_from.has_value() ? std::to_string(date_from.value()) : "unbounded",
+      date_to.has_value() ? std::to_string(date_to.value()) : "unbounded"
+   );
+}
+
 std::vector<schema::ColumnIdentifier> DateBetween::freeIUs() const {
    return {column};
 }
@@ -51,12 +60,11 @@ std::unique_ptr<ScalarExpression> DateBetween::rewrite(
    return std::make_unique<DateBetween>(column, date_from, date_to);
 }
 
-using filter::operators::Comparator;
-using filter::operators::CompareToValueSelection;
+using filter::operators::CompareToRangeSelection;
 using filter::operators::Operator;
-using filter::operators::PredicateVector;
 using filter::operators::RangeSelection;
 using filter::operators::Selection;
+using filter::operators::ValueRange;
 
 std::unique_ptr<Operator> DateBetween::compile(const storage::Table& table) const {
    CHECK_SILO_QUERY(
@@ -77,16 +85,18 @@ std::unique_ptr<Operator> DateBetween::compile(const storage::Table& table) cons
          computeRangesOfSortedColumn(date_column), table.row_layout
       );
    }
-   PredicateVector predicates;
-   predicates.emplace_back(std::make_unique<CompareToValueSelection<Date32Column>>(
-      date_column,
-      Comparator::HIGHER_OR_EQUALS,
-      date_from.value_or(std::numeric_limits<Date32>::min())
-   ));
-   predicates.emplace_back(std::make_unique<CompareToValueSelection<Date32Column>>(
-      date_column, Comparator::LESS_OR_EQUALS, date_to.value_or(std::numeric_limits<Date32>::max())
-   ));
-   return std::make_unique<Selection>(std::move(predicates), table.row_layout);
+   // Appended data is usually sorted within its chunks though not across them, the chunks that are
+   // sorted on their own are still binary searched (see `compareChunksToRange`)
+   return std::make_unique<Selection>(
+      std::make_unique<CompareToRangeSelection<Date32Column>>(
+         date_column,
+         ValueRange<Date32>{
+            .lower = date_from.value_or(std::numeric_limits<Date32>::min()),
+            .upper = date_to.value_or(std::numeric_limits<Date32>::max())
+         }
+      ),
+      table.row_layout
+   );
 }
 
 using storage::column::RowId;
@@ -104,7 +114,7 @@ std::vector<RangeSelection::Range> DateBetween::computeRangesOfSortedColumn(
    const auto& value_buffer = date_column.getValueBuffer();
    SILO_ASSERT(value_buffer.numChunks() <= UINT16_MAX);
    for (size_t chunk_idx = 0; chunk_idx < value_buffer.numChunks(); ++chunk_idx) {
-      const auto& chunk = value_buffer.chunk(chunk_idx);
+      const auto chunk = value_buffer.chunk(chunk_idx);
       const auto* begin = chunk.data();
       const auto* end = begin + chunk.size();
       const auto* lower = std::lower_bound(begin, end, from);
@@ -35,6 +35,7 @@ class DateBetween : public ScalarExpression {
    }
 
    [[nodiscard]] std::string toString() const override;
+   [[nodiscard]] std::optional<std::string> cacheKey() const override;
    static constexpr Kind KIND = Kind::DATE_BETWEEN;
    [[nodiscard]] Kind kind() const override { return KIND; }
 
@@ -0,0 +1,249 @@
+#include "rhydb/query_engine/scalar_expressions/filter_bitmap_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include "evobench/evobench.hpp"
+#include "rhydb/query_engine/filter/operators/bitmap_producer.h"
+
+namespace rhydb::query_engine::scalar_expressions {
+
+using filter::operators::BitmapProducer;
+using filter::operators::Operator;
+
+void to_json(nlohmann::json& json, const FilterBitmapCacheStatistics& statistics) {
+   nlohmann::json kinds = nlohmann::json::object();
+   for (const auto& [kind, kind_statistics] : statistics.kinds) {
+      const uint64_t lookups = kind_statistics.hits + kind_statistics.misses;
+      kinds[kind] = nlohmann::json{
+         {"hits", kind_statistics.hits},
+         {"misses", kind_statistics.misses},
+         {"rejections", kind_statistics.rejections},
+         {"hitRate",
+          lookups == 0 ? 0.0
+                       : static_cast<double>(kind_statistics.hits) / static_cast<double>(lookups)},
+      };
+   }
+   json = nlohmann::json{
+      {"kinds", kinds},
+      {"entries", statistics.entries},
+      {"sizeInBytes", statistics.size_in_bytes},
+      {"capacityInBytes", statistics.capacity_in_bytes},
+   };
+}
+
+FilterBitmapCache::FilterBitmapCache(size_t capacity_in_bytes)
+    : capacity_in_bytes(capacity_in_bytes) {}
+
+bool FilterBitmapCache::enabled() const {
+   const std::lock_guard lock{mutex};
+   return capacity_in_bytes > 0;
+}
+
+void FilterBitmapCache::setCapacity(size_t new_capacity_in_bytes) {
+   const std::lock_guard lock{mutex};
+   capacity_in_bytes = new_capacity_in_bytes;
+   evictUntilBelow(capacity_in_bytes);
+}
+
+uint64_t FilterBitmapCache::currentGeneration() const {
+   const std::lock_guard lock{mutex};
+   return generation;
+}
+
+std::shared_ptr<const CopyOnWriteBitmap> FilterBitmapCache::lookup(
+   const std::string& key,
+   ScalarExpression::Kind kind
+) {
+   const std::lock_guard lock{mutex};
+   const auto entry = index.find(key);
+   if (entry == index.end()) {
+      ++statistics[kind].misses;
+      return nullptr;
+   }
+   entries.splice(entries.begin(), entries, entry->second);
+   ++statistics[kind].hits;
+   return entry->second->bitmap;
+}
+
+std::shared_ptr<const CopyOnWriteBitmap> FilterBitmapCache::peek(const std::string& key) const {
+   const std::lock_guard lock{mutex};
+   const auto entry = index.find(key);
+   return entry == index.end() ? nullptr : entry->second->bitmap;
+}
+
+bool FilterBitmapCache::admits(
+   size_t bitmap_size_in_bytes,
+   std::chrono::nanoseconds evaluation_time
+) const {
+   const std::lock_guard lock{mutex};
+   return bitmap_size_in_bytes <= capacity_in_bytes / MAX_ENTRY_SHARE &&
+          evaluation_time >= MIN_EVALUATION_TIME &&
+          static_cast<double>(evaluation_time.count()) >=
+             MIN_NANOSECONDS_PER_BYTE * static_cast<double>(bitmap_size_in_bytes);
+}
+
+void FilterBitmapCache::insert(
+   std::string key,
+   ScalarExpression::Kind kind,
+   const CopyOnWriteBitmap& bitmap,
+   std::chrono::nanoseconds evaluation_time,
+   uint64_t generation
+) {
+   const size_t entry_size = key.size() + bitmap.sizeInBytes() + sizeof(Entry);
+   if (!admits(entry_size, evaluation_time)) {
+      const std::lock_guard lock{mutex};
+      ++statistics[kind].rejections;
+      return;
+   }
+   auto cached_bitmap = std::make_shared<const CopyOnWriteBitmap>(bitmap);
+   const std::lock_guard lock{mutex};
+   if (generation != this->generation || index.contains(key) || entry_size > capacity_in_bytes) {
+      return;
+   }
+   evictUntilBelow(capacity_in_bytes - entry_size);
+   entries.push_front(Entry{
+      .key = std::move(key), .bitmap = std::move(cached_bitmap), .size_in_bytes = entry_size
+   });
+   index.emplace(entries.front().key, entries.begin());
+   size_in_bytes += entry_size;
+}
+
+void FilterBitmapCache::evictUntilBelow(size_t target_size_in_bytes) {
+   while (size_in_bytes > target_size_in_bytes) {
+      const Entry& least_recently_used = entries.back();
+      size_in_bytes -= least_recently_used.size_in_bytes;
+      index.erase(least_recently_used.key);
+      entries.pop_back();
+   }
+}
+
+void FilterBitmapCache::clear() {
+   const std::lock_guard lock{mutex};
+   ++generation;
+   index.clear();
+   entries.clear();
+   size_in_bytes = 0;
+}
+
+FilterBitmapCacheStatistics FilterBitmapCache::getStatistics() const {
+   const std::lock_guard lock{mutex};
+   FilterBitmapCacheStatistics result{
+      .kinds = {},
+      .entries = entries.size(),
+      .size_in_bytes = size_in_bytes,
+      .capacity_in_bytes = capacity_in_bytes,
+   };
+   for (const auto& [kind, kind_statistics] : statistics) {
+      result.kinds.emplace(kindToString(kind), kind_statistics);
+   }
+   return result;
+}
+
+FilterBitmapCache& getFilterBitmapCache() {
+   static FilterBitmapCache filter_bitmap_cache{0};
+   return filter_bitmap_cache;
+}
+
+std::optional<std::string> filterCacheKey(
+   const ScalarExpression& expression,
+   const storage::Table& table
+) {
+   auto expression_key = expression.cacheKey();
+   if (!expression_key.has_value()) {
+      return std::nullopt;
+   }
+   return fmt::format("{}\n{}", table.contentVersion(), *expression_key);
+}
+
+namespace {
+
+/// Whether the operator is worth to be wrapped for caching its bitmap: it does more than wrapping
+/// an existing bitmap and the parent evaluates it on its own anyway
+bool shouldOfferToCache(
+   filter::operators::Type type,
+   std::span<const filter::operators::Type> merged_by_parent
+) {
+   using filter::operators::Type;
+   if (type == Type::EMPTY || type == Type::FULL || type == Type::INDEX_SCAN) {
+      return false;
+   }
+   return std::ranges::find(merged_by_parent, type) == merged_by_parent.end();
+}
+
+std::unique_ptr<Operator> producerOfCachedBitmap(
+   std::shared_ptr<const CopyOnWriteBitmap> bitmap,
+   const storage::Table& table
+) {
+   return std::make_unique<BitmapProducer>(
+      [bitmap = std::move(bitmap)]() { return *bitmap; }, table.row_layout
+   );
+}
+
+}  // namespace
+
+std::unique_ptr<Operator> compileWithFilterCache(
+   const ScalarExpression& expression,
+   const storage::Table& table,
+   std::span<const filter::operators::Type> merged_by_parent
+) {
+   auto& cache = getFilterBitmapCache();
+   auto key = cache.enabled() ? filterCacheKey(expression, table) : std::nullopt;
+   if (!key.has_value()) {
+      return expression.compile(table);
+   }
+   const auto kind = expression.kind();
+   const uint64_t generation = cache.currentGeneration();
+   if (auto cached_bitmap = cache.lookup(*key, kind)) {
+      return producerOfCachedBitmap(std::move(cached_bitmap), table);
+   }
+
+   const auto compile_start = std::chrono::steady_clock::now();
+   auto compiled = expression.compile(table);
+   const auto compile_time = std::chrono::steady_clock::now() - compile_start;
+   if (!shouldOfferToCache(compiled->type(), merged_by_parent)) {
+      return compiled;
+   }
+   return std::make_unique<BitmapProducer>(
+      [compiled = std::shared_ptr<const Operator>{std::move(compiled)},
+       key = std::move(*key),
+       kind,
+       compile_time,
+       generation]() {
+         EVOBENCH_SCOPE("FilterBitmapCache", "evaluateAndOffer");
+         const auto start = std::chrono::steady_clock::now();
+         auto bitmap = compiled->evaluate();
+         const auto evaluation_time = compile_time + (std::chrono::steady_clock::now() - start);
+         getFilterBitmapCache().insert(key, kind, bitmap, evaluation_time, generation);
+         return bitmap;
+      },
+      table.row_layout
+   );
+}
+
+CopyOnWriteBitmap evaluateWithFilterCache(
+   const ScalarExpression& expression,
+   const storage::Table& table
+) {
+   auto& cache = getFilterBitmapCache();
+   auto key = cache.enabled() ? filterCacheKey(expression, table) : std::nullopt;
+   if (!key.has_value()) {
+      return expression.compile(table)->evaluate();
+   }
+   const auto kind = expression.kind();
+   const uint64_t generation = cache.currentGeneration();
+   if (auto cached_bitmap = cache.lookup(*key, kind)) {
+      return *cached_bitmap;
+   }
+   const auto start = std::chrono::steady_clock::now();
+   auto bitmap = expression.compile(table)->evaluate();
+   cache.insert(
+      std::move(*key), kind, bitmap, std::chrono::steady_clock::now() - start, generation
+   );
+   return bitmap;
+}
+
+}  // namespace rhydb::query_engine::scalar_expressions
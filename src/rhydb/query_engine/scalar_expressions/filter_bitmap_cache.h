@@ -0,0 +1,148 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <nlohmann/json_fwd.hpp>
+
+#include "rhydb/query_engine/copy_on_write_bitmap.h"
+#include "rhydb/query_engine/filter/operators/operator.h"
+#include "rhydb/query_engine/scalar_expressions/scalar_expression.h"
+#include "rhydb/storage/table.h"
+
+namespace rhydb::query_engine::scalar_expressions {
+
+struct FilterBitmapCacheKindStatistics {
+   uint64_t hits = 0;
+   uint64_t misses = 0;
+   /// Evaluated bitmaps that were not admitted, because they were cheap to compute for their size
+   uint64_t rejections = 0;
+};
+
+struct FilterBitmapCacheStatistics {
+   /// By `kindToString` of the cached expressions
+   std::map<std::string, FilterBitmapCacheKindStatistics> kinds;
+   size_t entries;
+   size_t size_in_bytes;
+   size_t capacity_in_bytes;
+};
+
+void to_json(nlohmann::json& json, const FilterBitmapCacheStatistics& statistics);
+
+/// The evaluated bitmaps of recent filter expressions, shared by all queries, so that queries
+/// that filter the same way only differ in the cost of their actions. Keyed by `filterCacheKey`,
+/// i.e. by the rewritten expression and the content version of the table it was evaluated on.
+/// Evicts the least recently used bitmaps first when they exceed `capacity_in_bytes`.
+///
+/// A bitmap is only admitted if its evaluation took long compared to the memory it holds: see
+/// `MIN_EVALUATION_TIME` and `MIN_NANOSECONDS_PER_BYTE`. Cheap bitmaps, e.g. views of an index,
+/// are computed again faster than they are copied out of the cache. `clear` drops all bitmaps when
+/// a new data version is activated, and makes `insert` reject the bitmaps of evaluations that
+/// looked the cache up before. Thread-safe.
+class FilterBitmapCache {
+   struct Entry {
+      std::string key;
+      std::shared_ptr<const CopyOnWriteBitmap> bitmap;
+      size_t size_in_bytes;
+   };
+
+   mutable std::mutex mutex;
+   size_t capacity_in_bytes;
+   /// Most recently used first
+   std::list<Entry> entries;
+   std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+   size_t size_in_bytes = 0;
+   uint64_t generation = 0;
+   std::map<ScalarExpression::Kind, FilterBitmapCacheKindStatistics> statistics;
+
+   void evictUntilBelow(size_t target_size_in_bytes);
+
+  public:
+   /// A share of the capacity, so that a single bitmap cannot evict most others
+   static constexpr size_t MAX_ENTRY_SHARE = 8;
+   static constexpr std::chrono::microseconds MIN_EVALUATION_TIME{50};
+   static constexpr double MIN_NANOSECONDS_PER_BYTE = 1.0;
+
+   /// A capacity of 0 disables the cache
+   explicit FilterBitmapCache(size_t capacity_in_bytes);
+
+   FilterBitmapCache(const FilterBitmapCache& other) = delete;
+   FilterBitmapCache& operator=(const FilterBitmapCache& other) = delete;
+
+   [[nodiscard]] bool enabled() const;
+
+   /// Evicts bitmaps that do not fit into the new capacity
+   void setCapacity(size_t new_capacity_in_bytes);
+
+   /// Has to be taken before the bitmap to be inserted is evaluated, and passed to `insert`
+   [[nodiscard]] uint64_t currentGeneration() const;
+
+   /// Counts a hit or a miss for `kind`
+   [[nodiscard]] std::shared_ptr<const CopyOnWriteBitmap> lookup(
+      const std::string& key,
+      ScalarExpression::Kind kind
+   );
+
+   /// Like `lookup`, but neither counts nor refreshes the entry, e.g. to estimate the cost of a
+   /// query before it is executed
+   [[nodiscard]] std::shared_ptr<const CopyOnWriteBitmap> peek(const std::string& key) const;
+
+   /// Whether a bitmap of this size that took this long to evaluate would be admitted
+   [[nodiscard]] bool admits(size_t bitmap_size_in_bytes, std::chrono::nanoseconds evaluation_time)
+      const;
+
+   /// Copies `bitmap` into the cache if `admits` it, otherwise counts a rejection for `kind`. Does
+   /// nothing if the cache was cleared since `generation`.
+   void insert(
+      std::string key,
+      ScalarExpression::Kind kind,
+      const CopyOnWriteBitmap& bitmap,
+      std::chrono::nanoseconds evaluation_time,
+      uint64_t generation
+   );
+
+   /// Drops all bitmaps, but keeps the statistics
+   void clear();
+
+   [[nodiscard]] FilterBitmapCacheStatistics getStatistics() const;
+};
+
+/// The process-wide cache used by `compileWithFilterCache` and `evaluateWithFilterCache`. It is
+/// disabled until it is given a capacity.
+FilterBitmapCache& getFilterBitmapCache();
+
+/// The key of `expression` evaluated on the current contents of `table`, nullopt if the expression
+/// cannot be cached
+[[nodiscard]] std::optional<std::string> filterCacheKey(
+   const ScalarExpression& expression,
+   const storage::Table& table
+);
+
+/// Compiles the rewritten `expression` as a child of an `And`, `Or`, .... If the cache holds its
+/// bitmap, the returned operator produces a copy of it. Otherwise the compiled operator is wrapped
+/// so that its bitmap is offered to the cache when it is evaluated, unless it is trivial to
+/// evaluate or of a type in `merged_by_parent`, i.e. one whose parts the parent merges into its
+/// own operator instead of evaluating it on its own.
+[[nodiscard]] std::unique_ptr<filter::operators::Operator> compileWithFilterCache(
+   const ScalarExpression& expression,
+   const storage::Table& table,
+   std::span<const filter::operators::Type> merged_by_parent
+);
+
+/// Compiles and evaluates the rewritten `expression`, or copies its bitmap from the cache
+[[nodiscard]] CopyOnWriteBitmap evaluateWithFilterCache(
+   const ScalarExpression& expression,
+   const storage::Table& table
+);
+
+}  // namespace rhydb::query_engine::scalar_expressions
@@ -0,0 +1,144 @@
+#include "rhydb/query_engine/scalar_expressions/filter_bitmap_cache.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <roaring/roaring.hh>
+
+#include "rhydb/query_engine/scalar_expressions/and.h"
+#include "rhydb/query_engine/scalar_expressions/int_between.h"
+#include "rhydb/query_engine/scalar_expressions/is_null.h"
+#include "rhydb/query_engine/scalar_expressions/negation.h"
+
+using rhydb::query_engine::CopyOnWriteBitmap;
+using rhydb::query_engine::scalar_expressions::And;
+using rhydb::query_engine::scalar_expressions::FilterBitmapCache;
+using rhydb::query_engine::scalar_expressions::IntBetween;
+using rhydb::query_engine::scalar_expressions::IsNull;
+using rhydb::query_engine::scalar_expressions::Negation;
+using rhydb::query_engine::scalar_expressions::ScalarExpression;
+using rhydb::query_engine::scalar_expressions::ScalarExpressionVector;
+using rhydb::schema::ColumnIdentifier;
+using rhydb::schema::ColumnType;
+
+namespace {
+
+constexpr auto KIND = ScalarExpression::Kind::AND;
+constexpr std::chrono::milliseconds SLOW_EVALUATION{100};
+
+/// Every second row, so that the containers are not run-length encoded
+CopyOnWriteBitmap ownedBitmap(uint32_t first_row, uint32_t end_row) {
+   roaring::Roaring bitmap;
+   for (uint32_t row = first_row; row < end_row; row += 2) {
+      bitmap.add(row);
+   }
+   return CopyOnWriteBitmap{std::move(bitmap)};
+}
+
+ColumnIdentifier intColumn(const std::string& name) {
+   return ColumnIdentifier{.name = name, .type = ColumnType::INT32};
+}
+
+}  // namespace
+
+TEST(FilterBitmapCache, returnsAdmittedBitmapsAndCountsHitsAndMissesPerKind) {
+   FilterBitmapCache under_test{1024 * 1024};
+   const uint64_t generation = under_test.currentGeneration();
+   EXPECT_EQ(under_test.lookup("filter", KIND), nullptr);
+
+   under_test.insert("filter", KIND, ownedBitmap(10, 20), SLOW_EVALUATION, generation);
+   const auto cached = under_test.lookup("filter", KIND);
+   ASSERT_NE(cached, nullptr);
+   EXPECT_EQ(cached->toRoaring(), ownedBitmap(10, 20).toRoaring());
+
+   const auto statistics = under_test.getStatistics();
+   EXPECT_EQ(statistics.entries, 1);
+   EXPECT_EQ(statistics.kinds.at("And").hits, 1);
+   EXPECT_EQ(statistics.kinds.at("And").misses, 1);
+   EXPECT_EQ(nlohmann::json(statistics)["kinds"]["And"]["hitRate"], 0.5);
+}
+
+TEST(FilterBitmapCache, rejectsBitmapsThatWereCheapToEvaluateForTheirSize) {
+   FilterBitmapCache under_test{1024 * 1024};
+   const uint64_t generation = under_test.currentGeneration();
+   const auto bitmap = ownedBitmap(0, 100'000);
+
+   under_test.insert("fast", KIND, bitmap, std::chrono::microseconds{1}, generation);
+   EXPECT_EQ(under_test.lookup("fast", KIND), nullptr);
+
+   const auto just_too_fast =
+      std::chrono::nanoseconds{static_cast<int64_t>(bitmap.sizeInBytes() / 2)};
+   EXPECT_FALSE(under_test.admits(bitmap.sizeInBytes(), just_too_fast));
+   EXPECT_TRUE(under_test.admits(bitmap.sizeInBytes(), SLOW_EVALUATION));
+   EXPECT_EQ(under_test.getStatistics().kinds.at("And").rejections, 1);
+}
+
+TEST(FilterBitmapCache, evictsTheLeastRecentlyUsedBitmaps) {
+   const auto bitmap = ownedBitmap(0, 100'000);
+   // Room for the keys and bookkeeping of the entries
+   const size_t entry_size = bitmap.sizeInBytes() + 1024;
+   FilterBitmapCache under_test{FilterBitmapCache::MAX_ENTRY_SHARE * 2 * entry_size};
+   const uint64_t generation = under_test.currentGeneration();
+   under_test.insert("first", KIND, bitmap, SLOW_EVALUATION, generation);
+   under_test.insert("second", KIND, bitmap, SLOW_EVALUATION, generation);
+   for (size_t i = 0; i < FilterBitmapCache::MAX_ENTRY_SHARE * 2; ++i) {
+      ASSERT_NE(under_test.lookup("first", KIND), nullptr);
+      under_test.insert(
+         "other " + std::to_string(i), KIND, bitmap, SLOW_EVALUATION, generation
+      );
+   }
+
+   EXPECT_NE(under_test.lookup("first", KIND), nullptr);
+   EXPECT_EQ(under_test.lookup("second", KIND), nullptr);
+   const auto statistics = under_test.getStatistics();
+   EXPECT_LE(statistics.size_in_bytes, statistics.capacity_in_bytes);
+
+   under_test.setCapacity(0);
+   EXPECT_FALSE(under_test.enabled());
+   EXPECT_EQ(under_test.getStatistics().entries, 0);
+}
+
+TEST(FilterBitmapCache, dropsBitmapsOfEvaluationsThatStartedBeforeItWasCleared) {
+   FilterBitmapCache under_test{1024 * 1024};
+   const uint64_t generation_before_clear = under_test.currentGeneration();
+   EXPECT_EQ(under_test.lookup("filter", KIND), nullptr);
+
+   under_test.clear();
+   under_test.insert("filter", KIND, ownedBitmap(10, 20), SLOW_EVALUATION, generation_before_clear);
+   EXPECT_EQ(under_test.lookup("filter", KIND), nullptr);
+   EXPECT_EQ(under_test.getStatistics().entries, 0);
+
+   under_test.insert(
+      "filter", KIND, ownedBitmap(10, 20), SLOW_EVALUATION, under_test.currentGeneration()
+   );
+   EXPECT_NE(under_test.lookup("filter", KIND), nullptr);
+}
+
+TEST(FilterBitmapCache, keysIdentifyExpressionsExactly) {
+   const auto key_of = [](const ScalarExpression& expression) {
+      return expression.cacheKey();
+   };
+   const IntBetween age{intColumn("age"), 1, 10};
+   EXPECT_NE(key_of(age), std::nullopt);
+   EXPECT_EQ(key_of(age), key_of(IntBetween{intColumn("age"), 1, 10}));
+   // The descriptions do not contain the column
+   EXPECT_EQ(age.toString(), IntBetween(intColumn("height"), 1, 10).toString());
+   EXPECT_NE(key_of(age), key_of(IntBetween{intColumn("height"), 1, 10}));
+   EXPECT_NE(key_of(age), key_of(IntBetween{intColumn("age"), 1, std::nullopt}));
+
+   ScalarExpressionVector children;
+   children.push_back(std::make_unique<IntBetween>(intColumn("age"), 1, 10));
+   children.push_back(std::make_unique<Negation>(
+      std::make_unique<IntBetween>(intColumn("height"), std::nullopt, 200)
+   ));
+   EXPECT_NE(key_of(And{std::move(children)}), std::nullopt);
+
+   ScalarExpressionVector children_without_key;
+   children_without_key.push_back(std::make_unique<IntBetween>(intColumn("age"), 1, 10));
+   children_without_key.push_back(std::make_unique<IsNull>(intColumn("age")));
+   EXPECT_EQ(key_of(And{std::move(children_without_key)}), std::nullopt);
+}
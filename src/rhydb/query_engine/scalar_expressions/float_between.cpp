@@ -52,6 +52,19 @@ std::unique_ptr<filter::operators::Operator> FloatBetween::compile(const storage
    );
    const auto& float_column = table.columns.float_columns.at(column.name);
 
+   if (from.has_value() && to.has_value()) {
+      return std::make_unique<filter::operators::Selection>(
+         std::make_unique<filter::operators::CompareToRangeSelection<FloatColumn>>(
+            float_column,
+            filter::operators::ValueRange<double>{
+               .lower = from.value(),
+               .upper = to.value(),
+               .upper_comparator = filter::operators::Comparator::LESS
+            }
+         ),
+         table.row_layout
+      );
+   }
    filter::operators::PredicateVector predicates;
    if (from.has_value()) {
       predicates.emplace_back(
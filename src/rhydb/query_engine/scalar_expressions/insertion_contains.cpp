@@ -1,5 +1,6 @@
 #include "rhydb/query_engine/scalar_expressions/insertion_contains.h"
 
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -19,7 +20,7 @@ namespace rhydb::query_engine::scalar_expressions {
 template <typename SymbolType>
 InsertionContains<SymbolType>::InsertionContains(
    schema::ColumnIdentifier column,
-   uint32_t position_idx,
+   std::optional<uint32_t> position_idx,
    std::string value
 )
     : column(std::move(column)),
@@ -33,6 +34,17 @@ std::string InsertionContains<SymbolType>::toString() const {
    return sequence_string + " has insertion '" + value + "'";
 }
 
+template <typename SymbolType>
+std::optional<std::string> InsertionContains<SymbolType>::cacheKey() const {
+   return fmt::format(
+      "{}({},{},{})",
+      kindToString(kind()),
+      cacheKeyString(column.name),
+      position_idx.has_value() ? std::to_string(position_idx.value()) : "any",
+      cacheKeyString(value)
+   );
+}
+
 template <typename SymbolType>
 std::vector<schema::ColumnIdentifier> InsertionContains<SymbolType>::freeIUs() const {
    return {column};
@@ -59,17 +71,20 @@ std::unique_ptr<filter::operators::Operator> InsertionContains<SymbolType>::comp
       sequence_stores.at(valid_sequence_name);
    const size_t reference_sequence_size = sequence_store.metadata->reference_sequence.size();
    CHECK_SILO_QUERY(
-      position_idx <= reference_sequence_size,
+      !position_idx.has_value() || *position_idx <= reference_sequence_size,
       "the requested insertion position ({}) is larger than the length of the reference sequence "
       "({}) for sequence '{}'",
-      position_idx,
+      position_idx.value_or(0),
       reference_sequence_size,
       valid_sequence_name
    );
    return std::make_unique<filter::operators::BitmapProducer>(
       [&]() {
          try {
-            auto search_result = sequence_store.insertion_index.search(position_idx, value);
+            auto search_result =
+               position_idx.has_value()
+                  ? sequence_store.insertion_index.search(*position_idx, value)
+                  : sequence_store.insertion_index.search(value);
             return CopyOnWriteBitmap(std::move(*search_result));
          } catch (const storage::InsertionFormatException& exception) {
             throw IllegalQueryException(
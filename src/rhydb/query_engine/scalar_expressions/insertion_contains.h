@@ -22,13 +22,14 @@ template <typename SymbolType>
 class InsertionContains : public ScalarExpression {
   private:
    schema::ColumnIdentifier column;
-   uint32_t position_idx;
+   /// Unset to match insertions at any position
+   std::optional<uint32_t> position_idx;
    std::string value;
 
   public:
    explicit InsertionContains(
       schema::ColumnIdentifier column,
-      uint32_t position_idx,
+      std::optional<uint32_t> position_idx,
       std::string value
    );
 
@@ -37,6 +38,7 @@ class InsertionContains : public ScalarExpression {
    }
 
    [[nodiscard]] std::string toString() const override;
+   [[nodiscard]] std::optional<std::string> cacheKey() const override;
    static constexpr Kind KIND = std::is_same_v<SymbolType, Nucleotide>
                                    ? Kind::INSERTION_CONTAINS_NUCLEOTIDE
                                    : Kind::INSERTION_CONTAINS_AMINO_ACID;
@@ -34,6 +34,7 @@ const std::vector<nlohmann::json> DATA = {
    createDataWithNucleotideInsertions("id_2", {"23:TT"}, {}),
    createDataWithNucleotideInsertions("id_3", {"12:CCC"}, {}),
    createDataWithNucleotideInsertions("id_4", {"0:A"}, {}),
+   createDataWithNucleotideInsertions("id_5", {"5:ACGTACGT"}, {"3:ACGTACGT"}),
 };
 
 const auto DATABASE_CONFIG =
@@ -74,6 +75,32 @@ const QueryTestScenario INSERTION_CONTAINS_SCENARIO_POSITION_0_EQUALS_BEFORE_FIR
    .expected_query_result = nlohmann::json({{{"primaryKey", "id_4"}}})
 };
 
+const QueryTestScenario INSERTION_CONTAINS_AT_ANY_POSITION = {
+   .name = "INSERTION_CONTAINS_AT_ANY_POSITION",
+   .query =
+      "default.filter(insertionContains(value:='A', sequenceName:='segment1')).project(primaryKey)",
+   .expected_query_result = nlohmann::json(
+      {{{"primaryKey", "id_0"}}, {{"primaryKey", "id_1"}}, {{"primaryKey", "id_4"}}}
+   )
+};
+
+// Long enough for the candidates to be looked up in the k-mer index
+const QueryTestScenario INSERTION_CONTAINS_AT_ANY_POSITION_WITH_KMERS = {
+   .name = "INSERTION_CONTAINS_AT_ANY_POSITION_WITH_KMERS",
+   .query =
+      "default.filter(insertionContains(value:='.*GTAC.*', sequenceName:='segment1'))"
+      ".project(primaryKey)",
+   .expected_query_result = nlohmann::json({{{"primaryKey", "id_5"}}})
+};
+
+const QueryTestScenario INSERTION_CONTAINS_AT_ANY_POSITION_WITHOUT_MATCHING_KMERS = {
+   .name = "INSERTION_CONTAINS_AT_ANY_POSITION_WITHOUT_MATCHING_KMERS",
+   .query =
+      "default.filter(insertionContains(value:='.*GGGG.*', sequenceName:='segment1'))"
+      ".project(primaryKey)",
+   .expected_query_result = nlohmann::json::array()
+};
+
 // A sequence name is required for every nucleotide sequence filter.
 const QueryTestScenario INSERTION_CONTAINS_WITHOUT_SEQUENCE_NAME_ERRORS = {
    .name = "INSERTION_CONTAINS_WITHOUT_SEQUENCE_NAME_ERRORS",
@@ -162,6 +189,14 @@ const QueryTestScenario AMINO_ACID_INSERTION_CONTAINS_SCENARIO = {
    .expected_query_result = nlohmann::json({{{"primaryKey", "id_0"}}, {{"primaryKey", "id_1"}}})
 };
 
+const QueryTestScenario AMINO_ACID_INSERTION_CONTAINS_AT_ANY_POSITION = {
+   .name = "AMINO_ACID_INSERTION_CONTAINS_AT_ANY_POSITION",
+   .query =
+      "default.filter(aminoAcidInsertionContains(value:='.*B.*', sequenceName:='gene1'))"
+      ".project(primaryKey)",
+   .expected_query_result = nlohmann::json({{{"primaryKey", "id_2"}}})
+};
+
 const QueryTestScenario AMINO_ACID_INSERTION_CONTAINS_WITH_NULL_SEGMENT_SCENARIO = {
    .name = "AMINO_ACID_INSERTION_CONTAINS_WITH_NULL_SEGMENT_SCENARIO",
    .query = "default.filter(aminoAcidInsertionContains(position:=12, value:='A'))",
@@ -178,6 +213,9 @@ QUERY_TEST(
    ::testing::Values(
       nucleotide::INSERTION_CONTAINS_SCENARIO,
       nucleotide::INSERTION_CONTAINS_SCENARIO_POSITION_0_EQUALS_BEFORE_FIRST,
+      nucleotide::INSERTION_CONTAINS_AT_ANY_POSITION,
+      nucleotide::INSERTION_CONTAINS_AT_ANY_POSITION_WITH_KMERS,
+      nucleotide::INSERTION_CONTAINS_AT_ANY_POSITION_WITHOUT_MATCHING_KMERS,
       nucleotide::INSERTION_CONTAINS_WITHOUT_SEQUENCE_NAME_ERRORS,
       nucleotide::INSERTION_CONTAINS_WITH_UNKNOWN_SEGMENT_SCENARIO,
       nucleotide::INSERTION_CONTAINS_POSITION_OUT_OF_RANGE,
@@ -190,6 +228,7 @@ QUERY_TEST(
    amino_acid::TEST_DATA,
    ::testing::Values(
       amino_acid::AMINO_ACID_INSERTION_CONTAINS_SCENARIO,
+      amino_acid::AMINO_ACID_INSERTION_CONTAINS_AT_ANY_POSITION,
       amino_acid::AMINO_ACID_INSERTION_CONTAINS_WITH_NULL_SEGMENT_SCENARIO
    )
 );
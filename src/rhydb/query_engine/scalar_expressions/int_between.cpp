@@ -56,6 +56,15 @@ std::string IntBetween::toString() const {
    return "[IntBetween " + from_string + " - " + to_string + "]";
 }
 
+std::optional<std::string> IntBetween::cacheKey() const {
+   return fmt::format(
+      "IntBetween({},{},{})",
+      cacheKeyString(column.name),
+      from.has_value() ? std::to_string(from.value()) : "unbounded",
+      to.has_value() ? std::to_string(to.value()) : "unbounded"
+   );
+}
+
 std::vector<schema::ColumnIdentifier> IntBetween::freeIUs() const {
    return {column};
 }
@@ -73,6 +82,18 @@ std::unique_ptr<filter::operators::Operator> IntBetween::compileFor(
    const storage::Table& table
 ) const {
    using value_type = ColumnT::value_type;
+   if (from.has_value() && to.has_value()) {
+      return std::make_unique<filter::operators::Selection>(
+         std::make_unique<filter::operators::CompareToRangeSelection<ColumnT>>(
+            column_ref,
+            filter::operators::ValueRange<value_type>{
+               .lower = static_cast<value_type>(from.value()),
+               .upper = static_cast<value_type>(to.value())
+            }
+         ),
+         table.row_layout
+      );
+   }
    filter::operators::PredicateVector predicates;
    if (from.has_value()) {
       predicates.emplace_back(std::make_unique<filter::operators::CompareToValueSelection<ColumnT>>(
@@ -38,6 +38,7 @@ class IntBetween : public ScalarExpression {
    }
 
    [[nodiscard]] std::string toString() const override;
+   [[nodiscard]] std::optional<std::string> cacheKey() const override;
    static constexpr Kind KIND = Kind::INT_BETWEEN;
    [[nodiscard]] Kind kind() const override { return KIND; }
 
@@ -37,6 +37,16 @@ std::string LineageFilter::toString() const {
    return "'" + lineage.value() + "'";
 }
 
+std::optional<std::string> LineageFilter::cacheKey() const {
+   return fmt::format(
+      "LineageFilter({},{},{})",
+      cacheKeyString(column.name),
+      lineage.has_value() ? cacheKeyString(lineage.value()) : "null",
+      sublineage_mode.has_value() ? std::to_string(static_cast<int>(sublineage_mode.value()))
+                                  : "none"
+   );
+}
+
 std::vector<schema::ColumnIdentifier> LineageFilter::freeIUs() const {
    return {column};
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -29,6 +30,7 @@ class LineageFilter : public ScalarExpression {
    }
 
    [[nodiscard]] std::string toString() const override;
+   [[nodiscard]] std::optional<std::string> cacheKey() const override;
    static constexpr Kind KIND = Kind::LINEAGE_FILTER;
    [[nodiscard]] Kind kind() const override { return KIND; }
 
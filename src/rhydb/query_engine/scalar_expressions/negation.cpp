@@ -20,6 +20,14 @@ std::string Negation::toString() const {
    return "!(" + child->toString() + ")";
 }
 
+std::optional<std::string> Negation::cacheKey() const {
+   auto child_key = child->cacheKey();
+   if (!child_key.has_value()) {
+      return std::nullopt;
+   }
+   return "Not(" + *child_key + ")";
+}
+
 std::vector<schema::ColumnIdentifier> Negation::freeIUs() const {
    return child->freeIUs();
 }
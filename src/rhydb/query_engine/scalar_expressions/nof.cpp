@@ -5,6 +5,8 @@
 #include <utility>
 #include <vector>
 
+#include <fmt/format.h>
+
 #include "rhydb/common/string_utils.h"
 #include "rhydb/query_engine/filter/operators/complement.h"
 #include "rhydb/query_engine/filter/operators/empty.h"
@@ -170,6 +172,11 @@ std::string NOf::toString() const {
    return res;
 }
 
+std::optional<std::string> NOf::cacheKey() const {
+   const auto name = fmt::format("{}-of{}", number_of_matchers, match_exactly ? "-exactly" : "");
+   return compositeCacheKey(name, children);
+}
+
 std::vector<schema::ColumnIdentifier> NOf::freeIUs() const {
    std::vector<schema::ColumnIdentifier> result;
    for (const auto& child : children) {
@@ -1,6 +1,7 @@
 #include "rhydb/query_engine/scalar_expressions/or.h"
 
 #include <algorithm>
+#include <array>
 #include <string>
 #include <utility>
 #include <vector>
@@ -12,6 +13,7 @@
 #include "rhydb/query_engine/filter/operators/operator.h"
 #include "rhydb/query_engine/filter/operators/union.h"
 #include "rhydb/query_engine/illegal_query_exception.h"
+#include "rhydb/query_engine/scalar_expressions/filter_bitmap_cache.h"
 #include "rhydb/query_engine/scalar_expressions/literal.h"
 #include "rhydb/query_engine/scalar_expressions/scalar_expression.h"
 #include "rhydb/query_engine/scalar_expressions/string_in_set.h"
@@ -31,6 +33,10 @@ std::string Or::toString() const {
    return res;
 }
 
+std::optional<std::string> Or::cacheKey() const {
+   return compositeCacheKey("Or", children);
+}
+
 std::vector<schema::ColumnIdentifier> Or::freeIUs() const {
    std::vector<schema::ColumnIdentifier> result;
    for (const auto& child : children) {
@@ -123,6 +129,14 @@ template ScalarExpressionVector Or::rewriteSymbolInSetExpressions<Nucleotide>(
 );
 
 namespace {
+
+/// The child operators whose parts `compile` merges into the operator of the `Or`
+constexpr std::array MERGED_CHILD_TYPES{
+   filter::operators::EMPTY,
+   filter::operators::FULL,
+   filter::operators::UNION,
+   filter::operators::COMPLEMENT,
+};
 void appendStringSetToStringSet(
    std::unordered_set<std::string> from,
    std::unordered_set<std::string>& target
@@ -197,7 +211,7 @@ std::unique_ptr<filter::operators::Operator> Or::compile(const storage::Table& t
       children,
       std::back_inserter(all_child_operators),
       [&](const std::unique_ptr<ScalarExpression>& expression) {
-         return expression->compile(table);
+         return compileWithFilterCache(*expression, table, MERGED_CHILD_TYPES);
       }
    );
    OperatorVector filtered_child_operators;
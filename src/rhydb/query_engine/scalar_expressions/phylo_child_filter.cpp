@@ -21,6 +21,12 @@ std::string PhyloChildFilter::toString() const {
    return fmt::format("column {} phylo_child_of {}", column.name, internal_node);
 };
 
+std::optional<std::string> PhyloChildFilter::cacheKey() const {
+   return fmt::format(
+      "PhyloChildFilter({},{})", cacheKeyString(column.name), cacheKeyString(internal_node)
+   );
+}
+
 std::vector<schema::ColumnIdentifier> PhyloChildFilter::freeIUs() const {
    return {column};
 }
@@ -1,5 +1,9 @@
 #include "rhydb/query_engine/scalar_expressions/scalar_expression.h"
 
+#include <fmt/format.h>
+
+#include "rhydb/common/panic.h"
+
 namespace rhydb::query_engine::scalar_expressions {
 
 ScalarExpression::ScalarExpression() = default;
@@ -14,4 +18,108 @@ ScalarExpression::AmbiguityMode invertMode(ScalarExpression::AmbiguityMode mode)
    return mode;
 }
 
+std::string_view kindToString(ScalarExpression::Kind kind) {
+   switch (kind) {
+      case ScalarExpression::Kind::AND:
+         return "And";
+      case ScalarExpression::Kind::OR:
+         return "Or";
+      case ScalarExpression::Kind::AT:
+         return "At";
+      case ScalarExpression::Kind::ISO_WEEK:
+         return "IsoWeek";
+      case ScalarExpression::Kind::N_OF:
+         return "NOf";
+      case ScalarExpression::Kind::NEGATION:
+         return "Negation";
+      case ScalarExpression::Kind::MAYBE:
+         return "Maybe";
+      case ScalarExpression::Kind::EXACT:
+         return "Exact";
+      case ScalarExpression::Kind::EQUALS:
+         return "Equals";
+      case ScalarExpression::Kind::COMPARISON:
+         return "Comparison";
+      case ScalarExpression::Kind::DATE_BETWEEN:
+         return "DateBetween";
+      case ScalarExpression::Kind::FIELD_REF:
+         return "FieldRef";
+      case ScalarExpression::Kind::FLOAT_BETWEEN:
+         return "FloatBetween";
+      case ScalarExpression::Kind::INT_BETWEEN:
+         return "IntBetween";
+      case ScalarExpression::Kind::IS_NULL:
+         return "IsNull";
+      case ScalarExpression::Kind::LINEAGE_FILTER:
+         return "LineageFilter";
+      case ScalarExpression::Kind::PHYLO_CHILD_FILTER:
+         return "PhyloChildFilter";
+      case ScalarExpression::Kind::STRING_IN_SET:
+         return "StringInSet";
+      case ScalarExpression::Kind::STRING_SEARCH:
+         return "StringSearch";
+      case ScalarExpression::Kind::INT32_LITERAL:
+         return "Int32Literal";
+      case ScalarExpression::Kind::INT64_LITERAL:
+         return "Int64Literal";
+      case ScalarExpression::Kind::FLOAT_LITERAL:
+         return "FloatLiteral";
+      case ScalarExpression::Kind::STRING_LITERAL:
+         return "StringLiteral";
+      case ScalarExpression::Kind::BOOL_LITERAL:
+         return "BoolLiteral";
+      case ScalarExpression::Kind::DATE_LITERAL:
+         return "DateLiteral";
+      case ScalarExpression::Kind::HAS_MUTATION_NUCLEOTIDE:
+         return "HasMutationNucleotide";
+      case ScalarExpression::Kind::HAS_MUTATION_AMINO_ACID:
+         return "HasMutationAminoAcid";
+      case ScalarExpression::Kind::INSERTION_CONTAINS_NUCLEOTIDE:
+         return "InsertionContainsNucleotide";
+      case ScalarExpression::Kind::INSERTION_CONTAINS_AMINO_ACID:
+         return "InsertionContainsAminoAcid";
+      case ScalarExpression::Kind::MUTATION_PROFILE_NUCLEOTIDE:
+         return "MutationProfileNucleotide";
+      case ScalarExpression::Kind::MUTATION_PROFILE_AMINO_ACID:
+         return "MutationProfileAminoAcid";
+      case ScalarExpression::Kind::SYMBOL_EQUALS_NUCLEOTIDE:
+         return "SymbolEqualsNucleotide";
+      case ScalarExpression::Kind::SYMBOL_EQUALS_AMINO_ACID:
+         return "SymbolEqualsAminoAcid";
+      case ScalarExpression::Kind::SYMBOL_IN_SET_NUCLEOTIDE:
+         return "SymbolInSetNucleotide";
+      case ScalarExpression::Kind::SYMBOL_IN_SET_AMINO_ACID:
+         return "SymbolInSetAminoAcid";
+      case ScalarExpression::Kind::ZSTD_DECOMPRESS_SCALAR:
+         return "ZstdDecompressScalar";
+   }
+   SILO_UNREACHABLE();
+}
+
+std::string cacheKeyString(std::string_view value) {
+   return fmt::format("{}:{}", value.size(), value);
+}
+
+std::optional<std::string> compositeCacheKey(
+   std::string_view name,
+   const ScalarExpressionVector& children
+) {
+   std::string result{name};
+   result += '(';
+   bool first_child = true;
+   for (const auto& child : children) {
+      auto child_key = child->cacheKey();
+      if (!child_key.has_value()) {
+         return std::nullopt;
+      }
+      if (!first_child) {
+         result += ',';
+      }
+      first_child = false;
+      result += *child_key;
+   }
+   result += ')';
+   return result;
+}
+
 }  // namespace rhydb::query_engine::scalar_expressions
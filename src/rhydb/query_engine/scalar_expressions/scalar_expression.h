@@ -1,7 +1,9 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "rhydb/query_engine/filter/operators/operator.h"
@@ -72,6 +74,10 @@ class ScalarExpression {
 
    [[nodiscard]] virtual std::string toString() const = 0;
 
+   /// Identifies this expression exactly, unlike `toString`, which abbreviates and may leave out
+   /// arguments. Used to key the filter bitmap cache; expressions without a key are not cached.
+   [[nodiscard]] virtual std::optional<std::string> cacheKey() const { return std::nullopt; }
+
    /// The columns ("identifiable units") this expression references and that an
    /// upstream node must therefore provide. Literals reference none; a column
    /// reference yields that column. Used by column narrowing to keep the child
@@ -92,6 +98,12 @@ class ScalarExpression {
 
 ScalarExpression::AmbiguityMode invertMode(ScalarExpression::AmbiguityMode mode);
 
+[[nodiscard]] std::string_view kindToString(ScalarExpression::Kind kind);
+
+/// Prefixes `value` with its length, so that user-provided strings cannot run into the rest of a
+/// cache key
+[[nodiscard]] std::string cacheKeyString(std::string_view value);
+
 /// `To` must expose a `static constexpr Kind KIND` identifying its concrete type
 template <typename To, typename From>
 [[nodiscard]] bool isA(const From* expression) {
@@ -120,4 +132,10 @@ void appendVectorToVector(
 
 using ScalarExpressionVector = std::vector<std::unique_ptr<ScalarExpression>>;
 
+/// `name(key_1,key_2,...)` of the cache keys of `children`, nullopt if one of them has none
+[[nodiscard]] std::optional<std::string> compositeCacheKey(
+   std::string_view name,
+   const ScalarExpressionVector& children
+);
+
 }  // namespace rhydb::query_engine::scalar_expressions
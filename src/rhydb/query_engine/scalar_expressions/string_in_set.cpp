@@ -1,11 +1,14 @@
 #include "rhydb/query_engine/scalar_expressions/string_in_set.h"
 
+#include <algorithm>
+#include <iterator>
 #include <utility>
 
 #include <fmt/format.h>
 #include <fmt/ranges.h>
 
 #include "rhydb/common/panic.h"
+#include "rhydb/query_engine/filter/operators/empty.h"
 #include "rhydb/query_engine/filter/operators/index_scan.h"
 #include "rhydb/query_engine/filter/operators/operator.h"
 #include "rhydb/query_engine/filter/operators/string_in_set.h"
@@ -33,6 +36,15 @@ std::string StringInSet::toString() const {
    return fmt::format("{} IN [{}]", column.name, fmt::join(sorted_values, ","));
 }
 
+std::optional<std::string> StringInSet::cacheKey() const {
+   std::vector<std::string> sorted_values;
+   std::ranges::transform(values, std::back_inserter(sorted_values), cacheKeyString);
+   std::ranges::sort(sorted_values);
+   return fmt::format(
+      "StringInSet({},{})", cacheKeyString(column.name), fmt::join(sorted_values, ",")
+   );
+}
+
 std::vector<schema::ColumnIdentifier> StringInSet::freeIUs() const {
    return {column};
 }
@@ -74,6 +86,22 @@ std::unique_ptr<filter::operators::Operator> StringInSet::compile(const storage:
 ) const {
    SILO_ASSERT(table.columns.string_columns.contains(column.name));
    const auto& string_column = table.columns.string_columns.at(column.name);
+
+   // Point lookups of the values instead of a scan over every row, the primary key column is
+   // the only one with an index
+   if (string_column.hasPrimaryKeyIndex()) {
+      roaring::Roaring matching_rows;
+      for (const auto& value : values) {
+         matching_rows |= string_column.lookupPrimaryKey(value);
+      }
+      if (matching_rows.isEmpty()) {
+         return std::make_unique<filter::operators::Empty>(table.row_layout);
+      }
+      return std::make_unique<filter::operators::IndexScan>(
+         CopyOnWriteBitmap{std::move(matching_rows)}, table.row_layout
+      );
+   }
+
    return std::make_unique<filter::operators::Selection>(
       std::make_unique<filter::operators::StringInSet<StringColumn>>(
          &string_column, filter::operators::StringInSet<StringColumn>::Comparator::IN, values
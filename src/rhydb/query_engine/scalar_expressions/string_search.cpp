@@ -1,14 +1,24 @@
 #include "rhydb/query_engine/scalar_expressions/string_search.h"
 
+#include <algorithm>
+#include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 #include <fmt/format.h>
+#include <roaring/roaring.hh>
 
+#include "evobench/evobench.hpp"
 #include "rhydb/common/panic.h"
 #include "rhydb/query_engine/filter/operators/bitmap_producer.h"
 #include "rhydb/query_engine/filter/operators/operator.h"
+#include "rhydb/query_engine/filter/operators/parallel_evaluation.h"
 #include "rhydb/query_engine/illegal_query_exception.h"
 #include "rhydb/query_engine/scalar_expressions/scalar_expression.h"
+#include "rhydb/storage/column/dictionary_encoded_column.h"
+#include "rhydb/storage/column/row_id.h"
+#include "rhydb/storage/column/string_column.h"
 
 namespace rhydb::query_engine::scalar_expressions {
 
@@ -23,25 +33,78 @@ std::string StringSearch::toString() const {
    return fmt::format("column {} regex_matches \"{}\"", column.name, search_expression->pattern());
 }
 
+std::optional<std::string> StringSearch::cacheKey() const {
+   return fmt::format(
+      "StringSearch({},{})",
+      cacheKeyString(column.name),
+      cacheKeyString(search_expression->pattern())
+   );
+}
+
 std::vector<schema::ColumnIdentifier> StringSearch::freeIUs() const {
    return {column};
 }
 
 namespace {
-template <typename GenericStringColumn>
+
+using storage::column::RowId;
+
+/// The longest prefix that is computed for pruning, the German strings of a `StringColumn` store
+/// at most this many bytes in place
+constexpr int MAX_REQUIRED_PREFIX_LENGTH = RhyDBString::SHORT_STRING_SIZE;
+
+/// A prefix that every value matched by `search_expression` starts with, or the empty string if
+/// there is none or it cannot be determined. `PossibleMatchRange` bounds the matches that start at
+/// the beginning of the value, so it is only used if the leading `^` of the pattern anchors every
+/// match there, i.e. if the pattern does not contain an alternation.
+std::string requiredPrefix(const RE2& search_expression) {
+   const std::string& pattern = search_expression.pattern();
+   if (!pattern.starts_with('^') || pattern.find('|') != std::string::npos) {
+      return {};
+   }
+   std::string min;
+   std::string max;
+   if (!search_expression.PossibleMatchRange(&min, &max, MAX_REQUIRED_PREFIX_LENGTH)) {
+      return {};
+   }
+   // All strings between `min` and `max` start with their common prefix
+   const auto common_prefix_end = std::ranges::mismatch(min, max).in1;
+   return {min.begin(), common_prefix_end};
+}
+
+/// Whether `value` may start with `prefix`, as far as its length and the bytes stored in place
+/// tell
+bool mayStartWith(const RhyDBString& value, std::string_view prefix) {
+   if (value.length() < prefix.size()) {
+      return false;
+   }
+   const std::string_view stored = value.isInPlace() ? value.getShortString() : value.prefix();
+   const size_t compared_length = std::min(stored.size(), prefix.size());
+   return stored.substr(0, compared_length) == prefix.substr(0, compared_length);
+}
+
+/// Runs the regex once per distinct value of the dictionary and unions the rows of the matching
+/// values
 std::unique_ptr<filter::operators::Operator> createMatchingBitmap(
-   const GenericStringColumn& string_column,
+   const storage::column::DictionaryEncodedColumn& string_column,
    const RE2& search_expression,
    storage::column::RowLayout row_layout
 ) {
-   auto producer = [&string_column, &search_expression, row_layout]() {
-      roaring::Roaring result_bitmap;
-      for (const auto row_id : row_layout) {
-         const std::string full_string = string_column.getValueString(row_id);
-         if (re2::RE2::PartialMatch(full_string, search_expression)) {
-            result_bitmap.add(row_id.toGlobal());
+   auto producer = [&string_column, &search_expression]() {
+      EVOBENCH_SCOPE("StringSearch", "matchDictionary");
+      std::vector<const roaring::Roaring*> matching_bitmaps;
+      for (const auto& [value_id, rows] : string_column.getIndexedValues()) {
+         if (!rows.isEmpty() &&
+             re2::RE2::PartialMatch(string_column.lookupValue(value_id), search_expression)) {
+            matching_bitmaps.push_back(&rows);
          }
       }
+      roaring::Roaring result_bitmap =
+         roaring::Roaring::fastunion(matching_bitmaps.size(), matching_bitmaps.data());
+      // Null rows are not part of any indexed bitmap, their value is the empty string
+      if (re2::RE2::PartialMatch("", search_expression)) {
+         result_bitmap |= string_column.null_bitmap;
+      }
       return CopyOnWriteBitmap(std::move(result_bitmap));
    };
    return std::make_unique<filter::operators::BitmapProducer>(
@@ -49,6 +112,53 @@ std::unique_ptr<filter::operators::Operator> createMatchingBitmap(
    );
 }
 
+/// Scans the values chunk by chunk, concurrently for large tables. Values that are stored in place
+/// are matched without copying them, values whose stored prefix rules out a match are skipped
+/// without looking up their suffix.
+std::unique_ptr<filter::operators::Operator> createMatchingBitmap(
+   const storage::column::StringColumn& string_column,
+   const RE2& search_expression,
+   storage::column::RowLayout row_layout
+) {
+   auto producer = [&string_column,
+                    &search_expression,
+                    row_layout,
+                    required_prefix = requiredPrefix(search_expression)]() {
+      EVOBENCH_SCOPE("StringSearch", "scanChunks");
+      return filter::operators::evaluateByChunkRanges(
+         row_layout,
+         row_layout.numRows(),
+         [&](size_t first_chunk, size_t end_chunk) {
+            roaring::Roaring result_bitmap;
+            for (size_t chunk_idx = first_chunk; chunk_idx < end_chunk; ++chunk_idx) {
+               const auto chunk_id = static_cast<uint16_t>(chunk_idx);
+               const uint32_t chunk_size = row_layout.chunkSize(chunk_id);
+               for (uint32_t row_in_chunk = 0; row_in_chunk < chunk_size; ++row_in_chunk) {
+                  const RowId row_id(chunk_id, static_cast<uint16_t>(row_in_chunk));
+                  const auto value = string_column.getValue(row_id);
+                  if (!mayStartWith(value, required_prefix)) {
+                     continue;
+                  }
+                  const bool matches =
+                     value.isInPlace()
+                        ? re2::RE2::PartialMatch(value.getShortString(), search_expression)
+                        : re2::RE2::PartialMatch(
+                             string_column.getValueString(row_id), search_expression
+                          );
+                  if (matches) {
+                     result_bitmap.add(row_id.toGlobal());
+                  }
+               }
+            }
+            return CopyOnWriteBitmap(std::move(result_bitmap));
+         }
+      );
+   };
+   return std::make_unique<filter::operators::BitmapProducer>(
+      std::move(producer), std::move(row_layout)
+   );
+}
+
 }  // namespace
 
 std::unique_ptr<ScalarExpression> StringSearch::rewrite(
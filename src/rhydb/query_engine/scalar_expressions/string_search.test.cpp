@@ -33,7 +33,8 @@ const std::vector<nlohmann::json> DATA = {
    createDataEntry("id4", "ABA"),
    createDataEntry("id5", "AA"),
    createDataEntry("id6", "something else"),
-   createDataEntry("id7", nullptr)
+   createDataEntry("id7", nullptr),
+   createDataEntry("id8", "a value longer than twelve bytes")
 };
 
 const auto DATABASE_CONFIG = fmt::format(
@@ -111,6 +112,30 @@ const QueryTestScenario FILTER_FOR_SOMETHING_THAT_DOES_NOT_OCCUR_ON_INDEXED_COLU
    .expected_query_result = createExpectedResult({})
 };
 
+const QueryTestScenario FILTER_FOR_LONG_VALUE_AT_THE_BEGINNING = {
+   .name = "FILTER_FOR_LONG_VALUE_AT_THE_BEGINNING",
+   .query = "default.filter(test_column.like('^a value longer.*bytes$')).project(primaryKey)",
+   .expected_query_result = createExpectedResult({"id8"})
+};
+
+const QueryTestScenario FILTER_FOR_PREFIX_OF_SHORT_AND_LONG_VALUES = {
+   .name = "FILTER_FOR_PREFIX_OF_SHORT_AND_LONG_VALUES",
+   .query = "default.filter(test_column.like('^(?i)[as]')).project(primaryKey)",
+   .expected_query_result = createExpectedResult({"id1", "id3", "id4", "id5", "id6", "id8"})
+};
+
+const QueryTestScenario FILTER_FOR_ALTERNATIVES_AT_THE_BEGINNING = {
+   .name = "FILTER_FOR_ALTERNATIVES_AT_THE_BEGINNING",
+   .query = "default.filter(test_column.like('^BA|twelve')).project(primaryKey)",
+   .expected_query_result = createExpectedResult({"id2", "id8"})
+};
+
+const QueryTestScenario FILTER_FOR_LONG_VALUE_ON_INDEXED_COLUMN = {
+   .name = "FILTER_FOR_LONG_VALUE_ON_INDEXED_COLUMN",
+   .query = "default.filter(indexed_test_column.like('twelve b')).project(primaryKey)",
+   .expected_query_result = createExpectedResult({"id8"})
+};
+
 const QueryTestScenario INVALID_REGULAR_EXPRESSION = {
    .name = "INVALID_REGULAR_EXPRESSION",
    .query = "default.filter(test_column.like('^(')).project(primaryKey)",
@@ -143,6 +168,10 @@ QUERY_TEST(
       FILTER_FOR_AA_ON_INDEXED_COLUMN,
       FILTER_FOR_AA_AT_THE_BEGINNING_ON_INDEXED_COLUMN,
       FILTER_FOR_SOMETHING_THAT_DOES_NOT_OCCUR_ON_INDEXED_COLUMN,
+      FILTER_FOR_LONG_VALUE_AT_THE_BEGINNING,
+      FILTER_FOR_PREFIX_OF_SHORT_AND_LONG_VALUES,
+      FILTER_FOR_ALTERNATIVES_AT_THE_BEGINNING,
+      FILTER_FOR_LONG_VALUE_ON_INDEXED_COLUMN,
       INVALID_REGULAR_EXPRESSION,
       FILTER_FOR_COLUMN_THAT_DOES_NOT_EXIST,
       TABLE_NOT_FOUND
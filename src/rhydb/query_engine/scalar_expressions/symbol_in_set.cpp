@@ -1,6 +1,9 @@
 #include "rhydb/query_engine/scalar_expressions/symbol_in_set.h"
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -50,6 +53,20 @@ std::string SymbolInSet<SymbolType>::toString() const {
    );
 }
 
+template <typename SymbolType>
+std::optional<std::string> SymbolInSet<SymbolType>::cacheKey() const {
+   std::string symbols_string;
+   std::ranges::transform(symbols, std::back_inserter(symbols_string), SymbolType::symbolToChar);
+   std::ranges::sort(symbols_string);
+   return fmt::format(
+      "{}({},{},{})",
+      kindToString(KIND),
+      cacheKeyString(column.name),
+      position_idx,
+      symbols_string
+   );
+}
+
 template <typename SymbolType>
 std::vector<schema::ColumnIdentifier> SymbolInSet<SymbolType>::freeIUs() const {
    return {column};
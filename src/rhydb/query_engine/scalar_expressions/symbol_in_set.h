@@ -55,6 +55,7 @@ class SymbolInSet : public ScalarExpression {
    }
 
    [[nodiscard]] std::string toString() const override;
+   [[nodiscard]] std::optional<std::string> cacheKey() const override;
    static constexpr Kind KIND = std::is_same_v<SymbolType, Nucleotide>
                                    ? Kind::SYMBOL_IN_SET_NUCLEOTIDE
                                    : Kind::SYMBOL_IN_SET_AMINO_ACID;
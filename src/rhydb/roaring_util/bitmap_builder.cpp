@@ -1,7 +1,31 @@
 #include "rhydb/roaring_util/bitmap_builder.h"
 
+#include <stdexcept>
+
 namespace rhydb::roaring_util {
 
+void appendContainer(
+   roaring::Roaring& bitmap,
+   uint16_t key,
+   roaring::internal::container_t* container,
+   uint8_t typecode
+) {
+   const int cardinality = roaring::internal::container_get_cardinality(container, typecode);
+   if (cardinality == 0) {
+      roaring::internal::container_free(container, typecode);
+      return;
+   }
+   if (typecode == BITSET_CONTAINER_TYPE && cardinality <= roaring::internal::DEFAULT_MAX_SIZE) {
+      auto* array = roaring::internal::array_container_from_bitset(
+         static_cast<const roaring::internal::bitset_container_t*>(container)
+      );
+      roaring::internal::container_free(container, typecode);
+      container = array;
+      typecode = ARRAY_CONTAINER_TYPE;
+   }
+   roaring::internal::ra_append(&bitmap.roaring.high_low_container, key, container, typecode);
+}
+
 void BitmapBuilderByContainer::addContainer(
    uint16_t v_index,
    const roaring::internal::container_t* container,
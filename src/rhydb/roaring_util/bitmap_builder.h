@@ -1,9 +1,21 @@
 #pragma once
 
+#include <cstdint>
+
 #include <roaring/roaring.hh>
 
 namespace rhydb::roaring_util {
 
+/// Appends `container` as the container of `key` to `bitmap`, whose keys must all be smaller, and
+/// takes ownership of it. An empty container is freed instead, and a bitset container of at most
+/// `DEFAULT_MAX_SIZE` values is converted to an array container first, as roaring expects.
+void appendContainer(
+   roaring::Roaring& bitmap,
+   uint16_t key,
+   roaring::internal::container_t* container,
+   uint8_t typecode
+);
+
 class BitmapBuilderByContainer {
    roaring::Roaring result_bitmap;
    uint16_t current_v_tile_index = 0;
@@ -0,0 +1,196 @@
+#include "rhydb/roaring_util/container_arena.h"
+
+#include <cstring>
+#include <new>
+
+#include "rhydb/common/panic.h"
+#include "rhydb/persistence/exception.h"
+
+namespace rhydb::roaring_util {
+
+namespace {
+
+// Bitset payloads are aligned like the ones roaring allocates itself, so that its vectorized
+// bitset kernels see the same alignment for arena-backed and heap-allocated containers.
+constexpr size_t BITSET_PAYLOAD_ALIGNMENT = 64;
+constexpr size_t OTHER_PAYLOAD_ALIGNMENT = 8;
+
+constexpr size_t alignUp(size_t offset, size_t alignment) {
+   return (offset + alignment - 1) / alignment * alignment;
+}
+
+const void* sourcePayload(const RoaringContainerView& view) {
+   switch (view.getTypecode()) {
+      case BITSET_CONTAINER_TYPE:
+         return static_cast<const roaring::internal::bitset_container_t*>(view.rawContainer())
+            ->words;
+      case ARRAY_CONTAINER_TYPE:
+         return static_cast<const roaring::internal::array_container_t*>(view.rawContainer())
+            ->array;
+      case RUN_CONTAINER_TYPE:
+         return static_cast<const roaring::internal::run_container_t*>(view.rawContainer())->runs;
+      default:
+         SILO_PANIC("unsupported roaring container typecode {}", view.getTypecode());
+   }
+}
+
+}  // namespace
+
+void ContainerArena::PayloadDeleter::operator()(std::byte* payload) const {
+   ::operator delete[](payload, std::align_val_t{BITSET_PAYLOAD_ALIGNMENT});
+}
+
+ContainerArena ContainerArena::copyOf(std::span<const RoaringContainerView> containers) {
+   ContainerArena arena;
+   arena.typecodes.reserve(containers.size());
+   arena.cardinalities.reserve(containers.size());
+   std::vector<int32_t> run_counts;
+   for (const auto& container : containers) {
+      arena.typecodes.push_back(container.getTypecode());
+      arena.cardinalities.push_back(container.getCardinality());
+      if (container.getTypecode() == RUN_CONTAINER_TYPE) {
+         run_counts.push_back(
+            static_cast<const roaring::internal::run_container_t*>(container.rawContainer())
+               ->n_runs
+         );
+      }
+   }
+   arena.initializeHeaders(run_counts);
+   arena.allocatePayload(arena.layoutPayload(nullptr));
+   arena.layoutPayload(arena.payload.get());
+
+   for (size_t idx = 0; idx < containers.size(); ++idx) {
+      const size_t bytes = payloadSizeInBytes(arena.headers[idx], arena.typecodes[idx]);
+      if (bytes == 0) {
+         continue;
+      }
+      void* destination = nullptr;
+      switch (arena.typecodes[idx]) {
+         case BITSET_CONTAINER_TYPE:
+            destination = arena.headers[idx].bitset.words;
+            break;
+         case ARRAY_CONTAINER_TYPE:
+            destination = arena.headers[idx].array.array;
+            break;
+         case RUN_CONTAINER_TYPE:
+            destination = arena.headers[idx].run.runs;
+            break;
+         default:
+            SILO_UNREACHABLE();
+      }
+      std::memcpy(destination, sourcePayload(containers[idx]), bytes);
+   }
+   return arena;
+}
+
+size_t ContainerArena::sizeInBytes() const {
+   return headers.size() * sizeof(Header) + cardinalities.size() * sizeof(uint32_t) +
+          typecodes.size() * sizeof(uint8_t) + payload_size;
+}
+
+const roaring::internal::container_t* ContainerArena::rawContainerAt(size_t idx) const {
+   const Header& header = headers[idx];
+   switch (typecodes[idx]) {
+      case BITSET_CONTAINER_TYPE:
+         return &header.bitset;
+      case ARRAY_CONTAINER_TYPE:
+         return &header.array;
+      case RUN_CONTAINER_TYPE:
+         return &header.run;
+      default:
+         SILO_UNREACHABLE();
+   }
+}
+
+size_t ContainerArena::payloadSizeInBytes(const Header& header, uint8_t typecode) {
+   switch (typecode) {
+      case BITSET_CONTAINER_TYPE:
+         return roaring::internal::BITSET_CONTAINER_SIZE_IN_WORDS * sizeof(uint64_t);
+      case ARRAY_CONTAINER_TYPE:
+         return static_cast<size_t>(header.array.cardinality) * sizeof(uint16_t);
+      case RUN_CONTAINER_TYPE:
+         return static_cast<size_t>(header.run.n_runs) * sizeof(roaring::internal::rle16_t);
+      default:
+         SILO_PANIC("unsupported roaring container typecode {}", typecode);
+   }
+}
+
+size_t ContainerArena::layoutPayload(std::byte* base) {
+   size_t offset = 0;
+   for (size_t idx = 0; idx < headers.size(); ++idx) {
+      Header& header = headers[idx];
+      const uint8_t typecode = typecodes[idx];
+      offset = alignUp(
+         offset,
+         typecode == BITSET_CONTAINER_TYPE ? BITSET_PAYLOAD_ALIGNMENT : OTHER_PAYLOAD_ALIGNMENT
+      );
+      if (base != nullptr) {
+         std::byte* slice = base + offset;
+         switch (typecode) {
+            case BITSET_CONTAINER_TYPE:
+               header.bitset.words = reinterpret_cast<uint64_t*>(slice);
+               break;
+            case ARRAY_CONTAINER_TYPE:
+               header.array.array = reinterpret_cast<uint16_t*>(slice);
+               break;
+            case RUN_CONTAINER_TYPE:
+               header.run.runs = reinterpret_cast<roaring::internal::rle16_t*>(slice);
+               break;
+            default:
+               SILO_UNREACHABLE();
+         }
+      }
+      offset += payloadSizeInBytes(header, typecode);
+   }
+   return offset;
+}
+
+void ContainerArena::allocatePayload(size_t size) {
+   payload.reset();
+   payload_size = size;
+   if (size == 0) {
+      return;
+   }
+   payload.reset(
+      static_cast<std::byte*>(::operator new[](size, std::align_val_t{BITSET_PAYLOAD_ALIGNMENT}))
+   );
+}
+
+void ContainerArena::initializeHeaders(const std::vector<int32_t>& run_counts) {
+   if (cardinalities.size() != typecodes.size()) {
+      throw persistence::LoadDatabaseException(
+         "container arena has mismatching typecodes and cardinalities"
+      );
+   }
+   headers.assign(typecodes.size(), Header{});
+   size_t run_idx = 0;
+   for (size_t idx = 0; idx < typecodes.size(); ++idx) {
+      const auto cardinality = static_cast<int32_t>(cardinalities[idx]);
+      switch (typecodes[idx]) {
+         case BITSET_CONTAINER_TYPE:
+            headers[idx].bitset.cardinality = cardinality;
+            headers[idx].bitset.words = nullptr;
+            break;
+         case ARRAY_CONTAINER_TYPE:
+            headers[idx].array.cardinality = cardinality;
+            headers[idx].array.capacity = cardinality;
+            headers[idx].array.array = nullptr;
+            break;
+         case RUN_CONTAINER_TYPE:
+            if (run_idx >= run_counts.size()) {
+               throw persistence::LoadDatabaseException(
+                  "container arena is missing the size of a run container"
+               );
+            }
+            headers[idx].run.n_runs = run_counts[run_idx];
+            headers[idx].run.capacity = run_counts[run_idx];
+            headers[idx].run.runs = nullptr;
+            ++run_idx;
+            break;
+         default:
+            throw persistence::LoadDatabaseException("unknown roaring container typecode");
+      }
+   }
+}
+
+}  // namespace rhydb::roaring_util
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/binary_object.hpp>
+#include <boost/serialization/split_member.hpp>
+#include <boost/serialization/vector.hpp>
+#include <roaring/roaring.hh>
+
+#include "rhydb/persistence/exception.h"
+#include "rhydb/roaring_util/roaring_container.h"
+
+namespace rhydb::roaring_util {
+
+/// Frozen, read-only storage for an indexed sequence of roaring containers. The container headers
+/// (the roaring structs holding a container's size and data pointer) are kept in one contiguous
+/// array and all payloads -- bitset words, array values and runs -- in a single aligned arena
+/// allocation. Walking the containers in index order is therefore a linear sweep over two buffers
+/// instead of a pointer chase over one heap allocation per container.
+///
+/// Containers are only handed out as `RoaringContainerView`s. They must never be passed to a
+/// roaring API that mutates or frees its argument, because their memory belongs to the arena.
+class ContainerArena {
+   union Header {
+      roaring::internal::bitset_container_t bitset;
+      roaring::internal::array_container_t array;
+      roaring::internal::run_container_t run;
+   };
+
+   struct PayloadDeleter {
+      void operator()(std::byte* payload) const;
+   };
+
+   std::vector<Header> headers;
+   std::vector<uint32_t> cardinalities;
+   std::vector<uint8_t> typecodes;
+   std::unique_ptr<std::byte[], PayloadDeleter> payload;
+   size_t payload_size = 0;
+
+  public:
+   ContainerArena() = default;
+
+   // Moving transfers the heap buffers, so the headers keep pointing into the moved-to arena.
+   ContainerArena(ContainerArena&& other) noexcept = default;
+   ContainerArena& operator=(ContainerArena&& other) noexcept = default;
+   // Copying is forbidden because copied headers would still point into the source's payload.
+   ContainerArena(const ContainerArena&) = delete;
+   ContainerArena& operator=(const ContainerArena&) = delete;
+
+   ~ContainerArena() = default;
+
+   /// Deep-copies `containers` into a new arena, preserving their order and container types.
+   static ContainerArena copyOf(std::span<const RoaringContainerView> containers);
+
+   [[nodiscard]] size_t size() const { return headers.size(); }
+
+   [[nodiscard]] bool empty() const { return headers.empty(); }
+
+   /// Non-owning view of the container at `idx`. It stays valid as long as the arena is alive,
+   /// also across moves of the arena.
+   [[nodiscard]] RoaringContainerView at(size_t idx) const {
+      return RoaringContainerView{rawContainerAt(idx), cardinalities[idx], typecodes[idx]};
+   }
+
+   /// Memory held by the arena: headers, per-container metadata and payload.
+   [[nodiscard]] size_t sizeInBytes() const;
+
+  private:
+   [[nodiscard]] const roaring::internal::container_t* rawContainerAt(size_t idx) const;
+
+   [[nodiscard]] static size_t payloadSizeInBytes(const Header& header, uint8_t typecode);
+
+   /// Assigns every container its aligned slice of the payload in index order and returns the
+   /// total payload size. With `base == nullptr` only the size is computed; otherwise the data
+   /// pointers of all headers are set to point into `base`.
+   size_t layoutPayload(std::byte* base);
+
+   void allocatePayload(size_t size);
+
+   friend class boost::serialization::access;
+
+   template <class Archive>
+   void save(Archive& archive, [[maybe_unused]] const uint32_t version) const {
+      // Run containers additionally need their number of runs to size their payload, everything
+      // else is derived from typecode and cardinality.
+      std::vector<int32_t> run_counts;
+      for (size_t idx = 0; idx < headers.size(); ++idx) {
+         if (typecodes[idx] == RUN_CONTAINER_TYPE) {
+            run_counts.push_back(headers[idx].run.n_runs);
+         }
+      }
+      // clang-format off
+      archive & typecodes;
+      archive & cardinalities;
+      archive & run_counts;
+      archive & payload_size;
+      // clang-format on
+      if (payload_size > 0) {
+         // clang-format off
+         archive & boost::serialization::make_binary_object(payload.get(), payload_size);
+         // clang-format on
+      }
+   }
+
+   template <class Archive>
+   void load(Archive& archive, [[maybe_unused]] const uint32_t version) {
+      std::vector<int32_t> run_counts;
+      size_t saved_payload_size = 0;
+      // clang-format off
+      archive & typecodes;
+      archive & cardinalities;
+      archive & run_counts;
+      archive & saved_payload_size;
+      // clang-format on
+      initializeHeaders(run_counts);
+      allocatePayload(layoutPayload(nullptr));
+      if (payload_size != saved_payload_size) {
+         throw persistence::LoadDatabaseException(
+            "container arena payload size does not match its headers"
+         );
+      }
+      layoutPayload(payload.get());
+      if (payload_size > 0) {
+         // clang-format off
+         archive & boost::serialization::make_binary_object(payload.get(), payload_size);
+         // clang-format on
+      }
+   }
+
+   /// Sizes `headers` after `typecodes` and fills in the cardinality (array, bitset) or the number
+   /// of runs (run) of each container. The data pointers are set later by `layoutPayload`.
+   void initializeHeaders(const std::vector<int32_t>& run_counts);
+
+   BOOST_SERIALIZATION_SPLIT_MEMBER()
+};
+
+}  // namespace rhydb::roaring_util
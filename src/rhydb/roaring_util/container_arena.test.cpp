@@ -0,0 +1,158 @@
+#include "rhydb/roaring_util/container_arena.h"
+
+#include <cstdint>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <roaring/roaring.hh>
+
+#include "rhydb/persistence/exception.h"
+#include "rhydb/roaring_util/bitmap_builder.h"
+#include "rhydb/roaring_util/roaring_container.h"
+
+using rhydb::roaring_util::BitmapBuilderByContainer;
+using rhydb::roaring_util::ContainerArena;
+using rhydb::roaring_util::RoaringContainer;
+using rhydb::roaring_util::RoaringContainerView;
+
+namespace {
+
+roaring::Roaring toRoaring(RoaringContainerView view) {
+   BitmapBuilderByContainer builder;
+   builder.addContainer(0, view.rawContainer(), view.getTypecode());
+   return std::move(builder).getBitmap();
+}
+
+// One container of each type: an array, a bitset (more than 4096 values) and a run container.
+std::vector<RoaringContainer> makeContainersOfEveryType() {
+   std::vector<RoaringContainer> containers;
+
+   auto array = RoaringContainer::withCapacity(3);
+   array.add(1);
+   array.add(42);
+   array.add(1000);
+   containers.push_back(std::move(array));
+
+   auto bitset = RoaringContainer::withCapacity(10000);
+   for (uint16_t value = 0; value < 20000; value += 2) {
+      bitset.add(value);
+   }
+   containers.push_back(std::move(bitset));
+
+   auto run = RoaringContainer::withCapacity(5000);
+   for (uint16_t value = 100; value < 5100; ++value) {
+      run.add(value);
+   }
+   run.runOptimizeAndShrink();
+   containers.push_back(std::move(run));
+
+   return containers;
+}
+
+std::vector<RoaringContainerView> viewsOf(const std::vector<RoaringContainer>& containers) {
+   std::vector<RoaringContainerView> views;
+   for (const auto& container : containers) {
+      views.emplace_back(container);
+   }
+   return views;
+}
+
+void expectSameContainers(
+   const ContainerArena& arena,
+   const std::vector<RoaringContainer>& expected
+) {
+   ASSERT_EQ(arena.size(), expected.size());
+   for (size_t idx = 0; idx < expected.size(); ++idx) {
+      const RoaringContainerView view = arena.at(idx);
+      EXPECT_EQ(view.getTypecode(), expected[idx].getTypecode());
+      EXPECT_EQ(view.getCardinality(), expected[idx].getCardinality());
+      EXPECT_EQ(toRoaring(view), toRoaring(RoaringContainerView{expected[idx]}));
+   }
+}
+
+}  // namespace
+
+TEST(ContainerArena, emptyArena) {
+   const ContainerArena arena = ContainerArena::copyOf({});
+   EXPECT_TRUE(arena.empty());
+   EXPECT_EQ(arena.size(), 0);
+   EXPECT_EQ(arena.sizeInBytes(), 0);
+}
+
+TEST(ContainerArena, copiesContainersOfEveryType) {
+   const auto containers = makeContainersOfEveryType();
+   ASSERT_EQ(containers[0].getTypecode(), ARRAY_CONTAINER_TYPE);
+   ASSERT_EQ(containers[1].getTypecode(), BITSET_CONTAINER_TYPE);
+   ASSERT_EQ(containers[2].getTypecode(), RUN_CONTAINER_TYPE);
+
+   const auto views = viewsOf(containers);
+   const ContainerArena arena = ContainerArena::copyOf(views);
+
+   expectSameContainers(arena, containers);
+}
+
+TEST(ContainerArena, viewsStayValidAfterMove) {
+   const auto containers = makeContainersOfEveryType();
+   const auto views = viewsOf(containers);
+   ContainerArena arena = ContainerArena::copyOf(views);
+   const RoaringContainerView view_before_move = arena.at(1);
+
+   const ContainerArena moved_to = std::move(arena);
+
+   EXPECT_EQ(toRoaring(view_before_move), toRoaring(RoaringContainerView{containers[1]}));
+   expectSameContainers(moved_to, containers);
+}
+
+TEST(ContainerArena, viewsCanBeUsedWithContainerAlgebra) {
+   const auto containers = makeContainersOfEveryType();
+   const auto views = viewsOf(containers);
+   const ContainerArena arena = ContainerArena::copyOf(views);
+
+   const RoaringContainer intersection = arena.at(0) & arena.at(2);
+   EXPECT_EQ(toRoaring(RoaringContainerView{intersection}), (roaring::Roaring{1000}));
+
+   const RoaringContainer owning = arena.at(1).toOwning();
+   EXPECT_EQ(owning.getCardinality(), 10000);
+}
+
+TEST(ContainerArena, serializationRoundTrip) {
+   const auto containers = makeContainersOfEveryType();
+   const auto views = viewsOf(containers);
+   const ContainerArena arena = ContainerArena::copyOf(views);
+
+   std::stringstream stream;
+   {
+      boost::archive::binary_oarchive output_archive(stream);
+      output_archive << arena;
+   }
+
+   ContainerArena restored;
+   {
+      boost::archive::binary_iarchive input_archive(stream);
+      input_archive >> restored;
+   }
+
+   expectSameContainers(restored, containers);
+   EXPECT_EQ(restored.sizeInBytes(), arena.sizeInBytes());
+}
+
+TEST(ContainerArena, inconsistentSavedHeadersAreRejectedAsLoadErrors) {
+   // An archive with a run container but no run count, as a corrupted file could contain it
+   const std::vector<uint8_t> typecodes{RUN_CONTAINER_TYPE};
+   const std::vector<uint32_t> cardinalities{10};
+   const std::vector<int32_t> run_counts;
+   const size_t payload_size = 0;
+   std::stringstream stream;
+   {
+      boost::archive::binary_oarchive output_archive(stream);
+      output_archive << typecodes << cardinalities << run_counts << payload_size;
+   }
+
+   ContainerArena restored;
+   boost::archive::binary_iarchive input_archive(stream);
+   EXPECT_THROW(input_archive >> restored, rhydb::persistence::LoadDatabaseException);
+}
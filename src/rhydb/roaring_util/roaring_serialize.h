@@ -1,7 +1,11 @@
 #pragma once
 
+#include <optional>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
+#include <fmt/format.h>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/iostreams/copy.hpp>
 #include <boost/serialization/binary_object.hpp>
@@ -10,6 +14,12 @@
 #include <boost/serialization/vector.hpp>
 #include <roaring/roaring.hh>
 
+#include "rhydb/persistence/aligned_block.h"
+#include "rhydb/persistence/exception.h"
+
+// Bitmaps are stored in roaring's frozen format as an aligned block (see `saveAlignedBlock`). When
+// a column file is memory-mapped, a loaded bitmap is a read-only frozen view into the mapping
+// instead of a copy; the owning `storage::Table` keeps the mapping alive.
 // no linting because needed by external library
 // NOLINTBEGIN
 BOOST_SERIALIZATION_SPLIT_FREE(::roaring::Roaring)
@@ -20,13 +30,9 @@ template <class Archive>
    const roaring::Roaring& bitmask,
    [[maybe_unused]] const uint32_t version
 ) {
-   std::size_t expected_size_in_bytes = bitmask.getSizeInBytes();
-   std::vector<char> buffer(expected_size_in_bytes);
-   std::size_t size_in_bytes = bitmask.write(buffer.data());
-   // clang-format off
-   ar & size_in_bytes;
-   ar & boost::serialization::make_binary_object(buffer.data(), size_in_bytes);
-   // clang-format on
+   std::vector<char> buffer(bitmask.getFrozenSizeInBytes());
+   bitmask.writeFrozen(buffer.data());
+   rhydb::persistence::saveAlignedBlock(ar, buffer);
 }
 
 template <class Archive>
@@ -35,13 +41,24 @@ template <class Archive>
    roaring::Roaring& bitmask,
    [[maybe_unused]] const uint32_t version
 ) {
-   std::size_t size_in_bytes = 0;
-   // clang-format off
-   ar & size_in_bytes;
-   std::vector<char> buffer(size_in_bytes);
-   ar & boost::serialization::make_binary_object(buffer.data(), size_in_bytes);
-   // clang-format on
-   bitmask = roaring::Roaring::readSafe(buffer.data(), size_in_bytes);
+   const auto block = rhydb::persistence::loadAlignedBlock(ar);
+   // frozenView only checks that the container layout fits the block, not the container contents.
+   // Copied loads verify the file checksum before deserializing, mapped loads rely on this check.
+   std::optional<roaring::Roaring> view;
+   try {
+      view.emplace(roaring::Roaring::frozenView(block.bytes().data(), block.bytes().size()));
+   } catch (const std::runtime_error&) {
+      throw rhydb::persistence::LoadDatabaseException(
+         fmt::format("Invalid frozen roaring bitmap of {} bytes", block.bytes().size())
+      );
+   }
+   if (block.isBorrowed()) {
+      bitmask = std::move(*view);
+   } else {
+      // The view points into the block, which is freed afterwards, so its containers are copied
+      const roaring::Roaring& borrowed_view = *view;
+      bitmask = roaring::Roaring{borrowed_view};
+   }
 }
 }  // namespace boost::serialization
 // NOLINTEND
@@ -1,10 +1,22 @@
 #pragma once
 
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
 #include <vector>
 
 #include <boost/serialization/access.hpp>
+#include <boost/serialization/split_member.hpp>
 #include <boost/serialization/vector.hpp>
 
+#include "rhydb/common/panic.h"
+#include "rhydb/persistence/aligned_block.h"
+#include "rhydb/persistence/exception.h"
+#include "rhydb/persistence/segment_store.h"
 #include "rhydb/storage/column/row_id.h"
 
 namespace rhydb::storage::column {
@@ -13,44 +25,200 @@ namespace rhydb::storage::column {
 /// buffer per appended chunk. Appending never touches previously ingested chunks. A row id is
 /// mapped to its value by splitting it into a chunk id and a within-chunk index (see `RowId`), so
 /// no offset index is needed: chunk `k` is reached in O(1) and indexed directly.
+///
+/// When a column file is loaded memory-mapped, chunks of trivially copyable values are views into
+/// the mapping instead of owned buffers (see `loadAlignedBlock`). Such a chunk is copied into an
+/// owned buffer the first time one of its values is overwritten.
+///
+/// Tables save the chunks into segment files (see `persistence::SegmentStore`). Every chunk
+/// remembers the segment it was loaded from until it is modified, so that saving it again reuses
+/// the segment and only new or modified chunks are written.
 template <typename T>
 class ChunkedValueBuffer {
-   std::vector<std::vector<T>> chunks;
+   using OwnedChunk = std::vector<T>;
+   using MappedChunk = std::span<const T>;
+
+   struct StoredChunk {
+      std::variant<OwnedChunk, MappedChunk> values;
+      std::optional<persistence::ChunkOrigin> origin;
+   };
+
+   std::vector<StoredChunk> chunks;
 
   public:
-   void appendChunk(std::vector<T>&& values) { chunks.push_back(std::move(values)); }
+   void appendChunk(std::vector<T>&& values) {
+      chunks.push_back(StoredChunk{.values = std::move(values), .origin = std::nullopt});
+   }
 
    [[nodiscard]] size_t numChunks() const { return chunks.size(); }
 
    [[nodiscard]] uint32_t chunkSize(uint16_t chunk_id) const {
-      return static_cast<uint32_t>(chunks.at(chunk_id).size());
+      return static_cast<uint32_t>(chunk(chunk_id).size());
    }
 
-   /// The raw value buffer of chunk `chunk_idx`. Exposed so a sorted column can be binary searched
-   /// in place (see `DateBetween`).
-   [[nodiscard]] const std::vector<T>& chunk(size_t chunk_idx) const {
-      return chunks.at(chunk_idx);
+   /// The raw values of chunk `chunk_idx`. Exposed so a sorted column can be binary searched in
+   /// place (see `DateBetween`).
+   [[nodiscard]] std::span<const T> chunk(size_t chunk_idx) const {
+      return std::visit(
+         [](const auto& values) { return std::span<const T>{values}; },
+         chunks.at(chunk_idx).values
+      );
    }
 
    [[nodiscard]] const T& at(RowId row_id) const {
-      return chunks.at(row_id.chunk_id).at(row_id.row_in_chunk);
+      const auto values = chunk(row_id.chunk_id);
+      SILO_ASSERT_LT(row_id.row_in_chunk, values.size());
+      return values[row_id.row_in_chunk];
    }
 
    /// Overwrites the value at `row_id` in place. Used by `update` to assign a new scalar value to
    /// an already ingested row; null handling lives in the owning column's bitmaps.
    void setValue(RowId row_id, T value) {
-      chunks.at(row_id.chunk_id).at(row_id.row_in_chunk) = value;
+      ownedChunk(row_id.chunk_id).at(row_id.row_in_chunk) = value;
+   }
+
+   /// Replaces all values of chunk `chunk_idx`, for columns whose values of a chunk depend on each
+   /// other and cannot be overwritten one at a time (see `ZstdCompressedStringColumn::update`)
+   void replaceChunk(size_t chunk_idx, std::vector<T>&& values) {
+      ownedChunk(chunk_idx) = std::move(values);
    }
 
    /// The most recently appended value (the last value of the last chunk).
-   [[nodiscard]] const T& lastValue() const { return chunks.back().back(); }
+   [[nodiscard]] const T& lastValue() const { return chunk(chunks.size() - 1).back(); }
 
   private:
+   /// The chunk's owned values, for modification. The chunk no longer matches its segment.
+   OwnedChunk& ownedChunk(size_t chunk_idx) {
+      auto& stored_chunk = chunks.at(chunk_idx);
+      stored_chunk.origin = std::nullopt;
+      if (const auto* mapped = std::get_if<MappedChunk>(&stored_chunk.values)) {
+         stored_chunk.values = OwnedChunk(mapped->begin(), mapped->end());
+      }
+      return std::get<OwnedChunk>(stored_chunk.values);
+   }
+
+   template <class Archive>
+   void saveChunkValues(Archive& archive, size_t chunk_idx) const {
+      if constexpr (std::is_trivially_copyable_v<T>) {
+         const auto values = chunk(chunk_idx);
+         persistence::saveAlignedBlock(
+            archive, {reinterpret_cast<const char*>(values.data()), values.size_bytes()}
+         );
+      } else {
+         // Only trivially copyable values are ever mapped
+         // clang-format off
+         archive & std::get<OwnedChunk>(chunks.at(chunk_idx).values);
+         // clang-format on
+      }
+   }
+
+   template <class Archive>
+   static StoredChunk loadChunkValues(Archive& archive) {
+      if constexpr (std::is_trivially_copyable_v<T>) {
+         const auto block = persistence::loadAlignedBlock(archive);
+         const std::span<const T> values{
+            reinterpret_cast<const T*>(block.bytes().data()), block.bytes().size() / sizeof(T)
+         };
+         if (block.isBorrowed()) {
+            return StoredChunk{.values = values, .origin = std::nullopt};
+         }
+         return StoredChunk{
+            .values = OwnedChunk(values.begin(), values.end()), .origin = std::nullopt
+         };
+      } else {
+         OwnedChunk values;
+         // clang-format off
+         archive & values;
+         // clang-format on
+         return StoredChunk{.values = std::move(values), .origin = std::nullopt};
+      }
+   }
+
+   /// Reuses the segments of all chunks with an origin and writes the others into one new segment.
+   std::vector<persistence::ChunkLocation> saveToSegments(persistence::SegmentStore& store) const {
+      return persistence::saveChunksToSegments(
+         store,
+         chunks.size(),
+         [&](size_t chunk_idx) { return chunks.at(chunk_idx).origin; },
+         [&](auto& segment_archive, size_t chunk_idx) {
+            saveChunkValues(segment_archive, chunk_idx);
+         }
+      );
+   }
+
+   void loadFromSegments(
+      persistence::SegmentStore& store,
+      const std::vector<persistence::ChunkLocation>& locations
+   ) {
+      chunks = persistence::loadChunksFromSegments<StoredChunk>(
+         store, locations, [](auto& segment_archive) { return loadChunkValues(segment_archive); }
+      );
+      for (size_t chunk_idx = 0; chunk_idx < chunks.size(); ++chunk_idx) {
+         chunks.at(chunk_idx).origin = persistence::ChunkOrigin{
+            .directory = store.getDirectory(), .location = locations.at(chunk_idx)
+         };
+      }
+   }
+
    friend class boost::serialization::access;
+
+   /// Chunks are stored as locations in segment files if a `SegmentStore` is active, otherwise
+   /// inline in the archive.
    template <class Archive>
-   void serialize(Archive& archive, const uint32_t /* version */) {
-      archive & chunks;
+   void save(Archive& archive, const uint32_t /* version */) const {
+      auto* store = persistence::SegmentStore::active();
+      bool in_segments = store != nullptr;
+      // clang-format off
+      archive & in_segments;
+      // clang-format on
+      if (in_segments) {
+         auto locations = saveToSegments(*store);
+         // clang-format off
+         archive & locations;
+         // clang-format on
+         return;
+      }
+      size_t num_chunks = chunks.size();
+      // clang-format off
+      archive & num_chunks;
+      // clang-format on
+      for (size_t chunk_idx = 0; chunk_idx < num_chunks; ++chunk_idx) {
+         saveChunkValues(archive, chunk_idx);
+      }
    }
+
+   template <class Archive>
+   void load(Archive& archive, const uint32_t /* version */) {
+      chunks.clear();
+      bool in_segments = false;
+      // clang-format off
+      archive & in_segments;
+      // clang-format on
+      if (in_segments) {
+         auto* store = persistence::SegmentStore::active();
+         if (store == nullptr) {
+            throw persistence::LoadDatabaseException(
+               "Chunks are stored in segment files, but no segment store is available"
+            );
+         }
+         std::vector<persistence::ChunkLocation> locations;
+         // clang-format off
+         archive & locations;
+         // clang-format on
+         loadFromSegments(*store, locations);
+         return;
+      }
+      size_t num_chunks = 0;
+      // clang-format off
+      archive & num_chunks;
+      // clang-format on
+      chunks.reserve(num_chunks);
+      for (size_t chunk_idx = 0; chunk_idx < num_chunks; ++chunk_idx) {
+         chunks.push_back(loadChunkValues(archive));
+      }
+   }
+
+   BOOST_SERIALIZATION_SPLIT_MEMBER()
 };
 
 }  // namespace rhydb::storage::column
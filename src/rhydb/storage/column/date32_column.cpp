@@ -16,22 +16,19 @@ bool Date32Column::isSorted() const {
 
 std::expected<void, std::string> Date32Column::appendChunk(const Buffer& buffer) {
    const uint32_t base = RowId::chunkStart(static_cast<uint16_t>(values.numChunks()));
-   std::vector<common::Date32> chunk;
-   chunk.reserve(buffer.size());
    for (size_t i = 0; i < buffer.size(); ++i) {
       if (buffer[i].has_value()) {
          if (last_appended_value.has_value() && *buffer[i] < *last_appended_value) {
             is_sorted = false;
          }
          last_appended_value = buffer[i];
-         chunk.push_back(*buffer[i]);
       } else {
          null_bitmap.add(base + static_cast<uint32_t>(i));
-         chunk.push_back(0);
          is_sorted = false;
       }
    }
-   values.appendChunk(std::move(chunk));
+   values.appendChunk(storedValuesOf(buffer));
+   zone_maps.push_back(ZoneMap<common::Date32>::of(buffer));
    return {};
 }
 
@@ -45,6 +42,7 @@ void Date32Column::update(const roaring::Roaring& row_ids, std::optional<common:
    for (const uint32_t global_row_id : row_ids) {
       values.setValue(RowId::fromGlobal(global_row_id), stored_value);
    }
+   updateZoneMaps(zone_maps, row_ids, value, null_bitmap);
 
    // An update can move a value in either direction, so the cheap incremental sortedness tracking
    // of `appendChunk` no longer applies; recompute it by scanning the whole column. As in
@@ -58,7 +56,7 @@ void Date32Column::update(const roaring::Roaring& row_ids, std::optional<common:
       return;
    }
    for (size_t chunk_id = 0; chunk_id < values.numChunks(); ++chunk_id) {
-      const std::vector<common::Date32>& chunk = values.chunk(chunk_id);
+      const auto chunk = values.chunk(chunk_id);
       for (common::Date32 date : chunk) {
          if (last_appended_value.has_value() && date < *last_appended_value) {
             is_sorted = false;
@@ -12,6 +12,7 @@
 #include "rhydb/schema/database_schema.h"
 #include "rhydb/storage/column/chunked_value_buffer.h"
 #include "rhydb/storage/column/column_metadata.h"
+#include "rhydb/storage/column/zone_map.h"
 
 namespace rhydb::storage::column {
 
@@ -33,6 +34,7 @@ class Date32Column {
 
   private:
    ChunkedValueBuffer<common::Date32> values;
+   std::vector<ZoneMap<common::Date32>> zone_maps;
    bool is_sorted = true;
    /// Transient ingestion state: the last non-null value appended, used to detect whether values
    /// stay sorted across chunk boundaries. Not serialized.
@@ -54,6 +56,10 @@ class Date32Column {
    /// The per-chunk value buffers. Used by `DateBetween` to binary search a sorted column.
    [[nodiscard]] const ChunkedValueBuffer<common::Date32>& getValueBuffer() const { return values; }
 
+   [[nodiscard]] const std::vector<ZoneMap<common::Date32>>& getZoneMaps() const {
+      return zone_maps;
+   }
+
    [[nodiscard]] size_t numChunks() const { return values.numChunks(); }
 
    [[nodiscard]] uint32_t chunkSize(uint16_t chunk_id) const { return values.chunkSize(chunk_id); }
@@ -69,6 +75,7 @@ class Date32Column {
       // clang-format off
       archive & null_bitmap;
       archive & values;
+      archive & zone_maps;
       archive & is_sorted;
       if constexpr (Archive::is_loading::value) {
          if (values.numChunks() > 0) {
@@ -57,8 +57,8 @@ std::optional<const roaring::Roaring*> DictionaryEncodedColumn::filter(
    return filter(value_id.value());
 }
 
-std::expected<void, std::string> DictionaryEncodedColumn::appendChunk(const Buffer& buffer) {
-   // Validate whole buffer before mutating anything
+std::expected<void, std::string> DictionaryEncodedColumn::validateChunk(const Buffer& buffer
+) const {
    if (lineage_index.has_value() && !metadata->treat_unknown_lineages_as_null) {
       for (const auto& maybe_value : buffer) {
          if (maybe_value.has_value() && !metadata->dictionary.getId(*maybe_value).has_value()) {
@@ -71,6 +71,14 @@ std::expected<void, std::string> DictionaryEncodedColumn::appendChunk(const Buff
          }
       }
    }
+   return {};
+}
+
+std::expected<void, std::string> DictionaryEncodedColumn::appendChunk(const Buffer& buffer) {
+   // Validate whole buffer before mutating anything
+   if (auto result = validateChunk(buffer); !result.has_value()) {
+      return result;
+   }
 
    // Build this chunk's value ids in isolation so that previously appended chunks are never
    // touched; the inverted index and lineage index are global and keep being updated by row id.
@@ -91,6 +91,10 @@ class DictionaryEncodedColumn {
       const std::optional<std::string>& value
    ) const;
 
+   /// Checks that `appendChunk` can append `buffer`: with a lineage index, every value must be a
+   /// known lineage unless unknown lineages are treated as null.
+   [[nodiscard]] std::expected<void, std::string> validateChunk(const Buffer& buffer) const;
+
    std::expected<void, std::string> appendChunk(const Buffer& buffer);
 
    void update(const roaring::Roaring& row_ids, const std::optional<std::string>& value);
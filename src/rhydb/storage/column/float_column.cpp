@@ -11,17 +11,13 @@ FloatColumn::FloatColumn(ColumnMetadata* metadata)
 
 std::expected<void, std::string> FloatColumn::appendChunk(const Buffer& buffer) {
    const uint32_t base = RowId::chunkStart(static_cast<uint16_t>(values.numChunks()));
-   std::vector<double> chunk;
-   chunk.reserve(buffer.size());
    for (size_t i = 0; i < buffer.size(); ++i) {
-      if (buffer[i].has_value()) {
-         chunk.push_back(*buffer[i]);
-      } else {
+      if (!buffer[i].has_value()) {
          null_bitmap.add(base + static_cast<uint32_t>(i));
-         chunk.push_back(0.0);
       }
    }
-   values.appendChunk(std::move(chunk));
+   values.appendChunk(storedValuesOf(buffer));
+   zone_maps.push_back(ZoneMap<double>::of(buffer));
    return {};
 }
 
@@ -35,6 +31,7 @@ void FloatColumn::update(const roaring::Roaring& row_ids, std::optional<double>
    for (const uint32_t global_row_id : row_ids) {
       values.setValue(RowId::fromGlobal(global_row_id), stored_value);
    }
+   updateZoneMaps(zone_maps, row_ids, value, null_bitmap);
 }
 
 }  // namespace rhydb::storage::column
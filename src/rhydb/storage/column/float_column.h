@@ -13,6 +13,7 @@
 #include "rhydb/storage/column/chunked_value_buffer.h"
 #include "rhydb/storage/column/column.h"
 #include "rhydb/storage/column/column_metadata.h"
+#include "rhydb/storage/column/zone_map.h"
 
 namespace rhydb::storage::column {
 
@@ -30,6 +31,7 @@ class FloatColumn {
 
   private:
    ChunkedValueBuffer<double> values;
+   std::vector<ZoneMap<double>> zone_maps;
 
   public:
    roaring::Roaring null_bitmap;
@@ -38,6 +40,10 @@ class FloatColumn {
 
    explicit FloatColumn(ColumnMetadata* metadata);
 
+   [[nodiscard]] const ChunkedValueBuffer<double>& getValueBuffer() const { return values; }
+
+   [[nodiscard]] const std::vector<ZoneMap<double>>& getZoneMaps() const { return zone_maps; }
+
    [[nodiscard]] size_t numChunks() const { return values.numChunks(); }
 
    [[nodiscard]] uint32_t chunkSize(uint16_t chunk_id) const { return values.chunkSize(chunk_id); }
@@ -60,6 +66,7 @@ class FloatColumn {
       // clang-format off
       archive & values;
       archive & null_bitmap;
+      archive & zone_maps;
       // clang-format on
    }
 };
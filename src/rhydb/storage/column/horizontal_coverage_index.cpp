@@ -3,6 +3,10 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
 
 #include <spdlog/spdlog.h>
 #include <roaring/roaring.hh>
@@ -11,6 +15,8 @@
 #include "rhydb/common/aligned_sequence.h"
 #include "rhydb/common/nucleotide_symbols.h"
 #include "rhydb/common/panic.h"
+#include "rhydb/persistence/exception.h"
+#include "rhydb/roaring_util/bitmap_builder.h"
 
 namespace rhydb::storage::column {
 
@@ -27,6 +33,7 @@ void HorizontalCoverageIndex::insertCoverage(RowId row_id, const Coverage& cover
    SILO_ASSERT_EQ(row_id.row_in_chunk, start_end.at(row_id.chunk_id).size());
 
    start_end.at(row_id.chunk_id).emplace_back(coverage.start, coverage.end);
+   forgetChunkOrigin(row_id.chunk_id);
 
    auto& [batch_start, batch_end] = batch_start_ends.back();
    batch_start = std::min(batch_start, coverage.start);
@@ -49,6 +56,219 @@ void HorizontalCoverageIndex::insertNullSequence(RowId row_id) {
    insertCoverage(row_id, Coverage{.start = 0, .end = 0, .missing_positions = {}});
 }
 
+ChunkCoverageOrder ChunkCoverageOrder::of(
+   const std::vector<std::pair<uint32_t, uint32_t>>& start_end
+) {
+   ChunkCoverageOrder order;
+   std::vector<uint16_t> rows(start_end.size());
+   std::iota(rows.begin(), rows.end(), uint16_t{0});
+
+   order.rows_by_start = rows;
+   std::ranges::stable_sort(order.rows_by_start, {}, [&](uint16_t row) {
+      return start_end[row].first;
+   });
+   order.sorted_starts.reserve(rows.size());
+   for (const uint16_t row : order.rows_by_start) {
+      order.sorted_starts.push_back(start_end[row].first);
+   }
+
+   order.rows_by_end = std::move(rows);
+   std::ranges::stable_sort(order.rows_by_end, {}, [&](uint16_t row) {
+      return start_end[row].second;
+   });
+   order.sorted_ends.reserve(order.rows_by_end.size());
+   for (const uint16_t row : order.rows_by_end) {
+      order.sorted_ends.push_back(start_end[row].second);
+   }
+   return order;
+}
+
+void HorizontalCoverageIndex::buildIndex() {
+   const size_t first_new_chunk = chunk_coverage_orders.size();
+   for (size_t chunk_id = first_new_chunk; chunk_id < start_end.size(); ++chunk_id) {
+      chunk_coverage_orders.push_back(ChunkCoverageOrder::of(start_end[chunk_id]));
+      forgetChunkOrigin(static_cast<uint16_t>(chunk_id));
+   }
+   // Rows are appended in ascending order, so the bitmaps are only appended to
+   const uint32_t first_new_row = RowId::chunkStart(static_cast<uint16_t>(first_new_chunk));
+   for (auto row = horizontal_bitmaps.lower_bound(first_new_row); row != horizontal_bitmaps.end();
+        ++row) {
+      const auto& [row_id, missing_positions] = *row;
+      if (missing_positions.isEmpty()) {
+         continue;
+      }
+      if (missing_positions.maximum() >= rows_missing_at_position.size()) {
+         rows_missing_at_position.resize(missing_positions.maximum() + 1);
+      }
+      for (const uint32_t position : missing_positions) {
+         rows_missing_at_position[position].add(row_id);
+      }
+   }
+   for (auto& rows : rows_missing_at_position) {
+      rows.runOptimize();
+      rows.shrinkToFit();
+   }
+}
+
+void HorizontalCoverageIndex::forgetChunkOrigin(uint16_t chunk_id) {
+   if (chunk_id < chunk_origins.size()) {
+      chunk_origins[chunk_id].reset();
+   }
+}
+
+std::pair<std::vector<uint32_t>, roaring_util::ContainerArena> HorizontalCoverageIndex::
+   rowsMissingInChunk(uint16_t chunk_id) const {
+   std::vector<uint32_t> positions;
+   std::vector<roaring_util::RoaringContainerView> containers;
+   for (size_t position = 0; position < rows_missing_at_position.size(); ++position) {
+      const auto& high_low_container =
+         rows_missing_at_position[position].roaring.high_low_container;
+      const std::span<const uint16_t> keys{
+         high_low_container.keys, static_cast<size_t>(high_low_container.size)
+      };
+      const auto key = std::ranges::lower_bound(keys, chunk_id);
+      if (key == keys.end() || *key != chunk_id) {
+         continue;
+      }
+      const auto idx = static_cast<size_t>(key - keys.begin());
+      const auto* container = high_low_container.containers[idx];
+      const uint8_t typecode = high_low_container.typecodes[idx];
+      positions.push_back(static_cast<uint32_t>(position));
+      containers.emplace_back(
+         container,
+         static_cast<uint32_t>(roaring::internal::container_get_cardinality(container, typecode)),
+         typecode
+      );
+   }
+   return {std::move(positions), roaring_util::ContainerArena::copyOf(containers)};
+}
+
+void HorizontalCoverageIndex::loadFromChunkParts(std::vector<ChunkPart>&& parts) {
+   for (size_t chunk_idx = 0; chunk_idx < parts.size(); ++chunk_idx) {
+      auto& part = parts[chunk_idx];
+      const auto chunk_id = static_cast<uint16_t>(chunk_idx);
+      start_end.push_back(std::move(part.start_end));
+      if (part.coverage_order.has_value()) {
+         if (chunk_coverage_orders.size() != chunk_idx) {
+            throw persistence::LoadDatabaseException(
+               "coverage index chunk is indexed after one that is not"
+            );
+         }
+         chunk_coverage_orders.push_back(std::move(part.coverage_order.value()));
+         // Chunks are appended in ascending order, so are the containers of every position
+         for (size_t idx = 0; idx < part.missing_positions.size(); ++idx) {
+            const uint32_t position = part.missing_positions[idx];
+            if (position >= rows_missing_at_position.size()) {
+               rows_missing_at_position.resize(size_t{position} + 1);
+            }
+            const auto container = part.rows_missing.at(idx);
+            const uint8_t typecode = container.getTypecode();
+            roaring_util::appendContainer(
+               rows_missing_at_position[position],
+               chunk_id,
+               roaring::internal::container_clone(container.rawContainer(), typecode),
+               typecode
+            );
+         }
+      }
+      for (auto& [row_in_chunk, bitmap] : part.horizontal_bitmaps) {
+         horizontal_bitmaps.emplace_hint(
+            horizontal_bitmaps.end(),
+            RowId{.chunk_id = chunk_id, .row_in_chunk = row_in_chunk}.toGlobal(),
+            std::move(bitmap)
+         );
+      }
+   }
+}
+
+namespace {
+
+void setBit(roaring::internal::bitset_container_t* bitset, uint16_t row) {
+   bitset->words[row / 64] |= uint64_t{1} << (row % 64);
+}
+
+void clearBit(roaring::internal::bitset_container_t* bitset, uint16_t row) {
+   bitset->words[row / 64] &= ~(uint64_t{1} << (row % 64));
+}
+
+/// The rows of a chunk that cover `position` with their range, ignoring Ns
+roaring::internal::bitset_container_t* rowsCoveringPosition(
+   const ChunkCoverageOrder& order,
+   uint32_t position
+) {
+   const auto rows_started = static_cast<size_t>(
+      std::ranges::upper_bound(order.sorted_starts, position) - order.sorted_starts.begin()
+   );
+   const auto rows_ended = static_cast<size_t>(
+      std::ranges::upper_bound(order.sorted_ends, position) - order.sorted_ends.begin()
+   );
+   auto* bitset = roaring::internal::bitset_container_create();
+   const std::span<const uint16_t> rows_by_start{order.rows_by_start};
+   // Every row that ended has started, so the covering rows are the started rows minus the ended
+   // ones. If most rows have started, it is cheaper to start with all rows and remove the others.
+   if (rows_started <= rows_by_start.size() - rows_started) {
+      for (const uint16_t row : rows_by_start.first(rows_started)) {
+         setBit(bitset, row);
+      }
+   } else {
+      const size_t num_rows = rows_by_start.size();
+      std::fill_n(bitset->words, num_rows / 64, ~uint64_t{0});
+      if (num_rows % 64 != 0) {
+         bitset->words[num_rows / 64] = (uint64_t{1} << (num_rows % 64)) - 1;
+      }
+      for (const uint16_t row : rows_by_start.subspan(rows_started)) {
+         clearBit(bitset, row);
+      }
+   }
+   for (const uint16_t row : std::span<const uint16_t>{order.rows_by_end}.first(rows_ended)) {
+      clearBit(bitset, row);
+   }
+   bitset->cardinality = roaring::internal::bitset_container_compute_cardinality(bitset);
+   return bitset;
+}
+
+}  // namespace
+
+roaring::Roaring HorizontalCoverageIndex::getCoverageBitmapForPosition(uint32_t position) const {
+   roaring::Roaring result;
+   for (size_t chunk_id = 0; chunk_id < chunk_coverage_orders.size(); ++chunk_id) {
+      const auto [batch_start, batch_end] = batch_start_ends.at(chunk_id);
+      if (position < batch_start || position >= batch_end) {
+         continue;
+      }
+      roaring_util::appendContainer(
+         result,
+         static_cast<uint16_t>(chunk_id),
+         rowsCoveringPosition(chunk_coverage_orders[chunk_id], position),
+         BITSET_CONTAINER_TYPE
+      );
+   }
+   if (position < rows_missing_at_position.size()) {
+      result -= rows_missing_at_position[position];
+   }
+
+   // The chunks that are not indexed yet
+   const uint32_t first_unindexed_row =
+      RowId::chunkStart(static_cast<uint16_t>(chunk_coverage_orders.size()));
+   for (size_t chunk_id = chunk_coverage_orders.size(); chunk_id < start_end.size(); ++chunk_id) {
+      const auto& chunk = start_end[chunk_id];
+      for (size_t row_in_chunk = 0; row_in_chunk < chunk.size(); ++row_in_chunk) {
+         const auto [coverage_start, coverage_end] = chunk[row_in_chunk];
+         if (coverage_start <= position && position < coverage_end) {
+            result.add(RowId(chunk_id, row_in_chunk).toGlobal());
+         }
+      }
+   }
+   for (auto row = horizontal_bitmaps.lower_bound(first_unindexed_row);
+        row != horizontal_bitmaps.end();
+        ++row) {
+      if (row->second.contains(position)) {
+         result.remove(row->first);
+      }
+   }
+   return result;
+}
+
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
 std::vector<uint64_t> HorizontalCoverageIndex::computeCoverageCardinalities(size_t genome_length
 ) const {
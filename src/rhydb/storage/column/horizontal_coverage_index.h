@@ -2,14 +2,24 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <iterator>
 #include <map>
+#include <optional>
 #include <utility>
 #include <vector>
 
 #include <boost/serialization/access.hpp>
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/split_member.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
 #include <roaring/roaring.hh>
 
+#include "rhydb/persistence/exception.h"
+#include "rhydb/persistence/segment_store.h"
 #include "rhydb/roaring_util/bitmap_builder.h"
+#include "rhydb/roaring_util/container_arena.h"
+#include "rhydb/roaring_util/roaring_serialize.h"
 #include "rhydb/storage/column/row_id.h"
 
 namespace rhydb {
@@ -18,6 +28,26 @@ class Coverage;
 
 namespace rhydb::storage::column {
 
+/// The rows of one chunk ordered by the start and by the end of their covered range. The rows that
+/// cover a position are then found with two binary searches: they are the rows that start at or
+/// before it, minus the rows that end at or before it.
+struct ChunkCoverageOrder {
+   std::vector<uint32_t> sorted_starts;
+   std::vector<uint16_t> rows_by_start;
+   std::vector<uint32_t> sorted_ends;
+   std::vector<uint16_t> rows_by_end;
+
+   static ChunkCoverageOrder of(const std::vector<std::pair<uint32_t, uint32_t>>& start_end);
+
+   template <class Archive>
+   void serialize(Archive& archive, [[maybe_unused]] const uint32_t version) {
+      archive & sorted_starts;
+      archive & rows_by_start;
+      archive & sorted_ends;
+      archive & rows_by_end;
+   }
+};
+
 class HorizontalCoverageIndex {
   public:
    /// Per-row N positions inside the covered region, keyed by sparse global row id (chunk `k` lives
@@ -34,6 +64,13 @@ class HorizontalCoverageIndex {
    // computations as whole chunks can be skipped if they cannot have coverage at a given position.
    std::vector<std::pair<uint32_t, uint32_t>> batch_start_ends;
 
+   /// `ChunkCoverageOrder` of the chunks that were indexed by `buildIndex`
+   std::vector<ChunkCoverageOrder> chunk_coverage_orders;
+
+   /// For every position, the rows of the indexed chunks that have an N there inside of their
+   /// covered range, i.e. `horizontal_bitmaps` inverted
+   std::vector<roaring::Roaring> rows_missing_at_position;
+
    void insertCoverage(RowId row_id, const Coverage& coverage);
 
    void insertNullSequence(RowId row_id);
@@ -53,6 +90,14 @@ class HorizontalCoverageIndex {
       return start_end.at(row_id.chunk_id).at(row_id.row_in_chunk);
    }
 
+   /// Indexes the chunks that were inserted since the last call, for `getCoverageBitmapForPosition`
+   void buildIndex();
+
+   /// The rows that cover `position` and do not have an N there. Per indexed chunk, this costs two
+   /// binary searches plus the smaller of the number of covering and not covering rows; chunks that
+   /// were inserted after the last `buildIndex` are scanned row by row.
+   [[nodiscard]] roaring::Roaring getCoverageBitmapForPosition(uint32_t position) const;
+
    template <size_t BatchSize>
    [[nodiscard]] std::array<roaring::Roaring, BatchSize> getCoverageBitmapForPositions(
       uint32_t position
@@ -104,13 +149,195 @@ class HorizontalCoverageIndex {
    ) const;
 
   private:
+   /// Per chunk, the segment it was loaded from (see `persistence::SegmentStore`). Every chunk is
+   /// saved as one chunk of a segment, holding its covered ranges, its `ChunkCoverageOrder`, the
+   /// `horizontal_bitmaps` of its rows and its rows in `rows_missing_at_position`. Inserting into a
+   /// chunk or indexing it forgets its origin.
+   std::vector<std::optional<persistence::ChunkOrigin>> chunk_origins;
+
+   void forgetChunkOrigin(uint16_t chunk_id);
+
+   /// The parts of the index that belong to one chunk
+   struct ChunkPart {
+      std::vector<std::pair<uint32_t, uint32_t>> start_end;
+      std::optional<ChunkCoverageOrder> coverage_order;
+      std::vector<std::pair<uint16_t, roaring::Roaring>> horizontal_bitmaps;
+      /// The positions at which the chunk has rows in `rows_missing_at_position`, and the
+      /// containers of those rows
+      std::vector<uint32_t> missing_positions;
+      roaring_util::ContainerArena rows_missing;
+   };
+
+   /// The containers of chunk `chunk_id` in `rows_missing_at_position`, with their positions
+   [[nodiscard]] std::pair<std::vector<uint32_t>, roaring_util::ContainerArena> rowsMissingInChunk(
+      uint16_t chunk_id
+   ) const;
+
+   /// Appends the parts of all chunks, `parts[k]` being those of chunk `k`, to the empty index
+   void loadFromChunkParts(std::vector<ChunkPart>&& parts);
+
    friend class boost::serialization::access;
+
    template <class Archive>
-   void serialize(Archive& archive, [[maybe_unused]] const uint32_t version) {
-      archive & horizontal_bitmaps;
-      archive & start_end;
+   void saveChunkPart(Archive& archive, uint16_t chunk_id) const {
+      bool is_indexed = chunk_id < chunk_coverage_orders.size();
+      // clang-format off
+      archive & start_end.at(chunk_id);
+      archive & is_indexed;
+      if (is_indexed) {
+         archive & chunk_coverage_orders.at(chunk_id);
+      }
+      // clang-format on
+      const auto begin = horizontal_bitmaps.lower_bound(RowId::chunkStart(chunk_id));
+      auto end = begin;
+      while (end != horizontal_bitmaps.end() &&
+             RowId::fromGlobal(end->first).chunk_id == chunk_id) {
+         ++end;
+      }
+      size_t num_bitmaps = static_cast<size_t>(std::distance(begin, end));
+      // clang-format off
+      archive & num_bitmaps;
+      for (auto row = begin; row != end; ++row) {
+         uint16_t row_in_chunk = RowId::fromGlobal(row->first).row_in_chunk;
+         archive & row_in_chunk;
+         archive & row->second;
+      }
+      // clang-format on
+      if (is_indexed) {
+         const auto [missing_positions, rows_missing] = rowsMissingInChunk(chunk_id);
+         // clang-format off
+         archive & missing_positions;
+         archive & rows_missing;
+         // clang-format on
+      }
+   }
+
+   template <class Archive>
+   static ChunkPart loadChunkPart(Archive& archive) {
+      ChunkPart part;
+      bool is_indexed = false;
+      // clang-format off
+      archive & part.start_end;
+      archive & is_indexed;
+      // clang-format on
+      if (is_indexed) {
+         ChunkCoverageOrder coverage_order;
+         // clang-format off
+         archive & coverage_order;
+         // clang-format on
+         part.coverage_order = std::move(coverage_order);
+      }
+      size_t num_bitmaps = 0;
+      // clang-format off
+      archive & num_bitmaps;
+      // clang-format on
+      for (size_t idx = 0; idx < num_bitmaps; ++idx) {
+         uint16_t row_in_chunk = 0;
+         roaring::Roaring bitmap;
+         // clang-format off
+         archive & row_in_chunk;
+         archive & bitmap;
+         // clang-format on
+         part.horizontal_bitmaps.emplace_back(row_in_chunk, std::move(bitmap));
+      }
+      if (is_indexed) {
+         // clang-format off
+         archive & part.missing_positions;
+         archive & part.rows_missing;
+         // clang-format on
+      }
+      if (part.missing_positions.size() != part.rows_missing.size()) {
+         throw persistence::LoadDatabaseException(
+            "coverage index chunk has mismatching positions and containers"
+         );
+      }
+      return part;
+   }
+
+   /// Into segments if a `SegmentStore` is active, one chunk of a segment per chunk, otherwise
+   /// inline in the archive
+   template <class Archive>
+   void save(Archive& archive, [[maybe_unused]] const uint32_t version) const {
+      auto* store = persistence::SegmentStore::active();
+      bool in_segments = store != nullptr;
+      // clang-format off
+      archive & in_segments;
+      archive & batch_start_ends;
+      // clang-format on
+      if (!in_segments) {
+         // clang-format off
+         archive & horizontal_bitmaps;
+         archive & start_end;
+         archive & chunk_coverage_orders;
+         archive & rows_missing_at_position;
+         // clang-format on
+         return;
+      }
+      auto locations = persistence::saveChunksToSegments(
+         *store,
+         start_end.size(),
+         [&](size_t chunk_idx) -> std::optional<persistence::ChunkOrigin> {
+            if (chunk_idx < chunk_origins.size()) {
+               return chunk_origins[chunk_idx];
+            }
+            return std::nullopt;
+         },
+         [&](auto& segment_archive, size_t chunk_idx) {
+            saveChunkPart(segment_archive, static_cast<uint16_t>(chunk_idx));
+         }
+      );
+      // clang-format off
+      archive & locations;
+      // clang-format on
+   }
+
+   template <class Archive>
+   void load(Archive& archive, [[maybe_unused]] const uint32_t version) {
+      horizontal_bitmaps.clear();
+      start_end.clear();
+      chunk_coverage_orders.clear();
+      rows_missing_at_position.clear();
+      chunk_origins.clear();
+      bool in_segments = false;
+      // clang-format off
+      archive & in_segments;
       archive & batch_start_ends;
+      // clang-format on
+      if (!in_segments) {
+         // clang-format off
+         archive & horizontal_bitmaps;
+         archive & start_end;
+         archive & chunk_coverage_orders;
+         archive & rows_missing_at_position;
+         // clang-format on
+         return;
+      }
+      auto* store = persistence::SegmentStore::active();
+      if (store == nullptr) {
+         throw persistence::LoadDatabaseException(
+            "Chunks are stored in segment files, but no segment store is available"
+         );
+      }
+      std::vector<persistence::ChunkLocation> locations;
+      // clang-format off
+      archive & locations;
+      // clang-format on
+      if (locations.size() != batch_start_ends.size()) {
+         throw persistence::LoadDatabaseException(
+            "coverage index has mismatching chunks and chunk ranges"
+         );
+      }
+      loadFromChunkParts(persistence::loadChunksFromSegments<ChunkPart>(
+         *store, locations, [](auto& segment_archive) { return loadChunkPart(segment_archive); }
+      ));
+      for (const auto& location : locations) {
+         chunk_origins.emplace_back(
+            persistence::ChunkOrigin{.directory = store->getDirectory(), .location = location}
+         );
+      }
    }
+
+   BOOST_SERIALIZATION_SPLIT_MEMBER()
 };
 
 }  // namespace rhydb::storage::column
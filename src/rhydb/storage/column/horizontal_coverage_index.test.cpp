@@ -1,13 +1,22 @@
 #include "rhydb/storage/column/horizontal_coverage_index.h"
 
+#include <algorithm>
+#include <filesystem>
 #include <memory>
+#include <random>
+#include <sstream>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <gtest/gtest.h>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 
 #include "rhydb/common/aligned_sequence.h"
 #include "rhydb/common/nucleotide_symbols.h"
+#include "rhydb/persistence/load_mode.h"
+#include "rhydb/persistence/segment_store.h"
 
 namespace rhydb::storage::column {
 
@@ -513,4 +522,139 @@ TEST_F(HorizontalCoverageIndexTest, CoverageCardinalitiesAcrossMultipleChunks) {
    }
 }
 
+// The indexed lookup must return the same rows as scanning every row, for indexed chunks, for
+// chunks inserted after the last buildIndex, and for chunks where most or few rows cover a position
+TEST_F(HorizontalCoverageIndexTest, IndexedCoverageBitmapMatchesScanningAllRows) {
+   std::mt19937 rng(7);
+   std::uniform_int_distribution<uint32_t> offset_distribution(0, 30);
+   std::uniform_int_distribution<uint32_t> length_distribution(0, 70);
+   std::uniform_int_distribution<uint32_t> symbol_distribution(0, 9);
+   const auto insert_chunk = [&](uint16_t chunk_id, size_t num_rows) {
+      for (size_t row_in_chunk = 0; row_in_chunk < num_rows; ++row_in_chunk) {
+         const RowId row_id{
+            .chunk_id = chunk_id, .row_in_chunk = static_cast<uint16_t>(row_in_chunk)
+         };
+         if (symbol_distribution(rng) == 0) {
+            index->insertNullSequence(row_id);
+            continue;
+         }
+         std::string sequence(length_distribution(rng), 'A');
+         for (auto& symbol : sequence) {
+            symbol = symbol_distribution(rng) == 0 ? 'N' : 'A';
+         }
+         index->insertCoverage(
+            row_id,
+            extractCoverageAndMutationsFromSequence<Nucleotide>(
+               sequence, offset_distribution(rng), REFERENCE
+            )
+               .value()
+               .coverage
+         );
+      }
+   };
+   const auto expect_indexed_bitmaps_match = [&]() {
+      for (uint32_t position_idx = 0; position_idx < GENOME_LENGTH; ++position_idx) {
+         EXPECT_EQ(
+            index->getCoverageBitmapForPosition(position_idx),
+            index->getCoverageBitmapForPositions<1>(position_idx).at(0)
+         ) << "at position "
+           << position_idx;
+      }
+   };
+
+   insert_chunk(0, 5000);
+   insert_chunk(1, 300);
+   index->buildIndex();
+   expect_indexed_bitmaps_match();
+
+   insert_chunk(2, 1000);
+   expect_indexed_bitmaps_match();
+   index->buildIndex();
+   expect_indexed_bitmaps_match();
+}
+
+
+// Saving into segments writes only the chunks that changed since the index was loaded, and loading
+// the segments again yields the same coverage
+TEST_F(HorizontalCoverageIndexTest, SegmentedSaveRewritesOnlyModifiedChunks) {
+   const std::filesystem::path directory =
+      std::filesystem::temp_directory_path() / "silo_coverage_index_segments";
+   std::filesystem::remove_all(directory);
+   std::filesystem::create_directories(directory / "1");
+   std::filesystem::create_directories(directory / "2");
+
+   const auto insert_rows = [](HorizontalCoverageIndex& target, uint16_t chunk_id) {
+      const std::vector<std::string> sequences{"AAAANAAAA", "ANNA", "AAAAAAAAAAAA"};
+      for (uint16_t row_in_chunk = 0; row_in_chunk < sequences.size(); ++row_in_chunk) {
+         target.insertCoverage(
+            RowId{.chunk_id = chunk_id, .row_in_chunk = row_in_chunk},
+            extractCoverageAndMutationsFromSequence<Nucleotide>(
+               sequences.at(row_in_chunk), 3 * chunk_id, REFERENCE
+            )
+               .value()
+               .coverage
+         );
+      }
+      target.insertNullSequence(RowId{.chunk_id = chunk_id, .row_in_chunk = 3});
+   };
+   const auto save = [&](const HorizontalCoverageIndex& to_save, const std::string& version) {
+      persistence::SegmentStore store{directory / version, "column_0." + version};
+      const persistence::SegmentStore::ActiveScope active_store{store};
+      std::stringstream stream;
+      boost::archive::binary_oarchive output_archive(stream);
+      output_archive << to_save;
+      return stream.str();
+   };
+   const auto load = [&](const std::string& saved, const std::string& version) {
+      persistence::SegmentStore store{directory / version, persistence::LoadMode::COPY};
+      const persistence::SegmentStore::ActiveScope active_store{store};
+      std::stringstream stream{saved};
+      boost::archive::binary_iarchive input_archive(stream);
+      auto restored = std::make_unique<HorizontalCoverageIndex>();
+      input_archive >> *restored;
+      return restored;
+   };
+   const auto segments_in = [&](const std::string& version) {
+      std::vector<std::string> names;
+      for (const auto& file : std::filesystem::directory_iterator(directory / version)) {
+         names.push_back(file.path().filename().string());
+      }
+      std::ranges::sort(names);
+      return names;
+   };
+   const auto expect_same_coverage = [](const HorizontalCoverageIndex& expected,
+                                        const HorizontalCoverageIndex& actual) {
+      for (uint32_t position_idx = 0; position_idx < GENOME_LENGTH; ++position_idx) {
+         EXPECT_EQ(
+            actual.getCoverageBitmapForPosition(position_idx),
+            expected.getCoverageBitmapForPosition(position_idx)
+         ) << "at position "
+           << position_idx;
+      }
+   };
+
+   insert_rows(*index, 0);
+   index->buildIndex();
+   auto restored = load(save(*index, "1"), "1");
+   expect_same_coverage(*index, *restored);
+   ASSERT_EQ(segments_in("1").size(), 1);
+
+   insert_rows(*index, 1);
+   index->buildIndex();
+   insert_rows(*restored, 1);
+   restored->buildIndex();
+   const auto saved_again = save(*restored, "2");
+
+   const auto first_segment = segments_in("1").at(0);
+   const auto second_segments = segments_in("2");
+   ASSERT_EQ(second_segments.size(), 2);
+   EXPECT_EQ(second_segments.at(0), first_segment);
+   EXPECT_TRUE(std::filesystem::equivalent(
+      directory / "1" / first_segment, directory / "2" / first_segment
+   ));
+   expect_same_coverage(*index, *load(saved_again, "2"));
+
+   std::filesystem::remove_all(directory);
+}
+
 }  // namespace rhydb::storage::column
@@ -1,7 +1,10 @@
 #include "rhydb/storage/column/insertion_index.h"
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
 #include <optional>
+#include <span>
 #include <string_view>
 #include <unordered_set>
 #include <utility>
@@ -10,7 +13,9 @@
 #include <boost/container_hash/hash.hpp>
 
 #include "rhydb/common/aa_symbols.h"
+#include "rhydb/common/block_timer.h"
 #include "rhydb/common/nucleotide_symbols.h"
+#include "rhydb/common/panic.h"
 #include "rhydb/common/string_utils.h"
 #include "rhydb/common/symbol_map.h"
 #include "rhydb/storage/insertion_format_exception.h"
@@ -231,6 +236,144 @@ std::unique_ptr<roaring::Roaring> InsertionPosition<SymbolType>::search(
    return searchWithRegex(regex_search_pattern);
 }
 
+void PostingList::append(InsertionPosting posting) {
+   const uint64_t packed = (uint64_t{posting.position_idx} << 32) | posting.insertion_id;
+   SILO_ASSERT(count == 0 || packed > last);
+   uint64_t delta = packed - last;
+   while (delta >= 0x80) {
+      encoded.push_back(static_cast<uint8_t>(delta | 0x80));
+      delta >>= 7;
+   }
+   encoded.push_back(static_cast<uint8_t>(delta));
+   last = packed;
+   ++count;
+}
+
+std::vector<InsertionPosting> PostingList::decode() const {
+   std::vector<InsertionPosting> result;
+   result.reserve(count);
+   uint64_t packed = 0;
+   size_t byte_idx = 0;
+   for (uint32_t posting_idx = 0; posting_idx < count; ++posting_idx) {
+      uint64_t delta = 0;
+      for (uint32_t shift = 0;; shift += 7) {
+         const uint8_t byte = encoded.at(byte_idx++);
+         delta |= uint64_t{byte & 0x7FU} << shift;
+         if ((byte & 0x80U) == 0) {
+            break;
+         }
+      }
+      packed += delta;
+      result.push_back(InsertionPosting{
+         .position_idx = static_cast<uint32_t>(packed >> 32),
+         .insertion_id = static_cast<uint32_t>(packed & UINT32_MAX)
+      });
+   }
+   return result;
+}
+
+template <typename SymbolType>
+InsertionKmerIndex<SymbolType>::InsertionKmerIndex(size_t kmer_length)
+    : kmer_length(kmer_length) {
+   SILO_ASSERT_GE(kmer_length, 1ULL);
+   SILO_ASSERT_LE(kmer_length, MAX_KMER_LENGTH);
+}
+
+template <typename SymbolType>
+std::vector<uint64_t> InsertionKmerIndex<SymbolType>::extractKmers(
+   const std::vector<typename SymbolType::Symbol>& symbols
+) const {
+   std::vector<uint64_t> kmers;
+   for (size_t start = 0; start + kmer_length <= symbols.size(); ++start) {
+      uint64_t kmer = 0;
+      for (size_t offset = 0; offset < kmer_length; ++offset) {
+         kmer = (kmer * SymbolType::COUNT) + static_cast<uint64_t>(symbols[start + offset]);
+      }
+      kmers.push_back(kmer);
+   }
+   std::ranges::sort(kmers);
+   const auto duplicates = std::ranges::unique(kmers);
+   kmers.erase(duplicates.begin(), duplicates.end());
+   return kmers;
+}
+
+template <typename SymbolType>
+void InsertionKmerIndex<SymbolType>::build(
+   const std::unordered_map<uint32_t, InsertionPosition<SymbolType>>& insertion_positions
+) {
+   const common::BlockTimer timer(build_time_in_microseconds);
+   postings.clear();
+
+   // The postings of every k-mer are appended in ascending order
+   std::vector<uint32_t> positions;
+   positions.reserve(insertion_positions.size());
+   for (const auto& [position_idx, _] : insertion_positions) {
+      positions.push_back(position_idx);
+   }
+   std::ranges::sort(positions);
+   for (const uint32_t position_idx : positions) {
+      const auto& insertions = insertion_positions.at(position_idx).insertions;
+      for (size_t insertion_id = 0; insertion_id < insertions.size(); ++insertion_id) {
+         const auto symbols = stringToSymbolVector<SymbolType>(insertions[insertion_id].value);
+         for (const uint64_t kmer : extractKmers(symbols)) {
+            postings[kmer].append(InsertionPosting{
+               .position_idx = position_idx, .insertion_id = static_cast<uint32_t>(insertion_id)
+            });
+         }
+      }
+   }
+   for (auto& [_, posting_list] : postings) {
+      posting_list.shrinkToFit();
+   }
+}
+
+template <typename SymbolType>
+std::optional<std::vector<InsertionPosting>> InsertionKmerIndex<SymbolType>::findCandidates(
+   const std::string& search_pattern
+) const {
+   std::vector<const PostingList*> posting_lists;
+   for (const auto& continuous_string : splitBy(search_pattern, REGEX_ANY)) {
+      const auto symbols = stringToSymbolVector<SymbolType>(continuous_string);
+      for (const uint64_t kmer : extractKmers(symbols)) {
+         const auto posting_list = postings.find(kmer);
+         if (posting_list == postings.end()) {
+            return std::vector<InsertionPosting>{};
+         }
+         posting_lists.push_back(&posting_list->second);
+      }
+   }
+   if (posting_lists.empty()) {
+      return std::nullopt;
+   }
+
+   // Intersect the shortest lists first, so that the intermediate results stay small
+   std::ranges::sort(posting_lists, {}, &PostingList::size);
+   std::vector<InsertionPosting> candidates = posting_lists.front()->decode();
+   for (const PostingList* posting_list : std::span{posting_lists}.subspan(1)) {
+      if (candidates.empty()) {
+         break;
+      }
+      const std::vector<InsertionPosting> postings_of_kmer = posting_list->decode();
+      std::vector<InsertionPosting> intersection;
+      std::ranges::set_intersection(candidates, postings_of_kmer, std::back_inserter(intersection));
+      candidates = std::move(intersection);
+   }
+   return candidates;
+}
+
+template <typename SymbolType>
+size_t InsertionKmerIndex<SymbolType>::sizeInBytes() const {
+   size_t size = sizeof(InsertionKmerIndex);
+   for (const auto& [_, posting_list] : postings) {
+      size += sizeof(uint64_t) + posting_list.sizeInBytes();
+   }
+   return size;
+}
+
+template <typename SymbolType>
+InsertionIndex<SymbolType>::InsertionIndex(size_t kmer_length)
+    : kmer_index(kmer_length) {}
+
 template <typename SymbolType>
 void InsertionIndex<SymbolType>::addLazily(
    uint32_t position_idx,
@@ -248,24 +391,37 @@ void InsertionIndex<SymbolType>::addLazily(
 
 template <typename SymbolType>
 void InsertionIndex<SymbolType>::buildIndex() {
-   insertion_positions.reserve(collected_insertions.size());
-
-   for (auto [pos, insertion_info] : collected_insertions) {
-      InsertionPosition<SymbolType> insertion_position;
-      insertion_position.insertions.reserve(insertion_info.size());
-      std::ranges::transform(
-         insertion_info,
-         std::back_inserter(insertion_position.insertions),
-         [](auto& insertion) {
-            return Insertion{std::move(insertion.first), std::move(insertion.second)};
+   if (collected_insertions.empty()) {
+      return;
+   }
+   insertion_positions.reserve(insertion_positions.size() + collected_insertions.size());
+
+   for (auto& [pos, insertion_info] : collected_insertions) {
+      InsertionPosition<SymbolType>& insertion_position = insertion_positions[pos];
+      auto& insertions = insertion_position.insertions;
+      // Values that already occur at the position of an earlier append only gain rows. New values
+      // are appended, which keeps the ids of the existing ones.
+      insertions.reserve(insertions.size() + insertion_info.size());
+      std::unordered_map<std::string_view, size_t> existing_ids;
+      for (size_t insertion_id = 0; insertion_id < insertions.size(); ++insertion_id) {
+         existing_ids.emplace(insertions[insertion_id].value, insertion_id);
+      }
+      for (auto& [value, row_ids] : insertion_info) {
+         const auto existing = existing_ids.find(value);
+         if (existing != existing_ids.end()) {
+            insertions[existing->second].row_ids |= row_ids;
+         } else {
+            insertions.push_back(Insertion{value, std::move(row_ids)});
          }
-      );
+      }
+      insertion_position.three_mer_index.clear();
       insertion_position.buildThreeMerIndex();
-      insertion_positions.emplace(pos, std::move(insertion_position));
    }
 
    // free up the memory
    collected_insertions.clear();
+
+   kmer_index.build(insertion_positions);
 }
 
 template <typename SymbolType>
@@ -286,9 +442,50 @@ std::unique_ptr<roaring::Roaring> InsertionIndex<SymbolType>::search(
    return insertion_pos_it->second.search(search_pattern);
 }
 
+template <typename SymbolType>
+std::unique_ptr<roaring::Roaring> InsertionIndex<SymbolType>::search(
+   const std::string& search_pattern
+) const {
+   const RE2 regex_search_pattern(search_pattern);
+   const auto candidates = kmer_index.findCandidates(search_pattern);
+   if (!candidates.has_value()) {
+      // The pattern is too short for the k-mer index, search every position on its own
+      const auto search_three_mers = extractThreeMers<SymbolType>(search_pattern);
+      auto result = std::make_unique<roaring::Roaring>();
+      for (const auto& [_, insertion_position] : insertion_positions) {
+         *result |= search_three_mers.empty()
+                       ? *insertion_position.searchWithRegex(regex_search_pattern)
+                       : *insertion_position.searchWithThreeMerIndex(
+                            search_three_mers, regex_search_pattern
+                         );
+      }
+      return result;
+   }
+
+   std::vector<const roaring::Roaring*> matching_row_ids;
+   const InsertionPosition<SymbolType>* insertion_position = nullptr;
+   std::optional<uint32_t> current_position_idx;
+   for (const auto& [position_idx, insertion_id] : candidates.value()) {
+      if (position_idx != current_position_idx) {
+         insertion_position = &insertion_positions.at(position_idx);
+         current_position_idx = position_idx;
+      }
+      const auto& insertion = insertion_position->insertions.at(insertion_id);
+      if (RE2::FullMatch(insertion.value, regex_search_pattern)) {
+         matching_row_ids.push_back(&insertion.row_ids);
+      }
+   }
+   return std::make_unique<roaring::Roaring>(
+      roaring::Roaring::fastunion(matching_row_ids.size(), matching_row_ids.data())
+   );
+}
+
 template class ThreeMerHash<Nucleotide>;
 template class ThreeMerHash<AminoAcid>;
 
+template class InsertionKmerIndex<Nucleotide>;
+template class InsertionKmerIndex<AminoAcid>;
+
 template class InsertionIndex<Nucleotide>;
 template class InsertionIndex<AminoAcid>;
 
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -76,6 +77,97 @@ class InsertionPosition {
    [[nodiscard]] std::unique_ptr<roaring::Roaring> search(const std::string& search_pattern) const;
 };
 
+/// An insertion value at a position: `insertion_id` indexes `InsertionPosition::insertions`
+struct InsertionPosting {
+   uint32_t position_idx;
+   uint32_t insertion_id;
+
+   auto operator<=>(const InsertionPosting&) const = default;
+   bool operator==(const InsertionPosting&) const = default;
+};
+
+/// Ascending postings, compressed: every posting is packed into `position_idx << 32 |
+/// insertion_id` and stored as the difference to its predecessor, encoded as a LEB128 varint.
+class PostingList {
+   friend class boost::serialization::access;
+
+   template <class Archive>
+   [[maybe_unused]] void serialize(Archive& archive, const uint32_t /*version*/) {
+      // clang-format off
+      archive & encoded;
+      archive & count;
+      archive & last;
+      // clang-format on
+   }
+
+   std::vector<uint8_t> encoded;
+   uint32_t count = 0;
+   uint64_t last = 0;
+
+  public:
+   /// `posting` must be larger than all postings appended before
+   void append(InsertionPosting posting);
+
+   [[nodiscard]] uint32_t size() const { return count; }
+
+   [[nodiscard]] std::vector<InsertionPosting> decode() const;
+
+   [[nodiscard]] size_t sizeInBytes() const { return sizeof(PostingList) + encoded.capacity(); }
+
+   void shrinkToFit() { encoded.shrink_to_fit(); }
+};
+
+constexpr size_t DEFAULT_INSERTION_KMER_LENGTH = 4;
+
+/// A column-wide index from every k-mer of the distinct insertion values of all positions to the
+/// positions and insertions that contain it. It answers searches for insertions at any position
+/// without visiting every position: only the insertions that contain all k-mers of the search
+/// pattern are candidates, which are then verified with the regex.
+template <typename SymbolType>
+class InsertionKmerIndex {
+   friend class boost::serialization::access;
+
+   template <class Archive>
+   [[maybe_unused]] void serialize(Archive& archive, const uint32_t /*version*/) {
+      // clang-format off
+      archive & kmer_length;
+      archive & postings;
+      archive & build_time_in_microseconds;
+      // clang-format on
+   }
+
+   size_t kmer_length;
+   std::unordered_map<uint64_t, PostingList> postings;
+   int64_t build_time_in_microseconds = 0;
+
+   [[nodiscard]] std::vector<uint64_t> extractKmers(
+      const std::vector<typename SymbolType::Symbol>& symbols
+   ) const;
+
+  public:
+   /// The k-mers are packed into 64 bits, which bounds their length
+   static constexpr size_t MAX_KMER_LENGTH = 8;
+
+   explicit InsertionKmerIndex(size_t kmer_length = DEFAULT_INSERTION_KMER_LENGTH);
+
+   /// Replaces the index with one over `insertion_positions`
+   void build(
+      const std::unordered_map<uint32_t, InsertionPosition<SymbolType>>& insertion_positions
+   );
+
+   /// The ascending postings of the insertions that contain every k-mer of the continuous parts of
+   /// `search_pattern`, or nullopt if no part is long enough to contain a k-mer
+   [[nodiscard]] std::optional<std::vector<InsertionPosting>> findCandidates(
+      const std::string& search_pattern
+   ) const;
+
+   [[nodiscard]] size_t kmerLength() const { return kmer_length; }
+
+   [[nodiscard]] size_t sizeInBytes() const;
+
+   [[nodiscard]] int64_t buildTimeInMicroseconds() const { return build_time_in_microseconds; }
+};
+
 template <typename SymbolType>
 class InsertionIndex {
    friend class boost::serialization::access;
@@ -85,14 +177,18 @@ class InsertionIndex {
       // clang-format off
       archive & insertion_positions;
       archive & collected_insertions;
+      archive & kmer_index;
       // clang-format on
    }
 
    std::unordered_map<uint32_t, InsertionPosition<SymbolType>> insertion_positions;
    std::unordered_map<uint32_t, std::unordered_map<std::string, roaring::Roaring>>
       collected_insertions;
+   InsertionKmerIndex<SymbolType> kmer_index;
 
   public:
+   explicit InsertionIndex(size_t kmer_length = DEFAULT_INSERTION_KMER_LENGTH);
+
    void addLazily(uint32_t position_idx, const std::string& insertion, uint32_t row_id);
 
    void buildIndex();
@@ -100,10 +196,15 @@ class InsertionIndex {
    [[nodiscard]] const std::unordered_map<uint32_t, InsertionPosition<SymbolType>>&
    getInsertionPositions() const;
 
+   [[nodiscard]] const InsertionKmerIndex<SymbolType>& getKmerIndex() const { return kmer_index; }
+
    [[nodiscard]] std::unique_ptr<roaring::Roaring> search(
       uint32_t position_idx,
       const std::string& search_pattern
    ) const;
+
+   /// The rows with an insertion at any position that matches `search_pattern`
+   [[nodiscard]] std::unique_ptr<roaring::Roaring> search(const std::string& search_pattern) const;
 };
 
 }  // namespace rhydb::storage::insertion
@@ -0,0 +1,58 @@
+#include "rhydb/storage/column/insertion_index.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <roaring/roaring.hh>
+
+#include "rhydb/common/nucleotide_symbols.h"
+
+using rhydb::Nucleotide;
+using rhydb::storage::insertion::InsertionIndex;
+using rhydb::storage::insertion::InsertionPosting;
+using rhydb::storage::insertion::PostingList;
+
+TEST(PostingList, decodesTheAppendedPostings) {
+   const std::vector<InsertionPosting> postings{{0, 0}, {0, 1}, {0, 300}, {7, 2}, {70'000, 0}};
+   PostingList posting_list;
+   for (const auto& posting : postings) {
+      posting_list.append(posting);
+   }
+   EXPECT_EQ(posting_list.size(), postings.size());
+   EXPECT_EQ(posting_list.decode(), postings);
+}
+
+TEST(InsertionIndex, searchesAtAnyPosition) {
+   InsertionIndex<Nucleotide> index;
+   index.addLazily(3, "ACGTACGT", 0);
+   index.addLazily(5, "ACGTACGT", 1);
+   index.addLazily(5, "CCCC", 2);
+   index.addLazily(9, "TTACGTAA", 3);
+   index.buildIndex();
+
+   EXPECT_EQ(*index.search(".*GTAC.*"), roaring::Roaring({0, 1}));
+   EXPECT_EQ(*index.search(".*ACGT.*"), roaring::Roaring({0, 1, 3}));
+   EXPECT_EQ(*index.search("ACGT.*"), roaring::Roaring({0, 1}));
+   EXPECT_EQ(*index.search(".*GGGG.*"), roaring::Roaring());
+   // Too short for the k-mer index
+   EXPECT_EQ(*index.search(".*CG.*"), roaring::Roaring({0, 1, 3}));
+   EXPECT_EQ(
+      *index.search(".*CG.*"),
+      *index.search(3, ".*CG.*") | *index.search(5, ".*CG.*") | *index.search(9, ".*CG.*")
+   );
+}
+
+TEST(InsertionIndex, mergesTheInsertionsOfSeveralBuilds) {
+   InsertionIndex<Nucleotide> index;
+   index.addLazily(5, "ACGTACGT", 0);
+   index.buildIndex();
+   index.addLazily(5, "ACGTACGT", 1);
+   index.addLazily(5, "TTTTT", 2);
+   index.buildIndex();
+
+   EXPECT_EQ(*index.search(5, "ACGTACGT"), roaring::Roaring({0, 1}));
+   EXPECT_EQ(*index.search(5, "TTTTT"), roaring::Roaring({2}));
+   EXPECT_EQ(*index.search(".*TTTT.*"), roaring::Roaring({2}));
+   EXPECT_EQ(*index.search(".*CGTA.*"), roaring::Roaring({0, 1}));
+}
@@ -13,6 +13,7 @@
 #include "rhydb/storage/column/chunked_value_buffer.h"
 #include "rhydb/storage/column/column.h"
 #include "rhydb/storage/column/column_metadata.h"
+#include "rhydb/storage/column/zone_map.h"
 
 namespace rhydb::storage::column {
 
@@ -37,9 +38,11 @@ struct NumericColumnTypeTraits<int64_t> {
 template <typename T>
 class NumericColumnBuilder;
 
-/// A fixed-width integer column storing values of type T. Nulls are tracked in a roaring bitmap;
-/// the value slot of a null row holds 0. Instantiated as Int32Column (int32_t) and Int64Column
-/// (int64_t) via the type aliases at the bottom of this header.
+/// A fixed-width integer column storing values of type T. Nulls are tracked in a roaring bitmap.
+/// An appended null row holds a neighbouring non-null value of its chunk (see `storedValuesOf`),
+/// so that a chunk whose zone map is sorted can be binary searched; a row set to null by `update`
+/// holds 0, which is fine because updates clear `ZoneMap::is_sorted`. Instantiated as Int32Column
+/// (int32_t) and Int64Column (int64_t) via the type aliases at the bottom of this header.
 template <typename T>
 class NumericColumn {
   public:
@@ -53,6 +56,7 @@ class NumericColumn {
 
   private:
    ChunkedValueBuffer<T> values;
+   std::vector<ZoneMap<T>> zone_maps;
 
   public:
    roaring::Roaring null_bitmap;
@@ -69,29 +73,30 @@ class NumericColumn {
       return values.at(row_id);
    }
 
+   [[nodiscard]] const ChunkedValueBuffer<T>& getValueBuffer() const { return values; }
+
+   [[nodiscard]] const std::vector<ZoneMap<T>>& getZoneMaps() const { return zone_maps; }
+
    [[nodiscard]] size_t numChunks() const { return values.numChunks(); }
 
    [[nodiscard]] uint32_t chunkSize(uint16_t chunk_id) const { return values.chunkSize(chunk_id); }
 
    std::expected<void, std::string> appendChunk(const Buffer& buffer) {
       const uint32_t base = RowId::chunkStart(static_cast<uint16_t>(values.numChunks()));
-      std::vector<T> chunk;
-      chunk.reserve(buffer.size());
       for (size_t i = 0; i < buffer.size(); ++i) {
-         if (buffer[i].has_value()) {
-            chunk.push_back(*buffer[i]);
-         } else {
+         if (!buffer[i].has_value()) {
             null_bitmap.add(base + static_cast<uint32_t>(i));
-            chunk.push_back(0);
          }
       }
-      values.appendChunk(std::move(chunk));
+      values.appendChunk(storedValuesOf(buffer));
+      zone_maps.push_back(ZoneMap<T>::of(buffer));
       return {};
    }
 
    /// Assigns `value` to every row in `row_ids` (physical global row ids). A `std::nullopt` value
    /// marks the rows null; a concrete value clears their null flag and overwrites the stored value
-   /// in place. Rows not in `row_ids` are left untouched.
+   /// in place. Rows not in `row_ids` are left untouched. Null rows get the stored value 0, which
+   /// may break the order of their chunk, so the chunk's zone map is no longer marked sorted.
    void update(const roaring::Roaring& row_ids, std::optional<T> value) {
       if (value == std::nullopt) {
          null_bitmap |= row_ids;
@@ -102,6 +107,7 @@ class NumericColumn {
       for (const uint32_t global_row_id : row_ids) {
          values.setValue(RowId::fromGlobal(global_row_id), stored_value);
       }
+      updateZoneMaps(zone_maps, row_ids, value, null_bitmap);
    }
 
   private:
@@ -111,6 +117,7 @@ class NumericColumn {
       // clang-format off
       archive & values;
       archive & null_bitmap;
+      archive & zone_maps;
       // clang-format on
    }
 };
@@ -0,0 +1,55 @@
+#include "rhydb/storage/column/primary_key_index.h"
+
+#include <utility>
+
+namespace rhydb::storage::column {
+
+uint64_t PrimaryKeyIndex::hash(std::string_view value) {
+   // FNV-1a, followed by the finalizer of MurmurHash3 to spread the bits over the whole word,
+   // the slot is taken from the lowest bits
+   constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+   constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+   uint64_t hash = FNV_OFFSET_BASIS;
+   for (const char character : value) {
+      hash ^= static_cast<uint8_t>(character);
+      hash *= FNV_PRIME;
+   }
+   hash ^= hash >> 33;
+   hash *= 0xff51afd7ed558ccdULL;
+   hash ^= hash >> 33;
+   hash *= 0xc4ceb9fe1a85ec53ULL;
+   hash ^= hash >> 33;
+   return hash;
+}
+
+void PrimaryKeyIndex::grow() {
+   std::vector<uint64_t> old_hashes = std::move(slot_hashes);
+   std::vector<uint32_t> old_row_ids = std::move(slot_row_ids);
+   const size_t capacity = old_row_ids.empty() ? MIN_CAPACITY : old_row_ids.size() * 2;
+   slot_hashes.assign(capacity, 0);
+   slot_row_ids.assign(capacity, EMPTY_SLOT);
+   // The stored hashes are enough to rehash, the values are not looked up again
+   for (size_t slot = 0; slot < old_row_ids.size(); ++slot) {
+      if (old_row_ids[slot] != EMPTY_SLOT) {
+         place(old_hashes[slot], old_row_ids[slot]);
+      }
+   }
+}
+
+void PrimaryKeyIndex::place(uint64_t hash, uint32_t row_id) {
+   size_t slot = hash & mask();
+   while (slot_row_ids[slot] != EMPTY_SLOT) {
+      slot = (slot + 1) & mask();
+   }
+   slot_hashes[slot] = hash;
+   slot_row_ids[slot] = row_id;
+}
+
+void PrimaryKeyIndex::clear() {
+   slot_hashes.clear();
+   slot_row_ids.clear();
+   num_rows = 0;
+   first_duplicate_row_id.reset();
+}
+
+}  // namespace rhydb::storage::column
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/optional.hpp>
+#include <boost/serialization/vector.hpp>
+
+namespace rhydb::storage::column {
+
+/// Maps the values of a primary key column to their global row ids. An open-addressing hash table
+/// with linear probing that only stores the 64-bit hash of each value, so the caller verifies a
+/// candidate row against the column's value (see `StringColumn::valueEquals`).
+///
+/// Rows with equal values are all indexed, the first row that repeats a value is remembered, so
+/// that checking the primary key for uniqueness does not need another pass over the column.
+class PrimaryKeyIndex {
+   static constexpr uint32_t EMPTY_SLOT = std::numeric_limits<uint32_t>::max();
+   static constexpr size_t MIN_CAPACITY = 16;
+
+   /// The hash of the value of each slot. The capacity is a power of two and at most half of the
+   /// slots are occupied, so that probe sequences stay short.
+   std::vector<uint64_t> slot_hashes;
+   /// The global row id of each slot, `EMPTY_SLOT` if the slot is free
+   std::vector<uint32_t> slot_row_ids;
+   size_t num_rows = 0;
+   std::optional<uint32_t> first_duplicate_row_id;
+
+   [[nodiscard]] size_t mask() const { return slot_row_ids.size() - 1; }
+
+   void grow();
+
+   void place(uint64_t hash, uint32_t row_id);
+
+  public:
+   /// Stable across processes and platforms, because the index is persisted
+   [[nodiscard]] static uint64_t hash(std::string_view value);
+
+   /// Adds `row_id`, whose value hashes to `hash`. Until the first duplicate is found,
+   /// `has_same_value(other_row_id)` is called for the indexed rows with the same hash.
+   template <typename HasSameValue>
+   void insert(uint64_t hash, uint32_t row_id, const HasSameValue& has_same_value) {
+      if ((num_rows + 1) * 2 > slot_row_ids.size()) {
+         grow();
+      }
+      size_t slot = hash & mask();
+      while (slot_row_ids[slot] != EMPTY_SLOT) {
+         if (!first_duplicate_row_id.has_value() && slot_hashes[slot] == hash &&
+             has_same_value(slot_row_ids[slot])) {
+            first_duplicate_row_id = row_id;
+         }
+         slot = (slot + 1) & mask();
+      }
+      slot_hashes[slot] = hash;
+      slot_row_ids[slot] = row_id;
+      ++num_rows;
+   }
+
+   /// Calls `function(row_id)` for every indexed row whose value hashes to `hash`
+   template <typename Function>
+   void forEachCandidate(uint64_t hash, const Function& function) const {
+      if (slot_row_ids.empty()) {
+         return;
+      }
+      for (size_t slot = hash & mask(); slot_row_ids[slot] != EMPTY_SLOT;
+           slot = (slot + 1) & mask()) {
+         if (slot_hashes[slot] == hash) {
+            function(slot_row_ids[slot]);
+         }
+      }
+   }
+
+   [[nodiscard]] size_t numRows() const { return num_rows; }
+
+   /// The first inserted row whose value an earlier row already had
+   [[nodiscard]] std::optional<uint32_t> firstDuplicateRowId() const {
+      return first_duplicate_row_id;
+   }
+
+   void clear();
+
+  private:
+   friend class boost::serialization::access;
+   template <class Archive>
+   [[maybe_unused]] void serialize(Archive& archive, const uint32_t /*version*/) {
+      // clang-format off
+      archive & slot_hashes;
+      archive & slot_row_ids;
+      archive & num_rows;
+      archive & first_duplicate_row_id;
+      // clang-format on
+   }
+};
+
+}  // namespace rhydb::storage::column
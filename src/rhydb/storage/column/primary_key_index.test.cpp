@@ -0,0 +1,60 @@
+#include "rhydb/storage/column/primary_key_index.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using rhydb::storage::column::PrimaryKeyIndex;
+
+namespace {
+std::vector<uint32_t> candidates(const PrimaryKeyIndex& index, uint64_t hash) {
+   std::vector<uint32_t> row_ids;
+   index.forEachCandidate(hash, [&](uint32_t row_id) { row_ids.push_back(row_id); });
+   std::ranges::sort(row_ids);
+   return row_ids;
+}
+}  // namespace
+
+TEST(PrimaryKeyIndex, findsEveryInsertedRowAfterGrowing) {
+   std::vector<std::string> values;
+   for (uint32_t row_id = 0; row_id < 1000; ++row_id) {
+      values.push_back("key_" + std::to_string(row_id));
+   }
+   PrimaryKeyIndex under_test;
+   for (uint32_t row_id = 0; row_id < values.size(); ++row_id) {
+      under_test.insert(PrimaryKeyIndex::hash(values[row_id]), row_id, [&](uint32_t other) {
+         return values[other] == values[row_id];
+      });
+   }
+
+   EXPECT_EQ(under_test.numRows(), 1000);
+   EXPECT_EQ(under_test.firstDuplicateRowId(), std::nullopt);
+   for (uint32_t row_id = 0; row_id < values.size(); ++row_id) {
+      EXPECT_EQ(candidates(under_test, PrimaryKeyIndex::hash(values[row_id])), std::vector{row_id});
+   }
+   EXPECT_TRUE(candidates(under_test, PrimaryKeyIndex::hash("key_1000")).empty());
+}
+
+TEST(PrimaryKeyIndex, collidingHashesAreLeftToTheCaller) {
+   const std::vector<std::string> values{"a", "b", "c", "a"};
+   PrimaryKeyIndex under_test;
+   // Every value collides, only the caller can tell the rows apart
+   constexpr uint64_t SAME_HASH = 42;
+   for (uint32_t row_id = 0; row_id < values.size(); ++row_id) {
+      under_test.insert(SAME_HASH, row_id, [&](uint32_t other) {
+         return values[other] == values[row_id];
+      });
+   }
+
+   EXPECT_EQ(candidates(under_test, SAME_HASH), (std::vector<uint32_t>{0, 1, 2, 3}));
+   EXPECT_EQ(under_test.firstDuplicateRowId(), 3);
+}
+
+TEST(PrimaryKeyIndex, hashIsStable) {
+   // The index is persisted, so the hash must not change between builds or platforms
+   EXPECT_EQ(PrimaryKeyIndex::hash("EPI_ISL_402124"), 4298227791472195084ULL);
+   EXPECT_NE(PrimaryKeyIndex::hash("EPI_ISL_402124"), PrimaryKeyIndex::hash("EPI_ISL_402125"));
+}
@@ -16,7 +16,16 @@ roaring::Roaring RowLayout::fullBitmap() const {
 }
 
 void RowLayout::complementInPlace(roaring::Roaring& bitmap) const {
-   for (size_t chunk_id = 0; chunk_id < chunk_sizes.size(); ++chunk_id) {
+   complementInPlace(bitmap, 0, chunk_sizes.size());
+}
+
+void RowLayout::complementInPlace(
+   roaring::Roaring& bitmap,
+   size_t first_chunk,
+   size_t end_chunk
+) const {
+   SILO_ASSERT_LE(end_chunk, chunk_sizes.size());
+   for (size_t chunk_id = first_chunk; chunk_id < end_chunk; ++chunk_id) {
       const uint64_t start = RowId::chunkStart(static_cast<uint16_t>(chunk_id));
       bitmap.flip(start, start + chunk_sizes[chunk_id]);
    }
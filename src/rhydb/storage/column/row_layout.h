@@ -62,6 +62,10 @@ class RowLayout {
    /// between chunks are never spuriously filled.
    void complementInPlace(roaring::Roaring& bitmap) const;
 
+   /// Like `complementInPlace`, but within the rows of the chunks `[first_chunk, end_chunk)` only.
+   /// `bitmap` is expected to contain no rows outside of these chunks.
+   void complementInPlace(roaring::Roaring& bitmap, size_t first_chunk, size_t end_chunk) const;
+
    /// Forward iterator yielding the `RowId` of every row in the partition
    class Iterator {
       const std::vector<uint32_t>* chunk_sizes = nullptr;
@@ -167,3 +167,15 @@ TEST(RowLayout, complementInPlaceOfFullBitmapIsEmptyAndViceVersa) {
    layout.complementInPlace(empty);
    ASSERT_EQ(empty, layout.fullBitmap());
 }
+
+TEST(RowLayout, complementInPlaceOfChunkRangeLeavesOtherChunksUntouched) {
+   const RowLayout layout = RowLayout::of(2, 3, 1);
+
+   roaring::Roaring bitmap = bitmapOf({global(1, 1)});
+
+   layout.complementInPlace(bitmap, 1, 2);
+
+   const roaring::Roaring expected = bitmapOf({global(1, 0), global(1, 2)});
+
+   ASSERT_EQ(bitmap, expected);
+}
@@ -1,12 +1,17 @@
 #include "rhydb/storage/column/sequence_column.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <expected>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <fmt/ranges.h>
 #include <spdlog/spdlog.h>
 #include <boost/lexical_cast.hpp>
 #include <roaring/roaring.hh>
@@ -14,7 +19,9 @@
 #include "rhydb/append/append_exception.h"
 #include "rhydb/common/aa_symbols.h"
 #include "rhydb/common/aligned_sequence.h"
+#include "rhydb/common/block_timer.h"
 #include "rhydb/common/nucleotide_symbols.h"
+#include "rhydb/common/parallel.h"
 #include "rhydb/common/string_utils.h"
 #include "rhydb/preprocessing/preprocessing.h"
 #include "rhydb/preprocessing/preprocessing_exception.h"
@@ -85,6 +92,22 @@ InsertionEntry<SymbolType> parseInsertion(const std::string& value) {
       value
    );
 }
+
+template <typename SymbolType>
+InsertionEntry<SymbolType> parseInsertionWithinGenome(
+   const std::string& value,
+   size_t genome_length
+) {
+   auto insertion = parseInsertion<SymbolType>(value);
+   if (insertion.position_idx > genome_length) {
+      throw append::AppendException(
+         "the insertion position ({}) is larger than the length of the reference sequence ({})",
+         insertion.position_idx,
+         genome_length
+      );
+   }
+   return insertion;
+}
 }  // namespace
 
 template <typename SymbolType>
@@ -94,6 +117,24 @@ SequenceColumn<SymbolType>::SequenceColumn(SequenceColumnMetadata<SymbolType>* m
       local_reference_sequence_string(SymbolType::sequenceToString(metadata->reference_sequence)) {
    mutation_buffer.resize(genome_length);
    SILO_ASSERT_GT(genome_length, 0ULL);
+   // The local reference has not been adapted yet, so it still equals the original reference
+   reference_compressor_pool = std::make_shared<ZstdCompressorPool>(
+      std::make_shared<const ZstdCDictionary>(local_reference_sequence_string, 3)
+   );
+}
+
+template <typename SymbolType>
+std::expected<void, std::string> SequenceColumn<SymbolType>::validateChunk(const Buffer& buffer
+) const {
+   for (const auto& buffered : buffer) {
+      if (buffered.is_null) {
+         continue;
+      }
+      for (const auto& insertion_and_position : buffered.insertions.insertions) {
+         parseInsertionWithinGenome<SymbolType>(insertion_and_position, genome_length);
+      }
+   }
+   return {};
 }
 
 template <typename SymbolType>
@@ -130,14 +171,8 @@ void SequenceColumn<SymbolType>::appendValue(RowId row_id, const BufferedSequenc
    }
 
    for (const auto& insertion_and_position : buffered.insertions.insertions) {
-      auto [position, insertion] = parseInsertion<SymbolType>(insertion_and_position);
-      if (position > genome_length) {
-         throw append::AppendException(
-            "the insertion position ({}) is larger than the length of the reference sequence ({})",
-            position,
-            genome_length
-         );
-      }
+      auto [position, insertion] =
+         parseInsertionWithinGenome<SymbolType>(insertion_and_position, genome_length);
       insertion_index.addLazily(position, insertion, row_id.toGlobal());
    }
 }
@@ -156,60 +191,263 @@ bool SequenceColumn<SymbolType>::isNull(RowId row_id) const {
 
 template <typename SymbolType>
 void SequenceColumn<SymbolType>::finalize() {
-   flushBuffer();
+   finalizeSequenceColumns({SequenceColumnFinalization{
+      .column_name = metadata->column_name, .phases = finalizePhases()
+   }});
+}
 
-   SPDLOG_DEBUG("Building insertion index");
-   insertion_index.buildIndex();
-
-   const SequenceColumnInfo info_after_filling = calculateInfo();
-
-   SPDLOG_DEBUG("Adapting local reference");
-   // We only need the number of rows covering a position to decide reference symbol adaptation
-   const std::vector<uint64_t> coverage_cardinalities =
-      horizontal_coverage_index.computeCoverageCardinalities(genome_length);
-   for (uint32_t position_idx = 0; position_idx < genome_length; ++position_idx) {
-      const auto current_reference_symbol =
-         SymbolType::charToSymbol(local_reference_sequence_string.at(position_idx)).value();
-      if (!vertical_sequence_index
-              .findBetterLocalReferenceSymbol(
-                 position_idx, current_reference_symbol, coverage_cardinalities.at(position_idx)
-              )
-              .has_value()) {
-         continue;
-      }
-      // Only now compute the coverage bitmap for the position that needs to be adapted
-      const auto coverage_bitmaps =
-         horizontal_coverage_index.getCoverageBitmapForPositions<1>(position_idx);
-      const roaring::Roaring& coverage_bitmap = coverage_bitmaps[0];
-      const auto new_reference_symbol = vertical_sequence_index.adaptLocalReference(
-         coverage_bitmap, position_idx, current_reference_symbol
-      );
-      SILO_ASSERT(new_reference_symbol.has_value());
-      SPDLOG_DEBUG(
-         "At position {} adapted local reference symbol to '{}'",
-         position_idx,
-         SymbolType::symbolToChar(new_reference_symbol.value())
-      );
-      local_reference_sequence_string.at(position_idx) =
-         SymbolType::symbolToChar(new_reference_symbol.value());
-   }
+namespace {
 
-   const SequenceColumnInfo info_after_adaption = calculateInfo();
+/// Positions whose local reference symbol one task of the finalize adapts
+constexpr size_t POSITIONS_PER_FINALIZE_TASK = 512;
 
-   SPDLOG_DEBUG("Optimizing bitmaps");
+/// Vertical containers that one task of the finalize optimizes
+constexpr size_t CONTAINERS_PER_FINALIZE_TASK = 4096;
 
-   optimizeBitmaps();
+size_t numTasks(size_t num_items, size_t items_per_task) {
+   return (num_items + items_per_task - 1) / items_per_task;
+}
 
-   const SequenceColumnInfo info_after_optimisation = calculateInfo();
+/// What the phases of finalizing one column hand on to the next
+template <typename SymbolType>
+struct FinalizeState {
+   SequenceColumnInfo info_after_filling{};
+   SequenceColumnInfo info_after_adaption{};
+   std::vector<uint64_t> coverage_cardinalities;
+   /// The adaptions planned by each task, in position order
+   std::vector<std::vector<typename VerticalSequenceIndex<SymbolType>::LocalReferenceAdaption>>
+      adaptions;
+   std::vector<typename VerticalSequenceIndex<SymbolType>::SequenceDiff*> containers_to_optimize;
+};
+
+}  // namespace
 
-   SPDLOG_DEBUG(
-      "Sequence store info after filling it: {}, after local reference adaption: {}, and "
-      "after optimising: {}",
-      info_after_filling,
-      info_after_adaption,
-      info_after_optimisation
+template <typename SymbolType>
+std::vector<SequenceColumnFinalizePhase> SequenceColumn<SymbolType>::finalizePhases() {
+   auto state = std::make_shared<FinalizeState<SymbolType>>();
+   std::vector<SequenceColumnFinalizePhase> phases;
+
+   // The mutation buffer, the insertion index and the coverage index are independent
+   phases.push_back(SequenceColumnFinalizePhase{
+      .name = "build indexes",
+      .prepare = [] { return size_t{3}; },
+      .run_task =
+         [this](size_t task_idx) {
+            if (task_idx == 0) {
+               flushBuffer();
+            } else if (task_idx == 1) {
+               SPDLOG_DEBUG("Building insertion index");
+               insertion_index.buildIndex();
+            } else {
+               SPDLOG_DEBUG("Building coverage index");
+               horizontal_coverage_index.buildIndex();
+            }
+         },
+      .finish =
+         [this, state] {
+            state->info_after_filling = calculateInfo();
+            // We only need the number of rows covering a position to decide reference symbol
+            // adaptation
+            state->coverage_cardinalities =
+               horizontal_coverage_index.computeCoverageCardinalities(genome_length);
+         }
+   });
+
+   // The adaption of a position only reads and writes the containers of that position, so the
+   // positions are planned concurrently and the plans applied in position order afterwards
+   phases.push_back(SequenceColumnFinalizePhase{
+      .name = "adapt local reference",
+      .prepare =
+         [this, state] {
+            SPDLOG_DEBUG("Adapting local reference");
+            state->adaptions.resize(numTasks(genome_length, POSITIONS_PER_FINALIZE_TASK));
+            return state->adaptions.size();
+         },
+      .run_task =
+         [this, state](size_t task_idx) {
+            const size_t end_position =
+               std::min(genome_length, (task_idx + 1) * POSITIONS_PER_FINALIZE_TASK);
+            for (size_t position = task_idx * POSITIONS_PER_FINALIZE_TASK;
+                 position < end_position;
+                 ++position) {
+               const auto position_idx = static_cast<uint32_t>(position);
+               const auto current_reference_symbol =
+                  SymbolType::charToSymbol(local_reference_sequence_string.at(position_idx))
+                     .value();
+               if (!vertical_sequence_index
+                       .findBetterLocalReferenceSymbol(
+                          position_idx,
+                          current_reference_symbol,
+                          state->coverage_cardinalities.at(position_idx)
+                       )
+                       .has_value()) {
+                  continue;
+               }
+               // Only now compute the coverage bitmap for the position that needs to be adapted
+               const roaring::Roaring coverage_bitmap =
+                  horizontal_coverage_index.getCoverageBitmapForPosition(position_idx);
+               auto adaption = vertical_sequence_index.planLocalReferenceAdaption(
+                  coverage_bitmap, position_idx, current_reference_symbol
+               );
+               SILO_ASSERT(adaption.has_value());
+               state->adaptions.at(task_idx).push_back(std::move(adaption.value()));
+            }
+         },
+      .finish =
+         [this, state] {
+            for (auto& task_adaptions : state->adaptions) {
+               for (auto& adaption : task_adaptions) {
+                  const uint32_t position_idx = adaption.position_idx;
+                  const auto new_reference_symbol =
+                     vertical_sequence_index.applyLocalReferenceAdaption(std::move(adaption));
+                  SPDLOG_DEBUG(
+                     "At position {} adapted local reference symbol to '{}'",
+                     position_idx,
+                     SymbolType::symbolToChar(new_reference_symbol)
+                  );
+                  local_reference_sequence_string.at(position_idx) =
+                     SymbolType::symbolToChar(new_reference_symbol);
+               }
+            }
+            state->adaptions.clear();
+            state->coverage_cardinalities.clear();
+            state->info_after_adaption = calculateInfo();
+         }
+   });
+
+   phases.push_back(SequenceColumnFinalizePhase{
+      .name = "optimize bitmaps",
+      .prepare =
+         [this, state] {
+            SPDLOG_DEBUG("Optimizing bitmaps");
+            // Containers of a frozen index were optimized before they were frozen, so only the
+            // ingestion map needs to be visited.
+            state->containers_to_optimize.reserve(vertical_sequence_index.vertical_bitmaps.size());
+            for (auto& [sequence_diff_key, sequence_diff] :
+                 vertical_sequence_index.vertical_bitmaps) {
+               state->containers_to_optimize.push_back(&sequence_diff);
+            }
+            return numTasks(state->containers_to_optimize.size(), CONTAINERS_PER_FINALIZE_TASK);
+         },
+      .run_task =
+         [state](size_t task_idx) {
+            const auto& containers = state->containers_to_optimize;
+            const size_t end = std::min(
+               containers.size(), (task_idx + 1) * CONTAINERS_PER_FINALIZE_TASK
+            );
+            for (size_t idx = task_idx * CONTAINERS_PER_FINALIZE_TASK; idx < end; ++idx) {
+               containers[idx]->runOptimizeAndShrink();
+            }
+         },
+      .finish =
+         [this, state] {
+            state->containers_to_optimize.clear();
+            const SequenceColumnInfo info_after_optimisation = calculateInfo();
+
+            SPDLOG_DEBUG("Freezing vertical sequence index");
+            vertical_sequence_index.freeze();
+
+            SPDLOG_DEBUG(
+               "Sequence store info after filling it: {}, after local reference adaption: {}, "
+               "and after optimising: {}",
+               state->info_after_filling,
+               state->info_after_adaption,
+               info_after_optimisation
+            );
+         }
+   });
+   return phases;
+}
+
+namespace {
+
+int64_t microsecondsSince(std::chrono::steady_clock::time_point start) {
+   return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start
+   )
+      .count();
+}
+
+}  // namespace
+
+void finalizeSequenceColumns(std::vector<SequenceColumnFinalization> finalizations) {
+   size_t num_phases = 0;
+   for (const auto& finalization : finalizations) {
+      num_phases = std::max(num_phases, finalization.phases.size());
+   }
+   // The time each column spent in each phase, summed over the threads that worked on it
+   std::vector<std::vector<std::atomic<int64_t>>> column_phase_microseconds(finalizations.size());
+   for (auto& phase_microseconds : column_phase_microseconds) {
+      phase_microseconds = std::vector<std::atomic<int64_t>>(num_phases);
+   }
+   std::vector<std::string> phase_summaries;
+
+   for (size_t phase_idx = 0; phase_idx < num_phases; ++phase_idx) {
+      const auto phase_start = std::chrono::steady_clock::now();
+      std::string_view phase_name;
+      const auto run_timed = [&](size_t column_idx, const std::function<void()>& function) {
+         const auto start = std::chrono::steady_clock::now();
+         function();
+         column_phase_microseconds.at(column_idx).at(phase_idx) += microsecondsSince(start);
+      };
+
+      // (column, task) of every task of the phase
+      std::vector<std::pair<size_t, size_t>> tasks;
+      for (size_t column_idx = 0; column_idx < finalizations.size(); ++column_idx) {
+         auto& phases = finalizations.at(column_idx).phases;
+         if (phase_idx >= phases.size()) {
+            continue;
+         }
+         phase_name = phases.at(phase_idx).name;
+         size_t num_tasks = 0;
+         run_timed(column_idx, [&] { num_tasks = phases.at(phase_idx).prepare(); });
+         for (size_t task_idx = 0; task_idx < num_tasks; ++task_idx) {
+            tasks.emplace_back(column_idx, task_idx);
+         }
+      }
+      common::forEachIndex(tasks.size(), [&](size_t idx) {
+         const size_t column_idx = tasks.at(idx).first;
+         const size_t task_idx = tasks.at(idx).second;
+         run_timed(column_idx, [&] {
+            finalizations.at(column_idx).phases.at(phase_idx).run_task(task_idx);
+         });
+      });
+      // Finishing a phase only touches its own column
+      common::forEachIndex(finalizations.size(), [&](size_t column_idx) {
+         auto& phases = finalizations.at(column_idx).phases;
+         if (phase_idx < phases.size()) {
+            run_timed(column_idx, phases.at(phase_idx).finish);
+         }
+      });
+
+      phase_summaries.push_back(fmt::format(
+         "{} {}", phase_name, common::formatDuration(microsecondsSince(phase_start))
+      ));
+   }
+
+   for (size_t column_idx = 0; column_idx < finalizations.size(); ++column_idx) {
+      const auto& finalization = finalizations.at(column_idx);
+      std::vector<std::string> column_summaries;
+      for (size_t phase_idx = 0; phase_idx < finalization.phases.size(); ++phase_idx) {
+         column_summaries.push_back(fmt::format(
+            "{} {}",
+            finalization.phases.at(phase_idx).name,
+            common::formatDuration(column_phase_microseconds.at(column_idx).at(phase_idx).load())
+         ));
+      }
+      SPDLOG_INFO(
+         "Finalized sequence column '{}', thread time per phase: {}",
+         finalization.column_name,
+         fmt::join(column_summaries, ", ")
+      );
+   }
+   SPDLOG_INFO(
+      "Finalized {} sequence columns, wall time per phase: {}",
+      finalizations.size(),
+      fmt::join(phase_summaries, ", ")
    );
 }
+
 }  // namespace rhydb::storage::column
 
 [[maybe_unused]] auto fmt::formatter<rhydb::storage::column::SequenceColumnInfo>::format(
@@ -219,10 +457,14 @@ void SequenceColumn<SymbolType>::finalize() {
    return fmt::format_to(
       ctx.out(),
       "SequenceColumnInfo[sequence count: {}, vertical bitmaps size: {}, horizontal bitmaps size: "
-      "{}]",
+      "{}, insertion k-mer index size: {}, insertion k-mer index build time: {}]",
       sequence_store_info.sequence_count,
       sequence_store_info.vertical_bitmaps_size,
-      sequence_store_info.horizontal_bitmaps_size
+      sequence_store_info.horizontal_bitmaps_size,
+      sequence_store_info.insertion_kmer_index_size,
+      rhydb::common::formatDuration(
+         sequence_store_info.insertion_kmer_index_build_time_in_microseconds
+      )
    );
 }
 
@@ -233,7 +475,10 @@ SequenceColumnInfo SequenceColumn<SymbolType>::calculateInfo() {
    sequence_column_info = {
       .sequence_count = sequence_count,
       .vertical_bitmaps_size = computeVerticalBitmapsSize(),
-      .horizontal_bitmaps_size = computeHorizontalBitmapsSize()
+      .horizontal_bitmaps_size = computeHorizontalBitmapsSize(),
+      .insertion_kmer_index_size = insertion_index.getKmerIndex().sizeInBytes(),
+      .insertion_kmer_index_build_time_in_microseconds =
+         insertion_index.getKmerIndex().buildTimeInMicroseconds()
    };
    return sequence_column_info;
 }
@@ -250,13 +495,6 @@ void SequenceColumn<SymbolType>::fillIndexes() {
    }
 }
 
-template <typename SymbolType>
-void SequenceColumn<SymbolType>::optimizeBitmaps() {
-   for (auto& [sequence_diff_key, sequence_diff] : vertical_sequence_index.vertical_bitmaps) {
-      sequence_diff.runOptimizeAndShrink();
-   }
-}
-
 template <typename SymbolType>
 void SequenceColumn<SymbolType>::flushBuffer() {
    fillIndexes();
@@ -270,9 +508,11 @@ void SequenceColumn<SymbolType>::flushBuffer() {
 template <typename SymbolType>
 size_t SequenceColumn<SymbolType>::computeVerticalBitmapsSize() const {
    size_t result = 0;
-   for (const auto& [_pos, sequence_diff] : vertical_sequence_index.vertical_bitmaps) {
-      result += sequence_diff.sizeInBytes();
-   }
+   vertical_sequence_index.forEachSequenceDiff(
+      [&](const auto& /*sequence_diff_key*/, roaring_util::RoaringContainerView sequence_diff) {
+         result += sequence_diff.sizeInBytes();
+      }
+   );
    return result;
 }
 
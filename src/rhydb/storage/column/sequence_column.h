@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <expected>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -22,6 +24,7 @@
 #include "rhydb/storage/column/insertion_index.h"
 #include "rhydb/storage/column/row_id.h"
 #include "rhydb/storage/column/vertical_sequence_index.h"
+#include "rhydb/zstd/zstd_compressor_pool.h"
 #include "rhydb/zstd/zstd_decompressor.h"
 
 namespace rhydb::storage::column {
@@ -36,14 +39,40 @@ class SequenceColumnInfo {
       archive & sequence_count;
       archive & vertical_bitmaps_size;
       archive & horizontal_bitmaps_size;
+      archive & insertion_kmer_index_size;
+      archive & insertion_kmer_index_build_time_in_microseconds;
    }
 
   public:
    uint32_t sequence_count;
    uint64_t vertical_bitmaps_size;
    uint64_t horizontal_bitmaps_size;
+   /// Memory footprint and last build time of the column-wide insertion k-mer index
+   uint64_t insertion_kmer_index_size;
+   int64_t insertion_kmer_index_build_time_in_microseconds;
 };
 
+/// One phase of finalizing a sequence column: `prepare` returns the number of tasks of the phase,
+/// which may run concurrently, and `finish` runs once all of them ran. Each phase starts after the
+/// previous one finished.
+struct SequenceColumnFinalizePhase {
+   std::string_view name;
+   std::function<size_t()> prepare;
+   std::function<void(size_t task_idx)> run_task;
+   std::function<void()> finish;
+};
+
+struct SequenceColumnFinalization {
+   std::string column_name;
+   std::vector<SequenceColumnFinalizePhase> phases;
+};
+
+/// Finalizes several sequence columns at once. The tasks of a phase of all columns run together on
+/// the arrow CPU pool, so that the positions of a long column are spread over all threads while the
+/// shorter columns are finalized, then the columns finish the phase concurrently. Inline on a
+/// thread of the pool. Logs the time each column spent in each phase.
+void finalizeSequenceColumns(std::vector<SequenceColumnFinalization> finalizations);
+
 template <typename SymbolType>
 class SequenceColumnMetadata : public ColumnMetadata {
   public:
@@ -112,6 +141,10 @@ class SequenceColumn {
    /// Number of appended chunks; see `RowLayout`. Kept so the column satisfies the `Column` concept
    /// and the table can check every column was appended to in lockstep.
    uint16_t num_chunks = 0;
+   /// Compressors for sequences that are returned zstd-compressed against the column's (original)
+   /// reference sequence. The dictionary is prepared once per column and shared read-only by all
+   /// queries, the compressors are reused across batches and threads.
+   std::shared_ptr<ZstdCompressorPool> reference_compressor_pool;
 
    explicit SequenceColumn(Metadata* metadata);
 
@@ -139,14 +172,25 @@ class SequenceColumn {
 
    [[nodiscard]] SequenceColumnInfo getInfo() const;
 
+   /// Checks that `appendChunk` can append `buffer`, i.e. that all of its insertions parse and lie
+   /// within the reference. Throws the exception `appendChunk` would throw.
+   [[nodiscard]] std::expected<void, std::string> validateChunk(const Buffer& buffer) const;
+
    /// Append a finalized ingestion chunk to the column's global structures,
    /// assigning global row ids as it goes.
    std::expected<void, std::string> appendChunk(const Buffer& buffer);
 
    [[nodiscard]] bool isNull(RowId row_id) const;
 
+   /// Builds the indexes of the appended rows, adapts the local reference to the most common
+   /// symbol of each position and optimizes and freezes the vertical index. Use
+   /// `finalizeSequenceColumns` with the `finalizePhases` of several columns to finalize them
+   /// together; the result is the same.
    void finalize();
 
+   /// The phases of `finalize`, which must run in order. They keep the column referenced.
+   [[nodiscard]] std::vector<SequenceColumnFinalizePhase> finalizePhases();
+
   private:
    static constexpr size_t BUFFER_SIZE = 1024;
    std::vector<SymbolMap<SymbolType, std::vector<uint32_t>>> mutation_buffer;
@@ -159,8 +203,6 @@ class SequenceColumn {
 
    void fillIndexes();
 
-   void optimizeBitmaps();
-
    void flushBuffer();
 
    [[nodiscard]] SequenceColumnInfo calculateInfo();
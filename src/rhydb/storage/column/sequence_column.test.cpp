@@ -13,7 +13,9 @@
 using rhydb::Nucleotide;
 using rhydb::append::AppendException;
 using rhydb::storage::InsertionFormatException;
+using rhydb::storage::column::finalizeSequenceColumns;
 using rhydb::storage::column::SequenceColumn;
+using rhydb::storage::column::SequenceColumnFinalization;
 using rhydb::storage::column::SequenceColumnMetadata;
 
 namespace {
@@ -32,6 +34,28 @@ void appendSequence(
    auto result = column.appendChunk(builder.finalize());
    SILO_ASSERT(result.has_value());
 }
+
+// Ten rows over a genome of `genome_length` A's, where a majority of the covered rows differs from
+// the reference at every seventh position
+void appendRowsWithMajorityMutations(SequenceColumn<Nucleotide>& column, size_t genome_length) {
+   SequenceColumn<Nucleotide>::Builder builder(
+      column.metadata, column.local_reference_sequence_string
+   );
+   for (size_t row = 0; row < 10; ++row) {
+      std::string sequence(genome_length, 'A');
+      for (size_t position = 0; position < genome_length; ++position) {
+         if (position % 13 == 0 && row < 3) {
+            sequence[position] = 'N';
+         } else if (position % 7 == 0 && row < 7) {
+            sequence[position] = 'C';
+         } else if (position % 11 == 0 && row % 2 == 0) {
+            sequence[position] = 'G';
+         }
+      }
+      builder.insert(sequence, 0, std::vector<std::string>{});
+   }
+   SILO_ASSERT(column.appendChunk(builder.finalize()).has_value());
+}
 }  // namespace
 
 TEST(SequenceColumn, validErrorOnBadInsertionFormat_noTwoParts) {
@@ -246,3 +270,44 @@ TEST(SequenceColumn, canFinalizeTwice) {
       })
    );
 }
+
+TEST(SequenceColumn, finalizingColumnsTogetherGivesTheSameResultAsOneByOne) {
+   constexpr size_t GENOME_LENGTH = 1300;
+   const std::vector<Nucleotide::Symbol> reference(GENOME_LENGTH, Nucleotide::Symbol::A);
+   SequenceColumnMetadata<Nucleotide> one_by_one_metadata{"one_by_one", std::vector{reference}};
+   SequenceColumnMetadata<Nucleotide> first_metadata{"first", std::vector{reference}};
+   SequenceColumnMetadata<Nucleotide> second_metadata{"second", std::vector{reference}};
+   SequenceColumn<Nucleotide> one_by_one(&one_by_one_metadata);
+   SequenceColumn<Nucleotide> first(&first_metadata);
+   SequenceColumn<Nucleotide> second(&second_metadata);
+   for (auto* column : {&one_by_one, &first, &second}) {
+      appendRowsWithMajorityMutations(*column, GENOME_LENGTH);
+   }
+
+   one_by_one.finalize();
+   std::vector<SequenceColumnFinalization> finalizations;
+   finalizations.push_back({.column_name = "first", .phases = first.finalizePhases()});
+   finalizations.push_back({.column_name = "second", .phases = second.finalizePhases()});
+   finalizeSequenceColumns(std::move(finalizations));
+
+   EXPECT_EQ(one_by_one.local_reference_sequence_string.at(7), 'C');
+   EXPECT_EQ(one_by_one.local_reference_sequence_string.at(11), 'A');
+   for (const auto* column : {&first, &second}) {
+      EXPECT_EQ(
+         column->local_reference_sequence_string, one_by_one.local_reference_sequence_string
+      );
+      EXPECT_TRUE(column->vertical_sequence_index.isFrozen());
+      EXPECT_EQ(
+         column->vertical_sequence_index.numSequenceDiffs(),
+         one_by_one.vertical_sequence_index.numSequenceDiffs()
+      );
+      for (uint32_t position = 0; position < GENOME_LENGTH; ++position) {
+         for (const auto symbol : Nucleotide::SYMBOLS) {
+            ASSERT_EQ(
+               column->vertical_sequence_index.getMatchingContainersAsBitmap(position, {symbol}),
+               one_by_one.vertical_sequence_index.getMatchingContainersAsBitmap(position, {symbol})
+            );
+         }
+      }
+   }
+}
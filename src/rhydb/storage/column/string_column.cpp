@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -38,6 +39,31 @@ RhyDBString StringColumnChunk::getValue(size_t row_in_chunk) const {
    return fixed_string_data.get(row_in_chunk);
 }
 
+bool StringColumnChunk::valueEquals(size_t row_in_chunk, std::string_view value) const {
+   const RhyDBString string = getValue(row_in_chunk);
+   if (string.length() != value.size()) {
+      return false;
+   }
+   if (string.isInPlace()) {
+      return string.getShortString() == value;
+   }
+   if (string.prefix() != value.substr(0, RhyDBString::PREFIX_LENGTH)) {
+      return false;
+   }
+   std::string_view remaining_suffix = value.substr(RhyDBString::PREFIX_LENGTH);
+   const vector::VariableDataRegistry::DataList suffix_chunks =
+      variable_string_data.get(string.suffixId());
+   const vector::VariableDataRegistry::DataList* current_chunk = &suffix_chunks;
+   while (current_chunk) {
+      if (!remaining_suffix.starts_with(current_chunk->data)) {
+         return false;
+      }
+      remaining_suffix.remove_prefix(current_chunk->data.size());
+      current_chunk = current_chunk->continuation.get();
+   }
+   return remaining_suffix.empty();
+}
+
 std::string StringColumnChunk::lookupValue(RhyDBString string) const {
    if (string.isInPlace()) {
       auto string_view = string.getShortString();
@@ -69,6 +95,50 @@ std::string StringColumn::getValueString(RowId row_id) const {
    return chunk.lookupValue(chunk.getValue(row_id.row_in_chunk));
 }
 
+bool StringColumn::valueEquals(RowId row_id, std::string_view value) const {
+   return chunks[row_id.chunk_id].valueEquals(row_id.row_in_chunk, value);
+}
+
+void StringColumn::enablePrimaryKeyIndex() {
+   primary_key_index.emplace();
+   for (size_t chunk_id = 0; chunk_id < chunks.size(); ++chunk_id) {
+      const StringColumnChunk& chunk = chunks[chunk_id];
+      const uint32_t base = RowId::chunkStart(static_cast<uint16_t>(chunk_id));
+      for (size_t row_in_chunk = 0; row_in_chunk < chunk.numValues(); ++row_in_chunk) {
+         const uint32_t row_id = base + static_cast<uint32_t>(row_in_chunk);
+         if (!null_bitmap.contains(row_id)) {
+            indexRow(row_id, chunk.lookupValue(chunk.getValue(row_in_chunk)));
+         }
+      }
+   }
+}
+
+void StringColumn::indexRow(uint32_t row_id, std::string_view value) {
+   primary_key_index->insert(PrimaryKeyIndex::hash(value), row_id, [&](uint32_t other_row_id) {
+      return valueEquals(RowId::fromGlobal(other_row_id), value);
+   });
+}
+
+roaring::Roaring StringColumn::lookupPrimaryKey(std::string_view value) const {
+   SILO_ASSERT(primary_key_index.has_value());
+   roaring::Roaring rows;
+   primary_key_index->forEachCandidate(PrimaryKeyIndex::hash(value), [&](uint32_t row_id) {
+      if (valueEquals(RowId::fromGlobal(row_id), value)) {
+         rows.add(row_id);
+      }
+   });
+   return rows;
+}
+
+std::optional<RowId> StringColumn::firstDuplicatePrimaryKey() const {
+   SILO_ASSERT(primary_key_index.has_value());
+   const auto row_id = primary_key_index->firstDuplicateRowId();
+   if (!row_id.has_value()) {
+      return std::nullopt;
+   }
+   return RowId::fromGlobal(row_id.value());
+}
+
 roaring::Roaring StringColumn::getDescendants(const TreeNodeId& parent) const {
    if (!metadata->phylo_tree.has_value()) {
       return {};
@@ -77,18 +147,19 @@ roaring::Roaring StringColumn::getDescendants(const TreeNodeId& parent) const {
 }
 
 namespace {
-// Binds every phylo-tree leaf referenced in `buffer` to its global row id (`base + i`) atomically:
-// the whole buffer is validated first, and the bindings are applied only once all of them are known
-// to be valid. On failure nothing is mutated, so the caller can treat the tree as unchanged.
-std::expected<void, std::string> registerPhyloNodes(
+using PhyloNodeBindings = std::vector<std::pair<common::TreeNode*, size_t>>;
+
+// The phylo-tree leaves referenced in `buffer` with the global row ids (`base + i`) they are bound
+// to, or an error if a leaf is already bound or referenced twice. Does not mutate the tree.
+std::expected<PhyloNodeBindings, std::string> collectPhyloNodeBindings(
    const StringColumn::Buffer& buffer,
    size_t base,
-   StringColumnMetadata* metadata
+   const StringColumnMetadata* metadata
 ) {
+   PhyloNodeBindings pending_bindings;
    if (!metadata->phylo_tree.has_value()) {
-      return {};
+      return pending_bindings;
    }
-   std::vector<std::pair<common::TreeNode*, size_t>> pending_bindings;
    // Tracks nodes already claimed earlier in this same buffer; `rowIndexExists()` cannot catch
    // these because the validated bindings have not been applied to the tree yet.
    std::unordered_set<common::TreeNode*> claimed_in_buffer;
@@ -109,14 +180,38 @@ std::expected<void, std::string> registerPhyloNodes(
       }
       pending_bindings.emplace_back(node, base + i);
    }
+   return pending_bindings;
+}
+
+// Binds every phylo-tree leaf referenced in `buffer` to its global row id (`base + i`) atomically:
+// the whole buffer is validated first, and the bindings are applied only once all of them are known
+// to be valid. On failure nothing is mutated, so the caller can treat the tree as unchanged.
+std::expected<void, std::string> registerPhyloNodes(
+   const StringColumn::Buffer& buffer,
+   size_t base,
+   StringColumnMetadata* metadata
+) {
+   auto pending_bindings = collectPhyloNodeBindings(buffer, base, metadata);
+   if (!pending_bindings.has_value()) {
+      return std::unexpected(std::move(pending_bindings.error()));
+   }
    // All bindings validated; apply them. This loop cannot fail.
-   for (const auto& [node, row_id] : pending_bindings) {
-      node->row_index = row_id;
+   for (const auto& [node, row_id] : pending_bindings.value()) {
+      metadata->phylo_tree->setRowIndex(*node, static_cast<uint32_t>(row_id));
    }
    return {};
 }
 }  // namespace
 
+std::expected<void, std::string> StringColumn::validateChunk(const Buffer& buffer) const {
+   const uint32_t base = RowId::chunkStart(static_cast<uint16_t>(chunks.size()));
+   auto pending_bindings = collectPhyloNodeBindings(buffer, base, metadata);
+   if (!pending_bindings.has_value()) {
+      return std::unexpected(std::move(pending_bindings.error()));
+   }
+   return {};
+}
+
 std::expected<void, std::string> StringColumn::appendChunk(const Buffer& buffer) {
    // Build the chunk in isolation so that previously appended chunks are never touched.
    // `registerPhyloNodes` is the only fallible step and applies its tree mutations atomically, so
@@ -136,6 +231,14 @@ std::expected<void, std::string> StringColumn::appendChunk(const Buffer& buffer)
       }
    }
    chunks.push_back(std::move(chunk));
+   zone_maps.push_back(ZoneMap<std::string>::of(buffer));
+   if (primary_key_index.has_value()) {
+      for (size_t i = 0; i < buffer.size(); ++i) {
+         if (buffer[i].has_value()) {
+            indexRow(base + static_cast<uint32_t>(i), *buffer[i]);
+         }
+      }
+   }
    return {};
 }
 
@@ -143,6 +246,8 @@ void StringColumn::update(
    const roaring::Roaring& row_ids,
    const std::optional<std::string>& value
 ) {
+   // The primary key index has no removal, and rebuilding it would cost a pass over the column
+   SILO_ASSERT(!primary_key_index.has_value());
    // Chunks are immutable once appended, so every chunk containing an updated row is rebuilt from
    // scratch rather than mutated in place. First collect the chunk ids that are actually touched so
    // untouched chunks are left alone.
@@ -182,6 +287,7 @@ void StringColumn::update(
    } else {
       null_bitmap |= row_ids;
    }
+   updateZoneMaps(zone_maps, row_ids, value, null_bitmap);
 }
 
 bool StringColumn::isNull(RowId row_id) const {
@@ -7,12 +7,14 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/deque.hpp>
 #include <boost/serialization/split_free.hpp>
+#include <boost/serialization/vector.hpp>
 
 #include "rhydb/common/bidirectional_string_map.h"
 #include "rhydb/common/german_string.h"
@@ -21,7 +23,9 @@
 #include "rhydb/schema/database_schema.h"
 #include "rhydb/storage/column/column.h"
 #include "rhydb/storage/column/column_metadata.h"
+#include "rhydb/storage/column/primary_key_index.h"
 #include "rhydb/storage/column/row_id.h"
+#include "rhydb/storage/column/zone_map.h"
 #include "rhydb/storage/vector/german_string_registry.h"
 #include "rhydb/storage/vector/variable_data_registry.h"
 
@@ -85,6 +89,10 @@ class StringColumnChunk {
 
    [[nodiscard]] RhyDBString getValue(size_t row_in_chunk) const;
 
+   /// Compares the length and prefix of the stored string first and only reads the suffix if they
+   /// match, without allocating
+   [[nodiscard]] bool valueEquals(size_t row_in_chunk, std::string_view value) const;
+
    /// This includes an (re)allocation of the resulting string, one should generally
    /// work with the RhyDBString and @getValue instead
    [[nodiscard]] std::string lookupValue(RhyDBString string) const;
@@ -119,12 +127,34 @@ class StringColumn {
    /// `[k << 16, (k << 16) + chunk_size)`. A `std::deque` is used because `StringColumnChunk` is
    /// move-only (its pages cannot be copied) and the deque never relocates already-appended chunks.
    std::deque<StringColumnChunk> chunks;
+   std::vector<ZoneMap<std::string>> zone_maps;
+   /// Only the primary key column of a table has one, see `enablePrimaryKeyIndex`
+   std::optional<PrimaryKeyIndex> primary_key_index;
+
+   void indexRow(uint32_t row_id, std::string_view value);
 
   public:
    explicit StringColumn(Metadata* metadata);
 
+   /// Indexes the values of this column, the rows that are already in the column and every
+   /// appended row. Null values are not indexed.
+   void enablePrimaryKeyIndex();
+
+   [[nodiscard]] bool hasPrimaryKeyIndex() const { return primary_key_index.has_value(); }
+
+   /// The rows whose value is `value`, looked up in the primary key index
+   [[nodiscard]] roaring::Roaring lookupPrimaryKey(std::string_view value) const;
+
+   /// The first row whose value an earlier row already has, per the primary key index
+   [[nodiscard]] std::optional<RowId> firstDuplicatePrimaryKey() const;
+
+   /// Checks that `appendChunk` can append `buffer`: no phylo-tree leaf may be referenced by a row
+   /// that already exists or twice within `buffer`.
+   [[nodiscard]] std::expected<void, std::string> validateChunk(const Buffer& buffer) const;
+
    std::expected<void, std::string> appendChunk(const Buffer& buffer);
 
+   /// Must not be called on a column with a primary key index
    void update(const roaring::Roaring& row_ids, const std::optional<std::string>& value);
 
    [[nodiscard]] bool isNull(RowId row_id) const;
@@ -133,6 +163,10 @@ class StringColumn {
 
    [[nodiscard]] std::string getValueString(RowId row_id) const;
 
+   [[nodiscard]] bool valueEquals(RowId row_id, std::string_view value) const;
+
+   [[nodiscard]] const std::vector<ZoneMap<std::string>>& getZoneMaps() const { return zone_maps; }
+
    [[nodiscard]] size_t numChunks() const { return chunks.size(); }
 
    [[nodiscard]] uint32_t chunkSize(size_t chunk_idx) const {
@@ -148,6 +182,8 @@ class StringColumn {
       // clang-format off
       archive & null_bitmap;
       archive & chunks;
+      archive & zone_maps;
+      archive & primary_key_index;
       // clang-format on
    }
 };
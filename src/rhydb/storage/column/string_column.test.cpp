@@ -352,3 +352,63 @@ TEST(StringColumn, manyMixedValues) {
       }
    }
 }
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+TEST(StringColumn, primaryKeyIndexLooksUpValuesAcrossChunks) {
+   StringColumnMetadata metadata{"string_column"};
+   StringColumn under_test(&metadata);
+   SILO_ASSERT(appendStringValues(under_test, {"short a", "a long key with suffix 1"}).has_value());
+   // Indexes the rows that are already in the column as well as the appended ones
+   under_test.enablePrimaryKeyIndex();
+   SILO_ASSERT(appendStringValues(under_test, {"a long key with suffix 2", "short b"}).has_value());
+
+   EXPECT_EQ(under_test.lookupPrimaryKey("short a"), roaring::Roaring{RowId(0, 0).toGlobal()});
+   EXPECT_EQ(
+      under_test.lookupPrimaryKey("a long key with suffix 1"),
+      roaring::Roaring{RowId(0, 1).toGlobal()}
+   );
+   EXPECT_EQ(
+      under_test.lookupPrimaryKey("a long key with suffix 2"),
+      roaring::Roaring{RowId(1, 0).toGlobal()}
+   );
+   // Same prefix and length, different suffix
+   EXPECT_TRUE(under_test.lookupPrimaryKey("a long key with suffix 3").isEmpty());
+   EXPECT_TRUE(under_test.lookupPrimaryKey("short").isEmpty());
+   EXPECT_EQ(under_test.firstDuplicatePrimaryKey(), std::nullopt);
+}
+
+TEST(StringColumn, primaryKeyIndexReportsTheFirstDuplicate) {
+   StringColumnMetadata metadata{"string_column"};
+   StringColumn under_test(&metadata);
+   under_test.enablePrimaryKeyIndex();
+   SILO_ASSERT(appendStringValues(under_test, {"key 1", "a long duplicated key"}).has_value());
+   SILO_ASSERT(
+      appendStringValues(under_test, {"key 2", "a long duplicated key", "key 2"}).has_value()
+   );
+
+   EXPECT_EQ(under_test.firstDuplicatePrimaryKey(), RowId(1, 1));
+   // Duplicates are still found by lookups
+   EXPECT_EQ(under_test.lookupPrimaryKey("key 2").cardinality(), 2);
+}
+
+TEST(StringColumn, primaryKeyIndexIsSerialized) {
+   StringColumnMetadata metadata{"string_column"};
+   StringColumn column(&metadata);
+   column.enablePrimaryKeyIndex();
+   SILO_ASSERT(appendStringValues(column, {"key 1", "a long key that is serialized"}).has_value());
+
+   std::ostringstream oss;
+   boost::archive::binary_oarchive oarchive(oss);
+   oarchive << column;
+
+   StringColumn under_test(&metadata);
+   std::istringstream iss(oss.str());
+   boost::archive::binary_iarchive iarchive(iss);
+   iarchive >> under_test;
+
+   ASSERT_TRUE(under_test.hasPrimaryKeyIndex());
+   EXPECT_EQ(
+      under_test.lookupPrimaryKey("a long key that is serialized"),
+      roaring::Roaring{RowId(0, 1).toGlobal()}
+   );
+}
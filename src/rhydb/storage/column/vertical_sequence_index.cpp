@@ -1,13 +1,19 @@
 #include "rhydb/storage/column/vertical_sequence_index.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
 #include <roaring/roaring.hh>
 
 #include "rhydb/common/aa_symbols.h"
 #include "rhydb/common/nucleotide_symbols.h"
 #include "rhydb/common/panic.h"
 #include "rhydb/common/symbol_map.h"
+#include "rhydb/persistence/exception.h"
 #include "rhydb/roaring_util/bitmap_builder.h"
 #include "rhydb/roaring_util/subset_ranks.h"
 
@@ -38,25 +44,186 @@ void VerticalSequenceIndex<SymbolType>::addSymbolsToPositions(
 }
 
 template <typename SymbolType>
-using const_iterator = typename VerticalSequenceIndex<SymbolType>::const_iterator;
+typename VerticalSequenceIndex<SymbolType>::Directory VerticalSequenceIndex<SymbolType>::Directory::
+   build(
+      std::vector<SequenceDiffKey>&& keys,
+      std::span<const roaring_util::RoaringContainerView> containers
+   ) {
+   SILO_ASSERT_EQ(keys.size(), containers.size());
+   SILO_ASSERT(std::ranges::is_sorted(keys));
+   Directory directory{
+      .keys = std::move(keys),
+      .containers = roaring_util::ContainerArena::copyOf(containers),
+      .position_offsets = {},
+      .keys_by_v_index = {},
+      .v_index_offsets = {}
+   };
+   directory.computePositionOffsets();
+   directory.computeChunkMajorOrder();
+   return directory;
+}
 
 template <typename SymbolType>
-std::pair<const_iterator<SymbolType>, const_iterator<SymbolType>> VerticalSequenceIndex<
-   SymbolType>::getRangeForPosition(uint32_t position_idx) const {
-   return {
-      vertical_bitmaps.lower_bound(
-         SequenceDiffKey{position_idx, 0, static_cast<SymbolType::Symbol>(0)}
-      ),
-      vertical_bitmaps.lower_bound(
-         SequenceDiffKey{position_idx + 1, 0, static_cast<SymbolType::Symbol>(0)}
-      )
-   };
+void VerticalSequenceIndex<SymbolType>::Directory::computePositionOffsets() {
+   // One entry per position up to the last one that holds a container, plus the end sentinel.
+   // Positions beyond are answered with an empty range by getRangeForPosition.
+   const size_t num_positions = keys.empty() ? 0 : keys.back().position + 1;
+   position_offsets.assign(num_positions + 1, 0);
+   size_t key_idx = 0;
+   for (size_t position_idx = 0; position_idx <= num_positions; ++position_idx) {
+      while (key_idx < keys.size() && keys[key_idx].position < position_idx) {
+         ++key_idx;
+      }
+      position_offsets[position_idx] = key_idx;
+   }
+}
+
+template <typename SymbolType>
+void VerticalSequenceIndex<SymbolType>::Directory::computeChunkMajorOrder() {
+   SILO_ASSERT_LE(keys.size(), size_t{UINT32_MAX});
+   // A counting sort by v_index, which keeps the position order of the keys within a v_index
+   uint16_t max_v_index = 0;
+   for (const auto& key : keys) {
+      max_v_index = std::max(max_v_index, key.v_index);
+   }
+   const size_t num_v_indices = keys.empty() ? 0 : size_t{max_v_index} + 1;
+   v_index_offsets.assign(num_v_indices + 1, 0);
+   for (const auto& key : keys) {
+      ++v_index_offsets[key.v_index + 1];
+   }
+   for (size_t v_index = 0; v_index < num_v_indices; ++v_index) {
+      v_index_offsets[v_index + 1] += v_index_offsets[v_index];
+   }
+   keys_by_v_index.resize(keys.size());
+   std::vector<size_t> next_slot(v_index_offsets.begin(), v_index_offsets.end() - 1);
+   for (size_t key_idx = 0; key_idx < keys.size(); ++key_idx) {
+      keys_by_v_index[next_slot[keys[key_idx].v_index]++] = static_cast<uint32_t>(key_idx);
+   }
+}
+
+template <typename SymbolType>
+std::span<const uint32_t> VerticalSequenceIndex<SymbolType>::Directory::getKeysForVIndex(
+   uint16_t v_index
+) const {
+   if (size_t{v_index} + 1 >= v_index_offsets.size()) {
+      return {};
+   }
+   return std::span<const uint32_t>{keys_by_v_index}.subspan(
+      v_index_offsets[v_index], v_index_offsets[v_index + 1] - v_index_offsets[v_index]
+   );
+}
+
+template <typename SymbolType>
+std::pair<size_t, size_t> VerticalSequenceIndex<SymbolType>::Directory::getRangeForPosition(
+   uint32_t position_idx
+) const {
+   if (position_idx + 1 >= position_offsets.size()) {
+      return {keys.size(), keys.size()};
+   }
+   return {position_offsets[position_idx], position_offsets[position_idx + 1]};
+}
+
+template <typename SymbolType>
+typename VerticalSequenceIndex<SymbolType>::Directory VerticalSequenceIndex<
+   SymbolType>::buildDirectoryFromMap() const {
+   std::vector<SequenceDiffKey> keys;
+   std::vector<roaring_util::RoaringContainerView> containers;
+   keys.reserve(vertical_bitmaps.size());
+   containers.reserve(vertical_bitmaps.size());
+   for (const auto& [sequence_diff_key, sequence_diff] : vertical_bitmaps) {
+      keys.push_back(sequence_diff_key);
+      containers.emplace_back(sequence_diff);
+   }
+   return Directory::build(std::move(keys), containers);
+}
+
+template <typename SymbolType>
+void VerticalSequenceIndex<SymbolType>::freeze() {
+   if (is_frozen) {
+      return;
+   }
+   directory = buildDirectoryFromMap();
+   vertical_bitmaps.clear();
+   is_frozen = true;
+}
+
+template <typename SymbolType>
+void VerticalSequenceIndex<SymbolType>::thaw() {
+   if (!is_frozen) {
+      return;
+   }
+   SILO_ASSERT(vertical_bitmaps.empty());
+   for (size_t idx = 0; idx < directory.keys.size(); ++idx) {
+      // The keys are sorted, so hinting the insertion at the end makes it amortized constant
+      vertical_bitmaps.emplace_hint(
+         vertical_bitmaps.end(), directory.keys[idx], directory.containers.at(idx).toOwning()
+      );
+   }
+   directory = Directory{};
+   is_frozen = false;
+}
+
+template <typename SymbolType>
+void VerticalSequenceIndex<SymbolType>::forgetChunkOrigin(uint16_t v_index) {
+   if (v_index < chunk_origins.size()) {
+      chunk_origins[v_index].reset();
+   }
+}
+
+template <typename SymbolType>
+void VerticalSequenceIndex<SymbolType>::loadFromChunkParts(std::vector<ChunkPart>&& parts) {
+   // Every part is ordered by position and symbol, so distributing the keys of the parts by
+   // position in `v_index` order yields the `{position, v_index, symbol}` order of the directory
+   size_t num_keys = 0;
+   uint32_t num_positions = 0;
+   for (size_t v_index = 0; v_index < parts.size(); ++v_index) {
+      const auto& keys = parts[v_index].keys;
+      if (!std::ranges::is_sorted(keys) ||
+          std::ranges::any_of(keys, [&](const SequenceDiffKey& key) {
+             return key.v_index != v_index;
+          })) {
+         throw persistence::LoadDatabaseException(
+            "vertical sequence index chunk is not ordered by its keys"
+         );
+      }
+      if (!keys.empty()) {
+         num_positions = std::max(num_positions, keys.back().position + 1);
+      }
+      num_keys += keys.size();
+   }
+
+   std::vector<size_t> next_slot(size_t{num_positions} + 1, 0);
+   for (const auto& part : parts) {
+      for (const auto& key : part.keys) {
+         ++next_slot[key.position + 1];
+      }
+   }
+   for (size_t position_idx = 0; position_idx < num_positions; ++position_idx) {
+      next_slot[position_idx + 1] += next_slot[position_idx];
+   }
+   std::vector<SequenceDiffKey> keys(num_keys);
+   std::vector<roaring_util::RoaringContainerView> containers(
+      num_keys, roaring_util::RoaringContainerView{nullptr, 0, 0}
+   );
+   for (const auto& part : parts) {
+      for (size_t idx = 0; idx < part.keys.size(); ++idx) {
+         const size_t slot = next_slot[part.keys[idx].position]++;
+         keys[slot] = part.keys[idx];
+         containers[slot] = part.containers.at(idx);
+      }
+   }
+   directory = Directory::build(std::move(keys), containers);
+   is_frozen = true;
+}
+
+template <typename SymbolType>
+size_t VerticalSequenceIndex<SymbolType>::numSequenceDiffs() const {
+   return is_frozen ? directory.keys.size() : vertical_bitmaps.size();
 }
 
 template <typename SymbolType>
 SymbolMap<SymbolType, uint32_t> VerticalSequenceIndex<SymbolType>::computeSymbolCountsForPosition(
-   std::map<SequenceDiffKey, SequenceDiff>::const_iterator start,
-   std::map<SequenceDiffKey, SequenceDiff>::const_iterator end,
+   uint32_t position_idx,
    SymbolType::Symbol current_local_reference_symbol,
    uint32_t coverage_cardinality
 ) const {
@@ -66,12 +233,15 @@ SymbolMap<SymbolType, uint32_t> VerticalSequenceIndex<SymbolType>::computeSymbol
    }
    symbol_counts[current_local_reference_symbol] = coverage_cardinality;
 
-   for (auto it = start; it != end; ++it) {
-      const auto& [sequence_diff_key, sequence_diff] = *it;
-      SILO_ASSERT(sequence_diff_key.symbol != current_local_reference_symbol);
-      symbol_counts[sequence_diff_key.symbol] += sequence_diff.getCardinality();
-      symbol_counts[current_local_reference_symbol] -= sequence_diff.getCardinality();
-   }
+   forEachSequenceDiffAtPosition(
+      position_idx,
+      [&](const SequenceDiffKey& sequence_diff_key, roaring_util::RoaringContainerView sequence_diff
+      ) {
+         SILO_ASSERT(sequence_diff_key.symbol != current_local_reference_symbol);
+         symbol_counts[sequence_diff_key.symbol] += sequence_diff.getCardinality();
+         symbol_counts[current_local_reference_symbol] -= sequence_diff.getCardinality();
+      }
+   );
    return symbol_counts;
 }
 
@@ -102,10 +272,8 @@ std::optional<typename SymbolType::Symbol> VerticalSequenceIndex<SymbolType>::
       SymbolType::Symbol current_local_reference_symbol,
       uint64_t coverage_cardinality
    ) const {
-   auto [start, end] = getRangeForPosition(position_idx);
-
    const SymbolMap<SymbolType, uint32_t> symbol_counts = computeSymbolCountsForPosition(
-      start, end, current_local_reference_symbol, coverage_cardinality
+      position_idx, current_local_reference_symbol, coverage_cardinality
    );
    const typename SymbolType::Symbol best_symbol =
       getSymbolWithHighestCount(symbol_counts, current_local_reference_symbol);
@@ -116,20 +284,24 @@ std::optional<typename SymbolType::Symbol> VerticalSequenceIndex<SymbolType>::
 }
 
 template <typename SymbolType>
-std::optional<typename SymbolType::Symbol> VerticalSequenceIndex<SymbolType>::adaptLocalReference(
+std::optional<typename VerticalSequenceIndex<SymbolType>::LocalReferenceAdaption>
+VerticalSequenceIndex<SymbolType>::planLocalReferenceAdaption(
    const roaring::Roaring& coverage_bitmap,
    uint32_t position_idx,
    SymbolType::Symbol current_local_reference_symbol
-) {
-   auto [start, end] = getRangeForPosition(position_idx);
-
+) const {
    const auto best_symbol = findBetterLocalReferenceSymbol(
       position_idx, current_local_reference_symbol, coverage_bitmap.cardinality()
    );
    if (!best_symbol.has_value()) {
       return std::nullopt;
    }
-   const typename SymbolType::Symbol new_reference_symbol = best_symbol.value();
+   LocalReferenceAdaption adaption{
+      .position_idx = position_idx,
+      .old_reference_symbol = current_local_reference_symbol,
+      .new_reference_symbol = best_symbol.value(),
+      .old_reference_containers = {}
+   };
    roaring::Roaring old_reference_bitmap = coverage_bitmap;
 
    old_reference_bitmap -= getMatchingContainersAsBitmap(
@@ -139,33 +311,67 @@ std::optional<typename SymbolType::Symbol> VerticalSequenceIndex<SymbolType>::ad
    const auto& roaring_array = old_reference_bitmap.roaring.high_low_container;
    SILO_ASSERT_LT(roaring_array.size, UINT16_MAX);
    auto num_containers = static_cast<uint16_t>(roaring_array.size);
+   adaption.old_reference_containers.reserve(num_containers);
    for (uint16_t container_idx = 0; container_idx < num_containers; ++container_idx) {
       const uint8_t typecode = roaring_array.typecodes[container_idx];
       const uint16_t v_index = roaring_array.keys[container_idx];
-
-      auto key = SequenceDiffKey{position_idx, v_index, current_local_reference_symbol};
-      vertical_bitmaps.insert(
-         {key, SequenceDiff::clonedFrom(roaring_array.containers[container_idx], typecode)}
+      adaption.old_reference_containers.emplace_back(
+         v_index, SequenceDiff::clonedFrom(roaring_array.containers[container_idx], typecode)
       );
    }
+   return adaption;
+}
+
+template <typename SymbolType>
+SymbolType::Symbol VerticalSequenceIndex<SymbolType>::applyLocalReferenceAdaption(
+   LocalReferenceAdaption&& adaption
+) {
+   thaw();
+   const uint32_t position_idx = adaption.position_idx;
+   for (auto& [v_index, container] : adaption.old_reference_containers) {
+      auto key = SequenceDiffKey{position_idx, v_index, adaption.old_reference_symbol};
+      vertical_bitmaps.insert({key, std::move(container)});
+      forgetChunkOrigin(v_index);
+   }
 
    std::vector<uint16_t> v_indices_to_remove;
-   for (auto it = start; it != end; ++it) {
-      const auto& [sequence_diff_key, sequence_diff] = *it;
-      if (sequence_diff_key.symbol == new_reference_symbol) {
-         v_indices_to_remove.push_back(sequence_diff_key.v_index);
+   forEachSequenceDiffAtPosition(
+      position_idx,
+      [&](const SequenceDiffKey& sequence_diff_key, roaring_util::RoaringContainerView /*unused*/) {
+         if (sequence_diff_key.symbol == adaption.new_reference_symbol) {
+            v_indices_to_remove.push_back(sequence_diff_key.v_index);
+         }
       }
-   }
+   );
    for (auto v_index : v_indices_to_remove) {
-      vertical_bitmaps.erase(SequenceDiffKey{position_idx, v_index, new_reference_symbol});
+      vertical_bitmaps.erase(
+         SequenceDiffKey{position_idx, v_index, adaption.new_reference_symbol}
+      );
+      forgetChunkOrigin(v_index);
    }
 
-   return new_reference_symbol;
+   return adaption.new_reference_symbol;
+}
+
+template <typename SymbolType>
+std::optional<typename SymbolType::Symbol> VerticalSequenceIndex<SymbolType>::adaptLocalReference(
+   const roaring::Roaring& coverage_bitmap,
+   uint32_t position_idx,
+   SymbolType::Symbol current_local_reference_symbol
+) {
+   auto adaption =
+      planLocalReferenceAdaption(coverage_bitmap, position_idx, current_local_reference_symbol);
+   if (!adaption.has_value()) {
+      return std::nullopt;
+   }
+   return applyLocalReferenceAdaption(std::move(adaption.value()));
 }
 
 template <typename SymbolType>
 VerticalSequenceIndex<SymbolType>::SequenceDiff& VerticalSequenceIndex<
    SymbolType>::getContainerOrCreateWithCapacity(const SequenceDiffKey& key, int32_t capacity) {
+   thaw();
+   forgetChunkOrigin(key.v_index);
    auto iter = vertical_bitmaps.find(key);
    if (iter != vertical_bitmaps.end()) {
       return iter->second;
@@ -180,25 +386,24 @@ roaring::Roaring VerticalSequenceIndex<SymbolType>::getMatchingContainersAsBitma
    uint32_t position_idx,
    std::vector<typename SymbolType::Symbol> symbols
 ) const {
-   // We compute the range of bitmap containers that are relevant for our position
-   auto [start, end] = getRangeForPosition(position_idx);
-
    // We need to union all bitmap containers at this position
-
    BitmapBuilderByContainer builder;
 
-   for (auto it = start; it != end; ++it) {
-      const auto& [sequence_diff_key, sequence_diff] = *it;
-      SILO_ASSERT(!sequence_diff.empty());
+   forEachSequenceDiffAtPosition(
+      position_idx,
+      [&](const SequenceDiffKey& sequence_diff_key, roaring_util::RoaringContainerView sequence_diff
+      ) {
+         SILO_ASSERT(!sequence_diff.empty());
 
-      // Only consider when the symbol is in the requested set
-      if (std::find(symbols.begin(), symbols.end(), sequence_diff_key.symbol) == symbols.end()) {
-         continue;
+         // Only consider when the symbol is in the requested set
+         if (std::find(symbols.begin(), symbols.end(), sequence_diff_key.symbol) == symbols.end()) {
+            return;
+         }
+         builder.addContainer(
+            sequence_diff_key.v_index, sequence_diff.rawContainer(), sequence_diff.getTypecode()
+         );
       }
-      builder.addContainer(
-         sequence_diff_key.v_index, sequence_diff.rawContainer(), sequence_diff.getTypecode()
-      );
-   }
+   );
    return std::move(builder).getBitmap();
 }
 
@@ -209,20 +414,19 @@ std::vector<std::pair<uint16_t, rhydb::roaring_util::RoaringContainerView>> Vert
       uint32_t position_idx,
       const std::vector<typename SymbolType::Symbol>& symbols
    ) const {
-   auto [start, end] = getRangeForPosition(position_idx);
-
    std::vector<std::pair<uint16_t, roaring_util::RoaringContainerView>> result;
-   for (auto it = start; it != end; ++it) {
-      const auto& [sequence_diff_key, sequence_diff] = *it;
-      SILO_ASSERT(!sequence_diff.empty());
-
-      if (std::find(symbols.begin(), symbols.end(), sequence_diff_key.symbol) == symbols.end()) {
-         continue;
+   forEachSequenceDiffAtPosition(
+      position_idx,
+      [&](const SequenceDiffKey& sequence_diff_key, roaring_util::RoaringContainerView sequence_diff
+      ) {
+         SILO_ASSERT(!sequence_diff.empty());
+
+         if (std::find(symbols.begin(), symbols.end(), sequence_diff_key.symbol) == symbols.end()) {
+            return;
+         }
+         result.emplace_back(sequence_diff_key.v_index, sequence_diff);
       }
-      result.emplace_back(
-         sequence_diff_key.v_index, roaring_util::RoaringContainerView{sequence_diff}
-      );
-   }
+   );
    return result;
 }
 
@@ -231,7 +435,8 @@ using rhydb::roaring_util::roaringSubsetRanks;
 template <typename SymbolType>
 void VerticalSequenceIndex<SymbolType>::overwriteSymbolsInSequences(
    std::vector<std::string>& sequences,
-   const roaring::Roaring& row_ids
+   const roaring::Roaring& row_ids,
+   ReconstructionStrategy strategy
 ) const {
    SILO_ASSERT_EQ(sequences.size(), row_ids.cardinality());
    if (row_ids.roaring.high_low_container.size == 0) {
@@ -262,36 +467,60 @@ void VerticalSequenceIndex<SymbolType>::overwriteSymbolsInSequences(
       current_sequences_pointer += cardinality;
    }
 
-   for (const auto& [sequence_diff_key, sequence_diff] : vertical_bitmaps) {
-      const uint16_t v_index = sequence_diff_key.v_index;
+   const auto overwrite_symbols =
+      [&](const SequenceDiffKey& sequence_diff_key, roaring_util::RoaringContainerView sequence_diff
+      ) {
+         const uint16_t v_index = sequence_diff_key.v_index;
 
-      if (v_index > max_v_index || sequences_by_v_index_sizes.at(v_index) == 0) {
-         continue;
-      }
-
-      auto ranks_in_reconstructed_sequences = roaringSubsetRanks(
-         roaring_containers_by_v_index.at(v_index),
-         roaring_typecodes_by_v_index.at(v_index),
-         sequence_diff.rawContainer(),
-         sequence_diff.getTypecode(),
-         /*base=*/0  // Base rank is 0, because we have a slice per container
-      );
+         if (v_index > max_v_index || sequences_by_v_index_sizes.at(v_index) == 0) {
+            return;
+         }
 
-      // Ranks are ordered, back() = largest rank -> should be a valid size for the current sequence
-      // slice
-      SILO_ASSERT(
-         ranks_in_reconstructed_sequences.empty() ||
-         ranks_in_reconstructed_sequences.back() <= sequences_by_v_index_sizes.at(v_index)
-      );
+         auto ranks_in_reconstructed_sequences = roaringSubsetRanks(
+            roaring_containers_by_v_index.at(v_index),
+            roaring_typecodes_by_v_index.at(v_index),
+            sequence_diff.rawContainer(),
+            sequence_diff.getTypecode(),
+            /*base=*/0  // Base rank is 0, because we have a slice per container
+         );
+
+         // Ranks are ordered, back() = largest rank -> should be a valid size for the current
+         // sequence slice
+         SILO_ASSERT(
+            ranks_in_reconstructed_sequences.empty() ||
+            ranks_in_reconstructed_sequences.back() <= sequences_by_v_index_sizes.at(v_index)
+         );
+
+         auto& current_v_index_sequences = sequences_by_v_index.at(v_index);
+         for (auto rank_in_reconstructed_sequences : ranks_in_reconstructed_sequences) {
+            // Ranks are 1-indexed
+            const uint32_t id_in_reconstructed_sequences = rank_in_reconstructed_sequences - 1;
+            current_v_index_sequences[id_in_reconstructed_sequences].at(
+               sequence_diff_key.position
+            ) = SymbolType::symbolToChar(sequence_diff_key.symbol);
+         }
+      };
 
-      auto& current_v_index_sequences = sequences_by_v_index.at(v_index);
-      for (auto rank_in_reconstructed_sequences : ranks_in_reconstructed_sequences) {
-         // Ranks are 1-indexed
-         const uint32_t id_in_reconstructed_sequences = rank_in_reconstructed_sequences - 1;
-         current_v_index_sequences[id_in_reconstructed_sequences].at(sequence_diff_key.position) =
-            SymbolType::symbolToChar(sequence_diff_key.symbol);
+   if (strategy == ReconstructionStrategy::AUTOMATIC && is_frozen) {
+      size_t num_visited_diffs = 0;
+      for (size_t idx = 0; idx < num_containers; ++idx) {
+         num_visited_diffs +=
+            directory.getKeysForVIndex(row_ids.roaring.high_low_container.keys[idx]).size();
       }
+      strategy = num_visited_diffs * CHUNK_MAJOR_MAX_SHARE <= directory.keys.size()
+                    ? ReconstructionStrategy::CHUNK_MAJOR
+                    : ReconstructionStrategy::FULL_SWEEP;
+   }
+   if (strategy == ReconstructionStrategy::CHUNK_MAJOR && is_frozen) {
+      for (size_t idx = 0; idx < num_containers; ++idx) {
+         const uint16_t v_index = row_ids.roaring.high_low_container.keys[idx];
+         for (const uint32_t key_idx : directory.getKeysForVIndex(v_index)) {
+            overwrite_symbols(directory.keys[key_idx], directory.containers.at(key_idx));
+         }
+      }
+      return;
    }
+   forEachSequenceDiff(overwrite_symbols);
 };
 
 template class VerticalSequenceIndex<Nucleotide>;
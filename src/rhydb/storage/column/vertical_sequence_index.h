@@ -2,14 +2,21 @@
 
 #include <map>
 #include <optional>
+#include <span>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <boost/serialization/access.hpp>
-#include <boost/serialization/map.hpp>
+#include <boost/serialization/binary_object.hpp>
+#include <boost/serialization/split_member.hpp>
+#include <boost/serialization/vector.hpp>
 #include <roaring/roaring.hh>
 
 #include "rhydb/common/symbol_map.h"
+#include "rhydb/persistence/exception.h"
+#include "rhydb/persistence/segment_store.h"
+#include "rhydb/roaring_util/container_arena.h"
 #include "rhydb/roaring_util/roaring_container.h"
 
 namespace rhydb::storage::column {
@@ -38,24 +45,104 @@ class VerticalSequenceIndex {
       }
    };
    static_assert(sizeof(SequenceDiffKey) == 8);
+   static_assert(std::is_trivially_copyable_v<SequenceDiffKey>);
 
    using SequenceDiff = roaring_util::RoaringContainer;
 
+   /// Mutable containers, only populated while rows are ingested: `appendChunk` and the local
+   /// reference adaption of `SequenceColumn::finalize` write here. `freeze` moves the containers
+   /// into the flat directory below and leaves this map empty, and the first mutation of a frozen
+   /// index copies them back (`thaw`).
    std::map<SequenceDiffKey, SequenceDiff> vertical_bitmaps;
 
-   using const_iterator = typename std::map<SequenceDiffKey, SequenceDiff>::const_iterator;
+   /// Frozen, struct-of-arrays layout of the same containers for the query path. The keys are
+   /// sorted by `{position, v_index, symbol}` and `containers.at(idx)` belongs to `keys[idx]`;
+   /// `position_offsets[p]` is the index of the first key at position `p`, so the containers of a
+   /// position are found without a search and a full scan is a linear sweep over both arrays.
+   ///
+   /// `keys_by_v_index` is a secondary, chunk-major order of the same keys: the key indices sorted
+   /// by `{v_index, position, symbol}`, where `v_index_offsets[v]` is the first one with
+   /// `v_index == v`. Reconstructing a few rows only visits the containers of their `v_index`.
+   struct Directory {
+      std::vector<SequenceDiffKey> keys;
+      roaring_util::ContainerArena containers;
+      std::vector<size_t> position_offsets;
+      std::vector<uint32_t> keys_by_v_index;
+      std::vector<size_t> v_index_offsets;
+
+      static Directory build(
+         std::vector<SequenceDiffKey>&& keys,
+         std::span<const roaring_util::RoaringContainerView> containers
+      );
+
+      /// The half-open index range `[begin, end)` of the keys at `position_idx`
+      [[nodiscard]] std::pair<size_t, size_t> getRangeForPosition(uint32_t position_idx) const;
+
+      /// The indices of the keys with `v_index`, ordered by position
+      [[nodiscard]] std::span<const uint32_t> getKeysForVIndex(uint16_t v_index) const;
+
+      /// One more than the largest `v_index` of a key, 0 without keys
+      [[nodiscard]] size_t numVIndices() const {
+         return v_index_offsets.empty() ? 0 : v_index_offsets.size() - 1;
+      }
+
+      void computePositionOffsets();
+
+      void computeChunkMajorOrder();
+   };
+
+   /// Moves the containers of the ingestion map into the frozen directory. Called at the end of
+   /// `SequenceColumn::finalize`; a no-op on an index that is already frozen.
+   void freeze();
+
+   [[nodiscard]] bool isFrozen() const { return is_frozen; }
+
+   /// Number of stored containers, in either representation.
+   [[nodiscard]] size_t numSequenceDiffs() const;
+
+   /// Calls `function(const SequenceDiffKey&, RoaringContainerView)` for every stored container in
+   /// key order.
+   template <typename Function>
+   void forEachSequenceDiff(Function&& function) const {
+      if (is_frozen) {
+         for (size_t idx = 0; idx < directory.keys.size(); ++idx) {
+            function(directory.keys[idx], directory.containers.at(idx));
+         }
+         return;
+      }
+      for (const auto& [sequence_diff_key, sequence_diff] : vertical_bitmaps) {
+         function(sequence_diff_key, roaring_util::RoaringContainerView{sequence_diff});
+      }
+   }
+
+   /// Like `forEachSequenceDiff`, restricted to the containers at `position_idx`.
+   template <typename Function>
+   void forEachSequenceDiffAtPosition(uint32_t position_idx, Function&& function) const {
+      if (is_frozen) {
+         const auto [begin, end] = directory.getRangeForPosition(position_idx);
+         for (size_t idx = begin; idx < end; ++idx) {
+            function(directory.keys[idx], directory.containers.at(idx));
+         }
+         return;
+      }
+      const auto begin = vertical_bitmaps.lower_bound(
+         SequenceDiffKey{position_idx, 0, static_cast<SymbolType::Symbol>(0)}
+      );
+      const auto end = vertical_bitmaps.lower_bound(
+         SequenceDiffKey{position_idx + 1, 0, static_cast<SymbolType::Symbol>(0)}
+      );
+      for (auto it = begin; it != end; ++it) {
+         function(it->first, roaring_util::RoaringContainerView{it->second});
+      }
+   }
 
    void addSymbolsToPositions(
       uint32_t position_idx,
       const SymbolMap<SymbolType, std::vector<uint32_t>>& ids_per_symbol
    );
 
-   [[nodiscard]] std::pair<const_iterator, const_iterator> getRangeForPosition(uint32_t position_idx
-   ) const;
-
    [[nodiscard]] SymbolMap<SymbolType, uint32_t> computeSymbolCountsForPosition(
-      std::map<SequenceDiffKey, SequenceDiff>::const_iterator start,
-      std::map<SequenceDiffKey, SequenceDiff>::const_iterator end,
+      uint32_t position_idx,
       SymbolType::Symbol current_local_reference_symbol,
       uint32_t coverage_cardinality
    ) const;
@@ -75,6 +162,25 @@ class VerticalSequenceIndex {
       uint64_t coverage_cardinality
    ) const;
 
+   /// The changes `adaptLocalReference` makes at one position. Planning them only reads the
+   /// index, so that the positions of a column can be planned concurrently.
+   struct LocalReferenceAdaption {
+      uint32_t position_idx;
+      SymbolType::Symbol old_reference_symbol;
+      SymbolType::Symbol new_reference_symbol;
+      /// The rows that keep the old reference symbol, by `v_index`
+      std::vector<std::pair<uint16_t, SequenceDiff>> old_reference_containers;
+   };
+
+   [[nodiscard]] std::optional<LocalReferenceAdaption> planLocalReferenceAdaption(
+      const roaring::Roaring& coverage_bitmap,
+      uint32_t position_idx,
+      SymbolType::Symbol current_local_reference_symbol
+   ) const;
+
+   /// Returns the new local reference symbol of the position
+   SymbolType::Symbol applyLocalReferenceAdaption(LocalReferenceAdaption&& adaption);
+
    std::optional<typename SymbolType::Symbol> adaptLocalReference(
       const roaring::Roaring& coverage_bitmap,
       uint32_t position_idx,
@@ -99,17 +205,197 @@ class VerticalSequenceIndex {
       const std::vector<typename SymbolType::Symbol>& symbols
    ) const;
 
+   /// How `overwriteSymbolsInSequences` finds the containers that hold the requested rows
+   enum class ReconstructionStrategy : uint8_t {
+      /// Whichever of the two below visits fewer containers
+      AUTOMATIC,
+      /// Sweep over all containers, skipping those of other `v_index` values
+      FULL_SWEEP,
+      /// Only the containers of the requested `v_index` values. Falls back to the full sweep on an
+      /// index that is not frozen.
+      CHUNK_MAJOR
+   };
+
    void overwriteSymbolsInSequences(
       std::vector<std::string>& sequences,
-      const roaring::Roaring& row_ids
+      const roaring::Roaring& row_ids,
+      ReconstructionStrategy strategy = ReconstructionStrategy::AUTOMATIC
    ) const;
 
   private:
+   /// `overwriteSymbolsInSequences` reads only the containers of the requested rows' `v_index`
+   /// instead of sweeping all containers, if that visits at most 1/CHUNK_MAJOR_MAX_SHARE of them.
+   /// Going through `keys_by_v_index` is an indirection per container, where the sweep only skips
+   /// the containers of other `v_index` values.
+   static constexpr size_t CHUNK_MAJOR_MAX_SHARE = 2;
+
+   Directory directory;
+   bool is_frozen = false;
+
+   /// Per `v_index`, the segment its containers were loaded from (see `persistence::SegmentStore`).
+   /// Every `v_index` is saved as one chunk of a segment. Adding containers to a `v_index` or
+   /// adapting the local reference at a position where it has containers forgets its origin, so
+   /// that saving only writes the containers of modified `v_index` values.
+   std::vector<std::optional<persistence::ChunkOrigin>> chunk_origins;
+
+   void forgetChunkOrigin(uint16_t v_index);
+
+   /// The keys and containers of one `v_index`, ordered by position and symbol
+   struct ChunkPart {
+      std::vector<SequenceDiffKey> keys;
+      roaring_util::ContainerArena containers;
+   };
+
+   /// Builds the frozen directory from the parts of all `v_index` values, `parts[v]` holding those
+   /// of `v_index == v`
+   void loadFromChunkParts(std::vector<ChunkPart>&& parts);
+
+   /// Copies the frozen containers back into the ingestion map so they can be mutated again, e.g.
+   /// when appending to a loaded database. A no-op on an index that is not frozen.
+   void thaw();
+
+   [[nodiscard]] Directory buildDirectoryFromMap() const;
+
    friend class boost::serialization::access;
+
+   template <class Archive>
+   static void saveDirectory(Archive& archive, const Directory& to_save) {
+      const size_t num_keys = to_save.keys.size();
+      // clang-format off
+      archive & num_keys;
+      archive & boost::serialization::make_binary_object(
+         const_cast<SequenceDiffKey*>(to_save.keys.data()), num_keys * sizeof(SequenceDiffKey)
+      );
+      archive & to_save.containers;
+      // clang-format on
+   }
+
+   template <class Archive>
+   static void saveChunkPart(Archive& archive, const Directory& from, uint16_t v_index) {
+      std::vector<SequenceDiffKey> keys;
+      std::vector<roaring_util::RoaringContainerView> containers;
+      for (const uint32_t key_idx : from.getKeysForVIndex(v_index)) {
+         keys.push_back(from.keys[key_idx]);
+         containers.push_back(from.containers.at(key_idx));
+      }
+      const auto part_containers = roaring_util::ContainerArena::copyOf(containers);
+      const size_t num_keys = keys.size();
+      // clang-format off
+      archive & num_keys;
+      archive & boost::serialization::make_binary_object(
+         keys.data(), num_keys * sizeof(SequenceDiffKey)
+      );
+      archive & part_containers;
+      // clang-format on
+   }
+
    template <class Archive>
-   void serialize(Archive& archive, [[maybe_unused]] const uint32_t version) {
-      archive & vertical_bitmaps;
+   static ChunkPart loadChunkPart(Archive& archive) {
+      ChunkPart part;
+      size_t num_keys = 0;
+      // clang-format off
+      archive & num_keys;
+      part.keys.resize(num_keys);
+      archive & boost::serialization::make_binary_object(
+         part.keys.data(), num_keys * sizeof(SequenceDiffKey)
+      );
+      archive & part.containers;
+      // clang-format on
+      if (part.containers.size() != num_keys) {
+         throw persistence::LoadDatabaseException(
+            "vertical sequence index has mismatching keys and containers"
+         );
+      }
+      return part;
+   }
+
+   // Always persisted in the frozen layout, the key array as one binary blob. Into segments if a
+   // `SegmentStore` is active, one chunk per `v_index`, otherwise inline in the archive.
+   template <class Archive>
+   void save(Archive& archive, [[maybe_unused]] const uint32_t version) const {
+      std::optional<Directory> built_directory;
+      if (!is_frozen) {
+         built_directory = buildDirectoryFromMap();
+      }
+      const Directory& to_save = is_frozen ? directory : built_directory.value();
+
+      auto* store = persistence::SegmentStore::active();
+      bool in_segments = store != nullptr;
+      // clang-format off
+      archive & in_segments;
+      // clang-format on
+      if (!in_segments) {
+         saveDirectory(archive, to_save);
+         return;
+      }
+      auto locations = persistence::saveChunksToSegments(
+         *store,
+         to_save.numVIndices(),
+         [&](size_t v_index) -> std::optional<persistence::ChunkOrigin> {
+            if (v_index < chunk_origins.size()) {
+               return chunk_origins[v_index];
+            }
+            return std::nullopt;
+         },
+         [&](auto& segment_archive, size_t v_index) {
+            saveChunkPart(segment_archive, to_save, static_cast<uint16_t>(v_index));
+         }
+      );
+      // clang-format off
+      archive & locations;
+      // clang-format on
+   }
+
+   template <class Archive>
+   void load(Archive& archive, [[maybe_unused]] const uint32_t version) {
+      vertical_bitmaps.clear();
+      chunk_origins.clear();
+      bool in_segments = false;
+      // clang-format off
+      archive & in_segments;
+      // clang-format on
+      if (in_segments) {
+         auto* store = persistence::SegmentStore::active();
+         if (store == nullptr) {
+            throw persistence::LoadDatabaseException(
+               "Chunks are stored in segment files, but no segment store is available"
+            );
+         }
+         std::vector<persistence::ChunkLocation> locations;
+         // clang-format off
+         archive & locations;
+         // clang-format on
+         loadFromChunkParts(persistence::loadChunksFromSegments<ChunkPart>(
+            *store, locations, [](auto& segment_archive) { return loadChunkPart(segment_archive); }
+         ));
+         for (const auto& location : locations) {
+            chunk_origins.emplace_back(
+               persistence::ChunkOrigin{.directory = store->getDirectory(), .location = location}
+            );
+         }
+         return;
+      }
+
+      size_t num_keys = 0;
+      // clang-format off
+      archive & num_keys;
+      directory.keys.resize(num_keys);
+      archive & boost::serialization::make_binary_object(
+         directory.keys.data(), num_keys * sizeof(SequenceDiffKey)
+      );
+      archive & directory.containers;
+      // clang-format on
+      if (directory.containers.size() != num_keys) {
+         throw persistence::LoadDatabaseException(
+            "vertical sequence index has mismatching keys and containers"
+         );
+      }
+      directory.computePositionOffsets();
+      directory.computeChunkMajorOrder();
+      is_frozen = true;
    }
+
+   BOOST_SERIALIZATION_SPLIT_MEMBER()
 };
 
 std::vector<std::pair<uint16_t, std::vector<uint16_t>>> splitIdsIntoBatches(
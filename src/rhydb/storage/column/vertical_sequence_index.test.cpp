@@ -1,17 +1,27 @@
 #include "rhydb/storage/column/vertical_sequence_index.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <filesystem>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include <gtest/gtest.h>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <roaring/roaring.hh>
 
 #include "rhydb/common/aa_symbols.h"
 #include "rhydb/common/nucleotide_symbols.h"
+#include "rhydb/persistence/load_mode.h"
+#include "rhydb/persistence/segment_store.h"
 
 using rhydb::AminoAcid;
 using rhydb::Nucleotide;
 using rhydb::SymbolMap;
+using rhydb::persistence::LoadMode;
+using rhydb::persistence::SegmentStore;
 using rhydb::storage::column::VerticalSequenceIndex;
 
 class VerticalSequenceIndexTest : public ::testing::Test {
@@ -438,6 +448,209 @@ TEST_F(VerticalSequenceIndexTest, adaptsAndFlipsCorrectlyWithManySymbols) {
    );
 }
 
+TEST_F(VerticalSequenceIndexTest, frozenIndexAnswersLikeTheIngestionMap) {
+   SymbolMap<Nucleotide, std::vector<uint32_t>> pos0;
+   pos0[Nucleotide::Symbol::A] = {0, 70000};
+   pos0[Nucleotide::Symbol::C] = {1};
+   index.addSymbolsToPositions(0, pos0);
+
+   SymbolMap<Nucleotide, std::vector<uint32_t>> pos3;
+   pos3[Nucleotide::Symbol::G] = {1, 70000};
+   index.addSymbolsToPositions(3, pos3);
+
+   const auto expected_a_at_0 = index.getMatchingContainersAsBitmap(0, {Nucleotide::Symbol::A});
+   const auto expected_g_at_3 = index.getMatchingContainersAsBitmap(3, {Nucleotide::Symbol::G});
+   const size_t expected_num_diffs = index.numSequenceDiffs();
+
+   index.freeze();
+
+   ASSERT_TRUE(index.isFrozen());
+   EXPECT_TRUE(index.vertical_bitmaps.empty());
+   EXPECT_EQ(index.numSequenceDiffs(), expected_num_diffs);
+   EXPECT_EQ(index.getMatchingContainersAsBitmap(0, {Nucleotide::Symbol::A}), expected_a_at_0);
+   EXPECT_EQ(index.getMatchingContainersAsBitmap(3, {Nucleotide::Symbol::G}), expected_g_at_3);
+   EXPECT_EQ(index.getMatchingContainersAsBitmap(1, {Nucleotide::Symbol::A}), roaring::Roaring{});
+   EXPECT_EQ(index.getMatchingContainersAsBitmap(100, {Nucleotide::Symbol::A}), roaring::Roaring{});
+
+   std::vector<std::string> sequences(3, "NNNN");
+   const roaring::Roaring row_ids{0, 1, 70000};
+   index.overwriteSymbolsInSequences(sequences, row_ids);
+   EXPECT_EQ(sequences[0], "ANNN");
+   EXPECT_EQ(sequences[1], "CNNG");
+   EXPECT_EQ(sequences[2], "ANNG");
+}
+
+TEST_F(VerticalSequenceIndexTest, frozenIndexIsThawedOnMutation) {
+   SymbolMap<Nucleotide, std::vector<uint32_t>> pos0;
+   pos0[Nucleotide::Symbol::A] = {0};
+   index.addSymbolsToPositions(0, pos0);
+   index.freeze();
+
+   SymbolMap<Nucleotide, std::vector<uint32_t>> more_pos0;
+   more_pos0[Nucleotide::Symbol::A] = {65536};
+   index.addSymbolsToPositions(0, more_pos0);
+
+   EXPECT_FALSE(index.isFrozen());
+   EXPECT_EQ(
+      index.getMatchingContainersAsBitmap(0, {Nucleotide::Symbol::A}), (roaring::Roaring{0, 65536})
+   );
+
+   index.freeze();
+   EXPECT_EQ(
+      index.getMatchingContainersAsBitmap(0, {Nucleotide::Symbol::A}), (roaring::Roaring{0, 65536})
+   );
+}
+
+TEST_F(VerticalSequenceIndexTest, serializationRoundTripYieldsFrozenIndex) {
+   SymbolMap<Nucleotide, std::vector<uint32_t>> pos2;
+   pos2[Nucleotide::Symbol::T] = {0, 2, 4};
+   pos2[Nucleotide::Symbol::GAP] = {1};
+   index.addSymbolsToPositions(2, pos2);
+
+   std::stringstream stream;
+   {
+      boost::archive::binary_oarchive output_archive(stream);
+      output_archive << index;
+   }
+
+   VerticalSequenceIndex<Nucleotide> restored;
+   {
+      boost::archive::binary_iarchive input_archive(stream);
+      input_archive >> restored;
+   }
+
+   EXPECT_TRUE(restored.isFrozen());
+   EXPECT_EQ(restored.numSequenceDiffs(), 2);
+   EXPECT_EQ(
+      restored.getMatchingContainersAsBitmap(2, {Nucleotide::Symbol::T}),
+      (roaring::Roaring{0, 2, 4})
+   );
+   EXPECT_EQ(
+      restored.getMatchingContainersAsBitmap(2, {Nucleotide::Symbol::GAP}), (roaring::Roaring{1})
+   );
+}
+
+TEST_F(VerticalSequenceIndexTest, segmentedSaveRewritesOnlyModifiedVIndices) {
+   constexpr uint32_t ROWS_PER_V_INDEX = 65536;
+   const std::filesystem::path directory =
+      std::filesystem::temp_directory_path() / "silo_vertical_index_segments";
+   std::filesystem::remove_all(directory);
+   std::filesystem::create_directories(directory / "1");
+   std::filesystem::create_directories(directory / "2");
+
+   SymbolMap<Nucleotide, std::vector<uint32_t>> pos3;
+   pos3[Nucleotide::Symbol::T] = {1, ROWS_PER_V_INDEX + 1};
+   pos3[Nucleotide::Symbol::GAP] = {2};
+   index.addSymbolsToPositions(3, pos3);
+
+   const auto save = [&](const VerticalSequenceIndex<Nucleotide>& to_save,
+                         const std::string& version) {
+      SegmentStore store{directory / version, "column_0." + version};
+      const SegmentStore::ActiveScope active_store{store};
+      std::stringstream stream;
+      boost::archive::binary_oarchive output_archive(stream);
+      output_archive << to_save;
+      return stream.str();
+   };
+   const auto load = [&](const std::string& saved, const std::string& version) {
+      SegmentStore store{directory / version, LoadMode::COPY};
+      const SegmentStore::ActiveScope active_store{store};
+      std::stringstream stream{saved};
+      boost::archive::binary_iarchive input_archive(stream);
+      VerticalSequenceIndex<Nucleotide> restored;
+      input_archive >> restored;
+      return restored;
+   };
+   const auto segments_in = [&](const std::string& version) {
+      std::vector<std::string> names;
+      for (const auto& file : std::filesystem::directory_iterator(directory / version)) {
+         names.push_back(file.path().filename().string());
+      }
+      std::ranges::sort(names);
+      return names;
+   };
+
+   auto restored = load(save(index, "1"), "1");
+   EXPECT_TRUE(restored.isFrozen());
+   EXPECT_EQ(
+      restored.getMatchingContainersAsBitmap(3, {Nucleotide::Symbol::T}),
+      (roaring::Roaring{1, ROWS_PER_V_INDEX + 1})
+   );
+   ASSERT_EQ(segments_in("1").size(), 1);
+
+   // Only the containers of v_index 1 change
+   SymbolMap<Nucleotide, std::vector<uint32_t>> pos5;
+   pos5[Nucleotide::Symbol::C] = {ROWS_PER_V_INDEX + 7};
+   restored.addSymbolsToPositions(5, pos5);
+   const auto saved_again = save(restored, "2");
+
+   const auto first_segment = segments_in("1").at(0);
+   const auto second_segments = segments_in("2");
+   ASSERT_EQ(second_segments.size(), 2);
+   EXPECT_EQ(second_segments.at(0), first_segment);
+   EXPECT_TRUE(std::filesystem::equivalent(
+      directory / "1" / first_segment, directory / "2" / first_segment
+   ));
+
+   auto reloaded = load(saved_again, "2");
+   EXPECT_EQ(reloaded.numSequenceDiffs(), 4);
+   EXPECT_EQ(
+      reloaded.getMatchingContainersAsBitmap(3, {Nucleotide::Symbol::T}),
+      (roaring::Roaring{1, ROWS_PER_V_INDEX + 1})
+   );
+   EXPECT_EQ(
+      reloaded.getMatchingContainersAsBitmap(3, {Nucleotide::Symbol::GAP}), (roaring::Roaring{2})
+   );
+   EXPECT_EQ(
+      reloaded.getMatchingContainersAsBitmap(5, {Nucleotide::Symbol::C}),
+      (roaring::Roaring{ROWS_PER_V_INDEX + 7})
+   );
+
+   std::filesystem::remove_all(directory);
+}
+
+TEST_F(VerticalSequenceIndexTest, chunkMajorReconstructionMatchesTheFullSweep) {
+   using ReconstructionStrategy = VerticalSequenceIndex<Nucleotide>::ReconstructionStrategy;
+   constexpr uint32_t ROWS_PER_V_INDEX = 65536;
+   for (uint32_t position = 0; position < 6; ++position) {
+      SymbolMap<Nucleotide, std::vector<uint32_t>> ids_per_symbol;
+      for (uint32_t v_index = 0; v_index < 4; ++v_index) {
+         const uint32_t v_index_start = v_index * ROWS_PER_V_INDEX;
+         ids_per_symbol[Nucleotide::Symbol::A].push_back(v_index_start + position);
+         ids_per_symbol[position % 2 == 0 ? Nucleotide::Symbol::G : Nucleotide::Symbol::T]
+            .push_back(v_index_start + 10 + v_index);
+      }
+      index.addSymbolsToPositions(position, ids_per_symbol);
+   }
+   index.freeze();
+
+   const std::vector<roaring::Roaring> row_id_sets{
+      roaring::Roaring{3},
+      roaring::Roaring{(2 * ROWS_PER_V_INDEX) + 12},
+      roaring::Roaring{0, 1, 11, ROWS_PER_V_INDEX + 4, (3 * ROWS_PER_V_INDEX) + 13},
+      roaring::Roaring{70000}
+   };
+   for (const auto& row_ids : row_id_sets) {
+      std::vector<std::vector<std::string>> results;
+      for (const auto strategy :
+           {ReconstructionStrategy::FULL_SWEEP,
+            ReconstructionStrategy::CHUNK_MAJOR,
+            ReconstructionStrategy::AUTOMATIC}) {
+         std::vector<std::string> sequences(row_ids.cardinality(), "NNNNNN");
+         index.overwriteSymbolsInSequences(sequences, row_ids, strategy);
+         results.push_back(std::move(sequences));
+      }
+      EXPECT_EQ(results.at(0), results.at(1));
+      EXPECT_EQ(results.at(0), results.at(2));
+   }
+
+   std::vector<std::string> sequences(2, "NNNNNN");
+   const roaring::Roaring row_ids{ROWS_PER_V_INDEX + 1, ROWS_PER_V_INDEX + 11};
+   index.overwriteSymbolsInSequences(sequences, row_ids, ReconstructionStrategy::CHUNK_MAJOR);
+   EXPECT_EQ(sequences.at(0), "NANNNN");
+   EXPECT_EQ(sequences.at(1), "GTGTGT");
+}
+
 using rhydb::storage::column::splitIdsIntoBatches;
 
 TEST(splitIdsIntoBatches, EmptyVector) {
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/optional.hpp>
+#include <boost/serialization/string.hpp>
+#include <roaring/roaring.hh>
+
+#include "rhydb/storage/column/row_id.h"
+
+namespace rhydb::storage::column {
+
+/// Statistics about the values of one chunk of a column: the bounds of its non-null values, its
+/// number of nulls and whether its values are sorted. Filters use them to skip chunks that cannot
+/// contain a match, to match all rows of a chunk without looking at its values, and to find the
+/// matching rows of a sorted chunk by binary search.
+template <typename T>
+struct ZoneMap {
+   /// Bounds of the non-null values, unset if the chunk has none. Updates only widen the bounds, so
+   /// they may be wider than the values that are currently in the chunk.
+   std::optional<T> min;
+   std::optional<T> max;
+   /// Whether the chunk contains a NaN. The bounds are not kept then, because NaN does not compare
+   /// to any value.
+   bool has_unordered_values = false;
+   uint32_t null_count = 0;
+   uint32_t row_count = 0;
+   /// Whether the non-null values of the chunk are in ascending order. Only kept for arithmetic
+   /// values, whose columns store them with `storedValuesOf`, so that then all stored values of the
+   /// chunk are in ascending order. Updates clear it.
+   bool is_sorted = false;
+
+   static ZoneMap of(const std::vector<std::optional<T>>& buffer) {
+      ZoneMap zone_map;
+      zone_map.row_count = static_cast<uint32_t>(buffer.size());
+      zone_map.is_sorted = std::is_arithmetic_v<T>;
+      const T* previous_value = nullptr;
+      for (const auto& value : buffer) {
+         if (value.has_value()) {
+            zone_map.include(*value);
+            if constexpr (std::is_arithmetic_v<T>) {
+               if (previous_value != nullptr && *value < *previous_value) {
+                  zone_map.is_sorted = false;
+               }
+               previous_value = &*value;
+            }
+         } else {
+            ++zone_map.null_count;
+         }
+      }
+      // NaN does not compare to any value, a chunk that contains one cannot be searched
+      zone_map.is_sorted = zone_map.is_sorted && !zone_map.has_unordered_values;
+      return zone_map;
+   }
+
+   /// Whether every non-null value of the chunk lies within `[*min, *max]`
+   [[nodiscard]] bool hasBounds() const { return min.has_value() && !has_unordered_values; }
+
+   [[nodiscard]] bool allNull() const { return null_count == row_count; }
+
+   /// Widens the bounds to include `value`
+   void include(const T& value) {
+      if constexpr (std::is_floating_point_v<T>) {
+         if (std::isnan(value)) {
+            has_unordered_values = true;
+            min.reset();
+            max.reset();
+         }
+      }
+      if (has_unordered_values) {
+         return;
+      }
+      if (!min.has_value() || value < *min) {
+         min = value;
+      }
+      if (!max.has_value() || *max < value) {
+         max = value;
+      }
+   }
+
+   template <class Archive>
+   [[maybe_unused]] void serialize(Archive& archive, const uint32_t /*version*/) {
+      // clang-format off
+      archive & min;
+      archive & max;
+      archive & has_unordered_values;
+      archive & null_count;
+      archive & row_count;
+      archive & is_sorted;
+      // clang-format on
+   }
+};
+
+/// The values of a chunk as a column of arithmetic values stores them. A null row repeats the
+/// closest preceding non-null value, leading nulls the first one, so that the stored values are in
+/// ascending order iff the non-null values are (see `ZoneMap::is_sorted`). The stored values of
+/// null rows are never read, the null bitmap of the column decides for them.
+template <typename T>
+   requires std::is_arithmetic_v<T>
+std::vector<T> storedValuesOf(const std::vector<std::optional<T>>& buffer) {
+   std::vector<T> chunk;
+   chunk.reserve(buffer.size());
+   const auto first_value = std::ranges::find_if(buffer, [](const std::optional<T>& value) {
+      return value.has_value();
+   });
+   T null_value = first_value == buffer.end() ? T{} : **first_value;
+   for (const auto& value : buffer) {
+      if (value.has_value()) {
+         null_value = *value;
+      }
+      chunk.push_back(null_value);
+   }
+   return chunk;
+}
+
+/// Adapts the zone maps of a column to an update that assigned `value` to the rows `row_ids`.
+/// `null_bitmap` is the null bitmap of the column after the update.
+template <typename T>
+void updateZoneMaps(
+   std::vector<ZoneMap<T>>& zone_maps,
+   const roaring::Roaring& row_ids,
+   const std::optional<T>& value,
+   const roaring::Roaring& null_bitmap
+) {
+   std::optional<uint16_t> previous_chunk_id;
+   for (const uint32_t global_row_id : row_ids) {
+      const uint16_t chunk_id = RowId::fromGlobal(global_row_id).chunk_id;
+      if (chunk_id == previous_chunk_id) {
+         continue;
+      }
+      previous_chunk_id = chunk_id;
+      auto& zone_map = zone_maps.at(chunk_id);
+      // The value can be placed anywhere in the order of the chunk
+      zone_map.is_sorted = false;
+      if (value.has_value()) {
+         zone_map.include(*value);
+      }
+      const uint32_t chunk_start = RowId::chunkStart(chunk_id);
+      const uint64_t nulls_before_chunk = chunk_start == 0 ? 0 : null_bitmap.rank(chunk_start - 1);
+      const uint64_t nulls_up_to_chunk_end = null_bitmap.rank(chunk_start + zone_map.row_count - 1);
+      zone_map.null_count = static_cast<uint32_t>(nulls_up_to_chunk_end - nulls_before_chunk);
+   }
+}
+
+}  // namespace rhydb::storage::column
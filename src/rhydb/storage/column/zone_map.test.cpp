@@ -0,0 +1,88 @@
+#include "rhydb/storage/column/zone_map.h"
+
+#include <cmath>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <roaring/roaring.hh>
+
+#include "rhydb/storage/column/column_metadata.h"
+#include "rhydb/storage/column/int_column.h"
+#include "rhydb/storage/column/row_id.h"
+
+using rhydb::storage::column::ColumnMetadata;
+using rhydb::storage::column::Int32Column;
+using rhydb::storage::column::RowId;
+using rhydb::storage::column::storedValuesOf;
+using rhydb::storage::column::ZoneMap;
+
+TEST(ZoneMap, boundsTheNonNullValuesAndCountsTheNulls) {
+   const auto zone_map =
+      ZoneMap<int32_t>::of({std::optional<int32_t>{4}, std::nullopt, -2, 7, std::nullopt});
+   ASSERT_TRUE(zone_map.hasBounds());
+   EXPECT_EQ(zone_map.min, -2);
+   EXPECT_EQ(zone_map.max, 7);
+   EXPECT_EQ(zone_map.null_count, 2);
+   EXPECT_EQ(zone_map.row_count, 5);
+   EXPECT_FALSE(zone_map.allNull());
+}
+
+TEST(ZoneMap, hasNoBoundsIfAllValuesAreNull) {
+   const auto zone_map = ZoneMap<std::string>::of({std::nullopt, std::nullopt});
+   EXPECT_FALSE(zone_map.hasBounds());
+   EXPECT_TRUE(zone_map.allNull());
+}
+
+TEST(ZoneMap, hasNoBoundsIfAChunkContainsNaN) {
+   auto zone_map = ZoneMap<double>::of({std::optional<double>{1.0}, std::nan(""), 3.0});
+   EXPECT_FALSE(zone_map.hasBounds());
+   zone_map.include(5.0);
+   EXPECT_FALSE(zone_map.hasBounds());
+}
+
+TEST(ZoneMap, tellsWhetherTheNonNullValuesAreSorted) {
+   const std::vector<std::optional<int32_t>> sorted{std::nullopt, -2, 4, std::nullopt, 4, 7};
+   EXPECT_TRUE(ZoneMap<int32_t>::of(sorted).is_sorted);
+   EXPECT_FALSE(ZoneMap<int32_t>::of({std::optional<int32_t>{4}, std::nullopt, -2}).is_sorted);
+   EXPECT_FALSE(ZoneMap<double>::of({std::optional<double>{1.0}, std::nan(""), 3.0}).is_sorted);
+   EXPECT_FALSE(ZoneMap<std::string>::of({std::optional<std::string>{"a"}, "b"}).is_sorted);
+
+   // Null rows are stored with a neighbouring value, so that the stored values stay sorted
+   EXPECT_EQ(storedValuesOf(sorted), (std::vector<int32_t>{-2, -2, 4, 4, 4, 7}));
+}
+
+TEST(ZoneMap, isWidenedByUpdatesAndRecountsTheNulls) {
+   ColumnMetadata metadata("int_column");
+   Int32Column column{&metadata};
+   for (const int32_t offset : {0, 100}) {
+      Int32Column::Builder builder;
+      builder.insert(offset + 1);
+      builder.insertNull();
+      builder.insert(offset + 3);
+      ASSERT_TRUE(column.appendChunk(builder.finalize()).has_value());
+   }
+
+   roaring::Roaring second_chunk_rows;
+   second_chunk_rows.add(RowId(1, 0).toGlobal());
+   second_chunk_rows.add(RowId(1, 1).toGlobal());
+   column.update(second_chunk_rows, 500);
+
+   const auto& zone_maps = column.getZoneMaps();
+   ASSERT_EQ(zone_maps.size(), 2);
+   EXPECT_EQ(zone_maps.at(0).min, 1);
+   EXPECT_EQ(zone_maps.at(0).max, 3);
+   EXPECT_EQ(zone_maps.at(0).null_count, 1);
+   EXPECT_EQ(zone_maps.at(1).min, 101);
+   EXPECT_EQ(zone_maps.at(1).max, 500);
+   EXPECT_EQ(zone_maps.at(1).null_count, 0);
+   EXPECT_TRUE(zone_maps.at(0).is_sorted);
+   EXPECT_FALSE(zone_maps.at(1).is_sorted);
+
+   roaring::Roaring first_row;
+   first_row.add(RowId(0, 0).toGlobal());
+   column.update(first_row, std::nullopt);
+   EXPECT_EQ(column.getZoneMaps().at(0).null_count, 2);
+   EXPECT_EQ(column.getZoneMaps().at(0).row_count, 3);
+}
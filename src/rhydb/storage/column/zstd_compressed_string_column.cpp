@@ -1,5 +1,11 @@
 #include "rhydb/storage/column/zstd_compressed_string_column.h"
 
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "rhydb/common/panic.h"
 #include "rhydb/storage/column/row_id.h"
 
 namespace rhydb::storage::column {
@@ -19,19 +25,24 @@ ZstdCompressedStringColumn::ZstdCompressedStringColumn(
     : metadata(metadata) {}
 
 std::expected<void, std::string> ZstdCompressedStringColumn::appendChunk(const Buffer& buffer) {
-   const uint32_t base = RowId::chunkStart(static_cast<uint16_t>(values.numChunks()));
-   std::vector<std::string> chunk;
-   chunk.reserve(buffer.size());
+   const uint32_t base = RowId::chunkStart(static_cast<uint16_t>(value_ends.numChunks()));
+   std::vector<char> arena;
+   std::vector<uint64_t> ends;
+   ends.reserve(buffer.size());
    for (size_t i = 0; i < buffer.size(); ++i) {
       const auto& value = buffer[i];
       if (value.has_value()) {
-         chunk.emplace_back(metadata->compressor.compress(value->data(), value->size()));
+         const std::string_view compressed =
+            metadata->compressor.compress(value->data(), value->size());
+         arena.insert(arena.end(), compressed.begin(), compressed.end());
       } else {
          null_bitmap.add(base + static_cast<uint32_t>(i));
-         chunk.emplace_back();
       }
+      ends.push_back(arena.size());
    }
-   values.appendChunk(std::move(chunk));
+   arena.shrink_to_fit();
+   compressed_bytes.appendChunk(std::move(arena));
+   value_ends.appendChunk(std::move(ends));
    return {};
 }
 
@@ -39,7 +50,7 @@ void ZstdCompressedStringColumn::update(
    const roaring::Roaring& row_ids,
    const std::optional<std::string>& value
 ) {
-   // An empty stored buffer denotes null (see `appendChunk`/`getDecompressed`); a concrete value is
+   // An empty stored value denotes null (see `appendChunk`/`getDecompressed`); a concrete value is
    // compressed once and the same bytes are written to every matched row.
    std::string stored_value;
    if (value.has_value()) {
@@ -48,27 +59,75 @@ void ZstdCompressedStringColumn::update(
    } else {
       null_bitmap |= row_ids;
    }
+   // The values of a chunk are stored back to back, so every touched chunk is rebuilt once
+   std::vector<uint16_t> rows_in_chunk;
+   std::optional<uint16_t> chunk_id;
    for (const uint32_t global_row_id : row_ids) {
-      values.setValue(RowId::fromGlobal(global_row_id), stored_value);
+      const RowId row_id = RowId::fromGlobal(global_row_id);
+      if (chunk_id.has_value() && row_id.chunk_id != chunk_id) {
+         overwriteRowsOfChunk(chunk_id.value(), rows_in_chunk, stored_value);
+         rows_in_chunk.clear();
+      }
+      chunk_id = row_id.chunk_id;
+      rows_in_chunk.push_back(row_id.row_in_chunk);
+   }
+   if (chunk_id.has_value()) {
+      overwriteRowsOfChunk(chunk_id.value(), rows_in_chunk, stored_value);
    }
 }
 
+void ZstdCompressedStringColumn::overwriteRowsOfChunk(
+   uint16_t chunk_id,
+   const std::vector<uint16_t>& rows_in_chunk,
+   std::string_view stored_value
+) {
+   const uint32_t chunk_size = value_ends.chunkSize(chunk_id);
+   std::vector<char> arena;
+   std::vector<uint64_t> ends;
+   ends.reserve(chunk_size);
+   auto next_overwritten_row = rows_in_chunk.begin();
+   for (uint32_t row_in_chunk = 0; row_in_chunk < chunk_size; ++row_in_chunk) {
+      std::string_view row_value;
+      if (next_overwritten_row != rows_in_chunk.end() && *next_overwritten_row == row_in_chunk) {
+         row_value = stored_value;
+         ++next_overwritten_row;
+      } else {
+         row_value = compressedValue(
+            RowId{.chunk_id = chunk_id, .row_in_chunk = static_cast<uint16_t>(row_in_chunk)}
+         );
+      }
+      arena.insert(arena.end(), row_value.begin(), row_value.end());
+      ends.push_back(arena.size());
+   }
+   arena.shrink_to_fit();
+   compressed_bytes.replaceChunk(chunk_id, std::move(arena));
+   value_ends.replaceChunk(chunk_id, std::move(ends));
+}
+
 bool ZstdCompressedStringColumn::isNull(RowId row_id) const {
    return null_bitmap.contains(row_id.toGlobal());
 }
 
+std::string_view ZstdCompressedStringColumn::compressedValue(RowId row_id) const {
+   const auto ends = value_ends.chunk(row_id.chunk_id);
+   SILO_ASSERT_LT(row_id.row_in_chunk, ends.size());
+   const uint64_t begin = row_id.row_in_chunk == 0 ? 0 : ends[row_id.row_in_chunk - 1];
+   const uint64_t end = ends[row_id.row_in_chunk];
+   return std::string_view{compressed_bytes.chunk(row_id.chunk_id).data() + begin, end - begin};
+}
+
 std::optional<std::string> ZstdCompressedStringColumn::getDecompressed(RowId row_id) const {
-   const auto value = values.at(row_id);
+   const std::string_view value = compressedValue(row_id);
    if (value.empty()) {
       return std::nullopt;
    }
    std::string result_buffer;
-   metadata->decompressor.decompress(value, result_buffer);
+   metadata->decompressor.decompress(value.data(), value.size(), result_buffer);
    return result_buffer;
 }
 
-std::optional<std::string> ZstdCompressedStringColumn::getCompressed(RowId row_id) const {
-   auto value = values.at(row_id);
+std::optional<std::string_view> ZstdCompressedStringColumn::getCompressed(RowId row_id) const {
+   const std::string_view value = compressedValue(row_id);
    if (value.empty()) {
       return std::nullopt;
    }
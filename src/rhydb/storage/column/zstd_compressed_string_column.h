@@ -4,6 +4,7 @@
 #include <expected>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <boost/serialization/access.hpp>
@@ -46,7 +47,11 @@ class ZstdCompressedStringColumn {
    using value_type = std::string_view;
 
   private:
-   ChunkedValueBuffer<std::string> values;
+   /// The compressed values of each chunk, concatenated into one arena per chunk
+   ChunkedValueBuffer<char> compressed_bytes;
+   /// For every row, the end of its compressed value in the arena of its chunk. A value starts
+   /// where the value of the previous row ends, null rows have an empty value.
+   ChunkedValueBuffer<uint64_t> value_ends;
 
   public:
    roaring::Roaring null_bitmap;
@@ -60,20 +65,33 @@ class ZstdCompressedStringColumn {
 
    [[nodiscard]] bool isNull(RowId row_id) const;
 
-   [[nodiscard]] size_t numChunks() const { return values.numChunks(); }
+   [[nodiscard]] size_t numChunks() const { return value_ends.numChunks(); }
 
-   [[nodiscard]] uint32_t chunkSize(uint16_t chunk_id) const { return values.chunkSize(chunk_id); }
+   [[nodiscard]] uint32_t chunkSize(uint16_t chunk_id) const {
+      return value_ends.chunkSize(chunk_id);
+   }
 
    [[nodiscard]] std::optional<std::string> getDecompressed(RowId row_id) const;
 
-   [[nodiscard]] std::optional<std::string> getCompressed(RowId row_id) const;
+   /// The compressed value, a view into the arena of its chunk
+   [[nodiscard]] std::optional<std::string_view> getCompressed(RowId row_id) const;
 
   private:
+   [[nodiscard]] std::string_view compressedValue(RowId row_id) const;
+
+   /// Rebuilds the arena of chunk `chunk_id` with `stored_value` in the rows `rows_in_chunk`
+   void overwriteRowsOfChunk(
+      uint16_t chunk_id,
+      const std::vector<uint16_t>& rows_in_chunk,
+      std::string_view stored_value
+   );
+
    friend class boost::serialization::access;
    template <class Archive>
    [[maybe_unused]] void serialize(Archive& archive, const uint32_t /*version*/) {
       // clang-format off
-      archive & values;
+      archive & compressed_bytes;
+      archive & value_ends;
       archive & null_bitmap;
       // clang-format on
    }
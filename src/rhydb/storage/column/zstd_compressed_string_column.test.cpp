@@ -1,10 +1,14 @@
 #include "rhydb/storage/column/zstd_compressed_string_column.h"
 
 #include <optional>
+#include <sstream>
 
 #include <gtest/gtest.h>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <roaring/roaring.hh>
 
+#include "rhydb/roaring_util/roaring_serialize.h"
 #include "rhydb/storage/column/row_id.h"
 
 using rhydb::storage::column::RowId;
@@ -118,3 +122,33 @@ TEST(ZstdCompressedStringColumn, valuesSpanningMultipleAppendedChunks) {
       }
    }
 }
+
+TEST(ZstdCompressedStringColumn, serializedArenasRoundTrip) {
+   rhydb::storage::column::ZstdCompressedStringColumnMetadata column_metadata{
+      "test_column", "ACGT"
+   };
+   rhydb::storage::column::ZstdCompressedStringColumn column(&column_metadata);
+   appendChunk(column, {"ACGTACGT", std::nullopt, "", "TTTT"});
+   appendChunk(column, {std::nullopt, "GATTACA"});
+   roaring::Roaring updated_rows;
+   updated_rows.add(RowId(0, 3).toGlobal());
+   column.update(updated_rows, "CCCC");
+
+   std::ostringstream oss;
+   boost::archive::binary_oarchive oarchive(oss);
+   oarchive << column;
+   rhydb::storage::column::ZstdCompressedStringColumn under_test(&column_metadata);
+   std::istringstream iss(oss.str());
+   boost::archive::binary_iarchive iarchive(iss);
+   iarchive >> under_test;
+
+   ASSERT_EQ(under_test.numChunks(), 2);
+   EXPECT_EQ(under_test.chunkSize(0), 4);
+   EXPECT_EQ(under_test.chunkSize(1), 2);
+   EXPECT_EQ(under_test.getDecompressed(RowId(0, 0)), "ACGTACGT");
+   EXPECT_EQ(under_test.getCompressed(RowId(0, 1)), std::nullopt);
+   EXPECT_EQ(under_test.getDecompressed(RowId(0, 3)), "CCCC");
+   EXPECT_EQ(under_test.getCompressed(RowId(1, 0)), std::nullopt);
+   EXPECT_EQ(under_test.getDecompressed(RowId(1, 1)), "GATTACA");
+   EXPECT_EQ(under_test.getCompressed(RowId(1, 1)), column.getCompressed(RowId(1, 1)));
+}
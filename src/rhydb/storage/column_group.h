@@ -5,8 +5,6 @@
 #include <string>
 #include <vector>
 
-#include <boost/serialization/access.hpp>
-
 #include "rhydb/common/aa_symbols.h"
 #include "rhydb/common/nucleotide_symbols.h"
 #include "rhydb/schema/database_schema.h"
@@ -21,45 +19,9 @@
 
 namespace rhydb::storage {
 
+/// All columns of a table. Tables persist every column to a file of its own (see `Table::saveData`),
+/// so the group itself is not serializable.
 class ColumnGroup {
-   friend class boost::serialization::access;
-
-   template <class Archive>
-   [[maybe_unused]] void serialize(Archive& archive, const uint32_t /*version*/) {
-      // clang-format off
-      for(auto& [name, store] : string_columns){
-         archive & store;
-      }
-      for(auto& [name, store] : dictionary_encoded_columns){
-         archive & store;
-      }
-      for(auto& [name, store] : bool_columns){
-         archive & store;
-      }
-      for(auto& [name, store] : int32_columns){
-         archive & store;
-      }
-      for(auto& [name, store] : float_columns){
-         archive & store;
-      }
-      for(auto& [name, store] : date32_columns){
-         archive & store;
-      }
-      for(auto& [name, store] : int64_columns){
-         archive & store;
-      }
-      for(auto& [name, store] : nuc_columns){
-         archive & store;
-      }
-      for(auto& [name, store] : aa_columns){
-         archive & store;
-      }
-      for(auto& [name, store] : zstd_compressed_string_columns){
-         archive & store;
-      }
-      // clang-format on
-   }
-
   public:
    std::vector<rhydb::schema::ColumnIdentifier> metadata;
 
@@ -1,9 +1,16 @@
 #include "rhydb/storage/table.h"
 
+#include <atomic>
+#include <chrono>
 #include <fstream>
-#include <unordered_set>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <set>
 #include <utility>
 
+#include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
@@ -17,12 +24,17 @@
 #include <boost/serialization/vector.hpp>
 
 #include "evobench/evobench.hpp"
+#include "rhydb/common/date32.h"
+#include "rhydb/common/parallel.h"
+#include "rhydb/persistence/checksummed_file.h"
 #include "rhydb/persistence/exception.h"
+#include "rhydb/persistence/segment_store.h"
 #include "rhydb/preprocessing/preprocessing_exception.h"
 #include "rhydb/roaring_util/roaring_serialize.h"
 #include "rhydb/schema/duplicate_primary_key_exception.h"
 #include "rhydb/storage/column/column_type_visitor.h"
 #include "rhydb/storage/column_group_builder.h"
+#include "rhydb/storage/table_manifest.h"
 
 namespace rhydb::storage {
 
@@ -30,23 +42,40 @@ using schema::ColumnIdentifier;
 using schema::TableSchema;
 
 namespace {
-class BulkInsertVisitor {
+using ChunkAppend = std::function<std::expected<void, std::string>()>;
+
+// Finalizes the buffered chunk of one column and validates it against the column without changing
+// the column. On success, returns the step that appends the validated chunk.
+class PrepareChunkAppendVisitor {
   public:
    template <column::Column ColumnType>
-   std::expected<void, std::string> operator()(
+   std::expected<ChunkAppend, std::string> operator()(
       ColumnGroup& columns,
       ColumnGroupBuilder& block,
       const std::string& name
    ) {
-      return columns.getColumns<ColumnType>().at(name).appendChunk(
+      auto& column = columns.getColumns<ColumnType>().at(name);
+      auto buffer = std::make_shared<typename ColumnType::Buffer>(
          block.getColumnBuilders<ColumnType>().at(name).finalize()
       );
+      if constexpr (requires { column.validateChunk(*buffer); }) {
+         if (auto result = column.validateChunk(*buffer); !result.has_value()) {
+            return std::unexpected(std::move(result.error()));
+         }
+      }
+      return ChunkAppend{[&column, buffer]() { return column.appendChunk(*buffer); }};
    }
 };
+
+uint64_t nextContentVersion() {
+   static std::atomic<uint64_t> next_content_version = 0;
+   return next_content_version.fetch_add(1, std::memory_order_relaxed);
+}
 }  // namespace
 
 Table::Table(schema::TableName table_name, std::shared_ptr<schema::TableSchema> schema)
-    : table_name(std::move(table_name)),
+    : content_version(nextContentVersion()),
+      table_name(std::move(table_name)),
       schema(std::move(schema)) {
    auto column_initializer = []<column::Column ColumnType>(
                                 ColumnGroup& column_group,
@@ -60,12 +89,66 @@ Table::Table(schema::TableName table_name, std::shared_ptr<schema::TableSchema>
    for (const auto& col : this->schema->getColumnIdentifiers()) {
       column::visit(col.type, column_initializer, columns, col, *this->schema);
    }
+   const auto& primary_key = this->schema->primary_key;
+   if (primary_key.type == schema::ColumnType::STRING) {
+      columns.string_columns.at(primary_key.name).enablePrimaryKeyIndex();
+   }
 }
 
 nlohmann::json Table::logTable() const {
    return {{"name", table_name.getName()}, {"primaryKey", schema->primary_key.name}};
 }
 
+namespace {
+
+template <typename T, typename FormatValue>
+nlohmann::json zoneMapsToJson(
+   const std::vector<column::ZoneMap<T>>& zone_maps,
+   const FormatValue& format_value
+) {
+   nlohmann::json result = nlohmann::json::array();
+   for (const auto& zone_map : zone_maps) {
+      nlohmann::json chunk = {
+         {"min", nullptr},
+         {"max", nullptr},
+         {"nullCount", zone_map.null_count},
+         {"rowCount", zone_map.row_count}
+      };
+      if (zone_map.hasBounds()) {
+         chunk["min"] = format_value(*zone_map.min);
+         chunk["max"] = format_value(*zone_map.max);
+      }
+      result.push_back(std::move(chunk));
+   }
+   return result;
+}
+
+template <typename Columns, typename FormatValue>
+void addChunkStatistics(
+   nlohmann::json& statistics,
+   const Columns& columns,
+   const FormatValue& format_value
+) {
+   for (const auto& [column_name, column] : columns) {
+      statistics[column_name] = zoneMapsToJson(column.getZoneMaps(), format_value);
+   }
+}
+
+}  // namespace
+
+nlohmann::json Table::getChunkStatistics() const {
+   const auto identity = [](const auto& value) { return value; };
+   nlohmann::json statistics = nlohmann::json::object();
+   addChunkStatistics(statistics, columns.int32_columns, identity);
+   addChunkStatistics(statistics, columns.int64_columns, identity);
+   addChunkStatistics(statistics, columns.float_columns, identity);
+   addChunkStatistics(statistics, columns.date32_columns, [](common::Date32 date) {
+      return common::date32ToString(date);
+   });
+   addChunkStatistics(statistics, columns.string_columns, identity);
+   return statistics;
+}
+
 void Table::validate() const {
    validateNucleotideSequences();
    validateAminoAcidSequences();
@@ -73,10 +156,34 @@ void Table::validate() const {
 }
 
 std::expected<void, std::string> Table::bulkInsert(ColumnGroupBuilder& block) {
-   row_layout.appendChunk(static_cast<uint32_t>(block.numBufferedRows()));
-   sequence_count += block.numBufferedRows();
-   for (const auto& column : columns.metadata) {
-      auto result = column::visit(column.type, BulkInsertVisitor{}, columns, block, column.name);
+   if (isMemoryMapped()) {
+      return std::unexpected(fmt::format(
+         "The table '{}' was loaded memory-mapped and is read-only", table_name.getName()
+      ));
+   }
+   const size_t num_rows = block.numBufferedRows();
+   // The columns do not share any state, so that the chunk is applied to them in parallel. Every
+   // column validates its part of the chunk before any column is changed, so that a rejected chunk
+   // leaves all columns with the same number of rows.
+   std::vector<std::expected<ChunkAppend, std::string>> appends(columns.metadata.size());
+   common::forEachIndex(columns.metadata.size(), [&](size_t column_idx) {
+      const auto& column = columns.metadata.at(column_idx);
+      appends.at(column_idx) =
+         column::visit(column.type, PrepareChunkAppendVisitor{}, columns, block, column.name);
+   });
+   for (auto& append : appends) {
+      if (!append.has_value()) {
+         return std::unexpected(std::move(append.error()));
+      }
+   }
+   markModified();
+   row_layout.appendChunk(static_cast<uint32_t>(num_rows));
+   sequence_count += num_rows;
+   std::vector<std::expected<void, std::string>> results(appends.size());
+   common::forEachIndex(appends.size(), [&](size_t column_idx) {
+      results.at(column_idx) = appends.at(column_idx).value()();
+   });
+   for (auto& result : results) {
       if (!result.has_value()) {
          return result;
       }
@@ -84,13 +191,21 @@ std::expected<void, std::string> Table::bulkInsert(ColumnGroupBuilder& block) {
    return {};
 }
 
+void Table::markModified() {
+   content_version = nextContentVersion();
+}
+
 void Table::finalize() {
-   for (auto& [_, sequence_column] : columns.nuc_columns) {
-      sequence_column.finalize();
+   EVOBENCH_SCOPE("Table", "finalize");
+   markModified();
+   std::vector<column::SequenceColumnFinalization> finalizations;
+   for (auto& [name, sequence_column] : columns.nuc_columns) {
+      finalizations.push_back({.column_name = name, .phases = sequence_column.finalizePhases()});
    }
-   for (auto& [_, sequence_column] : columns.aa_columns) {
-      sequence_column.finalize();
+   for (auto& [name, sequence_column] : columns.aa_columns) {
+      finalizations.push_back({.column_name = name, .phases = sequence_column.finalizePhases()});
    }
+   column::finalizeSequenceColumns(std::move(finalizations));
 }
 
 void Table::validatePrimaryKeyUnique() const {
@@ -98,18 +213,19 @@ void Table::validatePrimaryKeyUnique() const {
    const auto primary_key = schema->primary_key;
    SILO_ASSERT(primary_key.type == schema::ColumnType::STRING);
 
+   // The primary key index records duplicates while the rows are inserted
    const auto& primary_key_column = columns.string_columns.at(primary_key.name);
-
-   std::unordered_set<std::string> unique_keys;
-   unique_keys.reserve(row_layout.numRows());
-   for (const column::RowId row_id : row_layout) {
-      std::string value = primary_key_column.getValueString(row_id);
-      if (unique_keys.contains(value)) {
-         throw schema::DuplicatePrimaryKeyException("Found duplicate primary key {}", value);
-      }
-      unique_keys.insert(value);
+   if (const auto duplicate = primary_key_column.firstDuplicatePrimaryKey()) {
+      throw schema::DuplicatePrimaryKeyException(
+         "Found duplicate primary key {}", primary_key_column.getValueString(duplicate.value())
+      );
+   }
+   // Null keys are not indexed, they all share the empty value
+   const uint64_t null_count = primary_key_column.null_bitmap.cardinality();
+   if (null_count > 1 ||
+       (null_count == 1 && !primary_key_column.lookupPrimaryKey("").isEmpty())) {
+      throw schema::DuplicatePrimaryKeyException("Found duplicate primary key {}", "");
    }
-   SPDLOG_DEBUG("Found {} distinct primary keys.", unique_keys.size());
 }
 
 void Table::validateNucleotideSequences() const {
@@ -207,30 +323,223 @@ std::ofstream openOutputFileOrThrow(const std::string& path) {
    return file;
 }
 
+std::filesystem::path columnDirectory(const std::filesystem::path& manifest_path) {
+   return manifest_path.parent_path() / manifest_path.stem();
+}
+
+/// Chunks of the column go into segment files named `<segment_prefix>.<n>.silo` next to the column
+/// file, chunks that were loaded and not modified since reuse their existing segment
+class SaveColumnVisitor {
+  public:
+   template <column::Column ColumnType>
+   persistence::FileFingerprint operator()(
+      const ColumnGroup& columns,
+      const std::string& name,
+      const std::filesystem::path& path,
+      const std::string& segment_prefix
+   ) {
+      persistence::SegmentStore segment_store{path.parent_path(), segment_prefix};
+      persistence::ChecksummingFileWriter writer{path};
+      {
+         const persistence::SegmentStore::ActiveScope active_store{segment_store};
+         const persistence::ChecksummingFileWriter::ActiveScope active_writer{writer};
+         ::boost::archive::binary_oarchive output_archive(writer);
+         output_archive << columns.getColumns<ColumnType>().at(name);
+      }
+      return writer.finish();
+   }
+};
+
+struct LoadedColumnFile {
+   /// The mappings of the column file and its segments if the load mode is
+   /// `LoadMode::MEMORY_MAPPED`
+   std::vector<std::shared_ptr<const persistence::MappedFile>> mappings;
+   uint64_t segment_bytes = 0;
+};
+
+class LoadColumnVisitor {
+  public:
+   template <column::Column ColumnType>
+   LoadedColumnFile operator()(
+      ColumnGroup& columns,
+      const ColumnFileEntry& entry,
+      const std::filesystem::path& path,
+      persistence::LoadMode load_mode
+   ) {
+      auto column = columns.getColumns<ColumnType>().find(entry.column.name);
+      if (column == columns.getColumns<ColumnType>().end()) {
+         throw persistence::LoadDatabaseException(fmt::format(
+            "Column file {} contains the column '{}', which is not part of the table schema",
+            path.string(),
+            entry.column.name
+         ));
+      }
+      persistence::SegmentStore segment_store{path.parent_path(), load_mode};
+      const persistence::SegmentStore::ActiveScope active_store{segment_store};
+      LoadedColumnFile loaded;
+      if (load_mode == persistence::LoadMode::MEMORY_MAPPED) {
+         loaded.mappings.push_back(loadMapped(column->second, entry, path));
+      } else {
+         loadCopied(column->second, entry, path);
+      }
+      std::ranges::move(segment_store.takeMappedSegments(), std::back_inserter(loaded.mappings));
+      loaded.segment_bytes = segment_store.getBytesLoaded();
+      return loaded;
+   }
+
+  private:
+   template <column::Column ColumnType>
+   static void loadCopied(
+      ColumnType& column,
+      const ColumnFileEntry& entry,
+      const std::filesystem::path& path
+   ) {
+      // The whole file is checked before anything is deserialized, so that corrupted blocks (e.g.
+      // frozen roaring bitmaps, which are not validated on their own) are never read
+      const auto fingerprint = persistence::fingerprintFile(path);
+      if (fingerprint != entry.fingerprint) {
+         throw persistence::LoadDatabaseException(fmt::format(
+            "Column file {} is corrupted: expected {} bytes with checksum {:08x}, found {} bytes "
+            "with checksum {:08x}",
+            path.string(),
+            entry.fingerprint.size_in_bytes,
+            entry.fingerprint.checksum,
+            fingerprint.size_in_bytes,
+            fingerprint.checksum
+         ));
+      }
+      auto file = openInputFileOrThrow(path.string());
+      ::boost::archive::binary_iarchive input_archive(file);
+      input_archive >> column;
+   }
+
+   template <column::Column ColumnType>
+   static std::shared_ptr<const persistence::MappedFile> loadMapped(
+      ColumnType& column,
+      const ColumnFileEntry& entry,
+      const std::filesystem::path& path
+   ) {
+      auto file = persistence::MappedFile::open(path);
+      // Checksumming would read every page of the file, only the size is checked
+      if (file->bytes().size() != entry.fingerprint.size_in_bytes) {
+         throw persistence::LoadDatabaseException(fmt::format(
+            "Column file {} is corrupted: expected {} bytes, found {} bytes",
+            path.string(),
+            entry.fingerprint.size_in_bytes,
+            file->bytes().size()
+         ));
+      }
+      persistence::MappedFileReader reader{file};
+      {
+         const persistence::MappedFileReader::ActiveScope active_reader{reader};
+         ::boost::archive::binary_iarchive input_archive(reader);
+         input_archive >> column;
+      }
+      return file;
+   }
+};
+
 }  // namespace
 
-void Table::saveData(const std::filesystem::path& path) {
+void Table::saveData(const std::filesystem::path& manifest_path) {
    EVOBENCH_SCOPE("Table", "saveData");
-   auto output_file = openOutputFileOrThrow(path);
-   if (!output_file) {
-      throw persistence::SaveDatabaseException(
-         "Cannot open output file " + path.string() + " for saving"
+   const auto column_directory = columnDirectory(manifest_path);
+   std::filesystem::create_directory(column_directory);
+   // The data version, which keeps the names of new segments unique across versions
+   const auto data_version = manifest_path.parent_path().filename().string();
+
+   TableManifest manifest{.sequence_count = sequence_count, .row_layout = row_layout};
+   manifest.column_files.resize(columns.metadata.size());
+
+   SPDLOG_INFO("Saving table data ({} columns)...", columns.metadata.size());
+   common::forEachIndex(columns.metadata.size(), [&](size_t column_idx) {
+      const auto& column = columns.metadata.at(column_idx);
+      auto& entry = manifest.column_files.at(column_idx);
+      entry.column = column;
+      entry.file_name = fmt::format("column_{}.silo", column_idx);
+      entry.fingerprint = column::visit(
+         column.type,
+         SaveColumnVisitor{},
+         columns,
+         column.name,
+         column_directory / entry.file_name,
+         fmt::format("column_{}.{}", column_idx, data_version)
       );
-   }
+   });
 
-   SPDLOG_INFO("Saving table data...");
+   auto output_file = openOutputFileOrThrow(manifest_path);
    ::boost::archive::binary_oarchive output_archive(output_file);
-   serializeData(output_archive, 0);
+   output_archive << manifest;
    SPDLOG_INFO("Finished saving table data");
 }
 
-void Table::loadData(const std::filesystem::path& path) {
+std::vector<ColumnLoadStatistics> Table::loadData(
+   const std::filesystem::path& manifest_path,
+   persistence::LoadMode load_mode
+) {
    EVOBENCH_SCOPE("Table", "loadData");
 
-   auto input_file = openInputFileOrThrow(path);
-   ::boost::archive::binary_iarchive input_archive(input_file);
-   serializeData(input_archive, 0);
+   TableManifest manifest;
+   {
+      auto input_file = openInputFileOrThrow(manifest_path);
+      ::boost::archive::binary_iarchive input_archive(input_file);
+      input_archive >> manifest;
+   }
+   if (manifest.column_files.size() != columns.metadata.size()) {
+      throw persistence::LoadDatabaseException(fmt::format(
+         "Table manifest {} lists {} columns, but the table schema has {}",
+         manifest_path.string(),
+         manifest.column_files.size(),
+         columns.metadata.size()
+      ));
+   }
+   // With as many entries as schema columns, this requires every schema column exactly once
+   std::set<schema::ColumnIdentifier> unlisted_columns{
+      columns.metadata.begin(), columns.metadata.end()
+   };
+   for (const auto& entry : manifest.column_files) {
+      if (unlisted_columns.erase(entry.column) == 0) {
+         throw persistence::LoadDatabaseException(fmt::format(
+            "Table manifest {} lists the column '{}' more than once or with a type that does not "
+            "match the table schema",
+            manifest_path.string(),
+            entry.column.name
+         ));
+      }
+   }
+   markModified();
+   sequence_count = manifest.sequence_count;
+   row_layout = std::move(manifest.row_layout);
+
+   const auto column_directory = columnDirectory(manifest_path);
+   std::vector<ColumnLoadStatistics> statistics(manifest.column_files.size());
+   std::vector<LoadedColumnFile> loaded_columns(manifest.column_files.size());
+   common::forEachIndex(manifest.column_files.size(), [&](size_t column_idx) {
+      const auto& entry = manifest.column_files.at(column_idx);
+      const auto start = std::chrono::steady_clock::now();
+      loaded_columns.at(column_idx) = column::visit(
+         entry.column.type,
+         LoadColumnVisitor{},
+         columns,
+         entry,
+         column_directory / entry.file_name,
+         load_mode
+      );
+      statistics.at(column_idx) = ColumnLoadStatistics{
+         .column = entry.column,
+         .size_in_bytes =
+            entry.fingerprint.size_in_bytes + loaded_columns.at(column_idx).segment_bytes,
+         .duration = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start
+         )
+      };
+   });
+   mapped_files.clear();
+   for (auto& loaded_column : loaded_columns) {
+      std::ranges::move(loaded_column.mappings, std::back_inserter(mapped_files));
+   }
    SPDLOG_INFO("Finished loading table data");
+   return statistics;
 }
 
 }  // namespace rhydb::storage
@@ -1,10 +1,16 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <expected>
 #include <filesystem>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "rhydb/persistence/load_mode.h"
+#include "rhydb/persistence/mapped_file.h"
 #include "rhydb/schema/database_schema.h"
 #include "rhydb/storage/column/row_layout.h"
 #include "rhydb/storage/column_group.h"
@@ -13,7 +19,20 @@ namespace rhydb::storage {
 
 class ColumnGroupBuilder;
 
+/// How long a column took to load, see `Table::loadData`
+struct ColumnLoadStatistics {
+   schema::ColumnIdentifier column;
+   uint64_t size_in_bytes;
+   std::chrono::microseconds duration;
+};
+
 class Table {
+   /// Files that columns were memory-mapped from, see `LoadMode::MEMORY_MAPPED`. Declared before
+   /// the columns so that the mappings outlive the bitmaps and buffers pointing into them.
+   std::vector<std::shared_ptr<const persistence::MappedFile>> mapped_files;
+
+   uint64_t content_version;
+
   public:
    schema::TableName table_name;
    std::shared_ptr<schema::TableSchema> schema;
@@ -32,29 +51,51 @@ class Table {
    Table(const Table& other) = delete;
    Table& operator=(const Table& other) = delete;
 
-   template <class Archive>
-   void serializeData(Archive& archive, [[maybe_unused]] const uint32_t version) {
-      // clang-format off
-      archive & columns;
-      archive & sequence_count;
-      archive & row_layout;
-      // clang-format on
-   }
-
    [[nodiscard]] nlohmann::json logTable() const;
 
+   /// The zone maps of the value columns: for every chunk of a column the bounds of its non-null
+   /// values (null if there are none or they are unordered) and its number of nulls and rows
+   [[nodiscard]] nlohmann::json getChunkStatistics() const;
+
    void validate() const;
 
    /// Apply a finalized ingestion chunk (one buffer per column) to the columns'
-   /// global structures. Consumes (clears) the builder's buffers.
+   /// global structures, the columns in parallel on the arrow CPU pool. Consumes (clears) the
+   /// builder's buffers.
    std::expected<void, std::string> bulkInsert(ColumnGroupBuilder& block);
 
+   /// Finalizes the sequence columns together, see `column::finalizeSequenceColumns`
    void finalize();
 
-   void loadData(const std::filesystem::path& path);
-   void saveData(const std::filesystem::path& path);
+   /// Loads the table saved by `saveData`. The columns are deserialized in parallel on the arrow
+   /// CPU pool and their files are checked against the sizes and checksums in the manifest. With
+   /// `LoadMode::MEMORY_MAPPED` only the sizes are checked, so that the files' pages are only read
+   /// once they are queried. Returns how long each column took to load.
+   std::vector<ColumnLoadStatistics> loadData(
+      const std::filesystem::path& manifest_path,
+      persistence::LoadMode load_mode = persistence::LoadMode::COPY
+   );
+
+   /// Saves every column to a file of its own in the directory `<manifest_path without
+   /// extension>/`, in parallel on the arrow CPU pool, and then writes the manifest listing the
+   /// column files with their sizes and checksums to `manifest_path`.
+   void saveData(const std::filesystem::path& manifest_path);
+
+   /// Throws `DuplicatePrimaryKeyException` for the first duplicate that the primary key index
+   /// recorded during the inserts
    void validatePrimaryKeyUnique() const;
 
+   /// Whether the columns were loaded with `LoadMode::MEMORY_MAPPED`. Such a table is read-only.
+   [[nodiscard]] bool isMemoryMapped() const { return !mapped_files.empty(); }
+
+   /// Identifies the current contents of this table. It is unique among all tables of the process
+   /// and renewed by every modification, so that results computed from the table can be cached
+   /// under it.
+   [[nodiscard]] uint64_t contentVersion() const { return content_version; }
+
+   /// Renews the content version. Has to be called after modifying the columns from outside.
+   void markModified();
+
   private:
    void validateNucleotideSequences() const;
    void validateAminoAcidSequences() const;
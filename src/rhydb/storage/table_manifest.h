@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include "rhydb/persistence/checksummed_file.h"
+#include "rhydb/schema/database_schema.h"
+#include "rhydb/storage/column/row_layout.h"
+
+namespace rhydb::storage {
+
+/// One column of a saved table, stored in a file of its own.
+struct ColumnFileEntry {
+   schema::ColumnIdentifier column;
+   /// Relative to the table's column directory
+   std::string file_name;
+   persistence::FileFingerprint fingerprint;
+
+   template <class Archive>
+   void serialize(Archive& archive, [[maybe_unused]] const uint32_t version) {
+      // clang-format off
+      archive & column;
+      archive & file_name;
+      archive & fingerprint;
+      // clang-format on
+   }
+};
+
+/// Content of a table's `<table_name>.silo` file: the data shared by all columns and an entry for
+/// every column file in the `<table_name>/` directory next to it.
+struct TableManifest {
+   uint32_t sequence_count = 0;
+   column::RowLayout row_layout;
+   std::vector<ColumnFileEntry> column_files;
+
+   template <class Archive>
+   void serialize(Archive& archive, [[maybe_unused]] const uint32_t version) {
+      // clang-format off
+      archive & sequence_count;
+      archive & row_layout;
+      archive & column_files;
+      // clang-format on
+   }
+};
+
+}  // namespace rhydb::storage
@@ -7,7 +7,7 @@
 
 namespace rhydb {
 
-ZstdCompressor::ZstdCompressor(std::shared_ptr<rhydb::ZstdCDictionary> dictionary)
+ZstdCompressor::ZstdCompressor(std::shared_ptr<const rhydb::ZstdCDictionary> dictionary)
     : dictionary(std::move(dictionary)) {}
 
 std::string_view ZstdCompressor::compress(const char* input_data, size_t input_size) {
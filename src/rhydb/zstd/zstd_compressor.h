@@ -14,13 +14,13 @@ namespace rhydb {
 
 class ZstdCompressor {
    std::string buffer;
-   std::shared_ptr<ZstdCDictionary> dictionary;
+   std::shared_ptr<const ZstdCDictionary> dictionary;
    ZstdCContext zstd_context;
 
   public:
    ZstdCompressor() = delete;
 
-   explicit ZstdCompressor(std::shared_ptr<ZstdCDictionary> dictionary);
+   explicit ZstdCompressor(std::shared_ptr<const ZstdCDictionary> dictionary);
 
    std::string_view compress(const char* input_data, size_t input_size);
 };
@@ -0,0 +1,40 @@
+#include "rhydb/zstd/zstd_compressor_pool.h"
+
+#include <utility>
+
+namespace rhydb {
+
+ZstdCompressorPool::Lease::Lease(
+   ZstdCompressorPool* pool,
+   std::unique_ptr<ZstdCompressor> compressor
+)
+    : pool(pool),
+      compressor(std::move(compressor)) {}
+
+ZstdCompressorPool::Lease::~Lease() {
+   if (compressor != nullptr) {
+      pool->release(std::move(compressor));
+   }
+}
+
+ZstdCompressorPool::ZstdCompressorPool(std::shared_ptr<const ZstdCDictionary> dictionary)
+    : dictionary(std::move(dictionary)) {}
+
+ZstdCompressorPool::Lease ZstdCompressorPool::acquire() {
+   {
+      const std::lock_guard lock{mutex};
+      if (!idle_compressors.empty()) {
+         auto compressor = std::move(idle_compressors.back());
+         idle_compressors.pop_back();
+         return Lease{this, std::move(compressor)};
+      }
+   }
+   return Lease{this, std::make_unique<ZstdCompressor>(dictionary)};
+}
+
+void ZstdCompressorPool::release(std::unique_ptr<ZstdCompressor> compressor) {
+   const std::lock_guard lock{mutex};
+   idle_compressors.push_back(std::move(compressor));
+}
+
+}  // namespace rhydb
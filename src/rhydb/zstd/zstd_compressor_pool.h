@@ -0,0 +1,61 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "rhydb/zstd/zstd_compressor.h"
+#include "rhydb/zstd/zstd_dictionary.h"
+
+namespace rhydb {
+
+/// Hands out `ZstdCompressor`s for one dictionary to concurrent users. A compressor owns a zstd
+/// context and an output buffer, both of which are expensive to set up for every batch. Leased
+/// compressors go back to the pool when the lease ends, so the pool grows to the number of threads
+/// compressing at the same time and their contexts are reused from then on.
+class ZstdCompressorPool {
+   std::shared_ptr<const ZstdCDictionary> dictionary;
+   std::mutex mutex;
+   std::vector<std::unique_ptr<ZstdCompressor>> idle_compressors;
+
+  public:
+   /// Exclusive use of one compressor of the pool. Must not outlive the pool.
+   class Lease {
+      ZstdCompressorPool* pool;
+      std::unique_ptr<ZstdCompressor> compressor;
+
+     public:
+      Lease(ZstdCompressorPool* pool, std::unique_ptr<ZstdCompressor> compressor);
+
+      Lease(const Lease&) = delete;
+      Lease& operator=(const Lease&) = delete;
+      Lease(Lease&& other) noexcept = default;
+      Lease& operator=(Lease&& other) noexcept = delete;
+
+      ~Lease();
+
+      ZstdCompressor& operator*() { return *compressor; }
+      ZstdCompressor* operator->() { return compressor.get(); }
+   };
+
+   explicit ZstdCompressorPool(std::shared_ptr<const ZstdCDictionary> dictionary);
+
+   ZstdCompressorPool(const ZstdCompressorPool&) = delete;
+   ZstdCompressorPool& operator=(const ZstdCompressorPool&) = delete;
+   ZstdCompressorPool(ZstdCompressorPool&&) = delete;
+   ZstdCompressorPool& operator=(ZstdCompressorPool&&) = delete;
+
+   ~ZstdCompressorPool() = default;
+
+   /// Takes an idle compressor, or creates a new one if all of them are in use.
+   Lease acquire();
+
+   [[nodiscard]] const std::shared_ptr<const ZstdCDictionary>& getDictionary() const {
+      return dictionary;
+   }
+
+  private:
+   void release(std::unique_ptr<ZstdCompressor> compressor);
+};
+
+}  // namespace rhydb
@@ -0,0 +1,57 @@
+#include "rhydb/zstd/zstd_compressor_pool.h"
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "rhydb/zstd/zstd_decompressor.h"
+#include "rhydb/zstd/zstd_dictionary.h"
+
+using rhydb::ZstdCDictionary;
+using rhydb::ZstdCompressor;
+using rhydb::ZstdCompressorPool;
+using rhydb::ZstdDDictionary;
+using rhydb::ZstdDecompressor;
+
+namespace {
+
+const std::string REFERENCE = "ACGTACGTTTGACCANNACGTAGCTAGCTAGCATCGATCGATCGA";
+
+}  // namespace
+
+TEST(ZstdCompressorPool, compressesAgainstTheDictionary) {
+   ZstdCompressorPool pool{std::make_shared<const ZstdCDictionary>(REFERENCE, 3)};
+   const std::string sequence = "ACGTACGTTTGACCATTACGTAGCTAGCTAGCATCGATCGATCGA";
+
+   std::string compressed;
+   {
+      auto compressor = pool.acquire();
+      compressed = std::string{compressor->compress(sequence.data(), sequence.size())};
+   }
+
+   ZstdDecompressor decompressor{std::make_shared<ZstdDDictionary>(REFERENCE)};
+   std::string decompressed;
+   decompressor.decompress(compressed, decompressed);
+   EXPECT_EQ(decompressed, sequence);
+}
+
+TEST(ZstdCompressorPool, reusesReleasedCompressors) {
+   ZstdCompressorPool pool{std::make_shared<const ZstdCDictionary>(REFERENCE, 3)};
+
+   const ZstdCompressor* first_compressor = nullptr;
+   {
+      auto lease = pool.acquire();
+      first_compressor = &*lease;
+   }
+   auto lease = pool.acquire();
+   EXPECT_EQ(&*lease, first_compressor);
+}
+
+TEST(ZstdCompressorPool, concurrentLeasesGetDistinctCompressors) {
+   ZstdCompressorPool pool{std::make_shared<const ZstdCDictionary>(REFERENCE, 3)};
+
+   auto first_lease = pool.acquire();
+   auto second_lease = pool.acquire();
+   EXPECT_NE(&*first_lease, &*second_lease);
+}